@@ -0,0 +1,11 @@
+// Benchmark: 11_fibonacci.js scaled up
+// Naive recursive fib(24), about 75k calls
+
+function fib(n) {
+    if (n <= 1) {
+        return n;
+    }
+    return fib(n - 1) + fib(n - 2);
+}
+
+console.log(fib(24));
@@ -0,0 +1,305 @@
+/* 포인터 AST vs 평평한 AST (flat.h)
+ * 같은 프로그램을 두 배치로 두고 비교
+ * - memory : 노드 수와 노드당 바이트 (이름 문자열 제외, 아레나 정렬 패딩 제외)
+ * - walk   : 모든 노드를 방문하는 순회 (포인터 재귀 / 인덱스 재귀 / 배열 선형 스캔)
+ * - eval   : eval_program vs flat_run (출력은 버퍼로, 두 결과가 같은지 확인)
+ *
+ * 사용법: flatbench <file.js> [반복 횟수]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ast.h"
+#include "context.h"
+#include "eval.h"
+#include "flat.h"
+#include "output.h"
+#include "resolve.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* === 포인터 AST === */
+
+typedef struct {
+    long nodes;
+    size_t bytes;
+    unsigned long sum;      /* 방문 검증용 (두 순회가 같은 값을 내야 함) */
+} Walk;
+
+static void walk_stmt(Walk *w, const Stmt *s);
+
+static void walk_expr(Walk *w, const Expr *e) {
+    if (!e) return;
+    w->nodes++;
+    w->bytes += sizeof(Expr);
+    w->sum = w->sum * 31 + e->kind;
+    switch (e->kind) {
+        case EXPR_INT:
+            w->sum += (unsigned long)e->u.int_value;
+            break;
+        case EXPR_BINOP:
+            walk_expr(w, e->u.binop.lhs);
+            walk_expr(w, e->u.binop.rhs);
+            break;
+        case EXPR_UNARY:
+            walk_expr(w, e->u.unary.operand);
+            break;
+        case EXPR_CALL:
+            for (const ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                w->bytes += sizeof(ExprList);
+                walk_expr(w, arg->expr);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void walk_list(Walk *w, const StmtList *list) {
+    if (!list) return;
+    w->bytes += sizeof(StmtList);
+    for (const Stmt *s = list->head; s; s = s->next) walk_stmt(w, s);
+}
+
+static void walk_stmt(Walk *w, const Stmt *s) {
+    if (!s) return;
+    w->nodes++;
+    w->bytes += sizeof(Stmt);
+    w->sum = w->sum * 31 + 100 + s->kind;
+    switch (s->kind) {
+        case STMT_VARDECL:
+            walk_expr(w, s->u.vardecl.init_value);
+            break;
+        case STMT_ASSIGN:
+            walk_expr(w, s->u.assign.value);
+            break;
+        case STMT_IF:
+            walk_expr(w, s->u.if_stmt.cond);
+            walk_stmt(w, s->u.if_stmt.then_stmt);
+            walk_stmt(w, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            walk_expr(w, s->u.while_stmt.cond);
+            walk_stmt(w, s->u.while_stmt.body);
+            break;
+        case STMT_FOR:
+            walk_stmt(w, s->u.for_stmt.init);
+            walk_expr(w, s->u.for_stmt.cond);
+            walk_stmt(w, s->u.for_stmt.step);
+            walk_stmt(w, s->u.for_stmt.body);
+            break;
+        case STMT_BLOCK:
+            walk_list(w, s->u.block);
+            break;
+        default:
+            walk_expr(w, s->u.expr);
+            break;
+    }
+}
+
+/* 함수 본문, top-level 문장 순서 (flat_build와 같은 순서) */
+static void walk_program(Walk *w, const Program *prog) {
+    for (const Item *item = prog->items; item; item = item->next) {
+        w->bytes += sizeof(Item);
+        if (item->kind != ITEM_FUNCTION) continue;
+        const Function *f = item->u.function;
+        w->bytes += sizeof(Function);
+        if (f->params) w->bytes += sizeof(ParamList);
+        for (const Param *p = f->params ? f->params->head : NULL; p; p = p->next) w->bytes += sizeof(Param);
+        walk_list(w, f->body);
+    }
+    for (const Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) walk_stmt(w, item->u.stmt);
+    }
+}
+
+/* === 평평한 AST === */
+
+static void flat_walk_stmt(Walk *w, const FlatProgram *fp, FlatId s);
+
+static void flat_walk_expr(Walk *w, const FlatProgram *fp, FlatId e) {
+    if (e == FLAT_NONE) return;
+    const FlatExpr *x = &fp->exprs[e];
+    w->nodes++;
+    w->sum = w->sum * 31 + x->kind;
+    switch (x->kind) {
+        case EXPR_INT:
+            w->sum += (unsigned long)x->a;
+            break;
+        case EXPR_BINOP:
+            flat_walk_expr(w, fp, x->a);
+            flat_walk_expr(w, fp, x->b);
+            break;
+        case EXPR_UNARY:
+            flat_walk_expr(w, fp, x->a);
+            break;
+        case EXPR_CALL: {
+            const FlatCall *c = &fp->calls[x->a];
+            for (int32_t k = 0; k < c->count; ++k) flat_walk_expr(w, fp, fp->list[c->first + k]);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void flat_walk_stmt(Walk *w, const FlatProgram *fp, FlatId s) {
+    if (s == FLAT_NONE) return;
+    const FlatStmt *x = &fp->stmts[s];
+    w->nodes++;
+    w->sum = w->sum * 31 + 100 + x->kind;
+    switch (x->kind) {
+        case STMT_VARDECL:
+        case STMT_ASSIGN:
+            flat_walk_expr(w, fp, x->a);
+            break;
+        case STMT_IF:
+            flat_walk_expr(w, fp, x->a);
+            flat_walk_stmt(w, fp, x->b);
+            flat_walk_stmt(w, fp, x->c);
+            break;
+        case STMT_WHILE:
+            flat_walk_expr(w, fp, x->a);
+            flat_walk_stmt(w, fp, x->b);
+            break;
+        case STMT_FOR:
+            flat_walk_stmt(w, fp, x->a);
+            flat_walk_expr(w, fp, x->b);
+            flat_walk_stmt(w, fp, x->c);
+            flat_walk_stmt(w, fp, x->d);
+            break;
+        case STMT_BLOCK:
+            for (int32_t k = 0; k < x->b; ++k) flat_walk_stmt(w, fp, fp->list[x->a + k]);
+            break;
+        default:
+            flat_walk_expr(w, fp, x->a);
+            break;
+    }
+}
+
+static void flat_walk_program(Walk *w, const FlatProgram *fp) {
+    for (int i = 0; i < fp->nitems; ++i) {
+        if (fp->items[i].kind != ITEM_FUNCTION) continue;
+        const FlatFunc *f = &fp->funcs[fp->items[i].index];
+        for (int32_t k = 0; k < f->count; ++k) flat_walk_stmt(w, fp, fp->list[f->first + k]);
+    }
+    for (int i = 0; i < fp->nitems; ++i) {
+        if (fp->items[i].kind == ITEM_STMT) flat_walk_stmt(w, fp, fp->items[i].index);
+    }
+}
+
+/* 순서가 필요 없는 분석은 배열을 앞에서부터 읽기만 하면 됨 */
+static void flat_scan(Walk *w, const FlatProgram *fp) {
+    for (int i = 0; i < fp->nexprs; ++i) {
+        w->nodes++;
+        if (fp->exprs[i].kind == EXPR_INT) w->sum += (unsigned long)fp->exprs[i].a;
+    }
+    for (int i = 0; i < fp->nstmts; ++i) {
+        w->nodes++;
+        w->sum += fp->stmts[i].kind;
+    }
+}
+
+/* === 측정 === */
+
+typedef void (*WalkFn)(Walk *w, const void *arg);
+
+static void run_pointer(Walk *w, const void *arg) { walk_program(w, (const Program *)arg); }
+static void run_flat(Walk *w, const void *arg) { flat_walk_program(w, (const FlatProgram *)arg); }
+static void run_scan(Walk *w, const void *arg) { flat_scan(w, (const FlatProgram *)arg); }
+
+static double best_walk(WalkFn fn, const void *arg, int repeat, Walk *out) {
+    double best = 0;
+    for (int r = 0; r < repeat; ++r) {
+        Walk w;
+        memset(&w, 0, sizeof(w));
+        double t0 = now_sec();
+        fn(&w, arg);
+        double t = now_sec() - t0;
+        if (r == 0 || t < best) best = t;
+        *out = w;
+    }
+    return best;
+}
+
+static double time_eval(Program *prog, FlatProgram *fp, Output *out) {
+    output_init_grow(out);
+    double t0 = now_sec();
+    if (fp) {
+        flat_run(fp, out);
+    } else {
+        eval_program(prog, out);
+    }
+    return now_sec() - t0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <file.js> [repeat]\n", argv[0]);
+        return 2;
+    }
+    const char *path = argv[1];
+    int repeat = argc > 2 ? atoi(argv[2]) : 5;
+    if (repeat < 1) repeat = 1;
+
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        fprintf(stderr, "Error: Cannot open file '%s'\n", path);
+        return 1;
+    }
+    MiniJSContext *ctx = minijs_context_new();
+    int parsed = minijs_parse_file(ctx, in);
+    fclose(in);
+    if (parsed != 0) {
+        minijs_context_free(ctx);
+        return 1;
+    }
+    Program *prog = ctx->program;
+    if (!resolve_program(prog)) {
+        fprintf(stderr, "note: %s (flat_run needs resolved slots, eval skipped)\n", prog->resolve_error);
+    }
+
+    double t0 = now_sec();
+    FlatProgram *fp = flat_build(prog);
+    double build = now_sec() - t0;
+
+    Walk pw, fw, sw;
+    double tp = best_walk(run_pointer, prog, repeat, &pw);
+    double tf = best_walk(run_flat, fp, repeat, &fw);
+    double ts = best_walk(run_scan, fp, repeat, &sw);
+    if (pw.nodes != fw.nodes || pw.sum != fw.sum) {
+        fprintf(stderr, "[FAIL] flat walk differs: %ld nodes vs %ld\n", fw.nodes, pw.nodes);
+        return 1;
+    }
+    size_t flat_total = flat_bytes(fp);
+
+    printf("%-8s %10s %12s %12s %16s\n", "layout", "nodes", "bytes", "bytes/node", "walk (ns/node)");
+    printf("%-8s %10ld %12zu %12.1f %16.2f\n", "pointer", pw.nodes, pw.bytes,
+           (double)pw.bytes / pw.nodes, tp * 1e9 / pw.nodes);
+    printf("%-8s %10d %12zu %12.1f %16.2f\n", "flat", flat_node_count(fp), flat_total,
+           (double)flat_total / flat_node_count(fp), tf * 1e9 / fw.nodes);
+    printf("%-8s %10s %12s %12s %16.2f\n", "scan", "", "", "", ts * 1e9 / sw.nodes);
+    printf("flat_build: %.2f ms\n", build * 1e3);
+
+    if (prog->resolved) {
+        Output a, b;
+        double te = time_eval(prog, NULL, &a);
+        double tr = time_eval(prog, fp, &b);
+        if (a.pos != b.pos || memcmp(a.buffer, b.buffer, a.pos) != 0) {
+            fprintf(stderr, "[FAIL] flat_run output differs from eval_program\n");
+            return 1;
+        }
+        printf("eval: tree %.1f ms, flat %.1f ms (%.2fx)\n", te * 1e3, tr * 1e3, tr > 0 ? te / tr : 0.0);
+        output_release(&a);
+        output_release(&b);
+    }
+
+    flat_free(fp);
+    minijs_context_free(ctx);
+    return 0;
+}
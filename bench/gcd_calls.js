@@ -0,0 +1,21 @@
+// Benchmark: 08_gcd.js scaled up
+// Recursive gcd over a 300x100 grid
+
+function gcd(a, b) {
+    if (b == 0) {
+        return a;
+    }
+    return gcd(b, a % b);
+}
+
+let acc = 0;
+let a = 1;
+while (a <= 300) {
+    let b = 1;
+    while (b <= 100) {
+        acc = acc + gcd(a, b);
+        b = b + 1;
+    }
+    a = a + 1;
+}
+console.log(acc);
@@ -0,0 +1,105 @@
+/* 렉서 처리량 측정 (MB/s)
+ * 같은 파일을 세 가지 입력 경로로 끝까지 토큰화
+ * - mmap  : yy_scan_file (파일을 매핑해 제자리 스캔)
+ * - read  : yy_scan_stream (파이프/stdin 경로, 끝까지 읽은 뒤 제자리 스캔)
+ * - string: yy_scan_string_custom (웹 버전 경로, 한 번 복사 후 제자리 스캔)
+ * 식별자는 실행마다 새 Program에 인터닝 (파서와 같은 조건, 해제는 측정 밖)
+ *
+ * 사용법: lexbench <file.js> [반복 횟수]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ast.h"
+#include "parser.tab.h"
+#include "scanner.h"
+
+extern int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner, Program *prog);
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* EOF까지 토큰화, 반환: 토큰 수 */
+static long drain(yyscan_t scanner, Program *prog) {
+    long count = 0;
+    YYSTYPE lval;
+    while (yylex(&lval, scanner, prog) != 0) count++;
+    return count;
+}
+
+static char *read_all(const char *path, long *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = (char *)malloc(*size + 1);
+    if (fread(buf, 1, *size, f) != (size_t)*size) {
+        fclose(f);
+        free(buf);
+        return NULL;
+    }
+    buf[*size] = '\0';
+    fclose(f);
+    return buf;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <file.js> [repeat]\n", argv[0]);
+        return 2;
+    }
+    const char *path = argv[1];
+    int repeat = argc > 2 ? atoi(argv[2]) : 3;
+    if (repeat < 1) repeat = 1;
+
+    long size = 0;
+    char *source = read_all(path, &size);
+    if (!source) {
+        fprintf(stderr, "Error: Cannot read file '%s'\n", path);
+        return 1;
+    }
+
+    yyscan_t scanner = scanner_create();
+    static const char *modes[] = { "mmap", "read", "string" };
+    printf("%-8s %10s %10s %10s\n", "input", "tokens", "best (ms)", "MB/s");
+    for (int m = 0; m < 3; ++m) {
+        double best = 0;
+        long tokens = 0;
+        for (int r = 0; r < repeat; ++r) {
+            FILE *f = NULL;
+            Program *prog = new_program();
+            double t0 = now_sec();
+            if (m == 2) {
+                yy_scan_string_custom(source, scanner);
+            } else {
+                f = fopen(path, "r");
+                if (!f) {
+                    fprintf(stderr, "Error: Cannot open file '%s'\n", path);
+                    return 1;
+                }
+                if (m == 0) {
+                    yy_scan_file(f, scanner);
+                } else {
+                    yy_scan_stream(f, scanner);
+                }
+            }
+            tokens = drain(scanner, prog);
+            double t = now_sec() - t0;
+            free_program(prog);
+            yy_scan_file_release(scanner);
+            if (f) fclose(f);
+            if (r == 0 || t < best) best = t;
+        }
+        printf("%-8s %10ld %10.1f %10.1f\n", modes[m], tokens, best * 1e3,
+               best > 0 ? size / best / 1e6 : 0.0);
+    }
+
+    scanner_destroy(scanner);
+    free(source);
+    return 0;
+}
@@ -0,0 +1,245 @@
+/* minijs --serve 부하 생성기
+ * 동시 연결 수를 바꿔 가며 같은 스크립트를 반복 요청하고
+ * 클라이언트에서 잰 왕복 지연 시간의 p50/p99와 처리량을 출력
+ * 마지막에 서버 카운터 (STATS 요청)를 출력
+ *
+ * 사용법: loadgen <socket> <file.js> [EVAL|VM|ASM] [연결당 요청 수] [동시성 목록]
+ *   예: loadgen /tmp/minijs.sock bench/fib_recursive.js VM 200 1,2,4,8,16
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define MAX_LEVELS 16
+
+static const char *socket_path;
+static const char *mode = "EVAL";
+static char *source;
+static long source_len;
+static int requests_per_client = 200;
+
+typedef struct {
+    long *latency_us;   /* 요청별 왕복 시간 */
+    int done;
+    int failed;
+} Client;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int connect_server(void) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int write_all(int fd, const char *data, long size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n <= 0) return -1;
+        data += n;
+        size -= n;
+    }
+    return 0;
+}
+
+static int read_exact(int fd, char *dst, long size) {
+    while (size > 0) {
+        ssize_t n = read(fd, dst, size);
+        if (n <= 0) return -1;
+        dst += n;
+        size -= n;
+    }
+    return 0;
+}
+
+/* 요청 하나 보내고 응답을 끝까지 읽음
+ * - body: 응답 본문 (NULL이면 버림, 널 종료)
+ * - 반환: OK/TRUNC 응답이면 0 */
+static int request(int fd, const char *cmd, const char *src, long len, char *body, long body_size) {
+    char header[128];
+    int hlen = snprintf(header, sizeof(header), "%s %ld\n", cmd, len);
+    if (body && body_size > 0) body[0] = '\0';
+    if (write_all(fd, header, hlen) != 0 || write_all(fd, src, len) != 0) return -1;
+
+    int n = 0;
+    for (;;) {
+        if (n + 1 >= (int)sizeof(header) || read(fd, header + n, 1) != 1) return -1;
+        if (header[n] == '\n') break;
+        n++;
+    }
+    header[n] = '\0';
+
+    char status[8];
+    int ret;
+    long body_len, us;
+    if (sscanf(header, "%7s %d %ld %ld", status, &ret, &body_len, &us) != 4) return -1;
+
+    char scratch[4096];
+    while (body_len > 0) {
+        long chunk = body_len;
+        char *dst = scratch;
+        if (body && body_size > 1) {
+            dst = body;
+            if (chunk > body_size - 1) chunk = body_size - 1;
+            body += chunk;
+            body_size -= chunk;
+            *body = '\0';
+        } else if (chunk > (long)sizeof(scratch)) {
+            chunk = sizeof(scratch);
+        }
+        if (read_exact(fd, dst, chunk) != 0) return -1;
+        body_len -= chunk;
+    }
+    return strcmp(status, "OK") == 0 || strcmp(status, "TRUNC") == 0 ? 0 : -1;
+}
+
+static void *client_main(void *arg) {
+    Client *c = (Client *)arg;
+    int fd = connect_server();
+    if (fd < 0) {
+        c->failed = requests_per_client;
+        return NULL;
+    }
+    for (int i = 0; i < requests_per_client; ++i) {
+        double t0 = now_sec();
+        if (request(fd, mode, source, source_len, NULL, 0) != 0) {
+            c->failed = requests_per_client - i;
+            break;
+        }
+        c->latency_us[c->done++] = (long)((now_sec() - t0) * 1e6);
+    }
+    close(fd);
+    return NULL;
+}
+
+static int cmp_long(const void *a, const void *b) {
+    long x = *(const long *)a, y = *(const long *)b;
+    return (x > y) - (x < y);
+}
+
+static char *read_all(const char *path, long *size) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = (char *)malloc(*size + 1);
+    if (fread(buf, 1, *size, f) != (size_t)*size) {
+        fclose(f);
+        free(buf);
+        return NULL;
+    }
+    buf[*size] = '\0';
+    fclose(f);
+    return buf;
+}
+
+/* 동시 연결 clients개로 한 단계 실행, 반환: 실패한 요청 수 */
+static int run_level(int clients) {
+    Client *cs = (Client *)calloc(clients, sizeof(Client));
+    pthread_t *threads = (pthread_t *)calloc(clients, sizeof(pthread_t));
+    long *all = (long *)malloc((size_t)clients * requests_per_client * sizeof(long));
+    for (int i = 0; i < clients; ++i) {
+        cs[i].latency_us = all + (size_t)i * requests_per_client;
+    }
+
+    double t0 = now_sec();
+    for (int i = 0; i < clients; ++i) pthread_create(&threads[i], NULL, client_main, &cs[i]);
+    for (int i = 0; i < clients; ++i) pthread_join(threads[i], NULL);
+    double elapsed = now_sec() - t0;
+
+    /* 완료된 요청만 앞으로 모아 정렬 */
+    long n = 0;
+    int failed = 0;
+    for (int i = 0; i < clients; ++i) {
+        memmove(all + n, cs[i].latency_us, cs[i].done * sizeof(long));
+        n += cs[i].done;
+        failed += cs[i].failed;
+    }
+    qsort(all, n, sizeof(long), cmp_long);
+    long p50 = n ? all[(n - 1) * 50 / 100] : 0;
+    long p99 = n ? all[(n - 1) * 99 / 100] : 0;
+    printf("%11d %10ld %10.1f %10ld %10ld %8d\n", clients, n,
+           elapsed > 0 ? n / elapsed : 0.0, p50, p99, failed);
+    fflush(stdout);
+
+    free(all);
+    free(threads);
+    free(cs);
+    return failed;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <socket> <file.js> [EVAL|VM|ASM] [requests] [c1,c2,...]\n", argv[0]);
+        return 2;
+    }
+    socket_path = argv[1];
+    if (argc > 3) mode = argv[3];
+    if (argc > 4) requests_per_client = atoi(argv[4]);
+    if (requests_per_client < 1) requests_per_client = 1;
+
+    int levels[MAX_LEVELS];
+    int nlevels = 0;
+    const char *spec = argc > 5 ? argv[5] : "1,2,4,8,16";
+    for (const char *p = spec; *p && nlevels < MAX_LEVELS; ) {
+        int c = atoi(p);
+        if (c > 0) levels[nlevels++] = c;
+        while (*p && *p != ',') p++;
+        if (*p == ',') p++;
+    }
+
+    source = read_all(argv[2], &source_len);
+    if (!source) {
+        fprintf(stderr, "Error: Cannot read file '%s'\n", argv[2]);
+        return 1;
+    }
+
+    /* 응답 확인용 한 번 실행 (실패하면 측정하지 않음)
+     * 연결은 바로 닫음: 열어 두면 측정 중에 워커 하나를 계속 점유 */
+    int fd = connect_server();
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot connect to '%s'\n", socket_path);
+        return 1;
+    }
+    char body[4096];
+    int ok = request(fd, mode, source, source_len, body, sizeof(body)) == 0;
+    close(fd);
+    if (!ok) {
+        fprintf(stderr, "Error: %s request failed: %s", mode, body);
+        return 1;
+    }
+
+    printf("mode: %s, %d request(s) per connection\n", mode, requests_per_client);
+    printf("%11s %10s %10s %10s %10s %8s\n",
+           "connections", "requests", "req/s", "p50 (us)", "p99 (us)", "failed");
+    int failed = 0;
+    for (int i = 0; i < nlevels; ++i) {
+        failed += run_level(levels[i]);
+    }
+
+    fd = connect_server();
+    if (fd >= 0 && request(fd, "STATS", "", 0, body, sizeof(body)) == 0) {
+        printf("--- server ---\n%s", body);
+    }
+    if (fd >= 0) close(fd);
+    free(source);
+    return failed ? 1 : 0;
+}
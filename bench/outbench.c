@@ -0,0 +1,77 @@
+/* console.log 출력 경로 처리량 측정
+ * 정수 N개를 줄마다 출력하는 시간을 경로별로 비교
+ * - fprintf : vfprintf(stdout, "%ld\n") (파일 출력의 이전 경로)
+ * - snprintf: 고정 버퍼에 vsnprintf("%ld\n") (버퍼 출력의 이전 경로, 가득 차면 비움)
+ * - file    : output_line_int, OUTPUT_FILE (자체 버퍼 + flush)
+ * - grow    : output_line_int, OUTPUT_GROW (늘어나는 메모리 버퍼)
+ *
+ * 사용법: outbench [정수 개수] [출력 파일 (기본 /dev/null)]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "output.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 예제가 출력하는 값과 비슷하게 부호와 자릿수가 섞인 정수 */
+static long value_at(long i) {
+    return (i & 1) ? i * 7919 : -i;
+}
+
+int main(int argc, char *argv[]) {
+    long count = argc > 1 ? atol(argv[1]) : 10000000;
+    const char *path = argc > 2 ? argv[2] : "/dev/null";
+    if (count < 1) count = 1;
+
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "Error: Cannot open output file '%s'\n", path);
+        return 1;
+    }
+
+    static const char *modes[] = { "fprintf", "snprintf", "file", "grow" };
+    double secs[4];
+    long bytes = 0;
+    for (int m = 0; m < 4; ++m) {
+        double t0 = now_sec();
+        if (m == 0) {
+            for (long i = 0; i < count; ++i) fprintf(f, "%ld\n", value_at(i));
+            fflush(f);
+        } else if (m == 1) {
+            static char buf[OUTPUT_FILE_BUFSIZE];
+            int pos = 0;
+            for (long i = 0; i < count; ++i) {
+                if (sizeof(buf) - pos < 32) pos = 0;
+                pos += snprintf(buf + pos, sizeof(buf) - pos, "%ld\n", value_at(i));
+            }
+            if (pos < 0) return 1;
+        } else if (m == 2) {
+            Output out;
+            output_init_file(&out, f);
+            for (long i = 0; i < count; ++i) output_line_int(&out, value_at(i));
+            output_release(&out);
+        } else {
+            Output out;
+            output_init_grow(&out);
+            for (long i = 0; i < count; ++i) output_line_int(&out, value_at(i));
+            bytes = out.pos;
+            output_release(&out);
+        }
+        secs[m] = now_sec() - t0;
+    }
+    fclose(f);
+
+    printf("%ld integers, %.1f MB of output\n", count, bytes / 1e6);
+    printf("%-10s %10s %10s %9s\n", "path", "ms", "ns/line", "speedup");
+    for (int m = 0; m < 4; ++m) {
+        printf("%-10s %10.1f %10.1f %8.1fx\n", modes[m], secs[m] * 1e3, secs[m] * 1e9 / count,
+               secs[m] > 0 ? secs[0] / secs[m] : 0);
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+// Benchmark: 14_prime.js scaled up
+// Counts primes below 30000 by trial division
+
+function isPrime(n) {
+    if (n <= 1) {
+        return 0;
+    }
+    let i = 2;
+    while (i * i <= n) {
+        if (n % i == 0) {
+            return 0;
+        }
+        i = i + 1;
+    }
+    return 1;
+}
+
+let count = 0;
+let n = 2;
+while (n < 30000) {
+    if (isPrime(n)) {
+        count = count + 1;
+    }
+    n = n + 1;
+}
+console.log(count);
@@ -0,0 +1,37 @@
+#!/usr/bin/env sh
+# Compare the pointer AST with the flattened index-based AST (flat.h):
+# memory per node and traversal time on a generated multi-megabyte program,
+# then tree interpreter vs flat interpreter time on every benchmark script.
+
+set -eu
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/build/flatbench}"
+FUNCS="${FLAT_BENCH_FUNCS:-20000}"
+
+if [ ! -x "${BINARY}" ]; then
+    echo "error: binary not found or not executable: ${BINARY}" >&2
+    exit 2
+fi
+
+TMP_SRC="$(mktemp)"
+trap 'rm -f "${TMP_SRC}"' EXIT
+
+# Functions with loops, branches and calls, each called once from top level
+# (an uncalled function would be removed before the layouts are built)
+awk -v n="${FUNCS}" 'BEGIN {
+    for (i = 0; i < n; i++) {
+        printf "function f%d(a, b) { let acc = 0; for (let i = 0; i < a; i = i + 1) { if (i %% 3 == 0) { acc = acc + (b * i) %% 7; } else { acc = acc - 1; } } return acc + a * b; }\n", i
+        printf "let r%d = f%d(%d, 3);\n", i, i, i % 10
+    }
+    print "console.log(r0 + r1);"
+}' >"${TMP_SRC}"
+
+echo "--- generated program (${FUNCS} functions) ---"
+"${BINARY}" "${TMP_SRC}" 5
+
+for JS_FILE in "${SCRIPT_DIR}"/*.js; do
+    echo "--- $(basename "${JS_FILE}") ---"
+    "${BINARY}" "${JS_FILE}" 3
+done
@@ -0,0 +1,29 @@
+#!/usr/bin/env sh
+# Measure lexer throughput (MB/s) on a generated multi-megabyte source.
+
+set -eu
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/build/lexbench}"
+FUNCS="${LEX_BENCH_FUNCS:-60000}"
+
+if [ ! -x "${BINARY}" ]; then
+    echo "error: binary not found or not executable: ${BINARY}" >&2
+    exit 2
+fi
+
+TMP_SRC="$(mktemp)"
+trap 'rm -f "${TMP_SRC}"' EXIT
+
+# Functions with loops, calls, strings and comments (~140 bytes each)
+awk -v n="${FUNCS}" 'BEGIN {
+    for (i = 0; i < n; i++) {
+        printf "// helper %d\nfunction f%d(a, b) { let acc = 0; for (let i = 0; i < a; i = i + 1) { acc = acc + (b * i) %% 7; } return acc; }\n", i, i
+        if (i % 100 == 0) printf "console.log(\"checkpoint %d\");\n", i
+    }
+}' >"${TMP_SRC}"
+
+SIZE="$(wc -c <"${TMP_SRC}")"
+awk -v s="${SIZE}" 'BEGIN { printf "source: %.1f MB\n", s / 1e6 }'
+"${BINARY}" "${TMP_SRC}" 3
@@ -0,0 +1,76 @@
+#!/usr/bin/env sh
+# Compile every benchmark and example to x86-64 at -O0 (stack machine) and -O1
+# (linear-scan register allocation), link with the system C compiler, check the
+# output against the tree interpreter and time REPEAT runs of each binary.
+
+set -eu
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/minijs}"
+CC="${CC:-cc}"
+REPEAT="${REPEAT:-20}"
+
+if [ ! -x "${BINARY}" ]; then
+    echo "error: binary not found or not executable: ${BINARY}" >&2
+    exit 2
+fi
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "${WORK_DIR}"' EXIT
+
+now_ns() {
+    date +%s%N
+}
+
+# build <file.js> <level>: 어셈블리 + 실행 파일 (실패하면 1)
+build() {
+    "${BINARY}" -c "-O$2" -o "${WORK_DIR}/O$2.s" "$1" >/dev/null &&
+        "${CC}" -o "${WORK_DIR}/O$2" "${WORK_DIR}/O$2.s"
+}
+
+# time_runs <exe>: REPEAT번 실행한 총 시간 (ns)
+time_runs() {
+    T0="$(now_ns)"
+    i=0
+    while [ "${i}" -lt "${REPEAT}" ]; do
+        "$1" >/dev/null || true
+        i=$((i + 1))
+    done
+    T1="$(now_ns)"
+    echo $((T1 - T0))
+}
+
+STATUS=0
+echo "${REPEAT} run(s) per binary, time per run"
+printf "%-26s %9s %9s %11s %11s %9s\n" "program" "-O0 insn" "-O1 insn" "-O0 (ms)" "-O1 (ms)" "speedup"
+
+for JS_FILE in "${SCRIPT_DIR}"/*.js "${PROJECT_ROOT}"/examples/*.js; do
+    NAME="$(basename "${JS_FILE}")"
+    "${BINARY}" -q -e "${JS_FILE}" >"${WORK_DIR}/expected" 2>&1 || true
+
+    if ! build "${JS_FILE}" 0 || ! build "${JS_FILE}" 1; then
+        echo "[FAIL] ${NAME}: native build failed" >&2
+        STATUS=1
+        continue
+    fi
+
+    for LEVEL in 0 1; do
+        "${WORK_DIR}/O${LEVEL}" >"${WORK_DIR}/out" 2>&1 || true
+        if ! cmp -s "${WORK_DIR}/expected" "${WORK_DIR}/out"; then
+            echo "[FAIL] ${NAME}: -O${LEVEL} output differs from eval_program" >&2
+            STATUS=1
+        fi
+    done
+
+    # 명령어 수: 들여쓴 줄 중 지시어(.)와 주석(#)을 제외
+    I0="$(grep -c '^    [a-z]' "${WORK_DIR}/O0.s" || true)"
+    I1="$(grep -c '^    [a-z]' "${WORK_DIR}/O1.s" || true)"
+    N0="$(time_runs "${WORK_DIR}/O0")"
+    N1="$(time_runs "${WORK_DIR}/O1")"
+
+    awk -v n="${NAME}" -v i0="${I0}" -v i1="${I1}" -v a="${N0}" -v b="${N1}" -v r="${REPEAT}" \
+        'BEGIN { printf "%-26s %9d %9d %11.2f %11.2f %8.2fx\n", n, i0, i1, a / r / 1e6, b / r / 1e6, (b > 0 ? a / b : 0) }'
+done
+
+exit ${STATUS}
@@ -0,0 +1,59 @@
+#!/usr/bin/env sh
+# Measure console.log throughput: the output writer on its own (outbench) and
+# end to end, a script printing COUNT integers under eval, the VM, the JIT and
+# as a native binary (-O0/-O1, buffered minijs_rt runtime in the assembly).
+
+set -eu
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/minijs}"
+OUTBENCH="${2:-${PROJECT_ROOT}/build/outbench}"
+COUNT="${OUTPUT_BENCH_COUNT:-10000000}"
+CC="${CC:-cc}"
+
+for B in "${BINARY}" "${OUTBENCH}"; do
+    if [ ! -x "${B}" ]; then
+        echo "error: binary not found or not executable: ${B}" >&2
+        exit 2
+    fi
+done
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "${WORK_DIR}"' EXIT
+TMP_SRC="${WORK_DIR}/print_ints.js"
+
+now_ns() {
+    date +%s%N
+}
+
+"${OUTBENCH}" "${COUNT}"
+echo
+
+cat >"${TMP_SRC}" <<JS
+let i = 0;
+while (i < ${COUNT}) {
+    console.log(i);
+    i = i + 1;
+}
+JS
+
+printf "%-8s %12s %14s\n" "engine" "ms" "lines/s"
+for ENGINE in "-e" "-e --vm" "-j"; do
+    T0="$(now_ns)"
+    # shellcheck disable=SC2086
+    "${BINARY}" -q ${ENGINE} "${TMP_SRC}" >/dev/null
+    T1="$(now_ns)"
+    awk -v e="${ENGINE}" -v t="$((T1 - T0))" -v n="${COUNT}" \
+        'BEGIN { printf "%-8s %12.1f %14.0f\n", e, t / 1e6, (t > 0 ? n / (t / 1e9) : 0) }'
+done
+
+for LEVEL in 0 1; do
+    "${BINARY}" -c "-O${LEVEL}" -o "${WORK_DIR}/O${LEVEL}.s" "${TMP_SRC}" >/dev/null
+    "${CC}" -o "${WORK_DIR}/O${LEVEL}" "${WORK_DIR}/O${LEVEL}.s"
+    T0="$(now_ns)"
+    "${WORK_DIR}/O${LEVEL}" >/dev/null
+    T1="$(now_ns)"
+    awk -v e="-O${LEVEL}" -v t="$((T1 - T0))" -v n="${COUNT}" \
+        'BEGIN { printf "%-8s %12.1f %14.0f\n", e, t / 1e6, (t > 0 ? n / (t / 1e9) : 0) }'
+done
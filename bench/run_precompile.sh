@@ -0,0 +1,65 @@
+#!/usr/bin/env sh
+# Cold start: run a generated program from source (lex + parse + AST passes)
+# and from its precompiled .mjsc (mmap, no parsing), at several program sizes.
+# Both run on the flattened AST interpreter (--flat), so the difference is
+# only the front end. Each time is the best of REPEAT runs of the whole process.
+
+set -eu
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/minijs}"
+SIZES="${PRECOMPILE_BENCH_SIZES:-100 1000 10000 50000}"
+REPEAT="${PRECOMPILE_BENCH_REPEAT:-5}"
+
+if [ ! -x "${BINARY}" ]; then
+    echo "error: binary not found or not executable: ${BINARY}" >&2
+    exit 2
+fi
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "${WORK_DIR}"' EXIT
+
+now_ns() {
+    date +%s%N
+}
+
+# best_ms <file>: fastest of REPEAT runs of `minijs -e --flat -q <file>`
+best_ms() {
+    BEST=""
+    R=0
+    while [ "${R}" -lt "${REPEAT}" ]; do
+        T0="$(now_ns)"
+        "${BINARY}" -e --flat -q "$1" >/dev/null
+        T1="$(now_ns)"
+        T=$((T1 - T0))
+        if [ -z "${BEST}" ] || [ "${T}" -lt "${BEST}" ]; then BEST="${T}"; fi
+        R=$((R + 1))
+    done
+    awk -v t="${BEST}" 'BEGIN { printf "%.2f", t / 1e6 }'
+}
+
+printf "%-8s %12s %12s %12s %12s %8s\n" "funcs" "source KB" "mjsc KB" "parse ms" "mjsc ms" "speedup"
+for FUNCS in ${SIZES}; do
+    SRC="${WORK_DIR}/p${FUNCS}.js"
+    MJSC="${WORK_DIR}/p${FUNCS}.mjsc"
+    # Every function is called once so dead code elimination keeps it
+    awk -v n="${FUNCS}" 'BEGIN {
+        for (i = 0; i < n; i++) {
+            printf "function f%d(a, b) { let acc = 0; for (let i = 0; i < a; i = i + 1) { if (i %% 3 == 0) { acc = acc + (b * i) %% 7; } else { acc = acc - 1; } } return acc + a * b; }\n", i
+            printf "let r%d = f%d(%d, 3);\n", i, i, i % 4
+        }
+        print "console.log(r0 + r1);"
+    }' >"${SRC}"
+    "${BINARY}" --precompile "${SRC}" -o "${MJSC}" >/dev/null
+
+    if [ "$("${BINARY}" -e -q "${SRC}")" != "$("${BINARY}" -e -q "${MJSC}")" ]; then
+        echo "error: output differs for ${FUNCS} functions" >&2
+        exit 1
+    fi
+    PARSE_MS="$(best_ms "${SRC}")"
+    MJSC_MS="$(best_ms "${MJSC}")"
+    awk -v n="${FUNCS}" -v s="$(wc -c <"${SRC}")" -v m="$(wc -c <"${MJSC}")" \
+        -v p="${PARSE_MS}" -v q="${MJSC_MS}" \
+        'BEGIN { printf "%-8d %12.1f %12.1f %12.2f %12.2f %7.1fx\n", n, s / 1024, m / 1024, p, q, (q > 0 ? p / q : 0) }'
+done
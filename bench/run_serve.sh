@@ -0,0 +1,60 @@
+#!/usr/bin/env sh
+# Start minijs --serve, drive it with the load generator at several
+# concurrency levels, and print p50/p99 latency and throughput.
+
+set -eu
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/minijs}"
+LOADGEN="${2:-${PROJECT_ROOT}/build/loadgen}"
+WORKERS="${SERVE_WORKERS:-4}"
+REQUESTS="${SERVE_REQUESTS:-200}"
+LEVELS="${SERVE_LEVELS:-1,2,4,8,16,32}"
+SCRIPT="${SERVE_SCRIPT:-${PROJECT_ROOT}/examples/11_fibonacci.js}"
+
+for BIN in "${BINARY}" "${LOADGEN}"; do
+    if [ ! -x "${BIN}" ]; then
+        echo "error: binary not found or not executable: ${BIN}" >&2
+        exit 2
+    fi
+done
+
+TMP_DIR="$(mktemp -d)"
+SOCKET="${TMP_DIR}/minijs.sock"
+"${BINARY}" --serve "${SOCKET}" --workers "${WORKERS}" 2>"${TMP_DIR}/server.log" &
+SERVER_PID=$!
+trap 'kill "${SERVER_PID}" 2>/dev/null || true; wait "${SERVER_PID}" 2>/dev/null || true; rm -rf "${TMP_DIR}"' EXIT
+
+# Wait for the socket to appear
+i=0
+while [ ! -S "${SOCKET}" ]; do
+    i=$((i + 1))
+    if [ "${i}" -gt 50 ]; then
+        echo "error: server did not start" >&2
+        cat "${TMP_DIR}/server.log" >&2
+        exit 1
+    fi
+    sleep 0.1
+done
+
+# Baseline: one process per script (what the daemon replaces)
+RUNS=100
+T0="$(date +%s%N)"
+i=0
+while [ "${i}" -lt "${RUNS}" ]; do
+    "${BINARY}" -q -e "${SCRIPT}" >/dev/null
+    i=$((i + 1))
+done
+T1="$(date +%s%N)"
+echo "script: $(basename "${SCRIPT}"), workers: ${WORKERS}"
+awk -v n="${RUNS}" -v t="$((T1 - T0))" \
+    'BEGIN { printf "process per script: %.0f us/run (%d runs)\n", t / n / 1e3, n }'
+
+STATUS=0
+for MODE in EVAL VM ASM; do
+    echo ""
+    "${LOADGEN}" "${SOCKET}" "${SCRIPT}" "${MODE}" "${REQUESTS}" "${LEVELS}" || STATUS=1
+done
+
+exit ${STATUS}
@@ -0,0 +1,53 @@
+#!/usr/bin/env sh
+# Time every benchmark under the tree interpreter, the bytecode VM and the x86-64 JIT.
+
+set -eu
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/minijs}"
+
+if [ ! -x "${BINARY}" ]; then
+    echo "error: binary not found or not executable: ${BINARY}" >&2
+    exit 2
+fi
+
+TMP_EVAL="$(mktemp)"
+TMP_VM="$(mktemp)"
+TMP_JIT="$(mktemp)"
+trap 'rm -f "${TMP_EVAL}" "${TMP_VM}" "${TMP_JIT}"' EXIT
+
+now_ns() {
+    date +%s%N
+}
+
+STATUS=0
+printf "%-24s %12s %12s %12s %9s %9s\n" "benchmark" "eval (ms)" "vm (ms)" "jit (ms)" "vm" "jit"
+
+for JS_FILE in "${SCRIPT_DIR}"/*.js; do
+    NAME="$(basename "${JS_FILE}")"
+
+    T0="$(now_ns)"
+    "${BINARY}" -q -e "${JS_FILE}" >"${TMP_EVAL}"
+    T1="$(now_ns)"
+    "${BINARY}" -q -e --vm "${JS_FILE}" >"${TMP_VM}"
+    T2="$(now_ns)"
+    "${BINARY}" -q -j "${JS_FILE}" >"${TMP_JIT}"
+    T3="$(now_ns)"
+
+    if ! cmp -s "${TMP_EVAL}" "${TMP_VM}"; then
+        echo "[FAIL] ${NAME}: VM output differs from eval_program" >&2
+        STATUS=1
+        continue
+    fi
+    if ! cmp -s "${TMP_EVAL}" "${TMP_JIT}"; then
+        echo "[FAIL] ${NAME}: JIT output differs from eval_program" >&2
+        STATUS=1
+        continue
+    fi
+
+    awk -v n="${NAME}" -v e="$((T1 - T0))" -v v="$((T2 - T1))" -v j="$((T3 - T2))" \
+        'BEGIN { printf "%-24s %12.1f %12.1f %12.1f %8.1fx %8.1fx\n", n, e / 1e6, v / 1e6, j / 1e6, (v > 0 ? e / v : 0), (j > 0 ? e / j : 0) }'
+done
+
+exit ${STATUS}
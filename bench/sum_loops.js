@@ -0,0 +1,16 @@
+// Benchmark: 13_sum.js scaled up
+// Nested for loops, about 300k iterations
+
+function sumTo(n) {
+    let sum = 0;
+    for (let i = 1; i <= n; i = i + 1) {
+        sum = sum + i % 7;
+    }
+    return sum;
+}
+
+let total = 0;
+for (let k = 0; k < 30; k = k + 1) {
+    total = total + sumTo(10000);
+}
+console.log(total);
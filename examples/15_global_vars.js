@@ -0,0 +1,28 @@
+// Test 15: Global Variables
+// Purpose: Test functions reading/writing top-level variables and block shadowing
+// Expected: 3, 30, 5, 6, 5
+
+let counter = 0;
+let base = 10;
+
+function bump() {
+    counter = counter + 1;
+    return counter;
+}
+
+function scaled(k) {
+    return base * k;
+}
+
+bump();
+bump();
+console.log(bump());      // 3
+console.log(scaled(3));   // 30
+
+let x = 5;
+console.log(x);           // 5
+{
+    let x = 6;
+    console.log(x);       // 6 (block scope)
+}
+console.log(x);           // 5
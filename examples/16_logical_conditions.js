@@ -0,0 +1,53 @@
+// Test 16: Logical Conditions
+// Purpose: Test &&, || and ! directly in if/while/for conditions
+// Note: Mini-JS evaluates both operands of && and ||, so calls on the right still run
+// Expected: 3, 1, 2, 5, 9, 0, 7, 1
+
+function note(x) {
+    console.log(x);
+    return x;
+}
+
+function main() {
+    let a = 3;
+    let b = 0;
+
+    // while: both comparisons must hold
+    let n = 0;
+    while (n < 10 && n * n < a * 3) {
+        n = n + 1;
+    }
+    console.log(n);       // 3
+
+    // !(a > 3) || b == 0 = true
+    if (!(a > 3) || b == 0) {
+        console.log(1);   // 1
+    }
+
+    // for: loop while i < 2 or i == a (stops at 2)
+    let i = 0;
+    for (i = 0; i < 2 || i == a; i = i + 1) {
+    }
+    console.log(i);       // 2
+
+    // left side already false, right side still called
+    if (b && note(5)) {
+        console.log(0);
+    } else {
+        console.log(9);   // 5, 9
+    }
+
+    // left side already true, right side still called
+    if (a || note(0)) {
+        console.log(7);   // 0, 7
+    }
+
+    // nested: (a > 1 && b == 0) && !(a == b)
+    if ((a > 1 && b == 0) && !(a == b)) {
+        console.log(1);   // 1
+    }
+
+    return 0;
+}
+
+main();
@@ -0,0 +1,47 @@
+// Test 17: Function Lookup
+// Purpose: Test call sites bound to functions registered at different times
+// Note: top-level function items are registered in order; a later item with
+//       the same name does not replace the first definition
+// Expected: 42, error + 0, 101, 20, 4950
+
+function twice(x) {
+    return x * 2;
+}
+
+function callLater(n) {
+    return later(n);
+}
+
+console.log(twice(21));       // 42
+
+// later is not registered yet
+console.log(callLater(1));    // Error: undefined function 'later', 0
+
+function later(x) {
+    return x + 100;
+}
+
+// same call site inside callLater, now bound
+console.log(callLater(1));    // 101
+
+function twice(x) {
+    return x * 3;
+}
+
+// the first definition of twice is still used
+let sum = 0;
+for (let i = 0; i < 5; i = i + 1) {
+    sum = sum + twice(i);
+}
+console.log(sum);             // 20
+
+// many calls through one call site
+function add(a, b) {
+    return a + b;
+}
+
+let total = 0;
+for (let k = 0; k < 100; k = k + 1) {
+    total = add(total, k);
+}
+console.log(total);           // 4950
@@ -0,0 +1,79 @@
+// Test 18: Memoization
+// Purpose: Test which functions --memoize may cache (same output with and without it)
+// Note: only functions without console.log, without outer variables and calling
+//       only such functions are cached; a call that prints an error is not cached
+// Expected: 75025, 285, 285, 30, 34, 1, 2, 11, 21, 3, 7, 3, 7, error + 0, error + 0
+
+function fib(n) {
+    if (n < 2) {
+        return n;
+    }
+    return fib(n - 1) + fib(n - 2);
+}
+
+console.log(fib(25));         // 75025
+
+// pure functions calling pure functions
+function sq(n) {
+    return n * n;
+}
+
+function sumSquares(n) {
+    let s = 0;
+    for (let i = 0; i < n; i = i + 1) {
+        s = s + sq(i);
+    }
+    return s;
+}
+
+console.log(sumSquares(10));  // 285
+console.log(sumSquares(10));  // 285
+
+// extra arguments are ignored
+function pair(a, b) {
+    return a * 10 + b;
+}
+
+console.log(pair(3, 0));      // 30
+console.log(pair(3, 4, 5));   // 34
+
+// writes a global: not pure
+let counter = 0;
+function bump(n) {
+    counter = counter + n;
+    return counter;
+}
+
+console.log(bump(1));         // 1
+console.log(bump(1));         // 2
+
+// reads a global that changes: not pure
+let base = 10;
+function addBase(n) {
+    return n + base;
+}
+
+console.log(addBase(1));      // 11
+base = 20;
+console.log(addBase(1));      // 21
+
+// calls a function with console.log: not pure
+function loud(n) {
+    console.log(n);
+    return n * 2;
+}
+
+function quiet(n) {
+    return loud(n) + 1;
+}
+
+console.log(quiet(3));        // 3, 7
+console.log(quiet(3));        // 3, 7
+
+// pure, but division by zero prints an error on every call
+function inverse(n) {
+    return 100 / n;
+}
+
+console.log(inverse(0));      // Error: division by zero, 0
+console.log(inverse(0));      // Error: division by zero, 0
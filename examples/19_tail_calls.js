@@ -0,0 +1,108 @@
+// Test 19: Tail Calls
+// Purpose: Test self-recursive tail calls (return f(...)) running in constant stack space
+// Note: a tail call rebinds the parameters and restarts the body, so recursion
+//       a million levels deep must not overflow the stack in any engine
+// Expected: 500000500000, 6, 1, 21, 100, 15, 120, 1, 0, 15, 3
+
+function sumTo(n, acc) {
+    if (n == 0) {
+        return acc;
+    }
+    return sumTo(n - 1, acc + n);
+}
+
+console.log(sumTo(1000000, 0));   // 500000500000
+
+function gcd(a, b) {
+    if (b == 0) {
+        return a;
+    }
+    return gcd(b, a % b);
+}
+
+console.log(gcd(48, 18));         // 6
+console.log(gcd(17, 5));          // 1
+
+// tail calls from both branches, with a local variable in the frame
+function countSteps(n, steps) {
+    let half = n / 2;
+    if (n <= 1) {
+        return steps;
+    }
+    if (n % 2 == 0) {
+        return countSteps(half, steps + 1);
+    } else {
+        return countSteps(3 * n + 1, steps + 1);
+    }
+}
+
+console.log(countSteps(9, 2));    // 21
+
+// extra arguments are evaluated and dropped
+function last(n, extra) {
+    if (n == 0) {
+        return extra;
+    }
+    return last(n - 1, 100, n * 1000);
+}
+
+console.log(last(5, 0));          // 100
+
+// an argument that itself makes tail calls
+function add(n, acc) {
+    if (n == 0) {
+        return acc;
+    }
+    return add(n - 1, acc + 1);
+}
+
+function nested(n, acc) {
+    if (n == 0) {
+        return acc;
+    }
+    return nested(n - 1, add(n, 0) + acc);
+}
+
+console.log(nested(5, 0));        // 15
+
+// non-tail recursion is unchanged
+function fact(n) {
+    if (n <= 1) {
+        return 1;
+    }
+    return n * fact(n - 1);
+}
+
+console.log(fact(5));             // 120
+
+// mutual recursion is an ordinary call
+function isEven(n) {
+    if (n == 0) {
+        return 1;
+    }
+    return isOdd(n - 1);
+}
+
+function isOdd(n) {
+    if (n == 0) {
+        return 0;
+    }
+    return isEven(n - 1);
+}
+
+console.log(isEven(10));          // 1
+console.log(isOdd(10));           // 0
+
+// a tail call inside a loop leaves the loop
+function firstMultiple(n, k) {
+    for (let i = n; i < n + k; i = i + 1) {
+        if (i % k == 0) {
+            return i;
+        }
+        return firstMultiple(n + 1, k);
+    }
+    return -1;
+}
+
+console.log(firstMultiple(11, 5));  // 15
+console.log(firstMultiple(3, 1));   // 3
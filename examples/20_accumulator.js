@@ -0,0 +1,102 @@
+// Test 20: Accumulator Rewrite
+// Purpose: Test linear recursion combined with + or * (rewritten to tail calls with an accumulator)
+// Note: --accum-report lists the rewritten functions; results and output order must not change
+// Expected: 120, 500000500000, 55, 3, 2, 1, 7, 12, 3628800, 12, 11, 10, 3, 10, 30
+
+function factorial(n) {
+    if (n <= 1) {
+        return 1;
+    }
+    return n * factorial(n - 1);
+}
+
+console.log(factorial(5));        // 120
+
+// call on the left, a million levels deep
+function sum(n) {
+    if (n == 0) {
+        return 0;
+    }
+    return sum(n - 1) + n;
+}
+
+console.log(sum(1000000));        // 500000500000
+
+function sumSquares(n) {
+    if (n == 0) {
+        return 0;
+    }
+    return sumSquares(n - 1) + n * n;
+}
+
+console.log(sumSquares(5));       // 55
+
+// the left operand prints before the recursive call, as before
+function noisy(n) {
+    console.log(n);
+    return n;
+}
+
+function sumNoisy(n) {
+    if (n == 0) {
+        return 1;
+    }
+    return noisy(n) + sumNoisy(n - 1);
+}
+
+console.log(sumNoisy(3));         // 3, 2, 1, then 7
+
+// several returns, plain tail calls and falling off the end
+function product(n, skip) {
+    if (n == 0) {
+        return 1;
+    }
+    if (n == skip) {
+        return product(n - 1, skip);
+    }
+    if (n < 100) {
+        return n * product(n - 1, skip);
+    }
+}
+
+console.log(product(4, 2));       // 12 (4 * 3 * 1)
+console.log(product(10, 0));      // 3628800
+
+// extra arguments are still evaluated and dropped
+function count(n) {
+    if (n == 0) {
+        return 0;
+    }
+    return 1 + count(n - 1, noisy(n + 9));
+}
+
+// prints 12, 11, 10, then the result
+console.log(count(3));            // 3
+
+// not rewritten: the operand after the call reads a global
+let base = 10;
+function addBase(n) {
+    if (n == 0) {
+        return 0;
+    }
+    return addBase(n - 1) + base;
+}
+
+console.log(addBase(1));          // 10
+
+// not rewritten: subtraction and two self calls
+function alternate(n) {
+    if (n == 0) {
+        return 0;
+    }
+    return n - alternate(n - 1);
+}
+
+function pairs(n) {
+    if (n <= 1) {
+        return 1;
+    }
+    return pairs(n - 1) + pairs(n - 2);
+}
+
+console.log(alternate(7) + pairs(7) + 5);     // 4 + 21 + 5 = 30
@@ -0,0 +1,67 @@
+// Test 21: Constant Folding
+// Purpose: Test constant folding/propagation (results and error messages must not change)
+// Note: constant subtrees are computed before running; division by zero and values
+//       outside the int range are left for run time
+// Expected: 41, 4, 60, 7, error + 0, error + 0, 2147483648, -2147483648, 1, 0, 1, 5, 1, yes,
+//           error + 0, 7, 100, 3
+
+let x = 6;
+console.log(2 * 3 + x * (10 - 4) - 1);   // 41
+console.log((x + 0) * 1 - 0 - 2);        // 4
+
+// const and never-reassigned locals
+function area(w) {
+    const h = 10;
+    let scale = 2 - 1;
+    return w * h * scale;
+}
+
+console.log(area(6));                    // 60
+
+function counter() {
+    const start = 5;
+    let n = start;
+    n = n + 2;
+    return n;
+}
+
+console.log(counter());                  // 7
+
+// division and modulo by a constant zero still report the error
+console.log(10 / (5 - 5));               // error + 0
+console.log(10 % (2 * 0));               // error + 0
+
+// results outside the int range are computed at run time
+console.log(2147483647 + 1);             // 2147483648
+console.log(-2147483647 - 1);            // -2147483648
+
+// !!x is 0 or 1, except where only truth matters
+let five = 5;
+console.log(!!(x < 10));                 // 1
+console.log(!!0);                        // 0
+console.log(!!five);                     // 1
+console.log(five * !!1);                 // 5
+console.log(!!five && !!x);              // 1
+if (!!five) {
+    console.log("yes");
+}
+
+// a global is only replaced after its declaration has run
+function limit() {
+    return LIMIT;
+}
+
+console.log(limit());                    // error + 0
+const LIMIT = 7;
+console.log(limit());                    // 7
+
+const SIZE = 10;
+let total = 0;
+for (let i = 0; i < SIZE; i = i + 1) {
+    total = total + SIZE;
+}
+console.log(total);                      // 100
+
+let changed = 1;
+changed = changed + 2;
+console.log(changed);                    // 3
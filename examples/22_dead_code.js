@@ -0,0 +1,98 @@
+// Test 22: Dead Code Elimination
+// Purpose: Test removal of unreachable statements and never-called functions
+// Note: removed code never runs, so output and error messages must not change
+//       (./minijs -e --opt-report shows what was removed)
+// Expected: 10, 1, -1, 1, 2, 3, 200, 7, 12, first, 5
+
+function early(n) {
+    return n * 2;
+    console.log("never printed");
+    n = n + 1;
+}
+
+function sign(n) {
+    if (n > 0) {
+        return 1;
+    } else {
+        return 0 - 1;
+    }
+    console.log("unreachable after if/else");
+}
+
+// only called from code that is removed, so it is removed too
+function onlyFromDeadCode() {
+    console.log("dead");
+    return 0;
+}
+
+// never called: the call to an undefined function is never reported
+function unused(x) {
+    return x + missing(x);
+}
+
+function countTo(limit) {
+    let i = 0;
+    while (1) {
+        i = i + 1;
+        console.log(i);
+        if (i >= limit) {
+            return i;
+            console.log("after return in a loop");
+        }
+    }
+    onlyFromDeadCode();
+}
+
+function scale(n) {
+    if (1) {
+        n = n * 2;
+    } else {
+        onlyFromDeadCode();
+    }
+    if (0) {
+        return onlyFromDeadCode();
+    }
+    while (0) {
+        console.log("loop body never runs");
+    }
+    return n;
+}
+
+function pick() {
+    return 1;
+}
+
+// redefinition: the first definition wins, the second is removed
+function pick() {
+    return 2;
+}
+
+function blockReturn(n) {
+    {
+        n = n + 2;
+        return n;
+    }
+    console.log("after a returning block");
+}
+
+console.log(early(5));                   // 10
+console.log(sign(7));                    // 1
+console.log(sign(0 - 7));                // -1
+countTo(3);                              // 1, 2, 3
+console.log(scale(100));                 // 200
+console.log(pick() + 6);                 // 7
+console.log(blockReturn(10));            // 12
+
+if (0) {
+    console.log("skipped");
+} else {
+    console.log("first");
+}
+
+let total = 5;
+if (total > 1) {
+    console.log(total);                  // 5
+    return;
+}
+console.log("after the program returned");
+onlyFromDeadCode();
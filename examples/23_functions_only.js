@@ -0,0 +1,13 @@
+// Test 23: Functions Only
+// Purpose: Test a program made only of function definitions
+// Note: no top-level statement calls them, so DCE removes every function,
+//       but the program is still valid (exit 0, nothing printed)
+// Expected: (no output)
+
+function add(a, b) {
+    return a + b;
+}
+
+function main() {
+    return add(1, 2);
+}
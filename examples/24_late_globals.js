@@ -0,0 +1,22 @@
+// Test 24: Late Globals
+// Purpose: Test functions that use a global declared later at top level
+// Note: a read before the declaration prints the undefined-variable error
+//       and yields 0; after the declaration reads and writes reach the global
+// Expected: Error: undefined variable 'limit', 0, 3, 10, 11, 11
+
+function getLimit() {
+    return limit;
+}
+
+function raise() {
+    limit = limit + 1;
+    return limit;
+}
+
+console.log(getLimit());
+let limit = 3;
+console.log(getLimit());
+limit = 10;
+console.log(getLimit());
+console.log(raise());
+console.log(limit);
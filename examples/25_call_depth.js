@@ -0,0 +1,24 @@
+// Test 25: Call Depth Limit
+// Purpose: Test that recursion deeper than the call depth limit stops with an error
+// Note: the call past 5000 active calls prints the error and yields 0;
+//       tail self-calls reuse the frame and do not count toward the limit
+// Expected: 4000, Error: maximum call depth exceeded, 5000, 100000
+
+function depth(n) {
+    if (n == 0) {
+        return 0;
+    }
+    let d = depth(n - 1);
+    return d + 1;
+}
+
+function count(n, acc) {
+    if (n == 0) {
+        return acc;
+    }
+    return count(n - 1, acc + 1);
+}
+
+console.log(depth(4000));
+console.log(depth(100000));
+console.log(count(100000, 0));
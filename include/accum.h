@@ -0,0 +1,34 @@
+#ifndef ACCUM_H
+#define ACCUM_H
+
+#include <stdio.h>
+#include "ast.h"
+
+/* 누산기 도입 (선형 재귀 → 꼬리 재귀)
+ * return n * f(n - 1)처럼 자기 호출 결과를 결합 법칙이 성립하는 연산(+, *)으로
+ * 한 번만 결합하는 함수 f를 누산기를 받는 도우미 f.acc로 바꿈
+ *
+ *   function f(n) { if (n <= 1) { return 1; } return n * f(n - 1); }
+ * →
+ *   function f(n) { return f.acc(1, n); }
+ *   function f.acc(.acc, n) { if (n <= 1) { return .acc * 1; } return f.acc(.acc * n, n - 1); ... }
+ *
+ * 도우미의 재귀 호출은 꼬리 호출이므로 resolve.c가 표시하면 모든 실행기에서 반복이 됨
+ * 바꾸는 조건:
+ * - 함수 이름의 첫 정의, 매개변수 ACCUM_MAX_PARAMS개 이하
+ * - 자기 호출은 return문에만: f(...), e OP f(...), f(...) OP e (OP는 함수 안에서 하나)
+ * - 자기 호출의 인자 수 >= 매개변수 수, 인자와 e 안에는 자기 호출 없음
+ * - 다른 호출 지점도 인자 수 >= 매개변수 수 (빠진 매개변수는 호출자 스코프에서 조회되므로)
+ * - f(...) OP e: e를 호출 전에 계산하게 되므로 e는 상수/매개변수/부작용 없는 연산만,
+ *   자기 호출의 인자에도 함수 호출이 없어야 함 (호출이 매개변수를 바꿀 수 없도록)
+ */
+
+/* 누산기를 더해도 매개변수가 모두 레지스터로 전달되도록 (LIR_MAX_REG_PARAMS - 1) */
+#define ACCUM_MAX_PARAMS 5
+
+/* 파싱 직후 프로그램 변환 (실행기/코드 생성기보다 먼저)
+ * - report: 바꾼 함수와 바꾸지 못한 자기 재귀 함수 목록 출력 (NULL이면 없음)
+ * - 반환: 바꾼 함수 수 */
+int accum_rewrite(Program *prog, FILE *report);
+
+#endif /* ACCUM_H */
@@ -0,0 +1,36 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/* 범프 포인터 아레나
+ * 청크 안에서 포인터만 증가시키며 할당하고, 해제는 arena_free 한 번으로 처리
+ * (개별 해제 없음)
+ */
+
+typedef struct ArenaChunk ArenaChunk;
+
+typedef struct {
+    ArenaChunk *head;       /* 현재 할당 중인 청크 (이전 청크는 연결 리스트) */
+    size_t next_size;       /* 다음 청크 크기 */
+    size_t bytes_used;      /* 할당된 바이트 (정렬 패딩 포함) */
+    size_t bytes_reserved;  /* 청크로 확보한 바이트 */
+    int nchunks;
+} Arena;
+
+/* 아레나 초기화 (첫 청크는 첫 할당 시 확보) */
+void arena_init(Arena *a);
+
+/* 0으로 초기화된 메모리 할당 (메모리 부족 시 종료) */
+void *arena_alloc(Arena *a, size_t size);
+
+/* 문자열 복제 (s가 NULL이면 NULL) */
+char *arena_strdup(Arena *a, const char *s);
+
+/* s[0..len)을 NUL로 끝나는 문자열로 복제 (정렬 없이) */
+char *arena_strndup(Arena *a, const char *s, size_t len);
+
+/* 모든 청크 해제 후 빈 아레나로 되돌림 */
+void arena_free(Arena *a);
+
+#endif /* ARENA_H */
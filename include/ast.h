@@ -1,6 +1,10 @@
 #ifndef AST_H
 #define AST_H
 
+#include <stddef.h>
+#include "arena.h"
+#include "intern.h"
+
 /* Mini-JS AST 정의
  * 12wk (함수 호출) + 11wk (제어문 if/while/for) + console.log 통합
  */
@@ -49,12 +53,40 @@ typedef enum {
     UNARY_NOT       /* ! (논리 부정) */
 } UnaryOpKind;
 
+/* 변수 참조 해석 결과 (resolve.c가 채움) */
+typedef enum {
+    VAR_UNRESOLVED = 0, /* 심볼 테이블로 조회 (해석 실패 시) */
+    VAR_LOCAL,          /* 현재 함수(또는 top-level) 프레임의 슬롯 */
+    VAR_GLOBAL,         /* 전역 프레임의 슬롯 */
+    VAR_UNDEFINED       /* 어디에도 선언되지 않은 이름 */
+} VarRefKind;
+
+typedef struct {
+    VarRefKind kind;
+    int slot;
+} VarRef;
+
+/* 문자열 리터럴: 소스 버퍼 안의 구간 (따옴표 제외, NUL로 끝나지 않음)
+ * 이스케이프는 쓰인 그대로 (모든 실행기가 변환 없이 출력) */
+typedef struct {
+    unsigned offset;    /* Program.source.base부터 */
+    unsigned len;
+} StrView;
+
+/* 스캐너가 제자리에서 스캔한 입력 (끝에 NUL 두 개, scanner.h)
+ * 문자열 리터럴이 가리키므로 Program이 소유하고 free_program이 해제 */
+typedef struct {
+    char *base;
+    size_t len;         /* 소스 바이트 수 */
+    size_t mapped_len;  /* mmap한 길이 (0이면 malloc 버퍼) */
+} SourceBuffer;
+
 /* 표현식 노드 */
 struct Expr {
     ExprKind kind;
     union {
         int int_value;                  /* EXPR_INT */
-        char *string_value;             /* EXPR_STRING */
+        StrView string;                 /* EXPR_STRING */
         char *var_name;                 /* EXPR_VAR */
         struct {                        /* EXPR_BINOP */
             BinOpKind op;
@@ -64,12 +96,15 @@ struct Expr {
         struct {                        /* EXPR_CALL */
             char *func_name;
             ExprList *args;
+            int site;                   /* 호출 지점 번호 (0부터, 실행기의 바인딩 캐시 인덱스) */
+            int tail;                   /* return 바로 아래의 자기 호출 (resolve.c, 해석 성공 시만) */
         } call;
         struct {                        /* EXPR_UNARY */
             UnaryOpKind op;
             Expr *operand;
         } unary;
     } u;
+    VarRef ref;                         /* EXPR_VAR 슬롯 */
 };
 
 /* 표현식 리스트 (함수 인자용) */
@@ -121,6 +156,8 @@ struct Stmt {
         } for_stmt;
         StmtList *block;                /* STMT_BLOCK */
     } u;
+    VarRef ref;                         /* STMT_VARDECL, STMT_ASSIGN 슬롯 */
+    int needs_scope;                    /* STMT_BLOCK, STMT_FOR: 심볼 테이블 스코프 필요 */
     Stmt *next;                         /* 연결 리스트용 */
 };
 
@@ -147,6 +184,10 @@ struct Function {
     char *name;
     ParamList *params;
     StmtList *body;
+    int nslots;         /* 프레임 슬롯 수 (매개변수 포함, resolve.c) */
+    int index;          /* 프로그램 안의 정의 순서 (0부터, 추가 전이면 -1) */
+    int pure;           /* 순수 함수 (purity.c, --memoize) */
+    int tail_calls;     /* 꼬리 자기 호출 수 (resolve.c, 해석 성공 시만) */
     Function *next;
 };
 
@@ -172,56 +213,114 @@ struct Item {
     Item *next;
 };
 
-/* 프로그램 구조체 */
+/* 아레나 사용량 통계 분류 (--mem-stats) */
+typedef enum {
+    AST_MEM_EXPR,                                   /* + ExprKind */
+    AST_MEM_STMT = AST_MEM_EXPR + EXPR_UNARY + 1,   /* + StmtKind */
+    AST_MEM_EXPR_LIST = AST_MEM_STMT + STMT_BLOCK + 1,
+    AST_MEM_STMT_LIST,
+    AST_MEM_PARAM,
+    AST_MEM_PARAM_LIST,
+    AST_MEM_FUNCTION,
+    AST_MEM_FUNCTION_LIST,
+    AST_MEM_ITEM,
+    AST_MEM_STRING,
+    AST_MEM_KIND_COUNT
+} AstMemKind;
+
+/* 프로그램 구조체
+ * 모든 AST 노드와 이름 문자열은 Program의 아레나에서 할당되며
+ * free_program이 한 번에 해제
+ * 이름(변수, 함수, 매개변수)은 names에 인터닝되므로 같은 이름은 같은 포인터
+ * 문자열 리터럴은 복사하지 않고 source의 구간으로 둠 (AST_STRING_TEXT) */
 struct Program {
     Item *items;        /* Top-level 항목들 */
     Item *items_tail;   /* append용 */
+    int nfunctions;     /* 함수 정의 수 (Function.index 범위) */
+    int ncall_sites;    /* EXPR_CALL 수 (u.call.site 범위) */
+    int empty;          /* 1이면 파싱한 항목이 없음 (최적화 전 판정, DCE가 모두 지운 프로그램은 0) */
+    int optimized;      /* 1이면 누산기 도입/상수 접기/DCE를 적용함 (minijs_optimize) */
+
+    /* 슬롯 해석 결과 (resolve.c) */
+    int resolved;       /* 1이면 모든 변수 참조가 슬롯으로 해석됨 */
+    int main_slots;     /* top-level 블록 지역 변수 슬롯 수 */
+    int nglobals;
+    char **global_names;
+    const char *resolve_error;  /* 해석 실패 이유 (resolved = 0일 때) */
+
+    /* AST 메모리 */
+    Arena arena;
+    InternTable names;  /* 인터닝된 이름 (intern.h) */
+    SourceBuffer source;    /* 파싱한 소스 (문자열 리터럴이 가리킴) */
+    size_t mem_bytes[AST_MEM_KIND_COUNT];
+    int mem_nodes[AST_MEM_KIND_COUNT];
 };
 
-/* === 표현식 생성 함수 === */
-Expr *new_int_expr(int value);
-Expr *new_string_expr(const char *value);
-Expr *new_var_expr(const char *name);
-Expr *new_binop_expr(BinOpKind op, Expr *lhs, Expr *rhs);
-Expr *new_call_expr(const char *func_name, ExprList *args);
-Expr *new_unary_expr(UnaryOpKind op, Expr *operand);
+/* 이름 인터닝: s[0..len)과 같은 내용의 prog 이름 (처음이면 아레나에 복사)
+ * prog가 NULL이면 인터닝 없이 복사 (해제 안 됨, 포인터 비교 불가) */
+char *ast_intern(Program *prog, const char *s, size_t len);
+
+/* EXPR_STRING 식 e의 첫 바이트 (길이는 e->u.string.len) */
+#define AST_STRING_TEXT(prog, e) ((prog)->source.base + (e)->u.string.offset)
+
+/* === 표현식 생성 함수 ===
+ * 모든 노드는 prog의 아레나에 할당하고 이름은 ast_intern (prog가 NULL이면 calloc, 해제 안 됨) */
+Expr *new_int_expr(Program *prog, int value);
+Expr *new_string_expr(Program *prog, StrView value);
+Expr *new_var_expr(Program *prog, const char *name);
+Expr *new_binop_expr(Program *prog, BinOpKind op, Expr *lhs, Expr *rhs);
+Expr *new_call_expr(Program *prog, const char *func_name, ExprList *args);
+Expr *new_unary_expr(Program *prog, UnaryOpKind op, Expr *operand);
 
 /* 표현식 리스트 */
-ExprList *expr_list_append(ExprList *list, Expr *expr);
+ExprList *expr_list_append(Program *prog, ExprList *list, Expr *expr);
 
 /* === 문장 생성 함수 === */
-Stmt *new_expr_stmt(Expr *e);
-Stmt *new_return_stmt(Expr *e);
-Stmt *new_vardecl_stmt(const char *name, Expr *init);
-Stmt *new_assign_stmt(const char *name, Expr *value);
-Stmt *new_print_stmt(Expr *e);
-Stmt *new_if_stmt(Expr *cond, Stmt *then_stmt, Stmt *else_stmt);
-Stmt *new_while_stmt(Expr *cond, Stmt *body);
-Stmt *new_for_stmt(Stmt *init, Expr *cond, Stmt *step, Stmt *body);
-Stmt *new_block_stmt(StmtList *stmts);
+Stmt *new_expr_stmt(Program *prog, Expr *e);
+Stmt *new_return_stmt(Program *prog, Expr *e);
+Stmt *new_vardecl_stmt(Program *prog, const char *name, Expr *init);
+Stmt *new_assign_stmt(Program *prog, const char *name, Expr *value);
+Stmt *new_print_stmt(Program *prog, Expr *e);
+Stmt *new_if_stmt(Program *prog, Expr *cond, Stmt *then_stmt, Stmt *else_stmt);
+Stmt *new_while_stmt(Program *prog, Expr *cond, Stmt *body);
+Stmt *new_for_stmt(Program *prog, Stmt *init, Expr *cond, Stmt *step, Stmt *body);
+Stmt *new_block_stmt(Program *prog, StmtList *stmts);
 
 /* 문장 리스트 */
-StmtList *stmt_list_append(StmtList *list, Stmt *stmt);
+StmtList *stmt_list_append(Program *prog, StmtList *list, Stmt *stmt);
 
 /* === 함수 및 매개변수 === */
-ParamList *param_list_append(ParamList *list, const char *name);
-Function *new_function(const char *name, ParamList *params, StmtList *body);
-FunctionList *function_list_append(FunctionList *list, Function *func);
+ParamList *param_list_append(Program *prog, ParamList *list, const char *name);
+Function *new_function(Program *prog, const char *name, ParamList *params, StmtList *body);
+FunctionList *function_list_append(Program *prog, FunctionList *list, Function *func);
+
+/* 호출 대상 표: 이름 → 첫 정의 (같은 이름을 다시 정의해도 호출은 첫 정의로 감)
+ * 만든 뒤에 추가한 함수는 찾지 못함 */
+typedef struct {
+    Function **funcs;   /* 이름(인터닝된 포인터)순 정렬, 같은 이름은 첫 정의만 */
+    int count;
+} FuncTable;
+
+void func_table_build(FuncTable *t, Program *prog);
+/* 반환: name의 첫 정의, 없으면 NULL (name은 prog에 인터닝된 포인터) */
+Function *func_table_find(const FuncTable *t, const char *name);
+void func_table_free(FuncTable *t);
 
 /* === 프로그램 생성/조작 === */
+
+/* 새 프로그램 생성 (빈 아레나) */
 Program *new_program(void);
 void program_add_function(Program *prog, Function *func);
 void program_add_stmt(Program *prog, Stmt *stmt);
+/* after 항목 바로 뒤에 함수 추가 (프로그램 변환용, Function.index는 새 번호) */
+void program_insert_function(Program *prog, Item *after, Function *func);
 
-/* 전역 프로그램 루트 */
-extern Program *g_program;
-
-/* 메모리 해제 */
-void free_expr(Expr *e);
-void free_stmt(Stmt *s);
-void free_function(Function *f);
+/* 메모리 해제 (아레나 전체를 한 번에 해제) */
 void free_program(Program *prog);
 
+/* 아레나 통계 분류 이름 */
+const char *ast_mem_kind_name(int kind);
+
 /* === AST 시각화 === */
 int ast_to_buffer(Program *prog, char *buffer, int bufsize);
 
@@ -2,17 +2,27 @@
 #define CODEGEN_X86_H
 
 #include "ast.h"
+#include "output.h"
 
-/* x86-64 어셈블리 코드 생성
- * - 파일로 출력
+/* x86-64 어셈블리 코드 생성 (GNU as, System V, libc printf/puts 사용)
+ * - opt_level 0: 스택 기계 방식 (연산마다 push/pop, 변수는 매번 스택에서 읽음)
+ * - opt_level 1 이상: LIR + 선형 스캔 레지스터 할당
+ * - 출력은 gcc로 바로 링크 가능 (gcc out.s -o prog)
  */
-void gen_x86_program(Program *prog);
+#define X86_OPT_DEFAULT 0
+
+/* 파일/버퍼 출력
+ * - out: 출력 대상
+ * - error: 실패 이유 (NULL 가능)
+ * - 반환: 성공 시 0, 슬롯 해석이 불가능한 프로그램이면 -1
+ */
+int gen_x86_program(Program *prog, Output *out, int opt_level, const char **error);
 
 /* 문자열 버퍼로 출력 (Wasm용)
  * - buffer: 출력 버퍼
  * - bufsize: 버퍼 크기
- * - 반환: 작성된 바이트 수
+ * - 반환: 작성된 바이트 수, 실패 시 -1
  */
-int gen_x86_to_buffer(Program *prog, char *buffer, int bufsize);
+int gen_x86_to_buffer(Program *prog, char *buffer, int bufsize, int opt_level, const char **error);
 
 #endif /* CODEGEN_X86_H */
@@ -0,0 +1,93 @@
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include <stdio.h>
+#include "ast.h"
+#include "output.h"
+#include "stats.h"
+
+/* Mini-JS 컨텍스트
+ * 스캐너, 파싱된 프로그램, 출력 대상을 한 객체로 묶음
+ * 파서/인터프리터/VM/코드 생성기에 전역 상태가 없으므로
+ * 스레드마다 컨텍스트를 하나씩 만들면 여러 스크립트를 동시에 처리할 수 있음
+ * (컨텍스트 하나를 여러 스레드가 동시에 쓰면 안 됨)
+ */
+typedef struct MiniJSContext {
+    void *scanner;      /* 재진입 flex 스캐너 (yyscan_t) */
+    Program *program;   /* 마지막으로 파싱한 프로그램, 없으면 NULL */
+    Output out;         /* 실행/코드 생성 출력 (기본 stdout) */
+    int opt_level;      /* x86-64 코드 생성 최적화 수준 (-O, 기본 X86_OPT_DEFAULT) */
+    long tier_threshold;    /* 계층 실행 승격 임계값 (--tier-threshold) */
+    FILE *tier_stats;   /* 계층 실행 보고서 출력 (--tier-stats), NULL이면 없음 */
+    int memoize;        /* 순수 함수 메모이제이션 (--memoize, 트리 인터프리터/--tier) */
+    FILE *memo_stats;   /* 메모 적중/실패 보고서 출력 (--memo-stats), NULL이면 없음 */
+    FILE *accum_report; /* 누산기 도입 보고서 출력 (--accum-report), NULL이면 없음 */
+    FILE *opt_report;   /* 상수 접기/죽은 코드 제거 보고서 출력 (--opt-report), NULL이면 없음 */
+    PhaseTimer *phases; /* 단계별 시간/최대 RSS 기록 (--time-phases), NULL이면 없음 */
+    ExecStats *stats;   /* 실행 카운터 (--stats, 트리 인터프리터/--tier), NULL이면 없음 */
+} MiniJSContext;
+
+/* 컨텍스트 생성/해제 (실패 시 NULL) */
+MiniJSContext *minijs_context_new(void);
+void minijs_context_free(MiniJSContext *ctx);
+
+/* 파싱: 이전 프로그램을 해제하고 결과를 ctx->program에 저장 (소스 그대로의 AST)
+ * ctx->phases가 있으면 "parse" 단계를 기록 (실행/코드 생성 함수도 각자 단계를 기록)
+ * - 반환: 성공 시 0, 파싱 오류 시 -1 (ctx->program = NULL)
+ *   항목이 하나도 없는 입력도 0 (ctx->program->empty = 1) */
+int minijs_parse_file(MiniJSContext *ctx, FILE *in);
+int minijs_parse_string(MiniJSContext *ctx, const char *source);
+
+/* 실행/코드 생성 전 최적화 (ctx->program을 제자리에서 바꿈, 두 번째 호출부터는 아무것도 안 함)
+ * 선형 재귀 함수는 누산기를 받는 꼬리 재귀로 바뀌고 (accum.h)
+ * 상수 부분식과 상수 변수는 접히며 (fold.h) 실행되지 않는 문장과 함수는 지워짐 (dce.h)
+ * minijs_eval/compile/emit_ir/precompile이 먼저 부르므로 소스 AST를 보여 줄 때만 신경 쓰면 됨
+ * ctx->phases가 있으면 "optimize" 단계를 기록 */
+void minijs_optimize(MiniJSContext *ctx);
+
+/* 현재 프로그램 해제 */
+void minijs_release_program(MiniJSContext *ctx);
+
+/* 출력 대상 설정 (이전 출력은 flush 후 해제)
+ * - file: 실행/코드 생성이 끝날 때마다 flush
+ * - buffer: 고정 크기, 넘치면 잘림
+ * - grow: 필요한 만큼 늘어나는 버퍼 (결과는 ctx->out.buffer, 길이 ctx->out.pos) */
+void minijs_set_output_file(MiniJSContext *ctx, FILE *file);
+void minijs_set_output_buffer(MiniJSContext *ctx, char *buffer, int bufsize);
+void minijs_set_output_grow(MiniJSContext *ctx);
+
+/* 실행 엔진 */
+typedef enum {
+    MINIJS_ENGINE_TREE,     /* 트리 인터프리터 (eval.c) */
+    MINIJS_ENGINE_VM,       /* 바이트코드 VM (--vm) */
+    MINIJS_ENGINE_JIT,      /* x86-64 인프로세스 JIT (-j) */
+    MINIJS_ENGINE_TIER,     /* 트리 인터프리터 + 뜨거운 함수만 JIT (--tier) */
+    MINIJS_ENGINE_FLAT      /* 평평한 AST 인터프리터 (--flat) */
+} MiniJSEngine;
+
+/* 실행 (ctx->program)
+ * - engine: MiniJSEngine (VM/JIT/평평한 AST로 실행할 수 없으면 트리 인터프리터)
+ * - used_engine, engine_error: 요청한 엔진 사용 여부와 사용하지 못한 이유 (NULL 가능)
+ * - ctx->stats: 트리 인터프리터 카운터를 더함 (출력 바이트는 모든 엔진)
+ * - 반환: 실행 결과 (return문 값 또는 0) */
+int minijs_eval(MiniJSContext *ctx, int engine, int *used_engine, const char **engine_error);
+
+/* x86-64 어셈블리 생성 (ctx->program → ctx 출력, ctx->opt_level 사용)
+ * - error: 실패 이유 (NULL 가능)
+ * - 반환: 성공 시 0, 네이티브로 컴파일할 수 없는 프로그램이면 -1 */
+int minijs_compile(MiniJSContext *ctx, const char **error);
+
+/* SSA IR 텍스트 출력 (ctx->program → ctx 출력, --emit-ir)
+ * - 반환: 성공 시 0, 슬롯 해석에 실패하면 -1 (error: 이유) */
+int minijs_emit_ir(MiniJSContext *ctx, const char **error);
+
+/* 미리 컴파일 (ctx->program → .mjsc 파일, --precompile, precompile.h)
+ * - 반환: 쓴 바이트 수, 슬롯 해석에 실패하거나 쓰지 못하면 -1 (error: 이유) */
+long minijs_precompile(MiniJSContext *ctx, FILE *out, const char **error);
+
+/* .mjsc 실행: 파싱 없이 mmap한 평평한 AST를 실행 (ctx->program은 쓰지 않음)
+ * - result: 실행 결과 (return문 값 또는 0)
+ * - 반환: 성공 시 0, 파일을 읽을 수 없으면 -1 (error: 이유) */
+int minijs_eval_precompiled(MiniJSContext *ctx, const char *path, int *result, const char **error);
+
+#endif /* CONTEXT_H */
@@ -0,0 +1,32 @@
+#ifndef DCE_H
+#define DCE_H
+
+#include <stdio.h>
+#include "ast.h"
+
+/* 죽은 코드 / 호출되지 않는 함수 제거 (AST 최적화, fold.h 다음에 실행)
+ * - 다음 문장으로 넘어가지 않는 문장(return, 양쪽 분기가 모두 return하는 if, 그런 문장을 가진 블록,
+ *   break가 없으므로 조건이 0이 아닌 상수인 while) 뒤의 문장
+ *   (top-level에서는 뒤의 문장 항목, 함수 정의는 아래 호출 그래프가 결정)
+ * - 조건이 상수인 if는 실행되는 분기로, 조건이 0인 while은 제거
+ * - top-level 문장에서 호출 그래프로 닿지 않는 함수와 같은 이름의 두 번째 이후 정의
+ * 지운 문장은 실행되지 않으므로 출력과 에러 메시지는 그대로
+ */
+
+/* 제거 통계 */
+typedef struct {
+    int functions;      /* 지운 함수 정의 */
+    int statements;     /* 지운 문장 (안에 든 문장 포함) */
+} DceStats;
+
+/* 다음 문장으로 넘어가지 않는 문장
+ * (return, 양쪽 분기가 모두 그런 if, 그런 문장을 가진 블록, break가 없으므로 while (상수 != 0)) */
+int dce_always_returns(Stmt *s);
+
+/* 프로그램 변환
+ * - report: 지운 함수와 문장을 한 줄씩 출력 (NULL이면 없음)
+ * - stats: NULL 가능
+ * - 반환: 지운 함수 + 문장 수 */
+int dce_program(Program *prog, DceStats *stats, FILE *report);
+
+#endif /* DCE_H */
@@ -1,28 +1,62 @@
 #ifndef EVAL_H
 #define EVAL_H
 
+#include <stdint.h>
 #include "ast.h"
+#include "output.h"
+#include "stats.h"
 
 /* Mini-JS 인터프리터
  * AST를 직접 실행하여 결과를 반환
+ * 실행 상태(함수 테이블, 심볼 테이블, 슬롯 프레임)는 호출마다 새로 만들어지므로
+ * 서로 다른 Program을 여러 스레드에서 동시에 실행할 수 있음
  */
 
 /* 프로그램 실행 (top-level 항목 순차 실행)
  * - prog: 프로그램 (함수 + 문장들)
+ * - out: console.log/에러 메시지 출력 대상
  * - 반환: 실행 결과 (return문 값 또는 0)
  */
-int eval_program(Program *prog);
+int eval_program(Program *prog, Output *out);
 
-/* 출력 버퍼 설정 (Wasm용)
- * - buffer: 출력 버퍼
- * - bufsize: 버퍼 크기
- */
-void eval_set_output_buffer(char *buffer, int bufsize);
+/* 실행 옵션 */
+#define EVAL_TIER_DEFAULT_THRESHOLD 1000
+#define EVAL_MEMO_MAX_ENTRIES 65536     /* 함수별 메모 캐시 최대 항목 수 */
+
+/* 최대 호출 깊이 (꼬리 자기 호출은 세지 않음)
+ * 넘는 호출은 "maximum call depth exceeded" 에러 후 0 (C 스택 넘침 대신)
+ * 트리/flat 인터프리터, VM, JIT이 같은 한계를 써서 출력이 같음 */
+#define EVAL_MAX_CALL_DEPTH 5000
+#define EVAL_STACK_BUDGET_DEFAULT (512 * 1024)
+
+/* C 스택 하한 주소: 호출 지점에서 이만큼 아래까지 C 스택을 씀
+ * 트리/flat 인터프리터는 호출 한 번에 쓰는 C 스택이 문장/식의 중첩에 따라 달라지므로
+ * 호출 깊이와 함께 이 주소도 검사 (같은 에러)
+ * 예산: RLIMIT_STACK의 3/4, 제한이 없거나 알 수 없으면 EVAL_STACK_BUDGET_DEFAULT */
+uintptr_t eval_stack_limit(void);
 
-/* 출력 버퍼 리셋 */
-void eval_reset_output_buffer(void);
+typedef struct {
+    /* 계층 실행 (--tier) */
+    int tier;
+    long tier_threshold;    /* 함수의 호출 + 루프 반복 수가 이 값에 이르면 JIT로 승격 */
+    FILE *tier_stats;       /* 실행 후 함수별 승격 보고서 (NULL이면 출력 안 함) */
 
-/* 출력 버퍼 내용 가져오기 */
-const char *eval_get_output(void);
+    /* 순수 함수 메모이제이션 (--memoize) */
+    int memoize;
+    FILE *memo_stats;       /* 실행 후 함수별 적중/실패 수 (NULL이면 출력 안 함) */
+
+    /* 실행 카운터 (--stats, NULL이면 세지 않음): 실행하며 더함 */
+    ExecStats *stats;
+} EvalOptions;
+
+/* 옵션을 지정한 실행: eval_program과 같은 결과
+ * - tier: 뜨거운 함수는 jit_compile_function으로 승격
+ *   (승격할 수 없는 함수와 top-level 코드는 인터프리터로 실행)
+ * - memoize: 순수 함수(purity.h)의 결과를 인자 튜플별로 캐시
+ *   (호출 중 에러 메시지가 출력된 결과는 캐시하지 않음)
+ * - stats: 종류별 노드 평가, 심볼 테이블 조회, 스코프, 호출 수와 최대 호출 깊이
+ *   (메모 적중은 호출로 세지 않음, 출력 바이트는 호출자가 Output.bytes로 셈)
+ */
+int eval_program_with_options(Program *prog, Output *out, const EvalOptions *opts);
 
 #endif /* EVAL_H */
@@ -0,0 +1,123 @@
+#ifndef FLAT_H
+#define FLAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ast.h"
+#include "output.h"
+
+/* 평평한 AST (데이터 지향 배치)
+ * 식과 문장을 각각 한 배열의 고정 크기 레코드(12/20바이트)로 두고 자식은 32비트 인덱스로 가리킴
+ * 블록/함수 본문의 문장과 호출 인자는 list 배열의 연속 구간
+ * 노드는 실행 순서(전위 순회)로 번호가 매겨지므로 순회가 배열을 앞에서부터 읽음
+ * 이름은 복사하지 않고 Program 아레나의 문자열을, 문자열 리터럴은 Program 소스 버퍼를 가리킴
+ * (Program보다 먼저 해제)
+ */
+
+typedef int32_t FlatId;     /* 노드 인덱스 */
+#define FLAT_NONE (-1)      /* 없는 자식 (else 없는 if, 초기값 없는 let 등) */
+
+/* 식 (ExprKind별 필드)
+ *   EXPR_INT     a = 값
+ *   EXPR_STRING  a = text 오프셋, b = 길이
+ *   EXPR_VAR     op = VarRefKind, a = 슬롯, b = names 인덱스
+ *   EXPR_BINOP   op = BinOpKind, a = lhs, b = rhs
+ *   EXPR_UNARY   op = UnaryOpKind, a = 피연산자
+ *   EXPR_CALL    op = 꼬리 자기 호출, a = calls 인덱스 */
+typedef struct {
+    uint8_t kind;
+    uint8_t op;
+    int32_t a;
+    int32_t b;
+} FlatExpr;
+
+/* 문장 (StmtKind별 필드, 없는 자식은 FLAT_NONE)
+ *   STMT_EXPR/RETURN/PRINT  a = 식
+ *   STMT_VARDECL/ASSIGN     op = VarRefKind, a = 값, b = 슬롯, c = names 인덱스
+ *   STMT_IF                 a = 조건, b = then, c = else
+ *   STMT_WHILE              a = 조건, b = 본문
+ *   STMT_FOR                op = needs_scope, a = 초기화, b = 조건(식), c = 스텝, d = 본문
+ *   STMT_BLOCK              op = needs_scope, a = list 시작, b = 문장 수 */
+typedef struct {
+    uint8_t kind;
+    uint8_t op;
+    int32_t a;
+    int32_t b;
+    int32_t c;
+    int32_t d;
+} FlatStmt;
+
+/* 호출 (EXPR_CALL의 a) */
+typedef struct {
+    int32_t name;           /* names 인덱스 */
+    int32_t func;           /* 같은 이름의 첫 정의 Function.index, 없으면 -1 */
+    int32_t first;          /* 인자: list[first .. first + count) */
+    int32_t count;
+} FlatCall;
+
+/* 함수 (Function.index로 인덱싱, DCE로 지워진 번호는 func = NULL) */
+typedef struct {
+    Function *func;
+    int32_t nparams;
+    int32_t nslots;
+    int32_t first;          /* 본문: list[first .. first + count) */
+    int32_t count;
+} FlatFunc;
+
+/* top-level 항목 (ITEM_FUNCTION이면 funcs 인덱스, ITEM_STMT이면 문장) */
+typedef struct {
+    uint8_t kind;
+    int32_t index;
+} FlatItem;
+
+typedef struct {
+    FlatExpr *exprs;
+    int nexprs;
+
+    FlatCall *calls;
+    int ncalls;
+
+    FlatStmt *stmts;
+    int nstmts;
+
+    int32_t *list;          /* 문장/인자 구간 */
+    int nlist;
+
+    const char **names;     /* 변수/함수 이름 */
+    int nnames;
+
+    const char *text;       /* 문자열 리터럴 바이트 (Program.source.base, NUL로 끝나지 않음) */
+
+    FlatFunc *funcs;
+    int nfuncs;             /* Program.nfunctions */
+    FlatItem *items;
+    int nitems;
+
+    int resolved;           /* 만들 때 Program.resolved */
+    int main_slots;
+    int nglobals;
+    char **global_names;
+} FlatProgram;
+
+/* Program → 평평한 AST (슬롯과 꼬리 호출 표시는 resolve_program 결과를 복사하므로 그 뒤에 호출)
+ * - 반환: 새 FlatProgram (flat_free로 해제) */
+FlatProgram *flat_build(Program *prog);
+void flat_free(FlatProgram *fp);
+
+/* 노드 수 (식 + 문장)와 배열이 차지하는 바이트 (이름 문자열 제외) */
+int flat_node_count(const FlatProgram *fp);
+size_t flat_bytes(const FlatProgram *fp);
+
+/* ir_expr_has_effects와 같은 판정 (0으로 나누기 가능, 정의 전 전역 읽기, 호출) */
+int flat_expr_has_effects(const FlatProgram *fp, FlatId e);
+
+/* 평평한 AST 인터프리터 (--flat)
+ * 슬롯으로 해석된 프로그램만 실행하며 출력과 반환값은 eval_program과 같음 */
+int flat_run(FlatProgram *fp, Output *out);
+
+/* resolve_program + flat_build + flat_run, 해석에 실패하면 eval_program으로 실행
+ * - used_flat: 평평한 AST로 실행했으면 1 (NULL 가능)
+ * - error: 사용하지 못한 이유 (NULL 가능) */
+int flat_eval_program(Program *prog, Output *out, int *used_flat, const char **error);
+
+#endif /* FLAT_H */
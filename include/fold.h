@@ -0,0 +1,29 @@
+#ifndef FOLD_H
+#define FOLD_H
+
+#include "ast.h"
+
+/* 상수 접기 / 상수 전파 (AST 최적화)
+ * 파싱 직후 실행되어 트리 인터프리터, VM, JIT, 네이티브 코드 생성기가 같은 결과를 사용
+ * - 상수 부분식 계산: 2 * 3 + x * (10 - 4) → 6 + x * 6
+ *   0으로 나누기/나머지는 실행 중 에러 메시지를 위해 남기고, int 범위를 넘는 결과도 남김
+ * - 항등원 제거: x + 0, 0 + x, x - 0, x * 1, 1 * x, x / 1 → x (x는 그대로 한 번 평가)
+ * - !!x → x (x가 이미 0/1이거나 조건식처럼 참/거짓만 쓰이는 곳)
+ * - 상수 전파 (resolve_program이 성공한 프로그램만)
+ *   - 슬롯에 선언이 하나뿐이고 대입이 없으며 초기값이 상수인 지역 변수 (const/let 구분 없음)
+ *   - 같은 조건의 전역 변수는 선언 이후의 top-level 문장에서만 (함수는 선언 전에 호출될 수 있음)
+ *   선언문은 남겨 둠 (동적 스코프로 읽는 쪽이 없도록 해석된 프로그램에만 적용)
+ */
+
+/* 변환 통계 */
+typedef struct {
+    int folded;         /* 상수로 계산한 연산 */
+    int simplified;     /* 항등원/이중 부정 제거 */
+    int propagated;     /* 상수로 바꾼 변수 읽기 */
+} FoldStats;
+
+/* 프로그램 변환 (stats는 NULL 가능)
+ * - 반환: 바뀐 노드 수 (folded + simplified + propagated) */
+int fold_program(Program *prog, FoldStats *stats);
+
+#endif /* FOLD_H */
@@ -0,0 +1,38 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+
+/* 이름 인터닝 (프로그램별, Program.names)
+ * 같은 내용의 식별자/문자열 리터럴은 아레나에 한 번만 저장하고 같은 포인터를 돌려줌
+ * 같은 Program의 이름끼리는 strcmp 대신 포인터로 비교하고, 해시도 포인터로 계산 (INTERN_HASH)
+ */
+
+typedef struct {
+    char *name;             /* 빈 칸은 NULL */
+    unsigned hash;          /* 내용 해시 (다시 만들 때 재계산하지 않음) */
+    unsigned len;
+} InternSlot;
+
+typedef struct {
+    InternSlot *slots;      /* 열린 주소법 */
+    int cap;                /* 2의 거듭제곱 */
+    int count;              /* 서로 다른 이름 수 */
+    size_t bytes;           /* 저장한 문자열 바이트 (NUL 포함) */
+} InternTable;
+
+/* 인터닝된 이름의 해시 (포인터를 섞은 값, 이름 길이와 무관)
+ * 이름은 아레나에 연달아 있으므로 하위 비트만 쓰는 테이블에서도 고르게 퍼지도록 섞음 */
+#define INTERN_HASH(name) intern_hash(name)
+
+unsigned intern_hash(const char *name);
+
+void intern_init(InternTable *t);
+void intern_free(InternTable *t);
+
+/* s[0..len)과 같은 내용의 이름 (없으면 아레나에 복사해 등록) */
+char *intern_name(InternTable *t, Arena *a, const char *s, size_t len);
+
+#endif /* INTERN_H */
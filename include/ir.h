@@ -0,0 +1,166 @@
+#ifndef IR_H
+#define IR_H
+
+#include "arena.h"
+#include "ast.h"
+#include "output.h"
+
+/* SSA 중간 표현 (IR)
+ * AST와 x86-64 백엔드 사이의 함수 단위 표현
+ * - 기본 블록마다 명령어 배열, 마지막 명령어는 종결 명령어 (jmp/br/chkfn/ret)
+ * - 지역 변수는 SSA 값으로 바뀌고 합류 지점에는 phi (블록 앞쪽)
+ * - 모든 값은 64비트 정수, 타입은 i64와 bool(0/1)로 구분
+ * - 전역 변수는 메모리 (loadg/storeg), 평가 순서와 에러 메시지는 eval_program과 동일
+ * SSA 구성은 Braun et al. "Simple and Efficient Construction of SSA Form"
+ * (AST를 한 번 순회하면서 블록을 봉인하고, 봉인 전에 읽은 변수는 불완전 phi로 처리)
+ */
+
+typedef enum {
+    IR_VOID,        /* 값 없음 (출력, 저장, 종결 명령어) */
+    IR_I64,
+    IR_BOOL         /* 0 또는 1 */
+} IrType;
+
+typedef enum {
+    IR_CONST,       /* imm */
+    IR_PARAM,       /* index번째 매개변수 */
+    IR_PHI,         /* args[i]: 블록의 preds[i]에서 들어올 때의 값 */
+    IR_ADD,         /* args[0] + args[1] */
+    IR_SUB,
+    IR_MUL,
+    IR_DIV,         /* 0으로 나누면 에러 출력 후 0 */
+    IR_MOD,
+    IR_CMP,         /* args[0] cc args[1] (cc: BIN_LT .. BIN_NE) */
+    IR_AND,         /* 논리 &&, ||: 양쪽 모두 이미 평가됨 */
+    IR_OR,
+    IR_NEG,
+    IR_NOT,
+    IR_LOADG,       /* globals[index] (정의 전이면 str 에러 출력 후 0) */
+    IR_STOREG,      /* globals[index] = args[0] */
+    IR_CALL,        /* funcs[index](args) */
+    IR_PRINT_INT,   /* console.log(args[0]) */
+    IR_PRINT_STR,   /* console.log(strings[str]) */
+    IR_ERROR,       /* strings[str] 출력 (미정의 변수/함수) */
+    IR_DEFFN,       /* funcs[index] 등록 (top-level 순서 보존) */
+
+    /* 종결 명령어: 후속 블록은 IrBlock.succ */
+    IR_JMP,         /* succ[0]으로 */
+    IR_BR,          /* args[0]이 0이 아니면 succ[0], 0이면 succ[1] */
+    IR_CHKFN,       /* funcs[index]가 등록됐으면 succ[0], 아니면 str 에러 출력 후 succ[1] */
+    IR_RET,         /* return args[0] (top-level은 프로그램 종료) */
+    IR_OP_COUNT
+} IrOp;
+
+/* 명령어 = 값 (번호는 IrFunc.insts의 인덱스) */
+typedef struct {
+    IrOp op;
+    IrType type;        /* 결과 타입 */
+    int block;          /* 속한 블록, 제거된 명령어는 -1 */
+    long imm;           /* IR_CONST */
+    int cc;             /* IR_CMP */
+    int index;          /* 매개변수 / 전역 변수 / 함수 인덱스 */
+    int str;            /* 문자열 테이블 인덱스 */
+    int *args;          /* 피연산자 값 번호 */
+    int nargs;
+    int repl;           /* 구성 중: 자명한 phi를 대신하는 값, 없으면 -1 */
+} IrInst;
+
+typedef struct {
+    int *insts;         /* 명령어 번호 (phi가 맨 앞, 종결 명령어가 맨 뒤) */
+    int ninsts;
+    int insts_cap;
+    int *preds;         /* 선행 블록 (phi 인자 순서) */
+    int npreds;
+    int preds_cap;
+    int succ[2];
+    int nsucc;
+
+    /* 구성 중에만 사용 */
+    int sealed;         /* 선행 블록이 모두 정해짐 */
+    int *defs;          /* 슬롯 → 현재 값 (-1: 없음), 필요할 때 할당 */
+    int *incomplete;    /* 봉인 전에 만든 phi (슬롯, phi) 쌍 */
+    int nincomplete;
+    int incomplete_cap;
+} IrBlock;
+
+/* 함수 하나 (top-level 코드는 IrProgram.main) */
+typedef struct {
+    Function *func;     /* 첫 번째 정의, top-level이면 NULL */
+    int nparams;
+    int nslots;         /* 지역 변수 슬롯 수 (resolve.c) */
+    int needs_check;    /* 첫 top-level 문장 이후에 정의됨 (호출 전 등록 검사) */
+
+    IrInst *insts;
+    int ninsts;
+    int insts_cap;
+    IrBlock *blocks;    /* blocks[0]이 진입 블록 */
+    int nblocks;
+    int blocks_cap;
+} IrFunc;
+
+typedef struct {
+    Program *prog;
+    IrFunc *funcs;      /* 같은 이름은 첫 정의만 */
+    int nfuncs;
+    IrFunc main;        /* top-level 코드 */
+
+    char **strings;     /* 문자열 리터럴과 에러 메시지 (복사본) */
+    int nstrings;
+    int strings_cap;
+
+    /* 이름 → 인덱스 해시 (개방 주소법, 빈 칸은 -1) */
+    int *func_index;
+    int func_index_cap;
+    int *string_index;
+    int string_index_cap;
+
+    int nglobals;       /* 전역(스코프 0) 변수 수, 이름은 prog->global_names */
+    Arena arena;        /* 명령어 피연산자 배열 */
+} IrProgram;
+
+/* 함수/전역/문자열 테이블 생성 (본문은 만들지 않음)
+ * - 슬롯 해석(resolve_program)에 실패하면 NULL
+ * - error: 실패 이유 (NULL 가능) */
+IrProgram *ir_new(Program *prog, const char **error);
+
+/* 모든 함수와 top-level 코드를 SSA로 구성 */
+void ir_build(IrProgram *ip);
+
+/* IR 텍스트 출력 (--emit-ir) */
+void ir_print(IrProgram *ip, Output *out);
+
+void ir_free(IrProgram *ip);
+
+/* 함수 인덱스 (같은 이름의 첫 정의), 없으면 -1
+ * name은 ip->prog에 인터닝된 이름 (포인터로 비교) */
+int ir_find_func(IrProgram *ip, const char *name);
+
+/* 문자열 테이블에 추가 (복사, 같은 문자열은 한 번만), 반환: 인덱스 */
+int ir_add_string(IrProgram *ip, const char *str);
+
+/* 문자열 리터럴(소스 구간 text[0..len), NUL로 끝나지 않음)을 문자열 테이블에 추가 */
+int ir_add_text(IrProgram *ip, const char *text, size_t len);
+
+/* 에러 메시지 문자열 ("Error: undefined variable 'x'\n" 등) */
+int ir_undefined_var_msg(IrProgram *ip, const char *name);
+int ir_undefined_func_msg(IrProgram *ip, const char *name);
+
+/* 명령어 이름 ("add", "br" 등) */
+const char *ir_op_name(IrOp op);
+
+/* 종결 명령어 여부 */
+int ir_is_terminator(IrOp op);
+
+/* 블록의 종결 명령어 (없으면 NULL) */
+IrInst *ir_terminator(IrFunc *f, int block);
+
+/* 비교 연산자 변환: 부정 (< → >=), 피연산자 교환 (< → >) */
+int ir_negate_cc(int cc);
+int ir_swap_cc(int cc);
+
+/* 식을 평가할 때 관찰 가능한 효과가 있을 수 있는지
+ * (호출, 전역/미정의 변수 읽기 에러, 0으로 나누기 에러)
+ * 효과가 없는 rhs만 &&, || 단락 평가로 건너뛸 수 있음 (eval_expr는 양쪽을 모두 평가) */
+int ir_expr_has_effects(const Expr *e);
+
+#endif /* IR_H */
@@ -0,0 +1,50 @@
+#ifndef JIT_X86_H
+#define JIT_X86_H
+
+#include "ast.h"
+#include "output.h"
+
+/* Mini-JS x86-64 인프로세스 JIT (-j)
+ * -O1과 같은 파이프라인(SSA IR → LIR → 선형 스캔)의 명령어 선택을
+ * 어셈블러 없이 기계어로 직접 인코딩하고 mmap 버퍼에서 실행
+ * - W^X: 코드 페이지는 쓰기가 끝난 뒤 읽기/실행 전용으로 바꿈 (데이터 페이지는 읽기/쓰기)
+ * - console.log와 에러 메시지는 프로세스 안의 런타임이 Output으로 출력
+ * - x86-64 호스트(System V)에서만 동작, 그 밖에서는 jit_compile이 NULL
+ */
+
+typedef struct JitProgram JitProgram;
+
+/* 기계어 생성
+ * - prog: 프로그램 (jit_compile 동안만 필요)
+ * - error: 실패 이유 (NULL 가능)
+ * - 반환: 실행 가능한 프로그램, 네이티브로 표현할 수 없으면 NULL
+ */
+JitProgram *jit_compile(Program *prog, const char **error);
+
+/* 함수 하나를 기계어로 (계층 실행에서 뜨거운 함수 승격)
+ * - func와 func가 호출하는 함수를 함께 생성, 진입점은 func
+ * - 전역 변수를 쓰거나 등록 검사가 필요한 함수(첫 top-level 문장 이후 정의)를 호출하면 거부
+ *   (전역 상태는 인터프리터가 갖고 있으므로)
+ */
+JitProgram *jit_compile_function(Program *prog, const Function *func, const char **error);
+
+/* 실행 (전역 변수/함수 등록 상태는 실행마다 초기화)
+ * - out: console.log/에러 메시지 출력 대상
+ * - 반환: eval_program과 동일한 반환값 */
+int jit_run(JitProgram *jp, Output *out);
+
+/* jit_compile_function으로 만든 함수 호출
+ * - args: 인자 (앞 6개까지, 모자란 매개변수는 0)
+ * - depth: 호출자의 호출 깊이 (EVAL_MAX_CALL_DEPTH 검사를 이어서 함)
+ * - 반환: 함수 반환값 */
+long jit_call(JitProgram *jp, Output *out, const long *args, int nargs, int depth);
+
+void jit_free(JitProgram *jp);
+
+/* 컴파일 + 실행, JIT로 실행할 수 없는 프로그램은 eval_program으로 실행
+ * - used_jit: JIT로 실행했으면 1 (NULL 가능)
+ * - error: JIT를 쓰지 못한 이유 (NULL 가능)
+ */
+int jit_eval_program(Program *prog, Output *out, int *used_jit, const char **error);
+
+#endif /* JIT_X86_H */
@@ -0,0 +1,107 @@
+#ifndef LIR_H
+#define LIR_H
+
+#include "ir.h"
+
+/* x86-64 백엔드용 저수준 IR (LIR)
+ * SSA IR(ir.h)에서 phi를 없앤 함수 단위 선형 3주소 코드, vreg는 무한히 많다고 가정
+ * - 매개변수 i는 vreg i, IR 상수는 즉시값 피연산자
+ * - phi는 선행 블록 끝의 MOV로 (분기가 둘인 블록에서 오는 간선은 중간 레이블로 분할)
+ * - 레이블/점프로 제어 흐름을 표현 (regalloc.c가 기본 블록과 생존 구간을 계산)
+ */
+
+#define LIR_MAX_ARGS 16         /* eval_call과 동일한 인자 개수 제한 */
+#define LIR_MAX_REG_PARAMS 6    /* 레지스터로 전달하는 매개변수 수 (System V) */
+
+typedef enum {
+    LIR_LABEL,      /* label: */
+    LIR_MOV,        /* dst = a */
+    LIR_LOADG,      /* dst = globals[index] (미정의면 str 에러 출력 후 0) */
+    LIR_STOREG,     /* globals[index] = a */
+    LIR_ADD,        /* dst = a + b */
+    LIR_SUB,
+    LIR_MUL,
+    LIR_DIV,        /* dst = a / b (b가 0이면 에러 출력 후 0) */
+    LIR_MOD,
+    LIR_SETCC,      /* dst = (a cc b) ? 1 : 0 */
+    LIR_LAND,       /* dst = (a && b) ? 1 : 0 (양쪽 모두 이미 평가됨) */
+    LIR_LOR,
+    LIR_NEG,        /* dst = -a */
+    LIR_NOT,        /* dst = !a */
+    LIR_JMP,        /* goto label */
+    LIR_JCC,        /* if (a cc b) goto label */
+    LIR_CALL,       /* dst = funcs[index](args) */
+    LIR_RET,        /* return a (top-level은 프로그램 종료) */
+    LIR_PRINT_INT,  /* console.log(a) */
+    LIR_PRINT_STR,  /* console.log(strings[str]) */
+    LIR_ERROR,      /* strings[str] 출력 (미정의 변수/함수) */
+    LIR_DEFFN,      /* funcs[index] 등록 (top-level 순서 보존) */
+    LIR_CHKFN,      /* funcs[index]가 아직 등록 전이면 str 에러 출력 후 goto label */
+    LIR_OP_COUNT
+} LirOp;
+
+/* 피연산자 */
+typedef enum {
+    LIR_NONE,
+    LIR_VREG,
+    LIR_IMM
+} LirValKind;
+
+typedef struct {
+    LirValKind kind;
+    long value;         /* LIR_VREG: vreg 번호, LIR_IMM: 상수 */
+} LirVal;
+
+typedef struct {
+    LirOp op;
+    int dst;            /* 결과 vreg, 없으면 -1 */
+    LirVal a;
+    LirVal b;
+    int cc;             /* LIR_SETCC/JCC: 비교 연산자 (BIN_LT .. BIN_NE) */
+    int label;          /* LIR_LABEL/JMP/JCC/CHKFN */
+    int index;          /* 전역 변수 / 함수 인덱스 */
+    int str;            /* 문자열 테이블 인덱스 (출력/에러 메시지) */
+    LirVal *args;       /* LIR_CALL 인자 (평가된 것 전부, 앞 6개만 전달) */
+    int nargs;
+} LirInst;
+
+/* 함수 하나 (top-level 코드는 LirProgram.main) */
+typedef struct {
+    int nparams;
+
+    LirInst *code;
+    int ncode;
+    int code_cap;
+    int nvregs;
+    int nlabels;
+
+    /* 레지스터 할당 결과 (regalloc.c) */
+    int *loc;           /* vreg → 위치 (LIR_LOC_*) */
+    int nspills;        /* 스필 슬롯 수 */
+    unsigned callee_used;   /* 사용한 callee-saved 레지스터 (비트 = 레지스터 번호) */
+    int *zero_init;     /* 진입 시 0으로 초기화할 vreg (정의 전에 읽힐 수 있음) */
+    int nzero_init;
+} LirFunc;
+
+typedef struct {
+    IrProgram *ir;      /* 함수/전역/문자열 테이블 (funcs[i]는 ir->funcs[i]) */
+    LirFunc *funcs;
+    int nfuncs;
+    LirFunc main;       /* top-level 코드 */
+} LirProgram;
+
+/* 위치 인코딩: 0..15는 물리 레지스터 (x86 인코딩 번호), 그 이상은 스필 슬롯 */
+#define LIR_LOC_SPILL_BASE 16
+#define LIR_LOC_IS_REG(loc) ((loc) < LIR_LOC_SPILL_BASE)
+#define LIR_LOC_SLOT(loc) ((loc) - LIR_LOC_SPILL_BASE)
+
+/* 네이티브로 표현할 수 없는 프로그램이면 이유, 아니면 NULL
+ * (매개변수는 레지스터로만 전달하므로 LIR_MAX_REG_PARAMS개까지) */
+const char *lir_check_native(IrProgram *ip);
+
+/* SSA IR을 LIR로 낮춤 (ip는 ir_build가 끝난 상태, 해제는 호출자) */
+LirProgram *lir_lower(IrProgram *ip);
+
+void lir_free(LirProgram *lp);
+
+#endif /* LIR_H */
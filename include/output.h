@@ -0,0 +1,60 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+#include <stdarg.h>
+
+/* 출력 대상 (인터프리터, VM, 코드 생성기 공용)
+ * 파일, 고정 크기 버퍼, 늘어나는 메모리 버퍼로 출력
+ * 호출마다 자기 Output을 가지므로 여러 스레드가 동시에 출력해도 섞이지 않음
+ *
+ * 파일 출력은 Output 자체 버퍼(OUTPUT_FILE_BUFSIZE)에 모았다가 output_flush 때 한 번에 씀
+ * - 같은 FILE에 직접 쓰기 전에 output_flush 필요 (context.c는 실행/코드 생성이 끝날 때 flush)
+ * - 터미널이면 줄마다 flush
+ */
+#define OUTPUT_FILE_BUFSIZE 65536
+
+typedef enum {
+    OUTPUT_FILE,    /* 파일 (자체 버퍼 + flush) */
+    OUTPUT_FIXED,   /* 호출자 버퍼, 넘치면 잘림 (--serve 응답 크기 제한) */
+    OUTPUT_GROW     /* 자체 버퍼, 필요한 만큼 늘어남 (웹 드라이버) */
+} OutputKind;
+
+typedef struct Output {
+    OutputKind kind;
+    FILE *file;     /* OUTPUT_FILE: 출력 파일 (NULL이면 stdout) */
+    char *buffer;   /* OUTPUT_FIXED/OUTPUT_GROW: 널 종료 유지, OUTPUT_FILE: flush 전 내용 */
+    int bufsize;
+    int pos;        /* 버퍼에 쓴 바이트 수 */
+    int line_flush; /* OUTPUT_FILE: 줄마다 flush (터미널) */
+    long writes;    /* 출력 호출 수 (메모이제이션이 호출 중 출력 여부 확인에 사용) */
+    long bytes;     /* 출력한 바이트 수 (OUTPUT_FIXED에서 잘린 부분 제외, --stats) */
+    int truncated;  /* OUTPUT_FIXED: 공간이 모자라 출력이 잘린 적 있음 (--serve TRUNC 응답) */
+} Output;
+
+/* 파일로 출력 (file이 NULL이면 stdout) */
+void output_init_file(Output *out, FILE *file);
+
+/* 고정 크기 버퍼로 출력 (항상 널 종료 유지) */
+void output_init_buffer(Output *out, char *buffer, int bufsize);
+
+/* 늘어나는 버퍼로 출력 (결과는 out->buffer, 길이 out->pos, output_release로 해제) */
+void output_init_grow(Output *out);
+
+/* 파일 출력: 버퍼 내용을 파일로 쓰고 비움 (다른 종류는 아무것도 안 함) */
+void output_flush(Output *out);
+
+/* flush 후 자체 버퍼 해제 (OUTPUT_FIXED는 호출자 버퍼이므로 그대로) */
+void output_release(Output *out);
+
+/* 서식 출력 */
+void output_printf(Output *out, const char *fmt, ...);
+void output_vprintf(Output *out, const char *fmt, va_list args);
+
+/* 서식 없는 출력 (console.log 경로) */
+void output_write(Output *out, const char *data, int len);
+void output_line_int(Output *out, long value);      /* "%ld\n" */
+void output_line_str(Output *out, const char *str); /* "%s\n" */
+void output_line_strn(Output *out, const char *str, int len);  /* "%.*s\n" (문자열 리터럴 구간) */
+
+#endif /* OUTPUT_H */
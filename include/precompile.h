@@ -0,0 +1,36 @@
+#ifndef PRECOMPILE_H
+#define PRECOMPILE_H
+
+#include <stdio.h>
+#include "ast.h"
+#include "flat.h"
+
+/* 미리 컴파일한 AST 파일 (.mjsc, --precompile)
+ * 최적화와 슬롯 해석이 끝난 평평한 AST(flat.h)를 배열 그대로 파일에 씀
+ * 노드는 인덱스로만 서로를 가리키므로 주소에 의존하지 않고, 읽을 때는 mmap한 구간을 그대로 사용
+ * (파싱, accum/fold/dce, resolve를 모두 건너뜀, 새로 만드는 것은 이름 포인터 표와 함수 표뿐)
+ * 같은 빌드(바이트 순서, 레코드 크기, 형식 버전)에서만 읽을 수 있음
+ */
+
+#define PRECOMPILE_MAGIC "MJSC"
+#define PRECOMPILE_VERSION 2    /* 2: 문자열 리터럴을 text 구간으로 분리 */
+
+/* 프로그램 → .mjsc
+ * 슬롯 해석에 실패하는 프로그램(동적 스코프)은 평평한 AST로 실행할 수 없으므로 만들지 않음
+ * - error: 실패 이유 (NULL 가능)
+ * - 반환: 성공 시 쓴 바이트 수, 실패 시 -1 */
+long precompile_write(Program *prog, FILE *out, const char **error);
+
+/* 파일이 .mjsc인지 (매직 바이트로 판단, 확장자는 보지 않음)
+ * 일반 파일만 읽어 봄: 파이프 등은 항상 0 (소스를 소비하지 않음) */
+int precompile_detect(const char *path);
+
+/* .mjsc를 mmap해 평평한 AST로
+ * 헤더, 구간 범위, 레코드 안의 인덱스(자식, 목록 구간, 슬롯, 이름/문자열 오프셋, 함수 표)를
+ * 모두 검사하므로 손상된 파일은 실행 전에 거부 (값만 바뀐 파일은 그대로 실행될 수 있음)
+ * - error: 실패 이유 (NULL 가능)
+ * - 반환: precompile_unload로 해제할 FlatProgram, 실패 시 NULL */
+FlatProgram *precompile_load(const char *path, const char **error);
+void precompile_unload(FlatProgram *fp);
+
+#endif /* PRECOMPILE_H */
@@ -0,0 +1,18 @@
+#ifndef PURITY_H
+#define PURITY_H
+
+#include "ast.h"
+
+/* 순수 함수 분석 (--memoize)
+ * 결과가 인자에만 달려 있고 부작용이 없는 함수를 찾아 Function.pure = 1
+ * - console.log가 없음
+ * - 지역 변수(매개변수 포함)만 읽고 씀 (전역 읽기도 결과를 바꿀 수 있으므로 제외)
+ * - 순수 함수만 호출 (재귀 포함, 이름은 첫 정의로 해석)
+ * 나눗셈 0, 등록 전 호출 같은 실행 중 에러 출력은 분석하지 않음 (호출자가 출력으로 확인)
+ */
+
+/* 분석 실행 (resolve_program이 성공한 프로그램만, 아니면 모두 0)
+ * - 반환: 순수 함수 수 */
+int purity_analyze(Program *prog);
+
+#endif /* PURITY_H */
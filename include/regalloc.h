@@ -0,0 +1,53 @@
+#ifndef REGALLOC_H
+#define REGALLOC_H
+
+#include "lir.h"
+
+/* LIR 선형 스캔 레지스터 할당 (Poletto & Sarkar)
+ * - 기본 블록 단위 생존 분석 후 vreg마다 하나의 생존 구간 (구멍은 무시)
+ * - 호출을 가로지르는 구간은 callee-saved 레지스터에만 배치
+ * - 레지스터가 부족하면 끝이 가장 먼 구간을 스택 슬롯으로 스필
+ * - rax, rcx, rdx는 코드 생성기의 스크래치로 남겨 둠 (idiv, 시프트, 병렬 이동)
+ */
+
+/* x86-64 범용 레지스터 (하드웨어 인코딩 순서) */
+typedef enum {
+    X86_RAX, X86_RCX, X86_RDX, X86_RBX, X86_RSP, X86_RBP, X86_RSI, X86_RDI,
+    X86_R8, X86_R9, X86_R10, X86_R11, X86_R12, X86_R13, X86_R14, X86_R15,
+    X86_NREGS
+} X86Reg;
+
+/* System V 인자 레지스터 */
+extern const X86Reg x86_arg_regs[LIR_MAX_REG_PARAMS];
+
+/* 이름 ("%rbx"), 32비트 이름 ("%ebx"), 8비트 이름 ("%bl") */
+const char *x86_reg_name(int reg);
+const char *x86_reg_name32(int reg);
+const char *x86_reg_name8(int reg);
+
+/* callee-saved 여부 (rbx, rbp, r12-r15) */
+int x86_is_callee_saved(int reg);
+
+/* 함수 하나 할당: f->loc, f->nspills, f->callee_used, f->zero_init 채움 */
+void regalloc_func(LirFunc *f);
+
+/* 프로그램 전체 (top-level + 모든 함수) */
+void regalloc_program(LirProgram *lp);
+
+/* === 병렬 이동 ===
+ * 호출 인자/매개변수/phi처럼 동시에 일어나야 하는 이동을 순차 이동으로 풀어냄
+ * 순환은 scratch 하나로 끊음 (위치는 LIR_LOC_* 또는 할당 전의 vreg 번호)
+ */
+typedef struct {
+    int dst;        /* 위치 */
+    int src;        /* 위치 (src_imm이면 무시) */
+    int src_imm;    /* 1이면 상수 이동 */
+    long imm;
+} RegMove;
+
+/* moves[0..n-1]을 순서대로 실행해도 되도록 out에 다시 씀 (최대 2n개)
+ * - scratch: 순환을 끊을 위치 (어떤 이동의 원본/목적지도 아니어야 함)
+ * - 반환: out 개수 */
+int regalloc_sequence_moves(const RegMove *moves, int n, int scratch, RegMove *out);
+
+#endif /* REGALLOC_H */
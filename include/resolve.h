@@ -0,0 +1,22 @@
+#ifndef RESOLVE_H
+#define RESOLVE_H
+
+#include "ast.h"
+
+/* 변수 슬롯 해석 (resolver)
+ * 모든 변수 참조/선언/대입을 (프레임, 슬롯)으로 해석해 AST에 기록
+ * - 지역 변수: 함수 프레임 슬롯 (매개변수가 0..n-1), 블록이 닫히면 슬롯 재사용
+ * - top-level 스코프 0 변수: 전역 프레임 슬롯
+ * - 호출자의 지역 변수를 읽는 등 심볼 테이블의 동적 스코프가 필요한
+ *   프로그램은 해석하지 않음 (모든 참조가 VAR_UNRESOLVED로 남음)
+ * - 함수나 블록이 아직 선언되지 않았을 수 있는 전역에 대입하는 프로그램도 해석하지 않음
+ *   (심볼 테이블은 그 대입으로 지역 변수를 만듦, 전역 읽기는 실행기가 정의 여부를 확인)
+ * - 어느 경우든 선언이 없는 블록/for문은 needs_scope = 0
+ */
+
+/* 해석 실행
+ * - 반환: 성공 시 1 (prog->resolved = 1),
+ *         실패 시 0 (이유는 prog->resolve_error) */
+int resolve_program(Program *prog);
+
+#endif /* RESOLVE_H */
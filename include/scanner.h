@@ -0,0 +1,45 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <stdio.h>
+#include "ast.h"
+
+/* 재진입 flex 스캐너 인터페이스 (parser/scanner.l)
+ * 스캐너 상태(버퍼, 입력 소스, mmap)는 모두 yyscan_t 안에 있음
+ * 스캐너 하나는 한 번에 한 스레드에서만 사용
+ * 입력은 항상 한 버퍼(SourceBuffer)에 모아 제자리에서 스캔하며
+ * 문자열 리터럴 토큰은 그 버퍼 안의 구간 (StrView)
+ */
+
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+
+/* 스캐너 생성/해제 (실패 시 NULL) */
+yyscan_t scanner_create(void);
+void scanner_destroy(yyscan_t yyscanner);
+
+/* 문자열 입력 (str은 한 번 복사하므로 호출 뒤 해제해도 됨) */
+void yy_scan_string_custom(const char *str, yyscan_t yyscanner);
+void yy_reset_input(yyscan_t yyscanner);
+
+/* 파일 입력 (가능하면 mmap)
+ * - 반환: 매핑했으면 1, 아니면 0 (yy_scan_stream) */
+int yy_scan_file(FILE *f, yyscan_t yyscanner);
+
+/* 스트림 입력 (stdin, 파이프): 끝까지 읽은 뒤 스캔 */
+void yy_scan_stream(FILE *f, yyscan_t yyscanner);
+
+/* 입력 해제 (파싱이 끝난 뒤 호출, yy_reset_input과 같음)
+ * scanner_take_source로 넘기지 않은 소스 버퍼는 여기서 해제 */
+void yy_scan_file_release(yyscan_t yyscanner);
+
+/* 스캔한 소스 버퍼를 dst로 넘김 (dst의 이전 버퍼는 해제)
+ * 문자열 리터럴이 가리키는 버퍼이므로 파싱 직후 Program.source로 옮김 */
+void scanner_take_source(yyscan_t yyscanner, SourceBuffer *dst);
+
+/* 소스 버퍼 해제 (mmap이면 munmap, 아니면 free, 빈 버퍼는 무시) */
+void scanner_source_free(SourceBuffer *src);
+
+#endif /* SCANNER_H */
@@ -0,0 +1,33 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+/* Mini-JS 상주 서버 (minijs --serve <socket>)
+ * Unix 도메인 소켓으로 스크립트를 받아 고정 크기 워커 스레드 풀에서 처리
+ * 워커마다 MiniJSContext 하나를 만들어 계속 재사용 (프로세스/파서 초기화 비용 없음)
+ *
+ * 프로토콜 (한 연결에서 요청을 여러 번 보낼 수 있음):
+ *   요청: "<명령> <길이>\n" + <길이> 바이트 소스
+ *         명령: EVAL (트리 인터프리터), VM (바이트코드 VM), ASM (x86-64 어셈블리),
+ *               STATS (카운터 조회, 길이 0)
+ *   응답: "<OK|TRUNC|ERR> <반환값> <길이> <처리 시간 us>\n" + <길이> 바이트 본문
+ *         본문: 실행 출력 / 어셈블리 / 오류 메시지 / 통계
+ *         TRUNC: 처리는 성공했지만 본문이 SERVER_OUTPUT_SIZE - 1 바이트에서 잘림
+ *   요청을 다 보내지 않은 채 SERVER_IO_TIMEOUT_MS 동안 멈추거나 응답을 읽지 않는
+ *   연결은 서버가 닫음 (요청 사이에 쉬는 연결은 제한 없음)
+ */
+
+#define SERVER_DEFAULT_WORKERS 4
+#define SERVER_MAX_SOURCE (16 * 1024 * 1024)    /* 요청 소스 최대 크기 */
+#define SERVER_OUTPUT_SIZE (1024 * 1024)        /* 워커별 출력 버퍼 (넘치면 잘림) */
+#define SERVER_IO_TIMEOUT_MS 5000               /* 요청 수신/응답 송신 제한 시간 */
+
+/* 서버 실행 (SIGINT/SIGTERM을 받을 때까지 반환하지 않음)
+ * - socket_path: 바인드할 소켓 경로 (이미 있으면 지우고 다시 만듦)
+ * - nworkers: 워커 스레드 수 (0 이하이면 기본값)
+ * - opt_level: ASM 요청의 코드 생성 최적화 수준 (-O)
+ * - 반환: 종료 코드 (0: 정상 종료, 1: 소켓/스레드 생성 실패)
+ * 종료 시 누적 카운터를 stderr에 출력
+ */
+int server_run(const char *socket_path, int nworkers, int opt_level);
+
+#endif /* SERVER_H */
@@ -0,0 +1,80 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include "ast.h"
+
+/* 단계별 측정 (--time-phases)과 실행 카운터 (--stats)
+ * - PhaseTimer: 단계가 끝날 때마다 벽시계 시간과 최대 RSS를 기록 (컨텍스트와 main이 표시)
+ * - ExecStats: 트리 인터프리터(eval.c)와 심볼 테이블(symtab.c)이 세는 카운터
+ *   카운터 포인터가 NULL이면 분기 하나로 건너뜀
+ *   -DMINIJS_NO_STATS로 빌드하면 카운터 코드가 모두 빠짐 (출력 바이트만 Output.bytes로 셈)
+ */
+
+/* === 단계별 측정 === */
+
+#define PHASE_MAX 8
+
+typedef struct {
+    const char *name;
+    double seconds;     /* 벽시계 시간 */
+    long peak_rss_kb;   /* 단계가 끝났을 때 프로세스의 최대 RSS (KB, 알 수 없으면 0) */
+} PhaseTime;
+
+typedef struct {
+    PhaseTime phases[PHASE_MAX];
+    int count;
+    double start;       /* 진행 중인 단계의 시작 시각 */
+    long start_rss_kb;  /* phase_timer_start 시점의 최대 RSS */
+} PhaseTimer;
+
+/* 첫 단계 시작 */
+void phase_timer_start(PhaseTimer *t);
+
+/* 마지막 표시 이후를 name 단계로 기록하고 다음 단계 시작 (t가 NULL이면 아무것도 안 함)
+ * PHASE_MAX를 넘는 단계는 마지막 단계에 합침 */
+void phase_mark(PhaseTimer *t, const char *name);
+
+/* 단계별 표 (시간, 최대 RSS, 단계 중 늘어난 최대 RSS) */
+void phase_report(const PhaseTimer *t, FILE *out);
+
+/* === 실행 카운터 === */
+
+typedef struct ExecStats {
+    long exprs[EXPR_UNARY + 1];     /* 평가한 식 (ExprKind별) */
+    long stmts[STMT_BLOCK + 1];     /* 실행한 문장 (StmtKind별) */
+    long sym_lookups;               /* 심볼 테이블 이름 조회 (동적 스코프) */
+    long sym_probes;                /* 조회 중 비교한 해시 칸 */
+    long scope_pushes;
+    long scope_pops;
+    long calls;                     /* 함수 호출 (꼬리 자기 호출, JIT로 승격된 호출 포함) */
+    long depth;                     /* 현재 호출 깊이 */
+    long max_depth;
+    long output_bytes;              /* console.log와 에러 메시지로 출력한 바이트 */
+} ExecStats;
+
+#ifndef MINIJS_NO_STATS
+#define STATS_ON(stats) (stats)
+#else
+#define STATS_ON(stats) ((ExecStats *)0)
+#endif
+
+#define STAT_INC(stats, field) \
+    do { if (STATS_ON(stats)) STATS_ON(stats)->field++; } while (0)
+
+/* 호출 진입/복귀 (깊이는 카운터가 켜졌을 때만 추적) */
+#define STAT_CALL_ENTER(stats) \
+    do { \
+        ExecStats *s_ = STATS_ON(stats); \
+        if (s_) { \
+            s_->calls++; \
+            if (++s_->depth > s_->max_depth) s_->max_depth = s_->depth; \
+        } \
+    } while (0)
+#define STAT_CALL_LEAVE(stats) \
+    do { if (STATS_ON(stats)) STATS_ON(stats)->depth--; } while (0)
+
+/* 카운터 표 (0인 종류는 생략) */
+void exec_stats_report(const ExecStats *s, FILE *out);
+
+#endif /* STATS_H */
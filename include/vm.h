@@ -0,0 +1,36 @@
+#ifndef VM_H
+#define VM_H
+
+#include "ast.h"
+#include "output.h"
+
+/* Mini-JS 바이트코드 VM
+ * Program을 한 번 선형 바이트코드로 낮춘 뒤 VM 루프에서 실행
+ * (GCC/Clang에서는 computed goto 디스패치)
+ * 실행 스택/프레임은 vm_run 호출마다 할당하므로 스레드마다 독립 실행 가능
+ */
+
+typedef struct VMProgram VMProgram;
+
+/* 바이트코드 컴파일
+ * - prog: 프로그램 (VMProgram보다 오래 살아 있어야 함)
+ * - error: 실패 이유를 받을 포인터 (NULL 가능)
+ * - 반환: 컴파일된 프로그램, 정적 이름 해석이 불가능하면 NULL
+ */
+VMProgram *vm_compile(Program *prog, const char **error);
+
+/* 바이트코드 실행
+ * - out: console.log/에러 메시지 출력 대상
+ * - 반환: eval_program과 동일한 반환값 */
+int vm_run(VMProgram *vp, Output *out);
+
+/* 바이트코드 해제 */
+void vm_free(VMProgram *vp);
+
+/* 컴파일 + 실행, 컴파일할 수 없는 프로그램은 eval_program으로 실행
+ * - used_vm: VM으로 실행했으면 1 (NULL 가능)
+ * - error: VM을 쓰지 못한 이유 (NULL 가능)
+ */
+int vm_eval_program(Program *prog, Output *out, int *used_vm, const char **error);
+
+#endif /* VM_H */
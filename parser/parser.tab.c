@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,20 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -65,20 +66,6 @@
 
 
 
-/* First part of user prologue.  */
-#line 1 "parser/parser.y"
-
-/* Mini-JavaScript Parser
- * JavaScript 스타일 문법 지원
- */
-#include <stdio.h>
-#include <stdlib.h>
-#include "ast.h"
-
-int yylex(void);
-void yyerror(const char *s);
-
-#line 82 "parser/parser.tab.c"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -101,88 +88,89 @@ void yyerror(const char *s);
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_PARSER_PARSER_TAB_H_INCLUDED
-# define YY_YY_PARSER_PARSER_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    FUNCTION = 258,
-    LET = 259,
-    VAR = 260,
-    CONST = 261,
-    RETURN = 262,
-    IF = 263,
-    ELSE = 264,
-    WHILE = 265,
-    FOR = 266,
-    CONSOLE = 267,
-    LOG = 268,
-    EQ = 269,
-    NE = 270,
-    LE = 271,
-    GE = 272,
-    AND = 273,
-    OR = 274,
-    NUMBER = 275,
-    IDENT = 276,
-    STRING = 277,
-    UMINUS = 278,
-    UNOT = 279
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-union YYSTYPE
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 13 "parser/parser.y"
-
-    int int_value;
-    char *ident;
-    Expr *expr;
-    ExprList *expr_list;
-    Stmt *stmt;
-    StmtList *stmt_list;
-    ParamList *param_list;
-    Function *function;
-    FunctionList *function_list;
-
-#line 171 "parser/parser.tab.c"
-
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_FUNCTION = 3,                   /* FUNCTION  */
+  YYSYMBOL_LET = 4,                        /* LET  */
+  YYSYMBOL_VAR = 5,                        /* VAR  */
+  YYSYMBOL_CONST = 6,                      /* CONST  */
+  YYSYMBOL_RETURN = 7,                     /* RETURN  */
+  YYSYMBOL_IF = 8,                         /* IF  */
+  YYSYMBOL_ELSE = 9,                       /* ELSE  */
+  YYSYMBOL_WHILE = 10,                     /* WHILE  */
+  YYSYMBOL_FOR = 11,                       /* FOR  */
+  YYSYMBOL_CONSOLE = 12,                   /* CONSOLE  */
+  YYSYMBOL_LOG = 13,                       /* LOG  */
+  YYSYMBOL_EQ = 14,                        /* EQ  */
+  YYSYMBOL_NE = 15,                        /* NE  */
+  YYSYMBOL_LE = 16,                        /* LE  */
+  YYSYMBOL_GE = 17,                        /* GE  */
+  YYSYMBOL_AND = 18,                       /* AND  */
+  YYSYMBOL_OR = 19,                        /* OR  */
+  YYSYMBOL_NUMBER = 20,                    /* NUMBER  */
+  YYSYMBOL_IDENT = 21,                     /* IDENT  */
+  YYSYMBOL_STRING = 22,                    /* STRING  */
+  YYSYMBOL_23_ = 23,                       /* '<'  */
+  YYSYMBOL_24_ = 24,                       /* '>'  */
+  YYSYMBOL_25_ = 25,                       /* '+'  */
+  YYSYMBOL_26_ = 26,                       /* '-'  */
+  YYSYMBOL_27_ = 27,                       /* '*'  */
+  YYSYMBOL_28_ = 28,                       /* '/'  */
+  YYSYMBOL_29_ = 29,                       /* '%'  */
+  YYSYMBOL_UMINUS = 30,                    /* UMINUS  */
+  YYSYMBOL_UNOT = 31,                      /* UNOT  */
+  YYSYMBOL_32_ = 32,                       /* '('  */
+  YYSYMBOL_33_ = 33,                       /* ')'  */
+  YYSYMBOL_34_ = 34,                       /* ','  */
+  YYSYMBOL_35_ = 35,                       /* '{'  */
+  YYSYMBOL_36_ = 36,                       /* '}'  */
+  YYSYMBOL_37_ = 37,                       /* ';'  */
+  YYSYMBOL_38_ = 38,                       /* '.'  */
+  YYSYMBOL_39_ = 39,                       /* '='  */
+  YYSYMBOL_40_ = 40,                       /* '!'  */
+  YYSYMBOL_YYACCEPT = 41,                  /* $accept  */
+  YYSYMBOL_program = 42,                   /* program  */
+  YYSYMBOL_program_items = 43,             /* program_items  */
+  YYSYMBOL_program_item = 44,              /* program_item  */
+  YYSYMBOL_function = 45,                  /* function  */
+  YYSYMBOL_param_list_opt = 46,            /* param_list_opt  */
+  YYSYMBOL_param_list = 47,                /* param_list  */
+  YYSYMBOL_compound_stmt = 48,             /* compound_stmt  */
+  YYSYMBOL_stmt_list_opt = 49,             /* stmt_list_opt  */
+  YYSYMBOL_stmt_list = 50,                 /* stmt_list  */
+  YYSYMBOL_stmt = 51,                      /* stmt  */
+  YYSYMBOL_opt_for_init = 52,              /* opt_for_init  */
+  YYSYMBOL_opt_expr = 53,                  /* opt_expr  */
+  YYSYMBOL_opt_for_step = 54,              /* opt_for_step  */
+  YYSYMBOL_single_stmt = 55,               /* single_stmt  */
+  YYSYMBOL_vardecl = 56,                   /* vardecl  */
+  YYSYMBOL_assign_stmt = 57,               /* assign_stmt  */
+  YYSYMBOL_expr = 58,                      /* expr  */
+  YYSYMBOL_primary = 59,                   /* primary  */
+  YYSYMBOL_call_expr = 60,                 /* call_expr  */
+  YYSYMBOL_arg_list_opt = 61,              /* arg_list_opt  */
+  YYSYMBOL_arg_list = 62                   /* arg_list  */
 };
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
-
-extern YYSTYPE yylval;
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-int yyparse (void);
 
-#endif /* !YY_YY_PARSER_PARSER_TAB_H_INCLUDED  */
 
+/* Unqualified %code blocks.  */
+#line 10 "parser/parser.y"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner, Program *prog);
+void yyerror(yyscan_t scanner, Program *prog, const char *s);
 
+#line 174 "parser/parser.tab.c"
 
 #ifdef short
 # undef short
@@ -221,6 +209,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -280,6 +280,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_uint8 yy_state_t;
 
@@ -298,6 +299,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -316,17 +318,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -355,7 +363,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -420,8 +428,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -497,14 +504,16 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  155
 
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   279
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -541,50 +550,50 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    55,    55,    59,    60,    61,    65,    66,    71,    76,
-      77,    82,    83,    88,    92,    93,    97,    98,   103,   104,
-     105,   106,   107,   109,   111,   113,   115,   117,   118,   123,
-     124,   125,   126,   131,   132,   137,   138,   143,   144,   145,
-     146,   147,   149,   154,   155,   156,   157,   158,   163,   168,
-     169,   170,   171,   172,   173,   174,   175,   176,   177,   178,
-     179,   180,   181,   182,   183,   188,   189,   190,   191,   192,
-     197,   202,   203,   207,   208
+       0,    65,    65,    69,    70,    71,    75,    76,    81,    86,
+      87,    92,    93,    98,   102,   103,   107,   108,   113,   114,
+     115,   116,   117,   119,   121,   123,   125,   127,   128,   133,
+     134,   135,   136,   141,   142,   147,   148,   153,   154,   155,
+     156,   157,   159,   164,   165,   166,   167,   168,   173,   178,
+     179,   180,   181,   182,   183,   184,   185,   186,   187,   188,
+     189,   190,   191,   192,   193,   198,   199,   200,   201,   202,
+     207,   212,   213,   217,   218
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "FUNCTION", "LET", "VAR", "CONST",
-  "RETURN", "IF", "ELSE", "WHILE", "FOR", "CONSOLE", "LOG", "EQ", "NE",
-  "LE", "GE", "AND", "OR", "NUMBER", "IDENT", "STRING", "'<'", "'>'",
-  "'+'", "'-'", "'*'", "'/'", "'%'", "UMINUS", "UNOT", "'('", "')'", "','",
-  "'{'", "'}'", "';'", "'.'", "'='", "'!'", "$accept", "program",
+  "\"end of file\"", "error", "\"invalid token\"", "FUNCTION", "LET",
+  "VAR", "CONST", "RETURN", "IF", "ELSE", "WHILE", "FOR", "CONSOLE", "LOG",
+  "EQ", "NE", "LE", "GE", "AND", "OR", "NUMBER", "IDENT", "STRING", "'<'",
+  "'>'", "'+'", "'-'", "'*'", "'/'", "'%'", "UMINUS", "UNOT", "'('", "')'",
+  "','", "'{'", "'}'", "';'", "'.'", "'='", "'!'", "$accept", "program",
   "program_items", "program_item", "function", "param_list_opt",
   "param_list", "compound_stmt", "stmt_list_opt", "stmt_list", "stmt",
   "opt_for_init", "opt_expr", "opt_for_step", "single_stmt", "vardecl",
   "assign_stmt", "expr", "primary", "call_expr", "arg_list_opt",
   "arg_list", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,    60,    62,    43,    45,    42,    47,    37,
-     278,   279,    40,    41,    44,   123,   125,    59,    46,    61,
-      33
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
 #define YYPACT_NINF (-91)
 
@@ -596,8 +605,8 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
      119,   -14,    -4,    -1,     2,   -16,     1,    32,    33,     7,
@@ -618,9 +627,9 @@ static const yytype_int16 yypact[] =
      314,   334,   -91,   109,   -91
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        5,     0,     0,     0,     0,     0,     0,     0,     0,     0,
@@ -641,7 +650,7 @@ static const yytype_int8 yydefact[] =
        0,    36,    26,     0,    41
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
      -91,   -91,   -91,   134,   -91,   -91,   -91,   -90,   -91,   -91,
@@ -649,17 +658,17 @@ static const yytype_int16 yypgoto[] =
      -91,   -91
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    17,    18,    19,    20,    98,    99,    21,    43,    44,
+       0,    17,    18,    19,    20,    98,    99,    21,    43,    44,
       22,    75,   125,   145,   117,    23,    24,    25,    26,    27,
       78,    79
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
       34,    72,    73,    45,    10,    32,    12,    28,    41,    42,
@@ -750,8 +759,8 @@ static const yytype_int16 yycheck[] =
       -1,    -1,    -1,    23,    24,    25,    26,    27,    28,    29
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,     3,     4,     5,     6,     7,     8,    10,    11,    12,
@@ -772,7 +781,7 @@ static const yytype_int8 yystos[] =
       58,    58,    55,    33,    37
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    41,    42,    43,    43,    43,    44,    44,    45,    46,
@@ -785,7 +794,7 @@ static const yytype_int8 yyr1[] =
       60,    61,    61,    62,    62
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     2,     1,     0,     1,     1,     6,     0,
@@ -799,14 +808,15 @@ static const yytype_int8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -823,15 +833,14 @@ static const yytype_int8 yyr2[] =
       }                                                           \
     else                                                          \
       {                                                           \
-        yyerror (YY_("syntax error: cannot back up")); \
+        yyerror (scanner, prog, YY_("syntax error: cannot back up")); \
         YYERROR;                                                  \
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -848,19 +857,16 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, scanner, prog); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -871,18 +877,17 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, Program *prog)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
+  YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (prog);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -892,12 +897,13 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, Program *prog)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyo, yytype, yyvaluep);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, prog);
   YYFPRINTF (yyo, ")");
 }
 
@@ -930,7 +936,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, yyscan_t scanner, Program *prog)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -942,9 +949,8 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, prog);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -952,15 +958,15 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner, prog); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -983,265 +989,33 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
-/* Return the length of YYSTR.  */
-static YYPTRDIFF_T
-yystrlen (const char *yystr)
-{
-  YYPTRDIFF_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYPTRDIFF_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYPTRDIFF_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            else
-              goto append;
-
-          append:
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
 
-  if (yyres)
-    return yystpcpy (yyres, yystr) - yyres;
-  else
-    return yystrlen (yystr);
-}
-# endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
-{
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Actual size of YYARG. */
-  int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
-    }
 
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-    default: /* Avoid compiler warnings. */
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          ++yyp;
-          ++yyformat;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, yyscan_t scanner, Program *prog)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (prog);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
@@ -1249,45 +1023,51 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (yyscan_t scanner, Program *prog)
 {
-    yy_state_fast_t yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
-
-    YYPTRDIFF_T yystacksize;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1295,16 +1075,10 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
 
@@ -1326,10 +1100,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1357,7 +1132,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1368,10 +1143,10 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1390,6 +1165,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1410,18 +1186,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner, prog);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1490,446 +1277,446 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 55 "parser/parser.y"
-                               { /* g_program은 이미 조작됨 */ }
-#line 1497 "parser/parser.tab.c"
+  case 2: /* program: program_items  */
+#line 65 "parser/parser.y"
+                               { /* prog는 이미 조작됨 */ }
+#line 1284 "parser/parser.tab.c"
     break;
 
-  case 3:
-#line 59 "parser/parser.y"
+  case 3: /* program_items: program_items program_item  */
+#line 69 "parser/parser.y"
                                   { /* 누적 */ }
-#line 1503 "parser/parser.tab.c"
+#line 1290 "parser/parser.tab.c"
     break;
 
-  case 4:
-#line 60 "parser/parser.y"
+  case 4: /* program_items: program_item  */
+#line 70 "parser/parser.y"
                                   { /* 첫 항목 */ }
-#line 1509 "parser/parser.tab.c"
+#line 1296 "parser/parser.tab.c"
     break;
 
-  case 5:
-#line 61 "parser/parser.y"
+  case 5: /* program_items: %empty  */
+#line 71 "parser/parser.y"
                                   { /* 빈 프로그램 허용 */ }
-#line 1515 "parser/parser.tab.c"
+#line 1302 "parser/parser.tab.c"
     break;
 
-  case 6:
-#line 65 "parser/parser.y"
-                { program_add_function(g_program, (yyvsp[0].function)); }
-#line 1521 "parser/parser.tab.c"
+  case 6: /* program_item: function  */
+#line 75 "parser/parser.y"
+                { program_add_function(prog, (yyvsp[0].function)); }
+#line 1308 "parser/parser.tab.c"
     break;
 
-  case 7:
-#line 66 "parser/parser.y"
-                { program_add_stmt(g_program, (yyvsp[0].stmt)); }
-#line 1527 "parser/parser.tab.c"
+  case 7: /* program_item: stmt  */
+#line 76 "parser/parser.y"
+                { program_add_stmt(prog, (yyvsp[0].stmt)); }
+#line 1314 "parser/parser.tab.c"
     break;
 
-  case 8:
-#line 72 "parser/parser.y"
-        { (yyval.function) = new_function((yyvsp[-4].ident), (yyvsp[-2].param_list), (yyvsp[0].stmt_list)); free((yyvsp[-4].ident)); }
-#line 1533 "parser/parser.tab.c"
+  case 8: /* function: FUNCTION IDENT '(' param_list_opt ')' compound_stmt  */
+#line 82 "parser/parser.y"
+        { (yyval.function) = new_function(prog, (yyvsp[-4].ident), (yyvsp[-2].param_list), (yyvsp[0].stmt_list)); }
+#line 1320 "parser/parser.tab.c"
     break;
 
-  case 9:
-#line 76 "parser/parser.y"
+  case 9: /* param_list_opt: %empty  */
+#line 86 "parser/parser.y"
                                { (yyval.param_list) = NULL; }
-#line 1539 "parser/parser.tab.c"
+#line 1326 "parser/parser.tab.c"
     break;
 
-  case 10:
-#line 77 "parser/parser.y"
+  case 10: /* param_list_opt: param_list  */
+#line 87 "parser/parser.y"
                                { (yyval.param_list) = (yyvsp[0].param_list); }
-#line 1545 "parser/parser.tab.c"
+#line 1332 "parser/parser.tab.c"
     break;
 
-  case 11:
-#line 82 "parser/parser.y"
-                               { (yyval.param_list) = param_list_append(NULL, (yyvsp[0].ident)); free((yyvsp[0].ident)); }
-#line 1551 "parser/parser.tab.c"
+  case 11: /* param_list: IDENT  */
+#line 92 "parser/parser.y"
+                               { (yyval.param_list) = param_list_append(prog, NULL, (yyvsp[0].ident)); }
+#line 1338 "parser/parser.tab.c"
     break;
 
-  case 12:
-#line 83 "parser/parser.y"
-                               { (yyval.param_list) = param_list_append((yyvsp[-2].param_list), (yyvsp[0].ident)); free((yyvsp[0].ident)); }
-#line 1557 "parser/parser.tab.c"
+  case 12: /* param_list: param_list ',' IDENT  */
+#line 93 "parser/parser.y"
+                               { (yyval.param_list) = param_list_append(prog, (yyvsp[-2].param_list), (yyvsp[0].ident)); }
+#line 1344 "parser/parser.tab.c"
     break;
 
-  case 13:
-#line 88 "parser/parser.y"
+  case 13: /* compound_stmt: '{' stmt_list_opt '}'  */
+#line 98 "parser/parser.y"
                                { (yyval.stmt_list) = (yyvsp[-1].stmt_list); }
-#line 1563 "parser/parser.tab.c"
+#line 1350 "parser/parser.tab.c"
     break;
 
-  case 14:
-#line 92 "parser/parser.y"
+  case 14: /* stmt_list_opt: %empty  */
+#line 102 "parser/parser.y"
                                { (yyval.stmt_list) = NULL; }
-#line 1569 "parser/parser.tab.c"
+#line 1356 "parser/parser.tab.c"
     break;
 
-  case 15:
-#line 93 "parser/parser.y"
+  case 15: /* stmt_list_opt: stmt_list  */
+#line 103 "parser/parser.y"
                                { (yyval.stmt_list) = (yyvsp[0].stmt_list); }
-#line 1575 "parser/parser.tab.c"
+#line 1362 "parser/parser.tab.c"
     break;
 
-  case 16:
-#line 97 "parser/parser.y"
-                               { (yyval.stmt_list) = stmt_list_append((yyvsp[-1].stmt_list), (yyvsp[0].stmt)); }
-#line 1581 "parser/parser.tab.c"
+  case 16: /* stmt_list: stmt_list stmt  */
+#line 107 "parser/parser.y"
+                               { (yyval.stmt_list) = stmt_list_append(prog, (yyvsp[-1].stmt_list), (yyvsp[0].stmt)); }
+#line 1368 "parser/parser.tab.c"
     break;
 
-  case 17:
-#line 98 "parser/parser.y"
-                               { (yyval.stmt_list) = stmt_list_append(NULL, (yyvsp[0].stmt)); }
-#line 1587 "parser/parser.tab.c"
+  case 17: /* stmt_list: stmt  */
+#line 108 "parser/parser.y"
+                               { (yyval.stmt_list) = stmt_list_append(prog, NULL, (yyvsp[0].stmt)); }
+#line 1374 "parser/parser.tab.c"
     break;
 
-  case 18:
-#line 103 "parser/parser.y"
+  case 18: /* stmt: vardecl ';'  */
+#line 113 "parser/parser.y"
                                { (yyval.stmt) = (yyvsp[-1].stmt); }
-#line 1593 "parser/parser.tab.c"
+#line 1380 "parser/parser.tab.c"
     break;
 
-  case 19:
-#line 104 "parser/parser.y"
+  case 19: /* stmt: assign_stmt ';'  */
+#line 114 "parser/parser.y"
                                { (yyval.stmt) = (yyvsp[-1].stmt); }
-#line 1599 "parser/parser.tab.c"
+#line 1386 "parser/parser.tab.c"
     break;
 
-  case 20:
-#line 105 "parser/parser.y"
-                               { (yyval.stmt) = new_return_stmt((yyvsp[-1].expr)); }
-#line 1605 "parser/parser.tab.c"
+  case 20: /* stmt: RETURN expr ';'  */
+#line 115 "parser/parser.y"
+                               { (yyval.stmt) = new_return_stmt(prog, (yyvsp[-1].expr)); }
+#line 1392 "parser/parser.tab.c"
     break;
 
-  case 21:
-#line 106 "parser/parser.y"
-                               { (yyval.stmt) = new_return_stmt(NULL); }
-#line 1611 "parser/parser.tab.c"
+  case 21: /* stmt: RETURN ';'  */
+#line 116 "parser/parser.y"
+                               { (yyval.stmt) = new_return_stmt(prog, NULL); }
+#line 1398 "parser/parser.tab.c"
     break;
 
-  case 22:
-#line 108 "parser/parser.y"
-        { (yyval.stmt) = new_print_stmt((yyvsp[-2].expr)); }
-#line 1617 "parser/parser.tab.c"
+  case 22: /* stmt: CONSOLE '.' LOG '(' expr ')' ';'  */
+#line 118 "parser/parser.y"
+        { (yyval.stmt) = new_print_stmt(prog, (yyvsp[-2].expr)); }
+#line 1404 "parser/parser.tab.c"
     break;
 
-  case 23:
-#line 110 "parser/parser.y"
-        { (yyval.stmt) = new_if_stmt((yyvsp[-4].expr), (yyvsp[-2].stmt), (yyvsp[0].stmt)); }
-#line 1623 "parser/parser.tab.c"
+  case 23: /* stmt: IF '(' expr ')' single_stmt ELSE single_stmt  */
+#line 120 "parser/parser.y"
+        { (yyval.stmt) = new_if_stmt(prog, (yyvsp[-4].expr), (yyvsp[-2].stmt), (yyvsp[0].stmt)); }
+#line 1410 "parser/parser.tab.c"
     break;
 
-  case 24:
-#line 112 "parser/parser.y"
-        { (yyval.stmt) = new_if_stmt((yyvsp[-2].expr), (yyvsp[0].stmt), NULL); }
-#line 1629 "parser/parser.tab.c"
+  case 24: /* stmt: IF '(' expr ')' single_stmt  */
+#line 122 "parser/parser.y"
+        { (yyval.stmt) = new_if_stmt(prog, (yyvsp[-2].expr), (yyvsp[0].stmt), NULL); }
+#line 1416 "parser/parser.tab.c"
     break;
 
-  case 25:
-#line 114 "parser/parser.y"
-        { (yyval.stmt) = new_while_stmt((yyvsp[-2].expr), (yyvsp[0].stmt)); }
-#line 1635 "parser/parser.tab.c"
+  case 25: /* stmt: WHILE '(' expr ')' single_stmt  */
+#line 124 "parser/parser.y"
+        { (yyval.stmt) = new_while_stmt(prog, (yyvsp[-2].expr), (yyvsp[0].stmt)); }
+#line 1422 "parser/parser.tab.c"
     break;
 
-  case 26:
-#line 116 "parser/parser.y"
-        { (yyval.stmt) = new_for_stmt((yyvsp[-6].stmt), (yyvsp[-4].expr), (yyvsp[-2].stmt), (yyvsp[0].stmt)); }
-#line 1641 "parser/parser.tab.c"
+  case 26: /* stmt: FOR '(' opt_for_init ';' opt_expr ';' opt_for_step ')' single_stmt  */
+#line 126 "parser/parser.y"
+        { (yyval.stmt) = new_for_stmt(prog, (yyvsp[-6].stmt), (yyvsp[-4].expr), (yyvsp[-2].stmt), (yyvsp[0].stmt)); }
+#line 1428 "parser/parser.tab.c"
     break;
 
-  case 27:
-#line 117 "parser/parser.y"
-                               { (yyval.stmt) = new_block_stmt((yyvsp[0].stmt_list)); }
-#line 1647 "parser/parser.tab.c"
+  case 27: /* stmt: compound_stmt  */
+#line 127 "parser/parser.y"
+                               { (yyval.stmt) = new_block_stmt(prog, (yyvsp[0].stmt_list)); }
+#line 1434 "parser/parser.tab.c"
     break;
 
-  case 28:
-#line 118 "parser/parser.y"
-                               { (yyval.stmt) = new_expr_stmt((yyvsp[-1].expr)); }
-#line 1653 "parser/parser.tab.c"
+  case 28: /* stmt: expr ';'  */
+#line 128 "parser/parser.y"
+                               { (yyval.stmt) = new_expr_stmt(prog, (yyvsp[-1].expr)); }
+#line 1440 "parser/parser.tab.c"
     break;
 
-  case 29:
-#line 123 "parser/parser.y"
+  case 29: /* opt_for_init: %empty  */
+#line 133 "parser/parser.y"
                                { (yyval.stmt) = NULL; }
-#line 1659 "parser/parser.tab.c"
+#line 1446 "parser/parser.tab.c"
     break;
 
-  case 30:
-#line 124 "parser/parser.y"
-                               { (yyval.stmt) = new_vardecl_stmt((yyvsp[-2].ident), (yyvsp[0].expr)); free((yyvsp[-2].ident)); }
-#line 1665 "parser/parser.tab.c"
+  case 30: /* opt_for_init: LET IDENT '=' expr  */
+#line 134 "parser/parser.y"
+                               { (yyval.stmt) = new_vardecl_stmt(prog, (yyvsp[-2].ident), (yyvsp[0].expr)); }
+#line 1452 "parser/parser.tab.c"
     break;
 
-  case 31:
-#line 125 "parser/parser.y"
-                               { (yyval.stmt) = new_vardecl_stmt((yyvsp[-2].ident), (yyvsp[0].expr)); free((yyvsp[-2].ident)); }
-#line 1671 "parser/parser.tab.c"
+  case 31: /* opt_for_init: VAR IDENT '=' expr  */
+#line 135 "parser/parser.y"
+                               { (yyval.stmt) = new_vardecl_stmt(prog, (yyvsp[-2].ident), (yyvsp[0].expr)); }
+#line 1458 "parser/parser.tab.c"
     break;
 
-  case 32:
-#line 126 "parser/parser.y"
-                               { (yyval.stmt) = new_assign_stmt((yyvsp[-2].ident), (yyvsp[0].expr)); free((yyvsp[-2].ident)); }
-#line 1677 "parser/parser.tab.c"
+  case 32: /* opt_for_init: IDENT '=' expr  */
+#line 136 "parser/parser.y"
+                               { (yyval.stmt) = new_assign_stmt(prog, (yyvsp[-2].ident), (yyvsp[0].expr)); }
+#line 1464 "parser/parser.tab.c"
     break;
 
-  case 33:
-#line 131 "parser/parser.y"
+  case 33: /* opt_expr: %empty  */
+#line 141 "parser/parser.y"
                                { (yyval.expr) = NULL; }
-#line 1683 "parser/parser.tab.c"
+#line 1470 "parser/parser.tab.c"
     break;
 
-  case 34:
-#line 132 "parser/parser.y"
+  case 34: /* opt_expr: expr  */
+#line 142 "parser/parser.y"
                                { (yyval.expr) = (yyvsp[0].expr); }
-#line 1689 "parser/parser.tab.c"
+#line 1476 "parser/parser.tab.c"
     break;
 
-  case 35:
-#line 137 "parser/parser.y"
+  case 35: /* opt_for_step: %empty  */
+#line 147 "parser/parser.y"
                                { (yyval.stmt) = NULL; }
-#line 1695 "parser/parser.tab.c"
+#line 1482 "parser/parser.tab.c"
     break;
 
-  case 36:
-#line 138 "parser/parser.y"
-                               { (yyval.stmt) = new_assign_stmt((yyvsp[-2].ident), (yyvsp[0].expr)); free((yyvsp[-2].ident)); }
-#line 1701 "parser/parser.tab.c"
+  case 36: /* opt_for_step: IDENT '=' expr  */
+#line 148 "parser/parser.y"
+                               { (yyval.stmt) = new_assign_stmt(prog, (yyvsp[-2].ident), (yyvsp[0].expr)); }
+#line 1488 "parser/parser.tab.c"
     break;
 
-  case 37:
-#line 143 "parser/parser.y"
-                               { (yyval.stmt) = new_block_stmt((yyvsp[0].stmt_list)); }
-#line 1707 "parser/parser.tab.c"
+  case 37: /* single_stmt: compound_stmt  */
+#line 153 "parser/parser.y"
+                               { (yyval.stmt) = new_block_stmt(prog, (yyvsp[0].stmt_list)); }
+#line 1494 "parser/parser.tab.c"
     break;
 
-  case 38:
-#line 144 "parser/parser.y"
+  case 38: /* single_stmt: vardecl ';'  */
+#line 154 "parser/parser.y"
                                { (yyval.stmt) = (yyvsp[-1].stmt); }
-#line 1713 "parser/parser.tab.c"
+#line 1500 "parser/parser.tab.c"
     break;
 
-  case 39:
-#line 145 "parser/parser.y"
+  case 39: /* single_stmt: assign_stmt ';'  */
+#line 155 "parser/parser.y"
                                { (yyval.stmt) = (yyvsp[-1].stmt); }
-#line 1719 "parser/parser.tab.c"
+#line 1506 "parser/parser.tab.c"
     break;
 
-  case 40:
-#line 146 "parser/parser.y"
-                               { (yyval.stmt) = new_return_stmt((yyvsp[-1].expr)); }
-#line 1725 "parser/parser.tab.c"
+  case 40: /* single_stmt: RETURN expr ';'  */
+#line 156 "parser/parser.y"
+                               { (yyval.stmt) = new_return_stmt(prog, (yyvsp[-1].expr)); }
+#line 1512 "parser/parser.tab.c"
     break;
 
-  case 41:
-#line 148 "parser/parser.y"
-        { (yyval.stmt) = new_print_stmt((yyvsp[-2].expr)); }
-#line 1731 "parser/parser.tab.c"
+  case 41: /* single_stmt: CONSOLE '.' LOG '(' expr ')' ';'  */
+#line 158 "parser/parser.y"
+        { (yyval.stmt) = new_print_stmt(prog, (yyvsp[-2].expr)); }
+#line 1518 "parser/parser.tab.c"
     break;
 
-  case 42:
-#line 149 "parser/parser.y"
-                               { (yyval.stmt) = new_expr_stmt((yyvsp[-1].expr)); }
-#line 1737 "parser/parser.tab.c"
+  case 42: /* single_stmt: expr ';'  */
+#line 159 "parser/parser.y"
+                               { (yyval.stmt) = new_expr_stmt(prog, (yyvsp[-1].expr)); }
+#line 1524 "parser/parser.tab.c"
     break;
 
-  case 43:
-#line 154 "parser/parser.y"
-                               { (yyval.stmt) = new_vardecl_stmt((yyvsp[0].ident), NULL); free((yyvsp[0].ident)); }
-#line 1743 "parser/parser.tab.c"
+  case 43: /* vardecl: LET IDENT  */
+#line 164 "parser/parser.y"
+                               { (yyval.stmt) = new_vardecl_stmt(prog, (yyvsp[0].ident), NULL); }
+#line 1530 "parser/parser.tab.c"
     break;
 
-  case 44:
-#line 155 "parser/parser.y"
-                               { (yyval.stmt) = new_vardecl_stmt((yyvsp[-2].ident), (yyvsp[0].expr)); free((yyvsp[-2].ident)); }
-#line 1749 "parser/parser.tab.c"
+  case 44: /* vardecl: LET IDENT '=' expr  */
+#line 165 "parser/parser.y"
+                               { (yyval.stmt) = new_vardecl_stmt(prog, (yyvsp[-2].ident), (yyvsp[0].expr)); }
+#line 1536 "parser/parser.tab.c"
     break;
 
-  case 45:
-#line 156 "parser/parser.y"
-                               { (yyval.stmt) = new_vardecl_stmt((yyvsp[0].ident), NULL); free((yyvsp[0].ident)); }
-#line 1755 "parser/parser.tab.c"
+  case 45: /* vardecl: VAR IDENT  */
+#line 166 "parser/parser.y"
+                               { (yyval.stmt) = new_vardecl_stmt(prog, (yyvsp[0].ident), NULL); }
+#line 1542 "parser/parser.tab.c"
     break;
 
-  case 46:
-#line 157 "parser/parser.y"
-                               { (yyval.stmt) = new_vardecl_stmt((yyvsp[-2].ident), (yyvsp[0].expr)); free((yyvsp[-2].ident)); }
-#line 1761 "parser/parser.tab.c"
+  case 46: /* vardecl: VAR IDENT '=' expr  */
+#line 167 "parser/parser.y"
+                               { (yyval.stmt) = new_vardecl_stmt(prog, (yyvsp[-2].ident), (yyvsp[0].expr)); }
+#line 1548 "parser/parser.tab.c"
     break;
 
-  case 47:
-#line 158 "parser/parser.y"
-                               { (yyval.stmt) = new_vardecl_stmt((yyvsp[-2].ident), (yyvsp[0].expr)); free((yyvsp[-2].ident)); }
-#line 1767 "parser/parser.tab.c"
+  case 47: /* vardecl: CONST IDENT '=' expr  */
+#line 168 "parser/parser.y"
+                               { (yyval.stmt) = new_vardecl_stmt(prog, (yyvsp[-2].ident), (yyvsp[0].expr)); }
+#line 1554 "parser/parser.tab.c"
     break;
 
-  case 48:
-#line 163 "parser/parser.y"
-                               { (yyval.stmt) = new_assign_stmt((yyvsp[-2].ident), (yyvsp[0].expr)); free((yyvsp[-2].ident)); }
-#line 1773 "parser/parser.tab.c"
+  case 48: /* assign_stmt: IDENT '=' expr  */
+#line 173 "parser/parser.y"
+                               { (yyval.stmt) = new_assign_stmt(prog, (yyvsp[-2].ident), (yyvsp[0].expr)); }
+#line 1560 "parser/parser.tab.c"
     break;
 
-  case 49:
-#line 168 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_ADD, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1779 "parser/parser.tab.c"
+  case 49: /* expr: expr '+' expr  */
+#line 178 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_ADD, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1566 "parser/parser.tab.c"
     break;
 
-  case 50:
-#line 169 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_SUB, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1785 "parser/parser.tab.c"
+  case 50: /* expr: expr '-' expr  */
+#line 179 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_SUB, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1572 "parser/parser.tab.c"
     break;
 
-  case 51:
-#line 170 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_MUL, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1791 "parser/parser.tab.c"
+  case 51: /* expr: expr '*' expr  */
+#line 180 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_MUL, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1578 "parser/parser.tab.c"
     break;
 
-  case 52:
-#line 171 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_DIV, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1797 "parser/parser.tab.c"
+  case 52: /* expr: expr '/' expr  */
+#line 181 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_DIV, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1584 "parser/parser.tab.c"
     break;
 
-  case 53:
-#line 172 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_MOD, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1803 "parser/parser.tab.c"
+  case 53: /* expr: expr '%' expr  */
+#line 182 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_MOD, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1590 "parser/parser.tab.c"
     break;
 
-  case 54:
-#line 173 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_LT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1809 "parser/parser.tab.c"
+  case 54: /* expr: expr '<' expr  */
+#line 183 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_LT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1596 "parser/parser.tab.c"
     break;
 
-  case 55:
-#line 174 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_GT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1815 "parser/parser.tab.c"
+  case 55: /* expr: expr '>' expr  */
+#line 184 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_GT, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1602 "parser/parser.tab.c"
     break;
 
-  case 56:
-#line 175 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_LE, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1821 "parser/parser.tab.c"
+  case 56: /* expr: expr LE expr  */
+#line 185 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_LE, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1608 "parser/parser.tab.c"
     break;
 
-  case 57:
-#line 176 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_GE, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1827 "parser/parser.tab.c"
+  case 57: /* expr: expr GE expr  */
+#line 186 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_GE, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1614 "parser/parser.tab.c"
     break;
 
-  case 58:
-#line 177 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_EQ, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1833 "parser/parser.tab.c"
+  case 58: /* expr: expr EQ expr  */
+#line 187 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_EQ, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1620 "parser/parser.tab.c"
     break;
 
-  case 59:
-#line 178 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_NE, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1839 "parser/parser.tab.c"
+  case 59: /* expr: expr NE expr  */
+#line 188 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_NE, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1626 "parser/parser.tab.c"
     break;
 
-  case 60:
-#line 179 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_AND, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1845 "parser/parser.tab.c"
+  case 60: /* expr: expr AND expr  */
+#line 189 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_AND, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1632 "parser/parser.tab.c"
     break;
 
-  case 61:
-#line 180 "parser/parser.y"
-                               { (yyval.expr) = new_binop_expr(BIN_OR, (yyvsp[-2].expr), (yyvsp[0].expr)); }
-#line 1851 "parser/parser.tab.c"
+  case 61: /* expr: expr OR expr  */
+#line 190 "parser/parser.y"
+                               { (yyval.expr) = new_binop_expr(prog, BIN_OR, (yyvsp[-2].expr), (yyvsp[0].expr)); }
+#line 1638 "parser/parser.tab.c"
     break;
 
-  case 62:
-#line 181 "parser/parser.y"
-                               { (yyval.expr) = new_unary_expr(UNARY_NEG, (yyvsp[0].expr)); }
-#line 1857 "parser/parser.tab.c"
+  case 62: /* expr: '-' expr  */
+#line 191 "parser/parser.y"
+                               { (yyval.expr) = new_unary_expr(prog, UNARY_NEG, (yyvsp[0].expr)); }
+#line 1644 "parser/parser.tab.c"
     break;
 
-  case 63:
-#line 182 "parser/parser.y"
-                               { (yyval.expr) = new_unary_expr(UNARY_NOT, (yyvsp[0].expr)); }
-#line 1863 "parser/parser.tab.c"
+  case 63: /* expr: '!' expr  */
+#line 192 "parser/parser.y"
+                               { (yyval.expr) = new_unary_expr(prog, UNARY_NOT, (yyvsp[0].expr)); }
+#line 1650 "parser/parser.tab.c"
     break;
 
-  case 64:
-#line 183 "parser/parser.y"
+  case 64: /* expr: primary  */
+#line 193 "parser/parser.y"
                                { (yyval.expr) = (yyvsp[0].expr); }
-#line 1869 "parser/parser.tab.c"
+#line 1656 "parser/parser.tab.c"
     break;
 
-  case 65:
-#line 188 "parser/parser.y"
-                               { (yyval.expr) = new_int_expr((yyvsp[0].int_value)); }
-#line 1875 "parser/parser.tab.c"
+  case 65: /* primary: NUMBER  */
+#line 198 "parser/parser.y"
+                               { (yyval.expr) = new_int_expr(prog, (yyvsp[0].int_value)); }
+#line 1662 "parser/parser.tab.c"
     break;
 
-  case 66:
-#line 189 "parser/parser.y"
-                               { (yyval.expr) = new_string_expr((yyvsp[0].ident)); free((yyvsp[0].ident)); }
-#line 1881 "parser/parser.tab.c"
+  case 66: /* primary: STRING  */
+#line 199 "parser/parser.y"
+                               { (yyval.expr) = new_string_expr(prog, (yyvsp[0].str)); }
+#line 1668 "parser/parser.tab.c"
     break;
 
-  case 67:
-#line 190 "parser/parser.y"
-                               { (yyval.expr) = new_var_expr((yyvsp[0].ident)); free((yyvsp[0].ident)); }
-#line 1887 "parser/parser.tab.c"
+  case 67: /* primary: IDENT  */
+#line 200 "parser/parser.y"
+                               { (yyval.expr) = new_var_expr(prog, (yyvsp[0].ident)); }
+#line 1674 "parser/parser.tab.c"
     break;
 
-  case 68:
-#line 191 "parser/parser.y"
+  case 68: /* primary: call_expr  */
+#line 201 "parser/parser.y"
                                { (yyval.expr) = (yyvsp[0].expr); }
-#line 1893 "parser/parser.tab.c"
+#line 1680 "parser/parser.tab.c"
     break;
 
-  case 69:
-#line 192 "parser/parser.y"
+  case 69: /* primary: '(' expr ')'  */
+#line 202 "parser/parser.y"
                                { (yyval.expr) = (yyvsp[-1].expr); }
-#line 1899 "parser/parser.tab.c"
+#line 1686 "parser/parser.tab.c"
     break;
 
-  case 70:
-#line 198 "parser/parser.y"
-        { (yyval.expr) = new_call_expr((yyvsp[-3].ident), (yyvsp[-1].expr_list)); free((yyvsp[-3].ident)); }
-#line 1905 "parser/parser.tab.c"
+  case 70: /* call_expr: IDENT '(' arg_list_opt ')'  */
+#line 208 "parser/parser.y"
+        { (yyval.expr) = new_call_expr(prog, (yyvsp[-3].ident), (yyvsp[-1].expr_list)); }
+#line 1692 "parser/parser.tab.c"
     break;
 
-  case 71:
-#line 202 "parser/parser.y"
+  case 71: /* arg_list_opt: %empty  */
+#line 212 "parser/parser.y"
                                { (yyval.expr_list) = NULL; }
-#line 1911 "parser/parser.tab.c"
+#line 1698 "parser/parser.tab.c"
     break;
 
-  case 72:
-#line 203 "parser/parser.y"
+  case 72: /* arg_list_opt: arg_list  */
+#line 213 "parser/parser.y"
                                { (yyval.expr_list) = (yyvsp[0].expr_list); }
-#line 1917 "parser/parser.tab.c"
+#line 1704 "parser/parser.tab.c"
     break;
 
-  case 73:
-#line 207 "parser/parser.y"
-                               { (yyval.expr_list) = expr_list_append(NULL, (yyvsp[0].expr)); }
-#line 1923 "parser/parser.tab.c"
+  case 73: /* arg_list: expr  */
+#line 217 "parser/parser.y"
+                               { (yyval.expr_list) = expr_list_append(prog, NULL, (yyvsp[0].expr)); }
+#line 1710 "parser/parser.tab.c"
     break;
 
-  case 74:
-#line 208 "parser/parser.y"
-                               { (yyval.expr_list) = expr_list_append((yyvsp[-2].expr_list), (yyvsp[0].expr)); }
-#line 1929 "parser/parser.tab.c"
+  case 74: /* arg_list: arg_list ',' expr  */
+#line 218 "parser/parser.y"
+                               { (yyval.expr_list) = expr_list_append(prog, (yyvsp[-2].expr_list), (yyvsp[0].expr)); }
+#line 1716 "parser/parser.tab.c"
     break;
 
 
-#line 1933 "parser/parser.tab.c"
+#line 1720 "parser/parser.tab.c"
 
       default: break;
     }
@@ -1944,11 +1731,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
@@ -1972,50 +1758,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (scanner, prog, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2030,7 +1780,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, scanner, prog);
           yychar = YYEMPTY;
         }
     }
@@ -2048,6 +1798,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2064,13 +1815,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2084,7 +1836,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, prog);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2096,7 +1848,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2107,7 +1859,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2115,31 +1867,29 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (scanner, prog, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, scanner, prog);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2148,22 +1898,22 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, prog);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 211 "parser/parser.y"
 
-
-void yyerror(const char *s) {
-    fprintf(stderr, "Parse error: %s\n", s);
-}
+#line 221 "parser/parser.y"
+
+
+void yyerror(yyscan_t scanner, Program *prog, const char *s) {
+    (void)scanner;
+    (void)prog;
+    fprintf(stderr, "Parse error: %s\n", s);
+}
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -31,8 +31,9 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
 #ifndef YY_YY_PARSER_PARSER_TAB_H_INCLUDED
 # define YY_YY_PARSER_PARSER_TAB_H_INCLUDED
@@ -43,54 +44,71 @@
 #if YYDEBUG
 extern int yydebug;
 #endif
-
-/* Token type.  */
+/* "%code requires" blocks.  */
+#line 1 "parser/parser.y"
+
+/* Mini-JavaScript Parser
+ * JavaScript 스타일 문법 지원
+ * 순수(pure) 파서: 스캐너와 결과 Program을 인자로 받으므로 전역 상태 없음
+ */
+#include "ast.h"
+#include "scanner.h"
+
+#line 58 "parser/parser.tab.h"
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    FUNCTION = 258,
-    LET = 259,
-    VAR = 260,
-    CONST = 261,
-    RETURN = 262,
-    IF = 263,
-    ELSE = 264,
-    WHILE = 265,
-    FOR = 266,
-    CONSOLE = 267,
-    LOG = 268,
-    EQ = 269,
-    NE = 270,
-    LE = 271,
-    GE = 272,
-    AND = 273,
-    OR = 274,
-    NUMBER = 275,
-    IDENT = 276,
-    STRING = 277,
-    UMINUS = 278,
-    UNOT = 279
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    FUNCTION = 258,                /* FUNCTION  */
+    LET = 259,                     /* LET  */
+    VAR = 260,                     /* VAR  */
+    CONST = 261,                   /* CONST  */
+    RETURN = 262,                  /* RETURN  */
+    IF = 263,                      /* IF  */
+    ELSE = 264,                    /* ELSE  */
+    WHILE = 265,                   /* WHILE  */
+    FOR = 266,                     /* FOR  */
+    CONSOLE = 267,                 /* CONSOLE  */
+    LOG = 268,                     /* LOG  */
+    EQ = 269,                      /* EQ  */
+    NE = 270,                      /* NE  */
+    LE = 271,                      /* LE  */
+    GE = 272,                      /* GE  */
+    AND = 273,                     /* AND  */
+    OR = 274,                      /* OR  */
+    NUMBER = 275,                  /* NUMBER  */
+    IDENT = 276,                   /* IDENT  */
+    STRING = 277,                  /* STRING  */
+    UMINUS = 278,                  /* UMINUS  */
+    UNOT = 279                     /* UNOT  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 13 "parser/parser.y"
-
-    int int_value;
-    char *ident;
-    Expr *expr;
-    ExprList *expr_list;
-    Stmt *stmt;
-    StmtList *stmt_list;
-    ParamList *param_list;
-    Function *function;
-    FunctionList *function_list;
-
-#line 94 "parser/parser.tab.h"
+#line 22 "parser/parser.y"
+
+    int int_value;
+    char *ident;
+    StrView str;
+    Expr *expr;
+    ExprList *expr_list;
+    Stmt *stmt;
+    StmtList *stmt_list;
+    ParamList *param_list;
+    Function *function;
+    FunctionList *function_list;
+
+#line 112 "parser/parser.tab.h"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -99,8 +117,9 @@ typedef union YYSTYPE YYSTYPE;
 #endif
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+
+int yyparse (yyscan_t scanner, Program *prog);
+
 
 #endif /* !YY_YY_PARSER_PARSER_TAB_H_INCLUDED  */
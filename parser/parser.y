@@ -1,18 +1,28 @@
-%{
+%code requires {
 /* Mini-JavaScript Parser
  * JavaScript 스타일 문법 지원
+ * 순수(pure) 파서: 스캐너와 결과 Program을 인자로 받으므로 전역 상태 없음
  */
+#include "ast.h"
+#include "scanner.h"
+}
+
+%code {
 #include <stdio.h>
 #include <stdlib.h>
-#include "ast.h"
 
-int yylex(void);
-void yyerror(const char *s);
-%}
+int yylex(YYSTYPE *yylval_param, yyscan_t yyscanner, Program *prog);
+void yyerror(yyscan_t scanner, Program *prog, const char *s);
+}
+
+%define api.pure full
+%lex-param {yyscan_t scanner} {Program *prog}
+%parse-param {yyscan_t scanner} {Program *prog}
 
 %union {
     int int_value;
     char *ident;
+    StrView str;
     Expr *expr;
     ExprList *expr_list;
     Stmt *stmt;
@@ -29,7 +39,7 @@ void yyerror(const char *s);
 %token EQ NE LE GE AND OR
 %token <int_value> NUMBER
 %token <ident> IDENT
-%token <ident> STRING
+%token <str> STRING
 
 /* 타입 정의 */
 %type <expr> expr primary call_expr opt_expr
@@ -52,7 +62,7 @@ void yyerror(const char *s);
 
 /* 프로그램: top-level 항목들 */
 program
-    : program_items            { /* g_program은 이미 조작됨 */ }
+    : program_items            { /* prog는 이미 조작됨 */ }
     ;
 
 program_items
@@ -62,14 +72,14 @@ program_items
     ;
 
 program_item
-    : function  { program_add_function(g_program, $1); }
-    | stmt      { program_add_stmt(g_program, $1); }
+    : function  { program_add_function(prog, $1); }
+    | stmt      { program_add_stmt(prog, $1); }
     ;
 
 /* 함수 정의: function name(params) { body } */
 function
     : FUNCTION IDENT '(' param_list_opt ')' compound_stmt
-        { $$ = new_function($2, $4, $6); free($2); }
+        { $$ = new_function(prog, $2, $4, $6); }
     ;
 
 param_list_opt
@@ -79,8 +89,8 @@ param_list_opt
 
 /* 매개변수 리스트: a, b, c */
 param_list
-    : IDENT                    { $$ = param_list_append(NULL, $1); free($1); }
-    | param_list ',' IDENT     { $$ = param_list_append($1, $3); free($3); }
+    : IDENT                    { $$ = param_list_append(prog, NULL, $1); }
+    | param_list ',' IDENT     { $$ = param_list_append(prog, $1, $3); }
     ;
 
 /* 복합문: { stmt_list } */
@@ -94,36 +104,36 @@ stmt_list_opt
     ;
 
 stmt_list
-    : stmt_list stmt           { $$ = stmt_list_append($1, $2); }
-    | stmt                     { $$ = stmt_list_append(NULL, $1); }
+    : stmt_list stmt           { $$ = stmt_list_append(prog, $1, $2); }
+    | stmt                     { $$ = stmt_list_append(prog, NULL, $1); }
     ;
 
 /* 문장 */
 stmt
     : vardecl ';'              { $$ = $1; }
     | assign_stmt ';'          { $$ = $1; }
-    | RETURN expr ';'          { $$ = new_return_stmt($2); }
-    | RETURN ';'               { $$ = new_return_stmt(NULL); }
+    | RETURN expr ';'          { $$ = new_return_stmt(prog, $2); }
+    | RETURN ';'               { $$ = new_return_stmt(prog, NULL); }
     | CONSOLE '.' LOG '(' expr ')' ';'
-        { $$ = new_print_stmt($5); }
+        { $$ = new_print_stmt(prog, $5); }
     | IF '(' expr ')' single_stmt ELSE single_stmt
-        { $$ = new_if_stmt($3, $5, $7); }
+        { $$ = new_if_stmt(prog, $3, $5, $7); }
     | IF '(' expr ')' single_stmt
-        { $$ = new_if_stmt($3, $5, NULL); }
+        { $$ = new_if_stmt(prog, $3, $5, NULL); }
     | WHILE '(' expr ')' single_stmt
-        { $$ = new_while_stmt($3, $5); }
+        { $$ = new_while_stmt(prog, $3, $5); }
     | FOR '(' opt_for_init ';' opt_expr ';' opt_for_step ')' single_stmt
-        { $$ = new_for_stmt($3, $5, $7, $9); }
-    | compound_stmt            { $$ = new_block_stmt($1); }
-    | expr ';'                 { $$ = new_expr_stmt($1); }
+        { $$ = new_for_stmt(prog, $3, $5, $7, $9); }
+    | compound_stmt            { $$ = new_block_stmt(prog, $1); }
+    | expr ';'                 { $$ = new_expr_stmt(prog, $1); }
     ;
 
 /* for문 초기화 */
 opt_for_init
     : /* empty */              { $$ = NULL; }
-    | LET IDENT '=' expr       { $$ = new_vardecl_stmt($2, $4); free($2); }
-    | VAR IDENT '=' expr       { $$ = new_vardecl_stmt($2, $4); free($2); }
-    | IDENT '=' expr           { $$ = new_assign_stmt($1, $3); free($1); }
+    | LET IDENT '=' expr       { $$ = new_vardecl_stmt(prog, $2, $4); }
+    | VAR IDENT '=' expr       { $$ = new_vardecl_stmt(prog, $2, $4); }
+    | IDENT '=' expr           { $$ = new_assign_stmt(prog, $1, $3); }
     ;
 
 /* for문 조건 */
@@ -135,59 +145,59 @@ opt_expr
 /* for문 스텝 */
 opt_for_step
     : /* empty */              { $$ = NULL; }
-    | IDENT '=' expr           { $$ = new_assign_stmt($1, $3); free($1); }
+    | IDENT '=' expr           { $$ = new_assign_stmt(prog, $1, $3); }
     ;
 
 /* 단일 문장 (if/while/for 바디용) */
 single_stmt
-    : compound_stmt            { $$ = new_block_stmt($1); }
+    : compound_stmt            { $$ = new_block_stmt(prog, $1); }
     | vardecl ';'              { $$ = $1; }
     | assign_stmt ';'          { $$ = $1; }
-    | RETURN expr ';'          { $$ = new_return_stmt($2); }
+    | RETURN expr ';'          { $$ = new_return_stmt(prog, $2); }
     | CONSOLE '.' LOG '(' expr ')' ';'
-        { $$ = new_print_stmt($5); }
-    | expr ';'                 { $$ = new_expr_stmt($1); }
+        { $$ = new_print_stmt(prog, $5); }
+    | expr ';'                 { $$ = new_expr_stmt(prog, $1); }
     ;
 
 /* 변수 선언 */
 vardecl
-    : LET IDENT                { $$ = new_vardecl_stmt($2, NULL); free($2); }
-    | LET IDENT '=' expr       { $$ = new_vardecl_stmt($2, $4); free($2); }
-    | VAR IDENT                { $$ = new_vardecl_stmt($2, NULL); free($2); }
-    | VAR IDENT '=' expr       { $$ = new_vardecl_stmt($2, $4); free($2); }
-    | CONST IDENT '=' expr     { $$ = new_vardecl_stmt($2, $4); free($2); }
+    : LET IDENT                { $$ = new_vardecl_stmt(prog, $2, NULL); }
+    | LET IDENT '=' expr       { $$ = new_vardecl_stmt(prog, $2, $4); }
+    | VAR IDENT                { $$ = new_vardecl_stmt(prog, $2, NULL); }
+    | VAR IDENT '=' expr       { $$ = new_vardecl_stmt(prog, $2, $4); }
+    | CONST IDENT '=' expr     { $$ = new_vardecl_stmt(prog, $2, $4); }
     ;
 
 /* 대입문 */
 assign_stmt
-    : IDENT '=' expr           { $$ = new_assign_stmt($1, $3); free($1); }
+    : IDENT '=' expr           { $$ = new_assign_stmt(prog, $1, $3); }
     ;
 
 /* 표현식 */
 expr
-    : expr '+' expr            { $$ = new_binop_expr(BIN_ADD, $1, $3); }
-    | expr '-' expr            { $$ = new_binop_expr(BIN_SUB, $1, $3); }
-    | expr '*' expr            { $$ = new_binop_expr(BIN_MUL, $1, $3); }
-    | expr '/' expr            { $$ = new_binop_expr(BIN_DIV, $1, $3); }
-    | expr '%' expr            { $$ = new_binop_expr(BIN_MOD, $1, $3); }
-    | expr '<' expr            { $$ = new_binop_expr(BIN_LT, $1, $3); }
-    | expr '>' expr            { $$ = new_binop_expr(BIN_GT, $1, $3); }
-    | expr LE expr             { $$ = new_binop_expr(BIN_LE, $1, $3); }
-    | expr GE expr             { $$ = new_binop_expr(BIN_GE, $1, $3); }
-    | expr EQ expr             { $$ = new_binop_expr(BIN_EQ, $1, $3); }
-    | expr NE expr             { $$ = new_binop_expr(BIN_NE, $1, $3); }
-    | expr AND expr            { $$ = new_binop_expr(BIN_AND, $1, $3); }
-    | expr OR expr             { $$ = new_binop_expr(BIN_OR, $1, $3); }
-    | '-' expr %prec UMINUS    { $$ = new_unary_expr(UNARY_NEG, $2); }
-    | '!' expr %prec UNOT      { $$ = new_unary_expr(UNARY_NOT, $2); }
+    : expr '+' expr            { $$ = new_binop_expr(prog, BIN_ADD, $1, $3); }
+    | expr '-' expr            { $$ = new_binop_expr(prog, BIN_SUB, $1, $3); }
+    | expr '*' expr            { $$ = new_binop_expr(prog, BIN_MUL, $1, $3); }
+    | expr '/' expr            { $$ = new_binop_expr(prog, BIN_DIV, $1, $3); }
+    | expr '%' expr            { $$ = new_binop_expr(prog, BIN_MOD, $1, $3); }
+    | expr '<' expr            { $$ = new_binop_expr(prog, BIN_LT, $1, $3); }
+    | expr '>' expr            { $$ = new_binop_expr(prog, BIN_GT, $1, $3); }
+    | expr LE expr             { $$ = new_binop_expr(prog, BIN_LE, $1, $3); }
+    | expr GE expr             { $$ = new_binop_expr(prog, BIN_GE, $1, $3); }
+    | expr EQ expr             { $$ = new_binop_expr(prog, BIN_EQ, $1, $3); }
+    | expr NE expr             { $$ = new_binop_expr(prog, BIN_NE, $1, $3); }
+    | expr AND expr            { $$ = new_binop_expr(prog, BIN_AND, $1, $3); }
+    | expr OR expr             { $$ = new_binop_expr(prog, BIN_OR, $1, $3); }
+    | '-' expr %prec UMINUS    { $$ = new_unary_expr(prog, UNARY_NEG, $2); }
+    | '!' expr %prec UNOT      { $$ = new_unary_expr(prog, UNARY_NOT, $2); }
     | primary                  { $$ = $1; }
     ;
 
 /* 기본 표현식 */
 primary
-    : NUMBER                   { $$ = new_int_expr($1); }
-    | STRING                   { $$ = new_string_expr($1); free($1); }
-    | IDENT                    { $$ = new_var_expr($1); free($1); }
+    : NUMBER                   { $$ = new_int_expr(prog, $1); }
+    | STRING                   { $$ = new_string_expr(prog, $1); }
+    | IDENT                    { $$ = new_var_expr(prog, $1); }
     | call_expr                { $$ = $1; }
     | '(' expr ')'             { $$ = $2; }
     ;
@@ -195,7 +205,7 @@ primary
 /* 함수 호출 */
 call_expr
     : IDENT '(' arg_list_opt ')'
-        { $$ = new_call_expr($1, $3); free($1); }
+        { $$ = new_call_expr(prog, $1, $3); }
     ;
 
 arg_list_opt
@@ -204,12 +214,14 @@ arg_list_opt
     ;
 
 arg_list
-    : expr                     { $$ = expr_list_append(NULL, $1); }
-    | arg_list ',' expr        { $$ = expr_list_append($1, $3); }
+    : expr                     { $$ = expr_list_append(prog, NULL, $1); }
+    | arg_list ',' expr        { $$ = expr_list_append(prog, $1, $3); }
     ;
 
 %%
 
-void yyerror(const char *s) {
+void yyerror(yyscan_t scanner, Program *prog, const char *s) {
+    (void)scanner;
+    (void)prog;
     fprintf(stderr, "Parse error: %s\n", s);
 }
@@ -0,0 +1,433 @@
+/* 누산기 도입 (선형 재귀 → 꼬리 재귀)
+ * 함수마다 return문의 자기 호출 모양을 검사하고, 조건이 맞으면
+ * 본문을 누산기 매개변수를 받는 도우미 함수로 옮긴 뒤 원래 함수는 도우미를 한 번 호출
+ * 실행 전 AST만 바꾸므로 인터프리터/VM/JIT/네이티브 모두 같은 프로그램을 실행
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "accum.h"
+#include "dce.h"
+
+#define ACC_NAME ".acc"         /* 누산기 매개변수 (소스에서 쓸 수 없는 이름) */
+#define ACC_SUFFIX ".acc"       /* 도우미 함수 이름 = 원래 이름 + 접미사 */
+
+/* === 검사 === */
+
+typedef struct {
+    Function *f;
+    int nparams;
+    int recursive;          /* 자기 호출이 있음 */
+    int combined;           /* e OP f(...) 꼴의 return 수 */
+    BinOpKind op;           /* 결합 연산 (combined > 0일 때) */
+    const char *reason;     /* 바꿀 수 없는 이유 (첫 번째만) */
+} Candidate;
+
+static void reject(Candidate *c, const char *reason) {
+    if (!c->reason) c->reason = reason;
+}
+
+static int is_self_call(const Candidate *c, const Expr *e) {
+    return e && e->kind == EXPR_CALL && e->u.call.func_name == c->f->name;
+}
+
+static int mentions_self(const Candidate *c, const Expr *e) {
+    if (!e) return 0;
+    switch (e->kind) {
+        case EXPR_BINOP:
+            return mentions_self(c, e->u.binop.lhs) || mentions_self(c, e->u.binop.rhs);
+        case EXPR_UNARY:
+            return mentions_self(c, e->u.unary.operand);
+        case EXPR_CALL:
+            if (is_self_call(c, e)) return 1;
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                if (mentions_self(c, arg->expr)) return 1;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+static int has_call(const Expr *e) {
+    if (!e) return 0;
+    switch (e->kind) {
+        case EXPR_BINOP:
+            return has_call(e->u.binop.lhs) || has_call(e->u.binop.rhs);
+        case EXPR_UNARY:
+            return has_call(e->u.unary.operand);
+        case EXPR_CALL:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int is_param(const Candidate *c, const char *name) {
+    for (Param *p = c->f->params ? c->f->params->head : NULL; p; p = p->next) {
+        if (p->name == name) return 1;
+    }
+    return 0;
+}
+
+/* 자기 호출 전후로 값이 같고 에러도 출력하지 않는 식 (상수, 매개변수, / % 이외의 연산)
+ * 호출된 쪽은 매개변수를 자기 프레임에 새로 만들므로 호출자의 매개변수를 바꿀 수 없음 */
+static int invariant_expr(const Candidate *c, const Expr *e) {
+    if (!e) return 1;
+    switch (e->kind) {
+        case EXPR_INT:
+            return 1;
+        case EXPR_VAR:
+            return is_param(c, e->u.var_name);
+        case EXPR_UNARY:
+            return invariant_expr(c, e->u.unary.operand);
+        case EXPR_BINOP:
+            if (e->u.binop.op == BIN_DIV || e->u.binop.op == BIN_MOD) return 0;
+            return invariant_expr(c, e->u.binop.lhs) && invariant_expr(c, e->u.binop.rhs);
+        default:
+            return 0;
+    }
+}
+
+/* no_calls: 결합할 식을 호출보다 먼저 계산하게 되는 경우 (인자 안의 호출 금지) */
+static void check_self_call(Candidate *c, const Expr *call, int no_calls) {
+    int argc = 0;
+    for (ExprList *arg = call->u.call.args; arg; arg = arg->next) {
+        if (mentions_self(c, arg->expr)) reject(c, "self call inside a self call's arguments");
+        if (no_calls && has_call(arg->expr)) {
+            reject(c, "operand moved before a self call whose arguments make calls");
+        }
+        argc++;
+    }
+    if (argc < c->nparams) reject(c, "self call passes fewer arguments than parameters");
+}
+
+static void check_return(Candidate *c, const Expr *e) {
+    if (!mentions_self(c, e)) return;
+    c->recursive = 1;
+    if (is_self_call(c, e)) {
+        check_self_call(c, e, 0);
+        return;
+    }
+    if (e->kind != EXPR_BINOP) {
+        reject(c, "self call nested inside an expression");
+        return;
+    }
+
+    const Expr *lhs = e->u.binop.lhs;
+    const Expr *rhs = e->u.binop.rhs;
+    int call_on_rhs = is_self_call(c, rhs) && !mentions_self(c, lhs);
+    int call_on_lhs = is_self_call(c, lhs) && !mentions_self(c, rhs);
+    if (!call_on_rhs && !call_on_lhs) {
+        reject(c, mentions_self(c, lhs) && mentions_self(c, rhs)
+                      ? "more than one self call in a return"
+                      : "self call nested inside an expression");
+        return;
+    }
+    if (e->u.binop.op != BIN_ADD && e->u.binop.op != BIN_MUL) {
+        reject(c, "self call combined with an operator other than + or *");
+        return;
+    }
+    if (c->combined > 0 && c->op != e->u.binop.op) {
+        reject(c, "returns mix + and *");
+        return;
+    }
+    c->op = e->u.binop.op;
+    c->combined++;
+
+    if (call_on_rhs) {
+        /* e OP f(...): e는 원래대로 인자보다 먼저 계산됨 */
+        check_self_call(c, rhs, 0);
+    } else {
+        /* f(...) OP e: e를 호출 전에 계산 */
+        if (!invariant_expr(c, rhs)) {
+            reject(c, "operand after a self call is not built from constants and parameters");
+        }
+        check_self_call(c, lhs, 1);
+    }
+}
+
+static void check_expr(Candidate *c, const Expr *e) {
+    if (mentions_self(c, e)) {
+        c->recursive = 1;
+        reject(c, "self call outside a return statement");
+    }
+}
+
+static void check_stmt(Candidate *c, Stmt *s) {
+    if (!s) return;
+    switch (s->kind) {
+        case STMT_VARDECL:
+            check_expr(c, s->u.vardecl.init_value);
+            break;
+        case STMT_ASSIGN:
+            check_expr(c, s->u.assign.value);
+            break;
+        case STMT_EXPR:
+        case STMT_PRINT:
+            check_expr(c, s->u.expr);
+            break;
+        case STMT_RETURN:
+            check_return(c, s->u.expr);
+            break;
+        case STMT_IF:
+            check_expr(c, s->u.if_stmt.cond);
+            check_stmt(c, s->u.if_stmt.then_stmt);
+            check_stmt(c, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            check_expr(c, s->u.while_stmt.cond);
+            check_stmt(c, s->u.while_stmt.body);
+            break;
+        case STMT_FOR:
+            check_stmt(c, s->u.for_stmt.init);
+            check_expr(c, s->u.for_stmt.cond);
+            check_stmt(c, s->u.for_stmt.step);
+            check_stmt(c, s->u.for_stmt.body);
+            break;
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                check_stmt(c, b);
+            }
+            break;
+    }
+}
+
+static void check_function(Candidate *c, Function *f) {
+    memset(c, 0, sizeof(*c));
+    c->f = f;
+    for (Param *p = f->params ? f->params->head : NULL; p; p = p->next) c->nparams++;
+    for (Stmt *s = f->body ? f->body->head : NULL; s; s = s->next) {
+        check_stmt(c, s);
+    }
+    if (c->recursive && c->nparams > ACCUM_MAX_PARAMS) reject(c, "too many parameters");
+    if (c->recursive && c->combined == 0) reject(c, "only plain tail calls (already a loop)");
+}
+
+/* === 변환 === */
+
+typedef struct {
+    Program *prog;
+    const Candidate *c;
+    const char *helper;     /* 도우미 함수 이름 (아레나) */
+} Rewriter;
+
+static Expr *acc_var(Rewriter *w) {
+    return new_var_expr(w->prog, ACC_NAME);
+}
+
+/* 자기 호출을 도우미 호출로: 누산기 인자를 맨 앞에 (원래 인자보다 먼저 계산) */
+static Expr *retarget_call(Rewriter *w, Expr *call, Expr *acc) {
+    ExprList *first = expr_list_append(w->prog, NULL, acc);
+    first->next = call->u.call.args;
+    call->u.call.args = first;
+    call->u.call.func_name = (char *)w->helper;
+    return call;
+}
+
+static void rewrite_return(Rewriter *w, Stmt *s) {
+    Expr *e = s->u.expr;
+    BinOpKind op = w->c->op;
+    if (is_self_call(w->c, e)) {
+        /* f(...) → f.acc(.acc, ...) */
+        retarget_call(w, e, acc_var(w));
+    } else if (mentions_self(w->c, e)) {
+        /* e OP f(...), f(...) OP e → f.acc(.acc OP e, ...) */
+        int call_on_rhs = is_self_call(w->c, e->u.binop.rhs);
+        Expr *call = call_on_rhs ? e->u.binop.rhs : e->u.binop.lhs;
+        Expr *other = call_on_rhs ? e->u.binop.lhs : e->u.binop.rhs;
+        s->u.expr = retarget_call(w, call, new_binop_expr(w->prog, op, acc_var(w), other));
+    } else {
+        /* 재귀 끝: return e → return .acc OP e */
+        s->u.expr = new_binop_expr(w->prog, op, acc_var(w), e ? e : new_int_expr(w->prog, 0));
+    }
+}
+
+static void rewrite_stmt(Rewriter *w, Stmt *s) {
+    if (!s) return;
+    switch (s->kind) {
+        case STMT_RETURN:
+            rewrite_return(w, s);
+            break;
+        case STMT_IF:
+            rewrite_stmt(w, s->u.if_stmt.then_stmt);
+            rewrite_stmt(w, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            rewrite_stmt(w, s->u.while_stmt.body);
+            break;
+        case STMT_FOR:
+            rewrite_stmt(w, s->u.for_stmt.body);
+            break;
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                rewrite_stmt(w, b);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* f의 본문을 도우미로 옮기고 f는 항등원으로 도우미를 호출 */
+static Function *rewrite_function(Program *prog, const Candidate *c) {
+    Function *f = c->f;
+    size_t len = strlen(f->name);
+    char *name = (char *)malloc(len + sizeof(ACC_SUFFIX));
+    memcpy(name, f->name, len);
+    memcpy(name + len, ACC_SUFFIX, sizeof(ACC_SUFFIX));
+
+    ParamList *params = param_list_append(prog, NULL, ACC_NAME);
+    ExprList *args = expr_list_append(prog, NULL, new_int_expr(prog, c->op == BIN_MUL ? 1 : 0));
+    for (Param *p = f->params ? f->params->head : NULL; p; p = p->next) {
+        params = param_list_append(prog, params, p->name);
+        args = expr_list_append(prog, args, new_var_expr(prog, p->name));
+    }
+
+    Function *helper = new_function(prog, name, params, f->body);
+    free(name);
+
+    Rewriter w = { prog, c, helper->name };
+    for (Stmt *s = helper->body ? helper->body->head : NULL; s; s = s->next) {
+        rewrite_stmt(&w, s);
+    }
+    /* 본문 끝에 닿으면 원래 함수는 0을 반환 (닿을 수 없으면 DCE가 사용자 코드로 세지 않도록 생략) */
+    int returns = 0;
+    for (Stmt *s = helper->body ? helper->body->head : NULL; s; s = s->next) {
+        if (dce_always_returns(s)) returns = 1;
+    }
+    if (!returns) {
+        Stmt *fallthrough = new_return_stmt(prog, new_binop_expr(prog, c->op, acc_var(&w),
+                                                                 new_int_expr(prog, 0)));
+        helper->body = stmt_list_append(prog, helper->body, fallthrough);
+    }
+
+    f->body = stmt_list_append(prog, NULL, new_return_stmt(prog, new_call_expr(prog, w.helper, args)));
+    return helper;
+}
+
+/* === 프로그램 === */
+
+/* 호출 검사: 같은 이름의 첫 정의만 호출되므로 나머지는 건너뜀 */
+typedef struct {
+    FuncTable defs;             /* 호출 대상 (이름 → 첫 정의) */
+    unsigned char *short_call;  /* Function.index → 인자가 매개변수보다 적은 호출이 있음 */
+} CallScan;
+
+/* 인자가 모자란 호출 찾기
+ * 빠진 매개변수는 호출자 스코프에서 조회되므로 (resolve.c) 감싸는 함수가 그 값을 한 번 읽어
+ * 도우미에 넘기면 에러 메시지의 수와 순서가 바뀜 → 그런 함수는 바꾸지 않음 */
+static void scan_expr(CallScan *t, const Expr *e) {
+    if (!e) return;
+    switch (e->kind) {
+        case EXPR_BINOP:
+            scan_expr(t, e->u.binop.lhs);
+            scan_expr(t, e->u.binop.rhs);
+            break;
+        case EXPR_UNARY:
+            scan_expr(t, e->u.unary.operand);
+            break;
+        case EXPR_CALL: {
+            int argc = 0;
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                scan_expr(t, arg->expr);
+                argc++;
+            }
+            Function *f = func_table_find(&t->defs, e->u.call.func_name);
+            if (!f) break;
+            int nparams = 0;
+            for (Param *p = f->params ? f->params->head : NULL; p; p = p->next) nparams++;
+            if (argc < nparams) t->short_call[f->index] = 1;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void scan_stmt(CallScan *t, const Stmt *s) {
+    if (!s) return;
+    switch (s->kind) {
+        case STMT_VARDECL:
+            scan_expr(t, s->u.vardecl.init_value);
+            break;
+        case STMT_ASSIGN:
+            scan_expr(t, s->u.assign.value);
+            break;
+        case STMT_EXPR:
+        case STMT_RETURN:
+        case STMT_PRINT:
+            scan_expr(t, s->u.expr);
+            break;
+        case STMT_IF:
+            scan_expr(t, s->u.if_stmt.cond);
+            scan_stmt(t, s->u.if_stmt.then_stmt);
+            scan_stmt(t, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            scan_expr(t, s->u.while_stmt.cond);
+            scan_stmt(t, s->u.while_stmt.body);
+            break;
+        case STMT_FOR:
+            scan_stmt(t, s->u.for_stmt.init);
+            scan_expr(t, s->u.for_stmt.cond);
+            scan_stmt(t, s->u.for_stmt.step);
+            scan_stmt(t, s->u.for_stmt.body);
+            break;
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                scan_stmt(t, b);
+            }
+            break;
+    }
+}
+
+static void scan_program(CallScan *t, Program *prog) {
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) {
+            scan_stmt(t, item->u.stmt);
+            continue;
+        }
+        Function *f = item->u.function;
+        for (Stmt *s = f->body ? f->body->head : NULL; s; s = s->next) scan_stmt(t, s);
+    }
+}
+
+int accum_rewrite(Program *prog, FILE *report) {
+    if (!prog) return 0;
+    if (report) fprintf(report, "=== Accumulator Rewrite ===\n");
+
+    CallScan scan;
+    func_table_build(&scan.defs, prog);
+    scan.short_call = (unsigned char *)calloc(prog->nfunctions + 1, 1);
+    scan_program(&scan, prog);
+    int nrecursive = 0;
+    int count = 0;
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind != ITEM_FUNCTION) continue;
+        if (func_table_find(&scan.defs, item->u.function->name) != item->u.function) continue;
+        Candidate c;
+        check_function(&c, item->u.function);
+        if (!c.recursive) continue;
+        if (scan.short_call[c.f->index]) reject(&c, "a call passes fewer arguments than parameters");
+        nrecursive++;
+        if (c.reason) {
+            if (report) fprintf(report, "  %-16s not rewritten: %s\n", c.f->name, c.reason);
+            continue;
+        }
+        Function *helper = rewrite_function(prog, &c);
+        /* 도우미는 원래 함수 바로 뒤에 등록 (같은 시점에 정의됨) */
+        program_insert_function(prog, item, helper);
+        item = item->next;
+        count++;
+        if (report) {
+            fprintf(report, "  %-16s %c  -> %s\n", c.f->name, c.op == BIN_MUL ? '*' : '+', helper->name);
+        }
+    }
+    func_table_free(&scan.defs);
+    free(scan.short_call);
+
+    if (report) fprintf(report, "  rewritten: %d of %d self-recursive functions\n", count, nrecursive);
+    return count;
+}
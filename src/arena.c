@@ -0,0 +1,87 @@
+/* 범프 포인터 아레나
+ * AST 노드처럼 수명이 같은 작은 객체를 청크 단위로 할당
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+#define ARENA_ALIGN 8          /* AST 노드 필드(포인터, long)의 최대 정렬 */
+#define ARENA_FIRST_CHUNK (16 * 1024)
+#define ARENA_MAX_CHUNK (1024 * 1024)
+
+struct ArenaChunk {
+    ArenaChunk *next;
+    size_t size;
+    size_t used;
+    unsigned char data[];   /* 헤더가 size_t 배수이므로 8바이트 정렬 */
+};
+
+void arena_init(Arena *a) {
+    memset(a, 0, sizeof(*a));
+    a->next_size = ARENA_FIRST_CHUNK;
+}
+
+/* 새 청크 확보 (calloc이므로 할당 영역은 이미 0) */
+static ArenaChunk *new_chunk(Arena *a, size_t min_size) {
+    size_t size = a->next_size ? a->next_size : ARENA_FIRST_CHUNK;
+    if (size < min_size) size = min_size;
+
+    ArenaChunk *c = (ArenaChunk *)calloc(1, sizeof(ArenaChunk) + size);
+    if (!c) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    c->size = size;
+    c->next = a->head;
+    a->head = c;
+    a->nchunks++;
+    a->bytes_reserved += size;
+
+    /* 큰 프로그램일수록 청크를 키워 청크 수를 줄임 */
+    if (a->next_size < ARENA_MAX_CHUNK) a->next_size *= 2;
+    return c;
+}
+
+/* align 단위로 맞춘 위치에서 size 바이트 할당 */
+static void *alloc_aligned(Arena *a, size_t size, size_t align) {
+    ArenaChunk *c = a->head;
+    size_t start = c ? (c->used + align - 1) & ~(align - 1) : 0;
+    if (!c || start > c->size || c->size - start < size) {
+        c = new_chunk(a, size);
+        start = 0;
+    }
+    a->bytes_used += start - c->used + size;
+    c->used = start + size;
+    return c->data + start;
+}
+
+void *arena_alloc(Arena *a, size_t size) {
+    return alloc_aligned(a, size, ARENA_ALIGN);
+}
+
+/* 문자열은 정렬 없이 빽빽하게 */
+char *arena_strdup(Arena *a, const char *s) {
+    if (!s) return NULL;
+    size_t len = strlen(s) + 1;
+    char *p = (char *)alloc_aligned(a, len, 1);
+    memcpy(p, s, len);
+    return p;
+}
+
+char *arena_strndup(Arena *a, const char *s, size_t len) {
+    char *p = (char *)alloc_aligned(a, len + 1, 1);
+    memcpy(p, s, len);
+    p[len] = '\0';
+    return p;
+}
+
+void arena_free(Arena *a) {
+    ArenaChunk *c = a->head;
+    while (c) {
+        ArenaChunk *next = c->next;
+        free(c);
+        c = next;
+    }
+    arena_init(a);
+}
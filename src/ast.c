@@ -1,49 +1,73 @@
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "ast.h"
+#include "output.h"
+#include "scanner.h"
+
+/* 노드 할당 (prog의 아레나 + 분류별 통계) */
+static void *ast_alloc(Program *prog, size_t size, int kind) {
+    if (!prog) {
+        /* 프로그램 없이 만든 노드 (해제되지 않음) */
+        void *p = calloc(1, size);
+        if (!p) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        return p;
+    }
+    prog->mem_bytes[kind] += size;
+    prog->mem_nodes[kind]++;
+    return arena_alloc(&prog->arena, size);
+}
 
-/* 전역 프로그램 루트 */
-Program *g_program = NULL;
-
-/* 문자열 복제 헬퍼 */
-static char *strdup_safe(const char *s) {
-    if (!s) return NULL;
-    size_t len = strlen(s) + 1;
-    char *p = (char *)malloc(len);
-    if (!p) {
-        fprintf(stderr, "out of memory\n");
-        exit(1);
+char *ast_intern(Program *prog, const char *s, size_t len) {
+    if (!prog) {
+        char *p = (char *)ast_alloc(NULL, len + 1, AST_MEM_STRING);
+        memcpy(p, s, len);
+        return p;
+    }
+    int before = prog->names.count;
+    char *p = intern_name(&prog->names, &prog->arena, s, len);
+    if (prog->names.count != before) {
+        prog->mem_bytes[AST_MEM_STRING] += len + 1;
+        prog->mem_nodes[AST_MEM_STRING]++;
     }
-    memcpy(p, s, len);
     return p;
 }
 
+/* 생성 함수의 이름 인자 (이미 인터닝된 이름이면 같은 포인터) */
+static char *intern_safe(Program *prog, const char *s) {
+    if (!s) return NULL;
+    return ast_intern(prog, s, strlen(s));
+}
+
 /* === 표현식 생성 함수 === */
 
-Expr *new_int_expr(int value) {
-    Expr *e = (Expr *)calloc(1, sizeof(Expr));
+Expr *new_int_expr(Program *prog, int value) {
+    Expr *e = (Expr *)ast_alloc(prog, sizeof(Expr), AST_MEM_EXPR + EXPR_INT);
     e->kind = EXPR_INT;
     e->u.int_value = value;
     return e;
 }
 
-Expr *new_string_expr(const char *value) {
-    Expr *e = (Expr *)calloc(1, sizeof(Expr));
+Expr *new_string_expr(Program *prog, StrView value) {
+    Expr *e = (Expr *)ast_alloc(prog, sizeof(Expr), AST_MEM_EXPR + EXPR_STRING);
     e->kind = EXPR_STRING;
-    e->u.string_value = strdup_safe(value);
+    e->u.string = value;
     return e;
 }
 
-Expr *new_var_expr(const char *name) {
-    Expr *e = (Expr *)calloc(1, sizeof(Expr));
+Expr *new_var_expr(Program *prog, const char *name) {
+    Expr *e = (Expr *)ast_alloc(prog, sizeof(Expr), AST_MEM_EXPR + EXPR_VAR);
     e->kind = EXPR_VAR;
-    e->u.var_name = strdup_safe(name);
+    e->u.var_name = intern_safe(prog, name);
     return e;
 }
 
-Expr *new_binop_expr(BinOpKind op, Expr *lhs, Expr *rhs) {
-    Expr *e = (Expr *)calloc(1, sizeof(Expr));
+Expr *new_binop_expr(Program *prog, BinOpKind op, Expr *lhs, Expr *rhs) {
+    Expr *e = (Expr *)ast_alloc(prog, sizeof(Expr), AST_MEM_EXPR + EXPR_BINOP);
     e->kind = EXPR_BINOP;
     e->u.binop.op = op;
     e->u.binop.lhs = lhs;
@@ -51,16 +75,18 @@ Expr *new_binop_expr(BinOpKind op, Expr *lhs, Expr *rhs) {
     return e;
 }
 
-Expr *new_call_expr(const char *func_name, ExprList *args) {
-    Expr *e = (Expr *)calloc(1, sizeof(Expr));
+Expr *new_call_expr(Program *prog, const char *func_name, ExprList *args) {
+    Expr *e = (Expr *)ast_alloc(prog, sizeof(Expr), AST_MEM_EXPR + EXPR_CALL);
     e->kind = EXPR_CALL;
-    e->u.call.func_name = strdup_safe(func_name);
+    e->u.call.func_name = intern_safe(prog, func_name);
     e->u.call.args = args;
+    e->u.call.site = prog ? prog->ncall_sites++ : -1;
+    e->u.call.tail = 0;
     return e;
 }
 
-Expr *new_unary_expr(UnaryOpKind op, Expr *operand) {
-    Expr *e = (Expr *)calloc(1, sizeof(Expr));
+Expr *new_unary_expr(Program *prog, UnaryOpKind op, Expr *operand) {
+    Expr *e = (Expr *)ast_alloc(prog, sizeof(Expr), AST_MEM_EXPR + EXPR_UNARY);
     e->kind = EXPR_UNARY;
     e->u.unary.op = op;
     e->u.unary.operand = operand;
@@ -68,8 +94,8 @@ Expr *new_unary_expr(UnaryOpKind op, Expr *operand) {
 }
 
 /* 표현식 리스트 추가 */
-ExprList *expr_list_append(ExprList *list, Expr *expr) {
-    ExprList *node = (ExprList *)calloc(1, sizeof(ExprList));
+ExprList *expr_list_append(Program *prog, ExprList *list, Expr *expr) {
+    ExprList *node = (ExprList *)ast_alloc(prog, sizeof(ExprList), AST_MEM_EXPR_LIST);
     node->expr = expr;
     node->next = NULL;
 
@@ -83,45 +109,45 @@ ExprList *expr_list_append(ExprList *list, Expr *expr) {
 
 /* === 문장 생성 함수 === */
 
-Stmt *new_expr_stmt(Expr *e) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_expr_stmt(Program *prog, Expr *e) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_EXPR);
     s->kind = STMT_EXPR;
     s->u.expr = e;
     return s;
 }
 
-Stmt *new_return_stmt(Expr *e) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_return_stmt(Program *prog, Expr *e) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_RETURN);
     s->kind = STMT_RETURN;
     s->u.expr = e;
     return s;
 }
 
-Stmt *new_vardecl_stmt(const char *name, Expr *init) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_vardecl_stmt(Program *prog, const char *name, Expr *init) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_VARDECL);
     s->kind = STMT_VARDECL;
-    s->u.vardecl.var_name = strdup_safe(name);
+    s->u.vardecl.var_name = intern_safe(prog, name);
     s->u.vardecl.init_value = init;
     return s;
 }
 
-Stmt *new_assign_stmt(const char *name, Expr *value) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_assign_stmt(Program *prog, const char *name, Expr *value) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_ASSIGN);
     s->kind = STMT_ASSIGN;
-    s->u.assign.var_name = strdup_safe(name);
+    s->u.assign.var_name = intern_safe(prog, name);
     s->u.assign.value = value;
     return s;
 }
 
-Stmt *new_print_stmt(Expr *e) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_print_stmt(Program *prog, Expr *e) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_PRINT);
     s->kind = STMT_PRINT;
     s->u.expr = e;
     return s;
 }
 
-Stmt *new_if_stmt(Expr *cond, Stmt *then_stmt, Stmt *else_stmt) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_if_stmt(Program *prog, Expr *cond, Stmt *then_stmt, Stmt *else_stmt) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_IF);
     s->kind = STMT_IF;
     s->u.if_stmt.cond = cond;
     s->u.if_stmt.then_stmt = then_stmt;
@@ -129,16 +155,16 @@ Stmt *new_if_stmt(Expr *cond, Stmt *then_stmt, Stmt *else_stmt) {
     return s;
 }
 
-Stmt *new_while_stmt(Expr *cond, Stmt *body) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_while_stmt(Program *prog, Expr *cond, Stmt *body) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_WHILE);
     s->kind = STMT_WHILE;
     s->u.while_stmt.cond = cond;
     s->u.while_stmt.body = body;
     return s;
 }
 
-Stmt *new_for_stmt(Stmt *init, Expr *cond, Stmt *step, Stmt *body) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_for_stmt(Program *prog, Stmt *init, Expr *cond, Stmt *step, Stmt *body) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_FOR);
     s->kind = STMT_FOR;
     s->u.for_stmt.init = init;
     s->u.for_stmt.cond = cond;
@@ -147,18 +173,18 @@ Stmt *new_for_stmt(Stmt *init, Expr *cond, Stmt *step, Stmt *body) {
     return s;
 }
 
-Stmt *new_block_stmt(StmtList *stmts) {
-    Stmt *s = (Stmt *)calloc(1, sizeof(Stmt));
+Stmt *new_block_stmt(Program *prog, StmtList *stmts) {
+    Stmt *s = (Stmt *)ast_alloc(prog, sizeof(Stmt), AST_MEM_STMT + STMT_BLOCK);
     s->kind = STMT_BLOCK;
     s->u.block = stmts;
     return s;
 }
 
 /* 문장 리스트 추가 */
-StmtList *stmt_list_append(StmtList *list, Stmt *stmt) {
+StmtList *stmt_list_append(Program *prog, StmtList *list, Stmt *stmt) {
     if (!stmt) return list;
     if (!list) {
-        list = (StmtList *)calloc(1, sizeof(StmtList));
+        list = (StmtList *)ast_alloc(prog, sizeof(StmtList), AST_MEM_STMT_LIST);
         list->head = list->tail = NULL;
     }
     if (!list->head) {
@@ -172,13 +198,13 @@ StmtList *stmt_list_append(StmtList *list, Stmt *stmt) {
 
 /* === 함수 및 매개변수 === */
 
-ParamList *param_list_append(ParamList *list, const char *name) {
-    Param *p = (Param *)calloc(1, sizeof(Param));
-    p->name = strdup_safe(name);
+ParamList *param_list_append(Program *prog, ParamList *list, const char *name) {
+    Param *p = (Param *)ast_alloc(prog, sizeof(Param), AST_MEM_PARAM);
+    p->name = intern_safe(prog, name);
     p->next = NULL;
 
     if (!list) {
-        list = (ParamList *)calloc(1, sizeof(ParamList));
+        list = (ParamList *)ast_alloc(prog, sizeof(ParamList), AST_MEM_PARAM_LIST);
         list->head = list->tail = NULL;
     }
     if (!list->head) {
@@ -190,19 +216,22 @@ ParamList *param_list_append(ParamList *list, const char *name) {
     return list;
 }
 
-Function *new_function(const char *name, ParamList *params, StmtList *body) {
-    Function *f = (Function *)calloc(1, sizeof(Function));
-    f->name = strdup_safe(name);
+Function *new_function(Program *prog, const char *name, ParamList *params, StmtList *body) {
+    Function *f = (Function *)ast_alloc(prog, sizeof(Function), AST_MEM_FUNCTION);
+    f->name = intern_safe(prog, name);
     f->params = params;
     f->body = body;
+    f->index = -1;
+    f->pure = 0;
+    f->tail_calls = 0;
     f->next = NULL;
     return f;
 }
 
-FunctionList *function_list_append(FunctionList *list, Function *func) {
+FunctionList *function_list_append(Program *prog, FunctionList *list, Function *func) {
     if (!func) return list;
     if (!list) {
-        list = (FunctionList *)calloc(1, sizeof(FunctionList));
+        list = (FunctionList *)ast_alloc(prog, sizeof(FunctionList), AST_MEM_FUNCTION_LIST);
         list->head = list->tail = NULL;
     }
     if (!list->head) {
@@ -220,11 +249,13 @@ Program *new_program(void) {
     Program *p = (Program *)calloc(1, sizeof(Program));
     p->items = NULL;
     p->items_tail = NULL;
+    arena_init(&p->arena);
+    intern_init(&p->names);
     return p;
 }
 
-static Item *new_item(ItemKind kind) {
-    Item *item = (Item *)calloc(1, sizeof(Item));
+static Item *new_item(Program *prog, ItemKind kind) {
+    Item *item = (Item *)ast_alloc(prog, sizeof(Item), AST_MEM_ITEM);
     item->kind = kind;
     item->next = NULL;
     return item;
@@ -232,8 +263,9 @@ static Item *new_item(ItemKind kind) {
 
 void program_add_function(Program *prog, Function *func) {
     if (!prog || !func) return;
-    Item *item = new_item(ITEM_FUNCTION);
+    Item *item = new_item(prog, ITEM_FUNCTION);
     item->u.function = func;
+    func->index = prog->nfunctions++;
     if (prog->items_tail) {
         prog->items_tail->next = item;
     } else {
@@ -242,9 +274,19 @@ void program_add_function(Program *prog, Function *func) {
     prog->items_tail = item;
 }
 
+void program_insert_function(Program *prog, Item *after, Function *func) {
+    if (!prog || !after || !func) return;
+    Item *item = new_item(prog, ITEM_FUNCTION);
+    item->u.function = func;
+    func->index = prog->nfunctions++;
+    item->next = after->next;
+    after->next = item;
+    if (prog->items_tail == after) prog->items_tail = item;
+}
+
 void program_add_stmt(Program *prog, Stmt *stmt) {
     if (!prog || !stmt) return;
-    Item *item = new_item(ITEM_STMT);
+    Item *item = new_item(prog, ITEM_STMT);
     item->u.stmt = stmt;
     if (prog->items_tail) {
         prog->items_tail->next = item;
@@ -254,161 +296,101 @@ void program_add_stmt(Program *prog, Stmt *stmt) {
     prog->items_tail = item;
 }
 
-/* === 메모리 해제 함수 === */
+/* === 호출 대상 표 === */
 
-void free_expr(Expr *e) {
-    if (!e) return;
-    switch (e->kind) {
-        case EXPR_STRING:
-            free(e->u.string_value);
-            break;
-        case EXPR_VAR:
-            free(e->u.var_name);
-            break;
-        case EXPR_BINOP:
-            free_expr(e->u.binop.lhs);
-            free_expr(e->u.binop.rhs);
-            break;
-        case EXPR_CALL: {
-            free(e->u.call.func_name);
-            ExprList *arg = e->u.call.args;
-            while (arg) {
-                ExprList *next = arg->next;
-                free_expr(arg->expr);
-                free(arg);
-                arg = next;
-            }
-            break;
-        }
-        case EXPR_UNARY:
-            free_expr(e->u.unary.operand);
-            break;
-        default:
-            break;
-    }
-    free(e);
+static int compare_func(const void *a, const void *b) {
+    const Function *fa = *(Function *const *)a;
+    const Function *fb = *(Function *const *)b;
+    if (fa->name != fb->name) return (uintptr_t)fa->name < (uintptr_t)fb->name ? -1 : 1;
+    return fa->index - fb->index;
 }
 
-void free_stmt(Stmt *s) {
-    if (!s) return;
-    switch (s->kind) {
-        case STMT_EXPR:
-        case STMT_RETURN:
-        case STMT_PRINT:
-            free_expr(s->u.expr);
-            break;
-        case STMT_VARDECL:
-            free(s->u.vardecl.var_name);
-            free_expr(s->u.vardecl.init_value);
-            break;
-        case STMT_ASSIGN:
-            free(s->u.assign.var_name);
-            free_expr(s->u.assign.value);
-            break;
-        case STMT_IF:
-            free_expr(s->u.if_stmt.cond);
-            free_stmt(s->u.if_stmt.then_stmt);
-            free_stmt(s->u.if_stmt.else_stmt);
-            break;
-        case STMT_WHILE:
-            free_expr(s->u.while_stmt.cond);
-            free_stmt(s->u.while_stmt.body);
-            break;
-        case STMT_FOR:
-            free_stmt(s->u.for_stmt.init);
-            free_expr(s->u.for_stmt.cond);
-            free_stmt(s->u.for_stmt.step);
-            free_stmt(s->u.for_stmt.body);
-            break;
-        case STMT_BLOCK: {
-            StmtList *block = s->u.block;
-            if (block) {
-                Stmt *curr = block->head;
-                while (curr) {
-                    Stmt *next = curr->next;
-                    curr->next = NULL;
-                    free_stmt(curr);
-                    curr = next;
-                }
-                free(block);
-            }
-            break;
-        }
+void func_table_build(FuncTable *t, Program *prog) {
+    t->funcs = (Function **)malloc(sizeof(Function *) * (prog->nfunctions + 1));
+    if (!t->funcs) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    int n = 0;
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_FUNCTION) t->funcs[n++] = item->u.function;
+    }
+    /* 이름이 같으면 정의 순서대로 → 각 이름의 첫 원소만 남김 */
+    qsort(t->funcs, n, sizeof(Function *), compare_func);
+    t->count = 0;
+    for (int i = 0; i < n; ++i) {
+        if (t->count > 0 && t->funcs[t->count - 1]->name == t->funcs[i]->name) continue;
+        t->funcs[t->count++] = t->funcs[i];
     }
-    free(s);
 }
 
-void free_function(Function *f) {
-    if (!f) return;
-    free(f->name);
-    if (f->params) {
-        Param *p = f->params->head;
-        while (p) {
-            Param *next = p->next;
-            free(p->name);
-            free(p);
-            p = next;
-        }
-        free(f->params);
-    }
-    if (f->body) {
-        Stmt *s = f->body->head;
-        while (s) {
-            Stmt *next = s->next;
-            s->next = NULL;
-            free_stmt(s);
-            s = next;
-        }
-        free(f->body);
+Function *func_table_find(const FuncTable *t, const char *name) {
+    int lo = 0, hi = t->count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (name == t->funcs[mid]->name) return t->funcs[mid];
+        if ((uintptr_t)name < (uintptr_t)t->funcs[mid]->name) hi = mid - 1; else lo = mid + 1;
     }
-    free(f);
+    return NULL;
 }
 
+void func_table_free(FuncTable *t) {
+    free(t->funcs);
+    t->funcs = NULL;
+    t->count = 0;
+}
+
+/* === 메모리 해제 함수 === */
+
 void free_program(Program *prog) {
     if (!prog) return;
-    Item *item = prog->items;
-    while (item) {
-        Item *next = item->next;
-        if (item->kind == ITEM_FUNCTION) {
-            free_function(item->u.function);
-        } else if (item->kind == ITEM_STMT) {
-            free_stmt(item->u.stmt);
-        }
-        free(item);
-        item = next;
-    }
+    /* 노드는 모두 아레나 소유이므로 트리를 순회하지 않음 */
+    arena_free(&prog->arena);
+    intern_free(&prog->names);
+    scanner_source_free(&prog->source);
+    free(prog->global_names);
     free(prog);
 }
 
+/* 아레나 통계 분류 이름 */
+const char *ast_mem_kind_name(int kind) {
+    static const char *expr_names[] = {
+        "Expr(int)", "Expr(string)", "Expr(var)", "Expr(binop)", "Expr(call)", "Expr(unary)"
+    };
+    static const char *stmt_names[] = {
+        "Stmt(expr)", "Stmt(return)", "Stmt(vardecl)", "Stmt(assign)", "Stmt(print)",
+        "Stmt(if)", "Stmt(while)", "Stmt(for)", "Stmt(block)"
+    };
+    if (kind >= AST_MEM_EXPR && kind < AST_MEM_STMT) return expr_names[kind - AST_MEM_EXPR];
+    if (kind >= AST_MEM_STMT && kind < AST_MEM_EXPR_LIST) return stmt_names[kind - AST_MEM_STMT];
+    switch (kind) {
+        case AST_MEM_EXPR_LIST: return "ExprList";
+        case AST_MEM_STMT_LIST: return "StmtList";
+        case AST_MEM_PARAM: return "Param";
+        case AST_MEM_PARAM_LIST: return "ParamList";
+        case AST_MEM_FUNCTION: return "Function";
+        case AST_MEM_FUNCTION_LIST: return "FunctionList";
+        case AST_MEM_ITEM: return "Item";
+        case AST_MEM_STRING: return "string";
+        default: return "?";
+    }
+}
+
 /* === AST 시각화 === */
 
 #include <stdarg.h>
 
-/* 버퍼 관리 (static 상태) */
-static char *ast_buf = NULL;
-static int ast_bufsize = 0;
-static int ast_pos = 0;
-
-/* 버퍼에 출력 */
-static void ast_emit(const char *fmt, ...) {
+/* 출력 (Output 버퍼) */
+static void ast_emit(Output *out, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    if (ast_buf) {
-        int remaining = ast_bufsize - ast_pos;
-        if (remaining > 0) {
-            int written = vsnprintf(ast_buf + ast_pos, remaining, fmt, args);
-            if (written > 0) {
-                ast_pos += (written < remaining) ? written : (remaining - 1);
-            }
-        }
-    }
+    output_vprintf(out, fmt, args);
     va_end(args);
 }
 
-/* 들여쓰기 (depth * 2칸) */
-static void ast_emit_indent(int depth) {
+static void ast_emit_indent(Output *out, int depth) {
     for (int i = 0; i < depth; i++) {
-        ast_emit("  ");
+        ast_emit(out, "  ");
     }
 }
 
@@ -442,136 +424,136 @@ static const char* unary_to_string(UnaryOpKind op) {
 }
 
 /* 전방 선언 */
-static void print_expr(Expr *e, int depth);
-static void print_stmt(Stmt *s, int depth);
+static void print_expr(const Program *prog, Output *out, Expr *e, int depth);
+static void print_stmt(const Program *prog, Output *out, Stmt *s, int depth);
 
 /* 표현식 노드 출력 */
-static void print_expr(Expr *e, int depth) {
+static void print_expr(const Program *prog, Output *out, Expr *e, int depth) {
     if (!e) return;
 
-    ast_emit_indent(depth);
+    ast_emit_indent(out, depth);
 
     switch (e->kind) {
         case EXPR_INT:
-            ast_emit("INT: %d\n", e->u.int_value);
+            ast_emit(out, "INT: %d\n", e->u.int_value);
             break;
 
         case EXPR_STRING:
-            ast_emit("STRING: \"%s\"\n", e->u.string_value ? e->u.string_value : "");
+            ast_emit(out, "STRING: \"%.*s\"\n", (int)e->u.string.len, AST_STRING_TEXT(prog, e));
             break;
 
         case EXPR_VAR:
-            ast_emit("VAR: %s\n", e->u.var_name);
+            ast_emit(out, "VAR: %s\n", e->u.var_name);
             break;
 
         case EXPR_BINOP:
-            ast_emit("BINOP: %s\n", binop_to_string(e->u.binop.op));
-            print_expr(e->u.binop.lhs, depth + 1);
-            print_expr(e->u.binop.rhs, depth + 1);
+            ast_emit(out, "BINOP: %s\n", binop_to_string(e->u.binop.op));
+            print_expr(prog, out, e->u.binop.lhs, depth + 1);
+            print_expr(prog, out, e->u.binop.rhs, depth + 1);
             break;
 
         case EXPR_CALL:
-            ast_emit("CALL: %s\n", e->u.call.func_name);
+            ast_emit(out, "CALL: %s\n", e->u.call.func_name);
             for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
-                print_expr(arg->expr, depth + 1);
+                print_expr(prog, out, arg->expr, depth + 1);
             }
             break;
 
         case EXPR_UNARY:
-            ast_emit("UNARY: %s\n", unary_to_string(e->u.unary.op));
-            print_expr(e->u.unary.operand, depth + 1);
+            ast_emit(out, "UNARY: %s\n", unary_to_string(e->u.unary.op));
+            print_expr(prog, out, e->u.unary.operand, depth + 1);
             break;
     }
 }
 
 /* 문장 노드 출력 */
-static void print_stmt(Stmt *s, int depth) {
+static void print_stmt(const Program *prog, Output *out, Stmt *s, int depth) {
     if (!s) return;
 
-    ast_emit_indent(depth);
+    ast_emit_indent(out, depth);
 
     switch (s->kind) {
         case STMT_EXPR:
-            ast_emit("EXPR_STMT\n");
-            print_expr(s->u.expr, depth + 1);
+            ast_emit(out, "EXPR_STMT\n");
+            print_expr(prog, out, s->u.expr, depth + 1);
             break;
 
         case STMT_RETURN:
-            ast_emit("RETURN\n");
+            ast_emit(out, "RETURN\n");
             if (s->u.expr) {
-                print_expr(s->u.expr, depth + 1);
+                print_expr(prog, out, s->u.expr, depth + 1);
             }
             break;
 
         case STMT_VARDECL:
-            ast_emit("VARDECL: %s\n", s->u.vardecl.var_name);
+            ast_emit(out, "VARDECL: %s\n", s->u.vardecl.var_name);
             if (s->u.vardecl.init_value) {
-                print_expr(s->u.vardecl.init_value, depth + 1);
+                print_expr(prog, out, s->u.vardecl.init_value, depth + 1);
             }
             break;
 
         case STMT_ASSIGN:
-            ast_emit("ASSIGN: %s\n", s->u.assign.var_name);
-            print_expr(s->u.assign.value, depth + 1);
+            ast_emit(out, "ASSIGN: %s\n", s->u.assign.var_name);
+            print_expr(prog, out, s->u.assign.value, depth + 1);
             break;
 
         case STMT_PRINT:
-            ast_emit("PRINT\n");
-            print_expr(s->u.expr, depth + 1);
+            ast_emit(out, "PRINT\n");
+            print_expr(prog, out, s->u.expr, depth + 1);
             break;
 
         case STMT_IF:
-            ast_emit("IF\n");
-            ast_emit_indent(depth + 1);
-            ast_emit("COND:\n");
-            print_expr(s->u.if_stmt.cond, depth + 2);
-            ast_emit_indent(depth + 1);
-            ast_emit("THEN:\n");
-            print_stmt(s->u.if_stmt.then_stmt, depth + 2);
+            ast_emit(out, "IF\n");
+            ast_emit_indent(out, depth + 1);
+            ast_emit(out, "COND:\n");
+            print_expr(prog, out, s->u.if_stmt.cond, depth + 2);
+            ast_emit_indent(out, depth + 1);
+            ast_emit(out, "THEN:\n");
+            print_stmt(prog, out, s->u.if_stmt.then_stmt, depth + 2);
             if (s->u.if_stmt.else_stmt) {
-                ast_emit_indent(depth + 1);
-                ast_emit("ELSE:\n");
-                print_stmt(s->u.if_stmt.else_stmt, depth + 2);
+                ast_emit_indent(out, depth + 1);
+                ast_emit(out, "ELSE:\n");
+                print_stmt(prog, out, s->u.if_stmt.else_stmt, depth + 2);
             }
             break;
 
         case STMT_WHILE:
-            ast_emit("WHILE\n");
-            ast_emit_indent(depth + 1);
-            ast_emit("COND:\n");
-            print_expr(s->u.while_stmt.cond, depth + 2);
-            ast_emit_indent(depth + 1);
-            ast_emit("BODY:\n");
-            print_stmt(s->u.while_stmt.body, depth + 2);
+            ast_emit(out, "WHILE\n");
+            ast_emit_indent(out, depth + 1);
+            ast_emit(out, "COND:\n");
+            print_expr(prog, out, s->u.while_stmt.cond, depth + 2);
+            ast_emit_indent(out, depth + 1);
+            ast_emit(out, "BODY:\n");
+            print_stmt(prog, out, s->u.while_stmt.body, depth + 2);
             break;
 
         case STMT_FOR:
-            ast_emit("FOR\n");
+            ast_emit(out, "FOR\n");
             if (s->u.for_stmt.init) {
-                ast_emit_indent(depth + 1);
-                ast_emit("INIT:\n");
-                print_stmt(s->u.for_stmt.init, depth + 2);
+                ast_emit_indent(out, depth + 1);
+                ast_emit(out, "INIT:\n");
+                print_stmt(prog, out, s->u.for_stmt.init, depth + 2);
             }
             if (s->u.for_stmt.cond) {
-                ast_emit_indent(depth + 1);
-                ast_emit("COND:\n");
-                print_expr(s->u.for_stmt.cond, depth + 2);
+                ast_emit_indent(out, depth + 1);
+                ast_emit(out, "COND:\n");
+                print_expr(prog, out, s->u.for_stmt.cond, depth + 2);
             }
             if (s->u.for_stmt.step) {
-                ast_emit_indent(depth + 1);
-                ast_emit("STEP:\n");
-                print_stmt(s->u.for_stmt.step, depth + 2);
+                ast_emit_indent(out, depth + 1);
+                ast_emit(out, "STEP:\n");
+                print_stmt(prog, out, s->u.for_stmt.step, depth + 2);
             }
-            ast_emit_indent(depth + 1);
-            ast_emit("BODY:\n");
-            print_stmt(s->u.for_stmt.body, depth + 2);
+            ast_emit_indent(out, depth + 1);
+            ast_emit(out, "BODY:\n");
+            print_stmt(prog, out, s->u.for_stmt.body, depth + 2);
             break;
 
         case STMT_BLOCK:
-            ast_emit("BLOCK\n");
+            ast_emit(out, "BLOCK\n");
             if (s->u.block) {
                 for (Stmt *curr = s->u.block->head; curr; curr = curr->next) {
-                    print_stmt(curr, depth + 1);
+                    print_stmt(prog, out, curr, depth + 1);
                 }
             }
             break;
@@ -579,29 +561,29 @@ static void print_stmt(Stmt *s, int depth) {
 }
 
 /* 함수 노드 출력 */
-static void print_function(Function *f, int depth) {
+static void print_function(const Program *prog, Output *out, Function *f, int depth) {
     if (!f) return;
 
-    ast_emit_indent(depth);
-    ast_emit("Function: %s(", f->name);
+    ast_emit_indent(out, depth);
+    ast_emit(out, "Function: %s(", f->name);
 
     /* 매개변수 */
     if (f->params) {
         Param *p = f->params->head;
         int first = 1;
         while (p) {
-            if (!first) ast_emit(", ");
-            ast_emit("%s", p->name);
+            if (!first) ast_emit(out, ", ");
+            ast_emit(out, "%s", p->name);
             first = 0;
             p = p->next;
         }
     }
-    ast_emit(")\n");
+    ast_emit(out, ")\n");
 
     /* 함수 본문 */
     if (f->body) {
         for (Stmt *s = f->body->head; s; s = s->next) {
-            print_stmt(s, depth + 1);
+            print_stmt(prog, out, s, depth + 1);
         }
     }
 }
@@ -612,40 +594,24 @@ int ast_to_buffer(Program *prog, char *buffer, int bufsize) {
         return 0;
     }
 
-    /* 버퍼 상태 초기화 */
-    ast_buf = buffer;
-    ast_bufsize = bufsize;
-    ast_pos = 0;
-    buffer[0] = '\0';
+    Output buf;
+    Output *out = &buf;
+    output_init_buffer(out, buffer, bufsize);
 
     if (!prog || !prog->items) {
-        ast_emit("(No program)\n");
+        ast_emit(out, "(No program)\n");
     } else {
-        ast_emit("Program\n");
+        ast_emit(out, "Program\n");
         for (Item *item = prog->items; item; item = item->next) {
             if (item->kind == ITEM_FUNCTION) {
-                print_function(item->u.function, 1);
+                print_function(prog, out, item->u.function, 1);
             } else if (item->kind == ITEM_STMT) {
-                ast_emit_indent(1);
-                ast_emit("TopLevel Statement:\n");
-                print_stmt(item->u.stmt, 2);
+                ast_emit_indent(out, 1);
+                ast_emit(out, "TopLevel Statement:\n");
+                print_stmt(prog, out, item->u.stmt, 2);
             }
         }
     }
 
-    /* null 종료 보장 */
-    if (ast_pos < bufsize) {
-        buffer[ast_pos] = '\0';
-    } else {
-        buffer[bufsize - 1] = '\0';
-    }
-
-    int result = ast_pos;
-
-    /* 상태 초기화 */
-    ast_buf = NULL;
-    ast_bufsize = 0;
-    ast_pos = 0;
-
-    return result;
+    return buf.pos;
 }
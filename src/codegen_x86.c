@@ -3,688 +3,1236 @@
 #include <string.h>
 #include <stdarg.h>
 #include "ast.h"
+#include "output.h"
+#include "eval.h"
+#include "ir.h"
+#include "lir.h"
+#include "regalloc.h"
+#include "flat.h"
 #include "codegen_x86.h"
 
 /* Mini-JS x86-64 코드 생성기
  * - 함수 정의 및 호출 (12wk 기반)
  * - 제어문 if/while/for (11wk 기반)
  * - console.log() 출력
+ * - -O0: 평평한 AST(flat.h)를 순회하는 스택 기계 방식 (모든 변수는 %rbp 기준 슬롯)
+ * - -O1: SSA IR(ir.c) → LIR(lir.c) → 선형 스캔 레지스터 할당(regalloc.c)
+ * 함수/전역/문자열 테이블은 두 수준 모두 IrProgram을 사용
+ * 실행 중 에러(0으로 나누기, 미정의 변수/함수, 호출 깊이 초과)는 eval_program과 같은 메시지를 출력
  */
 
-/* === 출력 관련 === */
-static FILE *out_file = NULL;
-static char *out_buffer = NULL;
-static int out_bufsize = 0;
-static int out_pos = 0;
-
-static void emit(const char *fmt, ...) {
+/* === 코드 생성 상태 (호출마다 하나, 전역 상태 없음) === */
+typedef struct {
+    Output *out;
+    IrProgram *ir;          /* 함수/전역/문자열 테이블 */
+    LirProgram *lp;         /* -O1: 할당할 LIR */
+    int label_counter;      /* 레이블 카운터 */
+    int div_msg;            /* "division by zero" 문자열 인덱스 */
+    int mod_msg;
+    int call_depth_msg;     /* "maximum call depth exceeded" */
+
+    /* 현재 함수 */
+    int func_id;            /* 0: top-level (main), i+1: ir->funcs[i] */
+    int depth;              /* -O0: push된 8바이트 수 (호출 전 16바이트 정렬) */
+    FlatProgram *fp;        /* -O0: 순회할 평평한 AST */
+    LirFunc *f;             /* -O1: 할당이 끝난 LIR 함수 */
+    int ncallee;            /* -O1: 프롤로그에서 push한 callee-saved 레지스터 수 */
+} CodeGen;
+
+static void emit(CodeGen *g, const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
+    output_vprintf(g->out, fmt, args);
+    va_end(args);
+}
 
-    if (out_buffer) {
-        int remaining = out_bufsize - out_pos;
-        if (remaining > 0) {
-            int written = vsnprintf(out_buffer + out_pos, remaining, fmt, args);
-            if (written > 0) {
-                out_pos += (written < remaining) ? written : (remaining - 1);
-            }
+static int new_label(CodeGen *g) {
+    return g->label_counter++;
+}
+
+/* === 공통: 심볼, 런타임, 데이터 === */
+
+/* 사용자 함수 심볼 (C의 main 등과 충돌하지 않도록 접두사) */
+static void emit_func_symbol(CodeGen *g, int fi) {
+    emit(g, "mjs_%s", g->ir->funcs[fi].func->name);
+}
+
+/* 런타임 스텁: 인자/결과는 %rax, %rax 외의 레지스터는 모두 보존
+ * 호출 지점에서 스택 정렬이나 caller-saved 레지스터를 신경 쓰지 않도록
+ * 스텁 안에서 저장하고 스택을 16바이트로 맞춤 */
+static void emit_stub(CodeGen *g, const char *name, const char *body) {
+    static const char *saved[] = { "%rcx", "%rdx", "%rsi", "%rdi", "%r8", "%r9", "%r10", "%r11" };
+    int n = (int)(sizeof(saved) / sizeof(saved[0]));
+    emit(g, "\n%s:\n", name);
+    for (int i = 0; i < n; ++i) emit(g, "    pushq %s\n", saved[i]);
+    emit(g, "    pushq %%rbp\n");
+    emit(g, "    movq %%rsp, %%rbp\n");
+    emit(g, "    andq $-16, %%rsp\n");
+    emit(g, "%s", body);
+    emit(g, "    movq %%rbp, %%rsp\n");
+    emit(g, "    popq %%rbp\n");
+    for (int i = n - 1; i >= 0; --i) emit(g, "    popq %s\n", saved[i]);
+    emit(g, "    ret\n");
+}
+
+/* 출력 런타임 (minijs_rt)
+ * 어셈블리 파일 안에 함께 출력하므로 `gcc out.s`만으로 링크됨
+ * console.log/에러 메시지는 .Lrt_buf(RT_BUFSIZE)에 모았다가 가득 차거나
+ * 프로그램이 끝날 때(main이 atexit로 등록한 __mjs_flush) write(2)로 한 번에 출력
+ * (printf의 서식 해석과 stdio 잠금을 호출마다 하지 않음) */
+#define RT_BUFSIZE 65536
+
+static void emit_runtime(CodeGen *g) {
+    /* .Lrt_write(ptr, len): 전부 쓸 때까지 write(1, ...) (System V 호출 규약) */
+    emit(g, "\n.Lrt_write:\n"
+            "    pushq %%rbx\n"
+            "    pushq %%r12\n"
+            "    pushq %%r13\n"
+            "    movq %%rdi, %%r12\n"
+            "    movq %%rsi, %%r13\n"
+            ".Lrt_write_loop:\n"
+            "    testq %%r13, %%r13\n"
+            "    jz .Lrt_write_done\n"
+            "    movl $1, %%edi\n"
+            "    movq %%r12, %%rsi\n"
+            "    movq %%r13, %%rdx\n"
+            "    call write@PLT\n"
+            "    testq %%rax, %%rax\n"
+            "    jle .Lrt_write_done\n"
+            "    addq %%rax, %%r12\n"
+            "    subq %%rax, %%r13\n"
+            "    jmp .Lrt_write_loop\n"
+            ".Lrt_write_done:\n"
+            "    popq %%r13\n"
+            "    popq %%r12\n"
+            "    popq %%rbx\n"
+            "    ret\n");
+
+    /* __mjs_flush(): 버퍼 내용 출력 (atexit에서도 호출) */
+    emit(g, "\n__mjs_flush:\n"
+            "    subq $8, %%rsp\n"
+            "    leaq .Lrt_buf(%%rip), %%rdi\n"
+            "    movq .Lrt_pos(%%rip), %%rsi\n"
+            "    call .Lrt_write\n"
+            "    movq $0, .Lrt_pos(%%rip)\n"
+            "    addq $8, %%rsp\n"
+            "    ret\n");
+
+    /* .Lrt_append(ptr, len): 버퍼에 추가, 넘치면 flush (버퍼보다 크면 바로 출력) */
+    emit(g, "\n.Lrt_append:\n"
+            "    pushq %%rbx\n"
+            "    pushq %%r12\n"
+            "    pushq %%r13\n"
+            "    movq %%rdi, %%r12\n"
+            "    movq %%rsi, %%r13\n"
+            "    movq .Lrt_pos(%%rip), %%rax\n"
+            "    addq %%r13, %%rax\n"
+            "    cmpq $%d, %%rax\n"
+            "    jbe .Lrt_append_copy\n"
+            "    call __mjs_flush\n"
+            "    cmpq $%d, %%r13\n"
+            "    jbe .Lrt_append_copy\n"
+            "    movq %%r12, %%rdi\n"
+            "    movq %%r13, %%rsi\n"
+            "    call .Lrt_write\n"
+            "    jmp .Lrt_append_done\n"
+            ".Lrt_append_copy:\n"
+            "    leaq .Lrt_buf(%%rip), %%rdi\n"
+            "    addq .Lrt_pos(%%rip), %%rdi\n"
+            "    movq %%r12, %%rsi\n"
+            "    movq %%r13, %%rcx\n"
+            "    rep movsb\n"
+            "    addq %%r13, .Lrt_pos(%%rip)\n"
+            ".Lrt_append_done:\n"
+            "    popq %%r13\n"
+            "    popq %%r12\n"
+            "    popq %%rbx\n"
+            "    ret\n", RT_BUFSIZE, RT_BUFSIZE);
+
+    /* 정수 → 10진수: 스택의 임시 공간에 뒤에서부터 채움 (10으로 나누기는 역수 곱셈) */
+    emit_stub(g, "__mjs_print_int",
+              "    subq $32, %rsp\n"
+              "    leaq 32(%rsp), %rsi\n"
+              "    decq %rsi\n"
+              "    movb $10, (%rsi)\n"
+              "    movq %rax, %r8\n"
+              "    testq %rax, %rax\n"
+              "    jns .Lrt_int_digit\n"
+              "    negq %rax\n"
+              ".Lrt_int_digit:\n"
+              "    movq %rax, %r10\n"
+              "    movabsq $-3689348814741910323, %rax\n"
+              "    mulq %r10\n"
+              "    shrq $3, %rdx\n"
+              "    leaq (%rdx,%rdx,4), %rax\n"
+              "    addq %rax, %rax\n"
+              "    subq %rax, %r10\n"
+              "    addb $48, %r10b\n"
+              "    decq %rsi\n"
+              "    movb %r10b, (%rsi)\n"
+              "    movq %rdx, %rax\n"
+              "    testq %rax, %rax\n"
+              "    jnz .Lrt_int_digit\n"
+              "    testq %r8, %r8\n"
+              "    jns .Lrt_int_out\n"
+              "    decq %rsi\n"
+              "    movb $45, (%rsi)\n"
+              ".Lrt_int_out:\n"
+              "    movq %rsi, %rdi\n"
+              "    leaq 32(%rsp), %rsi\n"
+              "    subq %rdi, %rsi\n"
+              "    call .Lrt_append\n");
+    emit_stub(g, "__mjs_print_str",
+              "    pushq %rax\n"
+              "    pushq %rax\n"
+              "    movq %rax, %rdi\n"
+              "    call strlen@PLT\n"
+              "    popq %rdi\n"
+              "    popq %rdi\n"
+              "    movq %rax, %rsi\n"
+              "    call .Lrt_append\n"
+              "    leaq .Lrt_newline(%rip), %rdi\n"
+              "    movl $1, %esi\n"
+              "    call .Lrt_append\n");
+    emit_stub(g, "__mjs_error",
+              "    pushq %rax\n"
+              "    pushq %rax\n"
+              "    movq %rax, %rdi\n"
+              "    call strlen@PLT\n"
+              "    popq %rdi\n"
+              "    popq %rdi\n"
+              "    movq %rax, %rsi\n"
+              "    call .Lrt_append\n");
+}
+
+/* main 진입: 출력 런타임의 flush를 종료 시점에 등록 */
+static void emit_main_entry(CodeGen *g) {
+    emit(g, "\n");
+    emit(g, "    .globl main\n");
+    emit(g, "main:\n");
+    emit(g, "    subq $8, %%rsp\n");
+    emit(g, "    leaq __mjs_flush(%%rip), %%rdi\n");
+    emit(g, "    call atexit@PLT\n");
+    emit(g, "    addq $8, %%rsp\n");
+}
+
+/* 문자열 이스케이프 처리 (어셈블리 출력용) */
+static void emit_escaped_string(CodeGen *g, const char *str) {
+    emit(g, "    .string \"");
+    for (const char *p = str; *p; p++) {
+        switch (*p) {
+            case '\n': emit(g, "\\n"); break;
+            case '\t': emit(g, "\\t"); break;
+            case '\r': emit(g, "\\r"); break;
+            case '\\': emit(g, "\\\\"); break;
+            case '"':  emit(g, "\\\""); break;
+            default:   emit(g, "%c", *p); break;
         }
-    } else {
-        vfprintf(out_file ? out_file : stdout, fmt, args);
     }
+    emit(g, "\"\n");
+}
 
-    va_end(args);
+/* 데이터 섹션 (코드 생성 중 추가된 문자열까지 포함하도록 마지막에 출력) */
+static void emit_data(CodeGen *g) {
+    IrProgram *ip = g->ir;
+
+    emit(g, "\n    .section .rodata\n");
+    emit(g, ".Lrt_newline:\n");
+    emit(g, "    .byte 10\n");
+    for (int i = 0; i < ip->nstrings; ++i) {
+        emit(g, ".Lstr_%d:\n", i);
+        emit_escaped_string(g, ip->strings[i]);
+    }
+
+    /* 전역 변수 값과 정의 여부, 함수 등록 여부 */
+    emit(g, "\n    .bss\n");
+    emit(g, "    .align 8\n");
+    emit(g, ".Lglobals:\n");
+    emit(g, "    .zero %d\n", ip->nglobals > 0 ? ip->nglobals * 8 : 8);
+    emit(g, ".Lgdef:\n");
+    emit(g, "    .zero %d\n", ip->nglobals > 0 ? ip->nglobals : 1);
+    emit(g, ".Lfdef:\n");
+    emit(g, "    .zero %d\n", ip->nfuncs > 0 ? ip->nfuncs : 1);
+    emit(g, "    .align 8\n");
+    emit(g, ".Lcall_depth:\n");
+    emit(g, "    .zero 8\n");
+    emit(g, ".Lrt_pos:\n");
+    emit(g, "    .zero 8\n");
+    emit(g, ".Lrt_buf:\n");
+    emit(g, "    .zero %d\n", RT_BUFSIZE);
+
+    emit(g, "\n    .section .note.GNU-stack,\"\",@progbits\n");
 }
 
-/* === 심볼 테이블 (지역 변수) === */
-typedef struct {
-    const char *name;
-    int offset;       /* rbp 기준 음수 오프셋 */
-    int is_param;
-    int param_index;
-} Var;
+/* 에러 메시지 출력 (%rax만 바뀜) */
+static void emit_error(CodeGen *g, int str) {
+    emit(g, "    leaq .Lstr_%d(%%rip), %%rax\n", str);
+    emit(g, "    call __mjs_error\n");
+}
 
-static const char *arg_regs[] = { "%rdi", "%rsi", "%rdx", "%rcx", "%r8", "%r9" };
+/* 호출 깊이 초과: 함수 진입에서 프레임을 만들기 전에 오므로 에러 후 0을 호출자에게 바로 반환 */
+static void emit_depth_overflow(CodeGen *g) {
+    emit(g, "\n.Lrt_depth:\n");
+    emit_error(g, g->call_depth_msg);
+    emit(g, "    xorl %%eax, %%eax\n");
+    emit(g, "    ret\n");
+}
 
-static int find_var(const Var *vars, int n, const char *name) {
-    for (int i = 0; i < n; ++i) {
-        if (strcmp(vars[i].name, name) == 0) return i;
-    }
-    return -1;
+/* 함수 진입/복귀: 호출 깊이를 세고 EVAL_MAX_CALL_DEPTH에 이르면 .Lrt_depth로
+ * (top-level은 세지 않음, 꼬리 자기 호출은 프롤로그 뒤로 점프하므로 세지 않음) */
+static void emit_depth_enter(CodeGen *g) {
+    if (g->func_id == 0) return;
+    emit(g, "    cmpq $%d, .Lcall_depth(%%rip)\n", EVAL_MAX_CALL_DEPTH);
+    emit(g, "    jge .Lrt_depth\n");
+    emit(g, "    addq $1, .Lcall_depth(%%rip)\n");
+}
+
+static void emit_depth_leave(CodeGen *g) {
+    if (g->func_id == 0) return;
+    emit(g, "    subq $1, .Lcall_depth(%%rip)\n");
+}
+
+/* %rax = globals[index], 정의 전이면 에러 후 0 */
+static void emit_load_global(CodeGen *g, int index, int msg) {
+    int ok = new_label(g);
+    int done = new_label(g);
+    emit(g, "    cmpb $0, .Lgdef+%d(%%rip)\n", index);
+    emit(g, "    jne .Lk%d\n", ok);
+    emit_error(g, msg);
+    emit(g, "    xorl %%eax, %%eax\n");
+    emit(g, "    jmp .Lk%d\n", done);
+    emit(g, ".Lk%d:\n", ok);
+    emit(g, "    movq .Lglobals+%d(%%rip), %%rax\n", index * 8);
+    emit(g, ".Lk%d:\n", done);
 }
 
-/* 레이블 카운터 */
-static int label_counter = 0;
-static int string_counter = 0;
+/* %rax = %rax / %rcx (또는 %), 0으로 나누면 에러 후 0 */
+static void emit_divmod(CodeGen *g, int is_mod) {
+    int ok = new_label(g);
+    int done = new_label(g);
+    emit(g, "    testq %%rcx, %%rcx\n");
+    emit(g, "    jne .Lk%d\n", ok);
+    emit_error(g, is_mod ? g->mod_msg : g->div_msg);
+    emit(g, "    xorl %%eax, %%eax\n");
+    emit(g, "    jmp .Lk%d\n", done);
+    emit(g, ".Lk%d:\n", ok);
+    emit(g, "    cqto\n");
+    emit(g, "    idivq %%rcx\n");
+    if (is_mod) emit(g, "    movq %%rdx, %%rax\n");
+    emit(g, ".Lk%d:\n", done);
+}
 
-static int new_label(void) {
-    return label_counter++;
+/* 등록 전 함수 호출 검사: 등록 전이면 에러 후 %rax = 0으로 skip 레이블로 */
+static void emit_check_func(CodeGen *g, int fi, int msg, const char *skip_fmt, int skip) {
+    int ok = new_label(g);
+    emit(g, "    cmpb $0, .Lfdef+%d(%%rip)\n", fi);
+    emit(g, "    jne .Lk%d\n", ok);
+    emit_error(g, msg);
+    emit(g, "    xorl %%eax, %%eax\n");
+    emit(g, "    jmp ");
+    emit(g, skip_fmt, g->func_id, skip);
+    emit(g, "\n.Lk%d:\n", ok);
 }
 
-static int new_string_label(void) {
-    return string_counter++;
+static const char *setcc_suffix(int op) {
+    switch (op) {
+        case BIN_LT: return "l";
+        case BIN_GT: return "g";
+        case BIN_LE: return "le";
+        case BIN_GE: return "ge";
+        case BIN_EQ: return "e";
+        default:     return "ne";
+    }
 }
 
-/* === 변수 수집 (스택 공간 할당) === */
-static void collect_vars_expr(Expr *e);
-static void collect_vars_stmt(Stmt *s, Var *vars, int *count, int *offset);
+/* ================================================================
+ * -O0: 스택 기계 방식 (피연산자는 push/pop, 변수는 매번 %rbp에서 읽음)
+ * 평평한 AST(flat.h)를 인덱스로 순회
+ * ================================================================ */
+
+static void gen_expr(CodeGen *g, FlatId e);
 
-static void collect_vars_expr(Expr *e) {
-    /* 표현식 내부의 변수는 이미 선언되어 있어야 함 */
-    (void)e;
+static int slot_offset(int slot) {
+    return -8 * (slot + 1);
 }
 
-static void collect_vars_stmt(Stmt *s, Var *vars, int *count, int *offset) {
-    if (!s) return;
+static void gen_push(CodeGen *g) {
+    emit(g, "    pushq %%rax\n");
+    g->depth++;
+}
 
-    switch (s->kind) {
-        case STMT_VARDECL:
-            if (find_var(vars, *count, s->u.vardecl.var_name) < 0) {
-                vars[*count].name = s->u.vardecl.var_name;
-                vars[*count].offset = *offset;
-                vars[*count].is_param = 0;
-                vars[*count].param_index = -1;
-                (*count)++;
-                *offset -= 8;
-            }
-            break;
-        case STMT_IF:
-            collect_vars_stmt(s->u.if_stmt.then_stmt, vars, count, offset);
-            collect_vars_stmt(s->u.if_stmt.else_stmt, vars, count, offset);
-            break;
-        case STMT_WHILE:
-            collect_vars_stmt(s->u.while_stmt.body, vars, count, offset);
-            break;
-        case STMT_FOR:
-            collect_vars_stmt(s->u.for_stmt.init, vars, count, offset);
-            collect_vars_stmt(s->u.for_stmt.body, vars, count, offset);
-            collect_vars_stmt(s->u.for_stmt.step, vars, count, offset);
+static void gen_pop(CodeGen *g, const char *reg) {
+    emit(g, "    popq %s\n", reg);
+    g->depth--;
+}
+
+static void load_var_to_rax(CodeGen *g, const FlatExpr *x) {
+    const char *name = g->fp->names[x->b];
+    switch (x->op) {
+        case VAR_LOCAL:
+            emit(g, "    movq %d(%%rbp), %%rax    # load %s\n", slot_offset(x->a), name);
             break;
-        case STMT_BLOCK:
-            if (s->u.block) {
-                Stmt *curr = s->u.block->head;
-                while (curr) {
-                    collect_vars_stmt(curr, vars, count, offset);
-                    curr = curr->next;
-                }
-            }
+        case VAR_GLOBAL:
+            emit_load_global(g, x->a, ir_undefined_var_msg(g->ir, name));
             break;
         default:
+            emit_error(g, ir_undefined_var_msg(g->ir, name));
+            emit(g, "    xorl %%eax, %%eax\n");
             break;
     }
 }
 
-static void alloc_locals(Function *f, Var *vars, int *var_count, int *stack_size) {
-    int count = 0;
-    int offset = -8;
-    int min_offset = 0;
-
-    /* 매개변수 먼저 */
-    int param_index = 0;
-    if (f->params) {
-        Param *p = f->params->head;
-        while (p) {
-            vars[count].name = p->name;
-            vars[count].offset = offset;
-            vars[count].is_param = 1;
-            vars[count].param_index = param_index;
-            count++;
-            min_offset = offset;
-            offset -= 8;
-            param_index++;
-            p = p->next;
-        }
-    }
+static int is_compare_op(BinOpKind op) {
+    return op >= BIN_LT && op <= BIN_NE;
+}
 
-    /* 지역변수 수집 */
-    if (f->body) {
-        Stmt *s = f->body->head;
-        while (s) {
-            collect_vars_stmt(s, vars, &count, &offset);
-            if (offset < min_offset) min_offset = offset;
-            s = s->next;
-        }
+/* 비교 연산의 플래그만 설정 (lhs 먼저, 상수 rhs는 즉시값으로) */
+static void gen_compare(CodeGen *g, const FlatExpr *x) {
+    FlatId rhs = x->b;
+    gen_expr(g, x->a);
+    if (rhs != FLAT_NONE && g->fp->exprs[rhs].kind == EXPR_INT) {
+        emit(g, "    cmpq $%d, %%rax\n", g->fp->exprs[rhs].a);
+        return;
     }
-
-    *var_count = count;
-    *stack_size = (count == 0) ? 0 : -min_offset + 8;
-
-    /* 16바이트 정렬 */
-    *stack_size = (*stack_size + 15) & ~15;
+    gen_push(g);
+    gen_expr(g, rhs);
+    emit(g, "    movq %%rax, %%rcx\n");
+    gen_pop(g, "%rax");
+    emit(g, "    cmpq %%rcx, %%rax\n");
 }
 
-/* === 표현식 코드 생성 === */
-static void gen_expr(Expr *e, Var *vars, int var_count);
-
-static void load_var_to_rax(const char *name, Var *vars, int var_count) {
-    int idx = find_var(vars, var_count, name);
-    if (idx < 0) {
-        emit("    # ERROR: Unknown variable: %s\n", name);
-        emit("    movq $0, %%rax\n");
+static void gen_binop(CodeGen *g, const FlatExpr *x) {
+    BinOpKind op = (BinOpKind)x->op;
+    if (is_compare_op(op)) {
+        gen_compare(g, x);
+        emit(g, "    set%s %%al\n", setcc_suffix(op));
+        emit(g, "    movzbq %%al, %%rax\n");
         return;
     }
-    emit("    movq %d(%%rbp), %%rax    # load %s\n", vars[idx].offset, name);
-}
 
-static void gen_binop(Expr *e, Var *vars, int var_count) {
-    /* rhs 먼저, lhs 나중 */
-    gen_expr(e->u.binop.rhs, vars, var_count);
-    emit("    pushq %%rax\n");
-    gen_expr(e->u.binop.lhs, vars, var_count);
-    emit("    popq %%rcx\n");  /* rcx = rhs */
+    /* eval_expr와 같이 lhs 먼저 */
+    gen_expr(g, x->a);
+    gen_push(g);
+    gen_expr(g, x->b);
+    emit(g, "    movq %%rax, %%rcx\n");  /* rcx = rhs */
+    gen_pop(g, "%rax");                 /* rax = lhs */
 
-    switch (e->u.binop.op) {
+    switch (op) {
         case BIN_ADD:
-            emit("    addq %%rcx, %%rax    # add\n");
+            emit(g, "    addq %%rcx, %%rax    # add\n");
             break;
         case BIN_SUB:
-            emit("    subq %%rcx, %%rax    # sub\n");
+            emit(g, "    subq %%rcx, %%rax    # sub\n");
             break;
         case BIN_MUL:
-            emit("    imulq %%rcx, %%rax   # mul\n");
+            emit(g, "    imulq %%rcx, %%rax   # mul\n");
             break;
         case BIN_DIV:
-            emit("    cqto\n");
-            emit("    idivq %%rcx          # div\n");
+            emit_divmod(g, 0);
             break;
         case BIN_MOD:
-            emit("    cqto\n");
-            emit("    idivq %%rcx\n");
-            emit("    movq %%rdx, %%rax    # mod (remainder)\n");
-            break;
-        case BIN_LT:
-            emit("    cmpq %%rcx, %%rax\n");
-            emit("    setl %%al\n");
-            emit("    movzbq %%al, %%rax   # less than\n");
-            break;
-        case BIN_GT:
-            emit("    cmpq %%rcx, %%rax\n");
-            emit("    setg %%al\n");
-            emit("    movzbq %%al, %%rax   # greater than\n");
-            break;
-        case BIN_LE:
-            emit("    cmpq %%rcx, %%rax\n");
-            emit("    setle %%al\n");
-            emit("    movzbq %%al, %%rax   # less or equal\n");
-            break;
-        case BIN_GE:
-            emit("    cmpq %%rcx, %%rax\n");
-            emit("    setge %%al\n");
-            emit("    movzbq %%al, %%rax   # greater or equal\n");
-            break;
-        case BIN_EQ:
-            emit("    cmpq %%rcx, %%rax\n");
-            emit("    sete %%al\n");
-            emit("    movzbq %%al, %%rax   # equal\n");
-            break;
-        case BIN_NE:
-            emit("    cmpq %%rcx, %%rax\n");
-            emit("    setne %%al\n");
-            emit("    movzbq %%al, %%rax   # not equal\n");
+            emit_divmod(g, 1);
             break;
         case BIN_AND:
-            emit("    testq %%rax, %%rax\n");
-            emit("    setne %%al\n");
-            emit("    testq %%rcx, %%rcx\n");
-            emit("    setne %%cl\n");
-            emit("    andb %%cl, %%al\n");
-            emit("    movzbq %%al, %%rax   # logical and\n");
+            emit(g, "    testq %%rax, %%rax\n");
+            emit(g, "    setne %%al\n");
+            emit(g, "    testq %%rcx, %%rcx\n");
+            emit(g, "    setne %%cl\n");
+            emit(g, "    andb %%cl, %%al\n");
+            emit(g, "    movzbq %%al, %%rax   # logical and\n");
             break;
         case BIN_OR:
-            emit("    orq %%rcx, %%rax\n");
-            emit("    testq %%rax, %%rax\n");
-            emit("    setne %%al\n");
-            emit("    movzbq %%al, %%rax   # logical or\n");
+            emit(g, "    orq %%rcx, %%rax\n");
+            emit(g, "    setne %%al\n");
+            emit(g, "    movzbq %%al, %%rax   # logical or\n");
             break;
         default:
-            emit("    # unknown binop\n");
+            /* 비교는 gen_compare */
             break;
     }
 }
 
-static void gen_call(Expr *e, Var *vars, int var_count) {
-    /* 인자 평가 및 스택에 저장 */
-    int argc = 0;
-    ExprList *arg = e->u.call.args;
-    while (arg) {
-        gen_expr(arg->expr, vars, var_count);
-        emit("    pushq %%rax\n");
-        argc++;
-        arg = arg->next;
+static void gen_call(CodeGen *g, const FlatCall *c) {
+    const char *name = g->fp->names[c->name];
+    int fi = ir_find_func(g->ir, name);
+    if (fi < 0) {
+        /* eval_call과 같이 인자를 평가하지 않고 에러 */
+        emit_error(g, ir_undefined_func_msg(g->ir, name));
+        emit(g, "    xorl %%eax, %%eax\n");
+        return;
+    }
+
+    int skip = -1;
+    if (g->ir->funcs[fi].needs_check) {
+        skip = new_label(g);
+        emit_check_func(g, fi, ir_undefined_func_msg(g->ir, name), ".Lskip%d_%d", skip);
     }
 
-    if (argc > 6) {
-        emit("    # WARNING: More than 6 arguments not fully supported\n");
+    /* 인자 평가 및 스택에 저장 (최대 16개, 7번째부터는 평가만) */
+    int argc = 0;
+    for (int32_t k = 0; k < c->count && argc < LIR_MAX_ARGS; ++k) {
+        gen_expr(g, g->fp->list[c->first + k]);
+        gen_push(g);
+        argc++;
     }
 
     /* 스택에서 인자 레지스터로 이동 (역순) */
     for (int i = argc - 1; i >= 0; --i) {
-        if (i < 6) {
-            emit("    popq %s\n", arg_regs[i]);
+        if (i < LIR_MAX_REG_PARAMS) {
+            gen_pop(g, x86_reg_name(x86_arg_regs[i]));
         } else {
-            emit("    popq %%rax    # extra arg discarded\n");
+            gen_pop(g, "%rax");
         }
     }
 
-    emit("    call %s\n", e->u.call.func_name);
+    if (g->depth % 2) emit(g, "    subq $8, %%rsp\n");
+    emit(g, "    call ");
+    emit_func_symbol(g, fi);
+    emit(g, "\n");
+    if (g->depth % 2) emit(g, "    addq $8, %%rsp\n");
+
+    if (skip >= 0) emit(g, ".Lskip%d_%d:\n", g->func_id, skip);
 }
 
-static void gen_unary(Expr *e, Var *vars, int var_count) {
-    gen_expr(e->u.unary.operand, vars, var_count);
+static void gen_unary(CodeGen *g, const FlatExpr *x) {
+    gen_expr(g, x->a);
 
-    switch (e->u.unary.op) {
+    switch (x->op) {
         case UNARY_NEG:
-            emit("    negq %%rax           # negate\n");
+            emit(g, "    negq %%rax           # negate\n");
             break;
         case UNARY_NOT:
-            emit("    testq %%rax, %%rax\n");
-            emit("    sete %%al\n");
-            emit("    movzbq %%al, %%rax   # logical not\n");
+            emit(g, "    testq %%rax, %%rax\n");
+            emit(g, "    sete %%al\n");
+            emit(g, "    movzbq %%al, %%rax   # logical not\n");
             break;
     }
 }
 
-/* 문자열 이스케이프 처리 (어셈블리 출력용) */
-static void emit_escaped_string(const char *str) {
-    emit("    .string \"");
-    for (const char *p = str; *p; p++) {
-        switch (*p) {
-            case '\n': emit("\\n"); break;
-            case '\t': emit("\\t"); break;
-            case '\r': emit("\\r"); break;
-            case '\\': emit("\\\\"); break;
-            case '"':  emit("\\\""); break;
-            default:   emit("%c", *p); break;
-        }
+static void gen_expr(CodeGen *g, FlatId e) {
+    if (e == FLAT_NONE) {
+        emit(g, "    movq $0, %%rax\n");
+        return;
     }
-    emit("\"\n");
-}
-
-static void gen_expr(Expr *e, Var *vars, int var_count) {
-    if (!e) return;
 
-    switch (e->kind) {
+    const FlatExpr *x = &g->fp->exprs[e];
+    switch (x->kind) {
         case EXPR_INT:
-            emit("    movq $%d, %%rax\n", e->u.int_value);
+            emit(g, "    movq $%d, %%rax\n", x->a);
             break;
         case EXPR_STRING:
             /* 문자열은 STMT_PRINT에서 별도 처리 */
-            emit("    movq $0, %%rax    # string (handled in print)\n");
+            emit(g, "    movq $0, %%rax    # string (handled in print)\n");
             break;
         case EXPR_VAR:
-            load_var_to_rax(e->u.var_name, vars, var_count);
+            load_var_to_rax(g, x);
             break;
         case EXPR_BINOP:
-            gen_binop(e, vars, var_count);
+            gen_binop(g, x);
             break;
         case EXPR_CALL:
-            gen_call(e, vars, var_count);
+            gen_call(g, &g->fp->calls[x->a]);
             break;
         case EXPR_UNARY:
-            gen_unary(e, vars, var_count);
-            break;
-        default:
-            emit("    # unknown expr kind\n");
+            gen_unary(g, x);
             break;
     }
 }
 
+/* 조건 분기: 조건의 참/거짓이 jump_if와 같으면 target으로, 아니면 다음 명령어로
+ * (lir.c의 lower_cond와 같은 규칙: 비교는 cmp + jcc, &&, ||는 rhs에 효과가 없을 때만 단락) */
+static void gen_cond(CodeGen *g, FlatId e, int jump_if, const char *target) {
+    const FlatExpr *x = e != FLAT_NONE ? &g->fp->exprs[e] : NULL;
+    if (x && x->kind == EXPR_UNARY && x->op == UNARY_NOT) {
+        gen_cond(g, x->a, !jump_if, target);
+        return;
+    }
+    if (x && x->kind == EXPR_BINOP) {
+        BinOpKind op = (BinOpKind)x->op;
+        if (is_compare_op(op)) {
+            gen_compare(g, x);
+            emit(g, "    j%s %s\n", setcc_suffix(jump_if ? (int)op : ir_negate_cc(op)), target);
+            return;
+        }
+        if ((op == BIN_AND || op == BIN_OR) && !flat_expr_has_effects(g->fp, x->b)) {
+            FlatId lhs = x->a, rhs = x->b;
+            if (jump_if == (op == BIN_OR)) {
+                gen_cond(g, lhs, jump_if, target);
+                gen_cond(g, rhs, jump_if, target);
+            } else {
+                char skip[32];
+                snprintf(skip, sizeof(skip), ".Lk%d", new_label(g));
+                gen_cond(g, lhs, !jump_if, skip);
+                gen_cond(g, rhs, jump_if, target);
+                emit(g, "%s:\n", skip);
+            }
+            return;
+        }
+    }
+    gen_expr(g, e);
+    emit(g, "    testq %%rax, %%rax\n");
+    emit(g, "    j%s %s\n", jump_if ? "ne" : "e", target);
+}
+
 /* === 문장 코드 생성 === */
-static void gen_stmt(Stmt *s, Var *vars, int var_count, const char *end_label);
 
-static void gen_stmt(Stmt *s, Var *vars, int var_count, const char *end_label) {
-    if (!s) return;
+static void gen_store(CodeGen *g, const FlatStmt *x) {
+    const char *name = g->fp->names[x->c];
+    if (x->op == VAR_GLOBAL) {
+        emit(g, "    movq %%rax, .Lglobals+%d(%%rip)   # %s = rax\n", x->b * 8, name);
+        emit(g, "    movb $1, .Lgdef+%d(%%rip)\n", x->b);
+    } else {
+        emit(g, "    movq %%rax, %d(%%rbp)   # %s = rax\n", slot_offset(x->b), name);
+    }
+}
+
+/* 꼬리 자기 호출: 인자를 매개변수 슬롯으로 옮기고 본문 처음으로 점프 (스택 사용량 일정) */
+static void gen_tail_call(CodeGen *g, const FlatCall *c) {
+    IrFunc *f = &g->ir->funcs[g->func_id - 1];
+    int argc = 0;
+    for (int32_t k = 0; k < c->count && argc < LIR_MAX_ARGS; ++k) {
+        gen_expr(g, g->fp->list[c->first + k]);
+        gen_push(g);
+        argc++;
+    }
+
+    /* 남는 인자는 버리고 나머지 지역 슬롯은 0 (프롤로그와 동일) */
+    for (int i = argc - 1; i >= 0; --i) {
+        if (i < f->nparams) {
+            emit(g, "    popq %d(%%rbp)   # tail param\n", slot_offset(i));
+            g->depth--;
+        } else {
+            gen_pop(g, "%rax");
+        }
+    }
+    for (int i = f->nparams; i < f->nslots; ++i) {
+        emit(g, "    movq $0, %d(%%rbp)\n", slot_offset(i));
+    }
+    emit(g, "    jmp .Lbody_%d\n", g->func_id);
+}
+
+static void gen_stmt(CodeGen *g, FlatId s) {
+    if (s == FLAT_NONE) return;
 
-    switch (s->kind) {
+    const FlatProgram *fp = g->fp;
+    const FlatStmt *x = &fp->stmts[s];
+    switch (x->kind) {
         case STMT_VARDECL:
-            emit("    # let %s\n", s->u.vardecl.var_name);
-            if (s->u.vardecl.init_value) {
-                gen_expr(s->u.vardecl.init_value, vars, var_count);
-                int idx = find_var(vars, var_count, s->u.vardecl.var_name);
-                if (idx >= 0) {
-                    emit("    movq %%rax, %d(%%rbp)   # %s = init\n",
-                         vars[idx].offset, s->u.vardecl.var_name);
-                }
-            }
+            emit(g, "    # let %s\n", fp->names[x->c]);
+            gen_expr(g, x->a);
+            gen_store(g, x);
             break;
 
-        case STMT_ASSIGN: {
-            gen_expr(s->u.assign.value, vars, var_count);
-            int idx = find_var(vars, var_count, s->u.assign.var_name);
-            if (idx < 0) {
-                emit("    # ERROR: Unknown variable in assign: %s\n", s->u.assign.var_name);
-            } else {
-                emit("    movq %%rax, %d(%%rbp)   # %s = rax\n",
-                     vars[idx].offset, s->u.assign.var_name);
-            }
+        case STMT_ASSIGN:
+            gen_expr(g, x->a);
+            gen_store(g, x);
             break;
-        }
 
         case STMT_EXPR:
-            gen_expr(s->u.expr, vars, var_count);
+            gen_expr(g, x->a);
             break;
 
         case STMT_RETURN:
-            if (s->u.expr) {
-                gen_expr(s->u.expr, vars, var_count);
-            } else {
-                emit("    movq $0, %%rax\n");
+            if (x->a != FLAT_NONE && fp->exprs[x->a].kind == EXPR_CALL && fp->exprs[x->a].op) {
+                gen_tail_call(g, &fp->calls[fp->exprs[x->a].a]);
+                break;
             }
-            emit("    jmp %s\n", end_label);
+            gen_expr(g, x->a);
+            emit(g, "    jmp .Lret_%d\n", g->func_id);
             break;
 
         case STMT_PRINT:
-            if (s->u.expr && s->u.expr->kind == EXPR_STRING) {
-                /* 문자열 출력: puts 사용 */
-                int str_lbl = new_string_label();
-                emit("    .section .rodata\n");
-                emit(".Lstr_%d:\n", str_lbl);
-                emit_escaped_string(s->u.expr->u.string_value);
-                emit("    .text\n");
-                emit("    leaq .Lstr_%d(%%rip), %%rdi\n", str_lbl);
-                emit("    call puts\n");
+            if (x->a != FLAT_NONE && fp->exprs[x->a].kind == EXPR_STRING) {
+                /* 문자열 출력: 런타임 버퍼에 문자열 + 줄바꿈 */
+                const FlatExpr *lit = &fp->exprs[x->a];
+                int str = ir_add_text(g->ir, fp->text + lit->a, (size_t)lit->b);
+                emit(g, "    leaq .Lstr_%d(%%rip), %%rax\n", str);
+                emit(g, "    call __mjs_print_str\n");
             } else {
-                /* 정수 출력: printf 사용 */
-                gen_expr(s->u.expr, vars, var_count);
-                emit("    movq %%rax, %%rsi\n");
-                emit("    leaq fmt_int(%%rip), %%rdi\n");
-                emit("    movq $0, %%rax\n");
-                emit("    call printf\n");
+                /* 정수 출력: 런타임이 10진수로 변환 */
+                gen_expr(g, x->a);
+                emit(g, "    call __mjs_print_int\n");
             }
             break;
 
         case STMT_IF: {
-            int lbl_else = new_label();
-            int lbl_end = new_label();
-
-            gen_expr(s->u.if_stmt.cond, vars, var_count);
-            emit("    cmpq $0, %%rax\n");
-
-            if (s->u.if_stmt.else_stmt) {
-                emit("    je .Lelse_%d\n", lbl_else);
-                gen_stmt(s->u.if_stmt.then_stmt, vars, var_count, end_label);
-                emit("    jmp .Lend_%d\n", lbl_end);
-                emit(".Lelse_%d:\n", lbl_else);
-                gen_stmt(s->u.if_stmt.else_stmt, vars, var_count, end_label);
-                emit(".Lend_%d:\n", lbl_end);
+            int lbl_else = new_label(g);
+            int lbl_end = new_label(g);
+            char target[32];
+
+            if (x->c != FLAT_NONE) {
+                snprintf(target, sizeof(target), ".Lelse_%d", lbl_else);
+                gen_cond(g, x->a, 0, target);
+                gen_stmt(g, x->b);
+                emit(g, "    jmp .Lend_%d\n", lbl_end);
+                emit(g, ".Lelse_%d:\n", lbl_else);
+                gen_stmt(g, x->c);
+                emit(g, ".Lend_%d:\n", lbl_end);
             } else {
-                emit("    je .Lend_%d\n", lbl_end);
-                gen_stmt(s->u.if_stmt.then_stmt, vars, var_count, end_label);
-                emit(".Lend_%d:\n", lbl_end);
+                snprintf(target, sizeof(target), ".Lend_%d", lbl_end);
+                gen_cond(g, x->a, 0, target);
+                gen_stmt(g, x->b);
+                emit(g, ".Lend_%d:\n", lbl_end);
             }
             break;
         }
 
         case STMT_WHILE: {
-            int lbl_begin = new_label();
-            int lbl_end = new_label();
-
-            emit(".Lbegin_%d:\n", lbl_begin);
-            gen_expr(s->u.while_stmt.cond, vars, var_count);
-            emit("    cmpq $0, %%rax\n");
-            emit("    je .Lend_%d\n", lbl_end);
-            gen_stmt(s->u.while_stmt.body, vars, var_count, end_label);
-            emit("    jmp .Lbegin_%d\n", lbl_begin);
-            emit(".Lend_%d:\n", lbl_end);
+            int lbl_begin = new_label(g);
+            int lbl_end = new_label(g);
+            char target[32];
+            snprintf(target, sizeof(target), ".Lend_%d", lbl_end);
+
+            emit(g, ".Lbegin_%d:\n", lbl_begin);
+            gen_cond(g, x->a, 0, target);
+            gen_stmt(g, x->b);
+            emit(g, "    jmp .Lbegin_%d\n", lbl_begin);
+            emit(g, ".Lend_%d:\n", lbl_end);
             break;
         }
 
         case STMT_FOR: {
-            int lbl_begin = new_label();
-            int lbl_end = new_label();
+            int lbl_begin = new_label(g);
+            int lbl_end = new_label(g);
+            char target[32];
+            snprintf(target, sizeof(target), ".Lend_%d", lbl_end);
 
             /* 초기화 */
-            if (s->u.for_stmt.init) {
-                gen_stmt(s->u.for_stmt.init, vars, var_count, end_label);
-            }
+            gen_stmt(g, x->a);
 
-            emit(".Lbegin_%d:\n", lbl_begin);
+            emit(g, ".Lbegin_%d:\n", lbl_begin);
 
             /* 조건 (없으면 항상 true) */
-            if (s->u.for_stmt.cond) {
-                gen_expr(s->u.for_stmt.cond, vars, var_count);
-                emit("    cmpq $0, %%rax\n");
-                emit("    je .Lend_%d\n", lbl_end);
+            if (x->b != FLAT_NONE) {
+                gen_cond(g, x->b, 0, target);
             }
 
-            /* 본문 */
-            gen_stmt(s->u.for_stmt.body, vars, var_count, end_label);
+            /* 본문, 스텝 */
+            gen_stmt(g, x->d);
+            gen_stmt(g, x->c);
 
-            /* 스텝 */
-            if (s->u.for_stmt.step) {
-                gen_stmt(s->u.for_stmt.step, vars, var_count, end_label);
-            }
-
-            emit("    jmp .Lbegin_%d\n", lbl_begin);
-            emit(".Lend_%d:\n", lbl_end);
+            emit(g, "    jmp .Lbegin_%d\n", lbl_begin);
+            emit(g, ".Lend_%d:\n", lbl_end);
             break;
         }
 
         case STMT_BLOCK:
-            if (s->u.block) {
-                Stmt *curr = s->u.block->head;
-                while (curr) {
-                    gen_stmt(curr, vars, var_count, end_label);
-                    curr = curr->next;
-                }
+            for (int32_t k = 0; k < x->b; ++k) {
+                gen_stmt(g, fp->list[x->a + k]);
             }
             break;
-
-        default:
-            emit("    # unknown stmt kind\n");
-            break;
     }
 }
 
-/* === 함수 코드 생성 === */
-static void gen_function(Function *f) {
-    Var vars[128];
-    int var_count = 0;
-    int stack_size = 0;
+/* 프롤로그: 슬롯 nslots개 (16바이트 정렬), 매개변수 저장, 나머지 슬롯은 0 */
+static void gen_prologue(CodeGen *g, int nparams, int nslots) {
+    int stack_size = (nslots * 8 + 15) & ~15;
+    emit_depth_enter(g);
+    emit(g, "    pushq %%rbp\n");
+    emit(g, "    movq %%rsp, %%rbp\n");
+    if (stack_size > 0) {
+        emit(g, "    subq $%d, %%rsp\n", stack_size);
+    }
+    for (int i = 0; i < nslots; ++i) {
+        if (i < nparams) {
+            emit(g, "    movq %s, %d(%%rbp)   # param\n", x86_reg_name(x86_arg_regs[i]), slot_offset(i));
+        } else {
+            emit(g, "    movq $0, %d(%%rbp)\n", slot_offset(i));
+        }
+    }
+    g->depth = 0;
+}
 
-    alloc_locals(f, vars, &var_count, &stack_size);
+static void gen_epilogue(CodeGen *g) {
+    emit(g, "    movq $0, %%rax\n");
+    emit(g, ".Lret_%d:\n", g->func_id);
+    emit(g, "    leave\n");
+    emit_depth_leave(g);
+    emit(g, "    ret\n");
+}
 
-    int is_main = (strcmp(f->name, "main") == 0);
+/* === 함수 코드 생성 === */
+static void gen_function(CodeGen *g, int fi) {
+    IrFunc *f = &g->ir->funcs[fi];
+    const FlatFunc *ff = &g->fp->funcs[f->func->index];
+    g->func_id = fi + 1;
+
+    emit(g, "\n");
+    emit_func_symbol(g, fi);
+    emit(g, ":\n");
+    gen_prologue(g, f->nparams, f->nslots);
+    if (f->func->tail_calls) emit(g, ".Lbody_%d:\n", g->func_id);
+
+    for (int32_t k = 0; k < ff->count; ++k) {
+        gen_stmt(g, g->fp->list[ff->first + k]);
+    }
+    gen_epilogue(g);
+}
 
-    emit("\n");
-    emit("    .globl %s\n", f->name);
-    emit("%s:\n", f->name);
+/* === Top-level 문장들을 main으로 래핑 (11wk gen_stmt 재사용) === */
+static void gen_top_level_wrapper(CodeGen *g) {
+    IrProgram *ip = g->ir;
+    const FlatProgram *fp = g->fp;
+    g->func_id = 0;
 
-    /* 프롤로그 */
-    emit("    pushq %%rbp\n");
-    emit("    movq %%rsp, %%rbp\n");
-    if (stack_size > 0) {
-        emit("    subq $%d, %%rsp\n", stack_size);
-    }
+    emit_main_entry(g);
+    gen_prologue(g, 0, ip->main.nslots);
 
-    /* 매개변수를 스택에 저장 */
-    for (int i = 0; i < var_count; ++i) {
-        if (vars[i].is_param) {
-            int pi = vars[i].param_index;
-            if (pi < 6) {
-                emit("    movq %s, %d(%%rbp)   # param %s\n",
-                     arg_regs[pi], vars[i].offset, vars[i].name);
+    for (int i = 0; i < fp->nitems; ++i) {
+        const FlatItem *item = &fp->items[i];
+        if (item->kind == ITEM_FUNCTION) {
+            Function *func = fp->funcs[item->index].func;
+            int fi = ir_find_func(ip, func->name);
+            if (ip->funcs[fi].func == func && ip->funcs[fi].needs_check) {
+                emit(g, "    movb $1, .Lfdef+%d(%%rip)   # define %s\n", fi, func->name);
             }
+        } else {
+            gen_stmt(g, item->index);
         }
     }
+    gen_epilogue(g);
+}
 
-    /* 종료 레이블 */
-    char end_label[64];
-    snprintf(end_label, sizeof(end_label), ".Lend_%s", f->name);
-
-    /* 본문 실행 */
-    if (f->body) {
-        Stmt *s = f->body->head;
-        while (s) {
-            gen_stmt(s, vars, var_count, end_label);
-            s = s->next;
-        }
+static void gen_program_o0(CodeGen *g) {
+    g->fp = flat_build(g->ir->prog);
+    for (int i = 0; i < g->ir->nfuncs; ++i) {
+        gen_function(g, i);
     }
+    gen_top_level_wrapper(g);
+    flat_free(g->fp);
+    g->fp = NULL;
+}
+
+/* ================================================================
+ * -O1: 레지스터 할당된 LIR 출력
+ * vreg 위치는 레지스터 또는 스필 슬롯, %rax/%rcx/%rdx는 스크래치
+ * ================================================================ */
+
+typedef char Operand[32];
 
-    /* 기본 반환값 */
-    if (is_main) {
-        emit("    movq $0, %%rax\n");
+static void loc_operand(CodeGen *g, int loc, Operand buf) {
+    if (LIR_LOC_IS_REG(loc)) {
+        snprintf(buf, sizeof(Operand), "%s", x86_reg_name(loc));
+    } else {
+        snprintf(buf, sizeof(Operand), "%d(%%rbp)", -8 * (g->ncallee + LIR_LOC_SLOT(loc) + 1));
     }
+}
 
-    /* 에필로그 */
-    emit("%s:\n", end_label);
-    emit("    leave\n");
-    emit("    ret\n");
+static int val_loc(CodeGen *g, LirVal v) {
+    return v.kind == LIR_VREG ? g->f->loc[v.value] : -1;
 }
 
-/* === Top-level 문장들을 main으로 래핑 (11wk gen_stmt 재사용) === */
-static void gen_top_level_wrapper(Program *prog, Var *vars, int var_count) {
-    emit("\n");
-    emit("    .globl main\n");
-    emit("main:\n");
-    emit("    pushq %%rbp\n");
-    emit("    movq %%rsp, %%rbp\n");
-
-    int stack_size = (var_count == 0) ? 0 : var_count * 8;
-    stack_size = (stack_size + 15) & ~15;
-    if (stack_size > 0) {
-        emit("    subq $%d, %%rsp\n", stack_size);
+static void val_operand(CodeGen *g, LirVal v, Operand buf) {
+    if (v.kind == LIR_IMM) {
+        snprintf(buf, sizeof(Operand), "$%ld", v.value);
+    } else {
+        loc_operand(g, val_loc(g, v), buf);
     }
+}
 
-    char end_label[] = ".Lend_main";
+static int val_is_mem(CodeGen *g, LirVal v) {
+    return v.kind == LIR_VREG && !LIR_LOC_IS_REG(val_loc(g, v));
+}
 
-    /* top-level 문장만 실행 (11wk gen_stmt 재사용) */
-    Item *item = prog->items;
-    while (item) {
-        if (item->kind == ITEM_STMT) {
-            gen_stmt(item->u.stmt, vars, var_count, end_label);
-        }
-        item = item->next;
+/* reg = v */
+static void load_reg(CodeGen *g, int reg, LirVal v) {
+    if (v.kind == LIR_IMM && v.value == 0) {
+        emit(g, "    xorl %s, %s\n", x86_reg_name32(reg), x86_reg_name32(reg));
+        return;
     }
+    if (val_loc(g, v) == reg) return;
+    Operand src;
+    val_operand(g, v, src);
+    emit(g, "    movq %s, %s\n", src, x86_reg_name(reg));
+}
 
-    emit("    movq $0, %%rax\n");
-    emit("%s:\n", end_label);
-    emit("    leave\n");
-    emit("    ret\n");
+/* loc = reg */
+static void store_reg(CodeGen *g, int loc, int reg) {
+    if (loc == reg) return;
+    Operand dst;
+    loc_operand(g, loc, dst);
+    emit(g, "    movq %s, %s\n", x86_reg_name(reg), dst);
 }
 
-/* === 프로그램 전체 코드 생성 === */
-void gen_x86_program(Program *prog) {
-    if (!prog) {
-        fprintf(stderr, "No program to generate.\n");
+/* loc = v (메모리끼리는 %rax 경유) */
+static void move_val(CodeGen *g, int loc, LirVal v) {
+    if (v.kind == LIR_VREG && val_loc(g, v) == loc) return;
+    if (LIR_LOC_IS_REG(loc)) {
+        load_reg(g, loc, v);
+    } else if (val_is_mem(g, v)) {
+        load_reg(g, X86_RAX, v);
+        store_reg(g, loc, X86_RAX);
+    } else {
+        Operand src, dst;
+        val_operand(g, v, src);
+        loc_operand(g, loc, dst);
+        emit(g, "    movq %s, %s\n", src, dst);
+    }
+}
+
+static void emit_regmove(CodeGen *g, const RegMove *m) {
+    if (m->src_imm) {
+        LirVal v = { LIR_IMM, m->imm };
+        move_val(g, m->dst, v);
         return;
     }
+    Operand src, dst;
+    loc_operand(g, m->src, src);
+    loc_operand(g, m->dst, dst);
+    if (!LIR_LOC_IS_REG(m->src) && !LIR_LOC_IS_REG(m->dst)) {
+        emit(g, "    movq %s, %%rax\n", src);
+        emit(g, "    movq %%rax, %s\n", dst);
+    } else {
+        emit(g, "    movq %s, %s\n", src, dst);
+    }
+}
 
-    out_file = stdout;
-    out_buffer = NULL;
-    label_counter = 0;
-    string_counter = 0;
+static void emit_block_label(CodeGen *g, int label) {
+    emit(g, ".LB%d_%d:\n", g->func_id, label);
+}
 
-    /* 데이터 섹션 */
-    emit("    .section .rodata\n");
-    emit("fmt_int:\n");
-    emit("    .string \"%%ld\\n\"\n");
+/* dst = a op b (add, sub, imul) */
+static void emit_arith(CodeGen *g, const LirInst *in, const char *mnemonic, int commutative) {
+    int d = g->f->loc[in->dst];
+    Operand a, b, dst;
+    val_operand(g, in->a, a);
+    val_operand(g, in->b, b);
+    loc_operand(g, d, dst);
+    int b_in_d = val_loc(g, in->b) == d;
+
+    if (LIR_LOC_IS_REG(d) && !b_in_d) {
+        move_val(g, d, in->a);
+        emit(g, "    %s %s, %s\n", mnemonic, b, dst);
+    } else if (LIR_LOC_IS_REG(d) && commutative) {
+        emit(g, "    %s %s, %s\n", mnemonic, a, dst);
+    } else {
+        load_reg(g, X86_RAX, in->a);
+        emit(g, "    %s %s, %%rax\n", mnemonic, b);
+        store_reg(g, d, X86_RAX);
+    }
+}
 
-    /* 코드 섹션 */
-    emit("    .text\n");
+/* %al의 0/1을 dst로 */
+static void store_flag(CodeGen *g, int d) {
+    if (LIR_LOC_IS_REG(d)) {
+        emit(g, "    movzbl %%al, %s\n", x86_reg_name32(d));
+    } else {
+        emit(g, "    movzbl %%al, %%eax\n");
+        store_reg(g, d, X86_RAX);
+    }
+}
 
-    /* 1. 함수들 먼저 생성 (12wk gen_function 재사용) */
-    Item *item = prog->items;
-    while (item) {
-        if (item->kind == ITEM_FUNCTION) {
-            gen_function(item->u.function);
-        }
-        item = item->next;
+/* 비교: 왼쪽은 레지스터 또는 메모리여야 하고 둘 다 메모리일 수 없음 */
+static void emit_compare(CodeGen *g, LirVal a, LirVal b) {
+    Operand aop, bop;
+    if (a.kind == LIR_IMM || (val_is_mem(g, a) && val_is_mem(g, b))) {
+        load_reg(g, X86_RAX, a);
+        snprintf(aop, sizeof(Operand), "%%rax");
+    } else {
+        val_operand(g, a, aop);
     }
+    val_operand(g, b, bop);
+    emit(g, "    cmpq %s, %s\n", bop, aop);
+}
 
-    /* 2. top-level 문장이 있으면 main 래퍼 생성 */
-    int has_top_level = 0;
-    item = prog->items;
-    while (item) {
-        if (item->kind == ITEM_STMT) {
-            has_top_level = 1;
-            break;
-        }
-        item = item->next;
-    }
-
-    if (has_top_level) {
-        /* top-level 변수 수집 */
-        Var vars[128];
-        int var_count = 0;
-        int offset = -8;
-        item = prog->items;
-        while (item) {
-            if (item->kind == ITEM_STMT) {
-                collect_vars_stmt(item->u.stmt, vars, &var_count, &offset);
-            }
-            item = item->next;
-        }
-        gen_top_level_wrapper(prog, vars, var_count);
+/* 비교 후 바로 조건 점프 (상수는 오른쪽으로, 0과 비교는 testq) */
+static void emit_jcc(CodeGen *g, const LirInst *in) {
+    LirVal a = in->a, b = in->b;
+    int cc = in->cc;
+    if (a.kind == LIR_IMM && b.kind != LIR_IMM) {
+        LirVal t = a;
+        a = b;
+        b = t;
+        cc = ir_swap_cc(cc);
+    }
+    if (b.kind == LIR_IMM && b.value == 0 && a.kind == LIR_VREG && !val_is_mem(g, a)) {
+        const char *r = x86_reg_name(val_loc(g, a));
+        emit(g, "    testq %s, %s\n", r, r);
+    } else {
+        emit_compare(g, a, b);
     }
+    emit(g, "    j%s .LB%d_%d\n", setcc_suffix(cc), g->func_id, in->label);
 }
 
-/* 버퍼로 출력 (Wasm용) */
-int gen_x86_to_buffer(Program *prog, char *buffer, int bufsize) {
-    if (!prog || !buffer || bufsize <= 0) {
-        return 0;
+static void emit_call(CodeGen *g, const LirInst *in) {
+    RegMove moves[LIR_MAX_REG_PARAMS], seq[2 * LIR_MAX_REG_PARAMS];
+    int n = in->nargs < LIR_MAX_REG_PARAMS ? in->nargs : LIR_MAX_REG_PARAMS;
+    for (int i = 0; i < n; ++i) {
+        moves[i].dst = x86_arg_regs[i];
+        moves[i].src_imm = in->args[i].kind == LIR_IMM;
+        moves[i].src = moves[i].src_imm ? -1 : val_loc(g, in->args[i]);
+        moves[i].imm = in->args[i].value;
     }
+    int nseq = regalloc_sequence_moves(moves, n, X86_RAX, seq);
+    for (int i = 0; i < nseq; ++i) emit_regmove(g, &seq[i]);
 
-    out_file = NULL;
-    out_buffer = buffer;
-    out_bufsize = bufsize;
-    out_pos = 0;
-    label_counter = 0;
-    string_counter = 0;
+    emit(g, "    call ");
+    emit_func_symbol(g, in->index);
+    emit(g, "\n");
+    store_reg(g, g->f->loc[in->dst], X86_RAX);
+}
 
-    /* 데이터 섹션 */
-    emit("    .section .rodata\n");
-    emit("fmt_int:\n");
-    emit("    .string \"%%ld\\n\"\n");
+static void emit_inst(CodeGen *g, const LirInst *in, int is_last) {
+    int d = in->dst >= 0 ? g->f->loc[in->dst] : -1;
+    Operand a;
 
-    /* 코드 섹션 */
-    emit("    .text\n");
+    switch (in->op) {
+        case LIR_LABEL:
+            emit_block_label(g, in->label);
+            break;
 
-    /* 1. 함수들 먼저 생성 */
-    Item *item = prog->items;
-    while (item) {
-        if (item->kind == ITEM_FUNCTION) {
-            gen_function(item->u.function);
+        case LIR_MOV:
+            move_val(g, d, in->a);
+            break;
+
+        case LIR_LOADG:
+            emit_load_global(g, in->index, in->str);
+            store_reg(g, d, X86_RAX);
+            break;
+
+        case LIR_STOREG:
+            if (val_is_mem(g, in->a)) {
+                load_reg(g, X86_RAX, in->a);
+                snprintf(a, sizeof(Operand), "%%rax");
+            } else {
+                val_operand(g, in->a, a);
+            }
+            emit(g, "    movq %s, .Lglobals+%d(%%rip)\n", a, in->index * 8);
+            emit(g, "    movb $1, .Lgdef+%d(%%rip)\n", in->index);
+            break;
+
+        case LIR_ADD:
+            emit_arith(g, in, "addq", 1);
+            break;
+
+        case LIR_SUB:
+            emit_arith(g, in, "subq", 0);
+            break;
+
+        case LIR_MUL:
+            emit_arith(g, in, "imulq", 1);
+            break;
+
+        case LIR_DIV:
+        case LIR_MOD:
+            load_reg(g, X86_RCX, in->b);
+            load_reg(g, X86_RAX, in->a);
+            emit_divmod(g, in->op == LIR_MOD);
+            store_reg(g, d, X86_RAX);
+            break;
+
+        case LIR_SETCC:
+            emit_compare(g, in->a, in->b);
+            emit(g, "    set%s %%al\n", setcc_suffix(in->cc));
+            store_flag(g, d);
+            break;
+
+        case LIR_LAND:
+            load_reg(g, X86_RAX, in->a);
+            load_reg(g, X86_RCX, in->b);
+            emit(g, "    testq %%rax, %%rax\n");
+            emit(g, "    setne %%al\n");
+            emit(g, "    testq %%rcx, %%rcx\n");
+            emit(g, "    setne %%cl\n");
+            emit(g, "    andb %%cl, %%al\n");
+            store_flag(g, d);
+            break;
+
+        case LIR_LOR:
+            load_reg(g, X86_RAX, in->a);
+            val_operand(g, in->b, a);
+            emit(g, "    orq %s, %%rax\n", a);
+            emit(g, "    setne %%al\n");
+            store_flag(g, d);
+            break;
+
+        case LIR_NEG:
+            if (LIR_LOC_IS_REG(d)) {
+                move_val(g, d, in->a);
+                emit(g, "    negq %s\n", x86_reg_name(d));
+            } else {
+                load_reg(g, X86_RAX, in->a);
+                emit(g, "    negq %%rax\n");
+                store_reg(g, d, X86_RAX);
+            }
+            break;
+
+        case LIR_NOT: {
+            LirVal zero = { LIR_IMM, 0 };
+            emit_compare(g, in->a, zero);
+            emit(g, "    sete %%al\n");
+            store_flag(g, d);
+            break;
         }
-        item = item->next;
-    }
 
-    /* 2. top-level 문장이 있으면 main 래퍼 생성 */
-    int has_top_level = 0;
-    item = prog->items;
-    while (item) {
-        if (item->kind == ITEM_STMT) {
-            has_top_level = 1;
+        case LIR_JMP:
+            emit(g, "    jmp .LB%d_%d\n", g->func_id, in->label);
+            break;
+
+        case LIR_JCC:
+            emit_jcc(g, in);
+            break;
+
+        case LIR_CALL:
+            emit_call(g, in);
+            break;
+
+        case LIR_RET:
+            load_reg(g, X86_RAX, in->a);
+            if (!is_last) emit(g, "    jmp .Lret_%d\n", g->func_id);
+            break;
+
+        case LIR_PRINT_INT:
+            load_reg(g, X86_RAX, in->a);
+            emit(g, "    call __mjs_print_int\n");
+            break;
+
+        case LIR_PRINT_STR:
+            emit(g, "    leaq .Lstr_%d(%%rip), %%rax\n", in->str);
+            emit(g, "    call __mjs_print_str\n");
+            break;
+
+        case LIR_ERROR:
+            emit_error(g, in->str);
+            break;
+
+        case LIR_DEFFN:
+            emit(g, "    movb $1, .Lfdef+%d(%%rip)\n", in->index);
+            break;
+
+        case LIR_CHKFN:
+            emit_check_func(g, in->index, in->str, ".LB%d_%d", in->label);
             break;
+
+        case LIR_OP_COUNT:
+            break;
+    }
+}
+
+/* 프롤로그: rbp 프레임, 사용한 callee-saved 저장, 스필 영역 (16바이트 정렬) */
+static void emit_lir_function(CodeGen *g, LirFunc *f, int func_id) {
+    g->f = f;
+    g->func_id = func_id;
+    g->ncallee = 0;
+
+    emit_depth_enter(g);
+    emit(g, "    pushq %%rbp\n");
+    emit(g, "    movq %%rsp, %%rbp\n");
+    for (int r = 0; r < X86_NREGS; ++r) {
+        if (f->callee_used & (1u << r)) {
+            emit(g, "    pushq %s\n", x86_reg_name(r));
+            g->ncallee++;
         }
-        item = item->next;
     }
+    int frame = (g->ncallee + f->nspills) * 8;
+    frame = ((frame + 15) & ~15) - g->ncallee * 8;
+    if (frame > 0) emit(g, "    subq $%d, %%rsp\n", frame);
+
+    /* 매개변수를 할당된 위치로 (병렬 이동) */
+    RegMove moves[LIR_MAX_REG_PARAMS], seq[2 * LIR_MAX_REG_PARAMS];
+    for (int i = 0; i < f->nparams; ++i) {
+        moves[i].dst = f->loc[i];
+        moves[i].src = x86_arg_regs[i];
+        moves[i].src_imm = 0;
+        moves[i].imm = 0;
+    }
+    int nseq = regalloc_sequence_moves(moves, f->nparams, X86_RAX, seq);
+    for (int i = 0; i < nseq; ++i) emit_regmove(g, &seq[i]);
 
-    if (has_top_level) {
-        Var vars[128];
-        int var_count = 0;
-        int offset = -8;
-        item = prog->items;
-        while (item) {
-            if (item->kind == ITEM_STMT) {
-                collect_vars_stmt(item->u.stmt, vars, &var_count, &offset);
-            }
-            item = item->next;
+    for (int i = 0; i < f->nzero_init; ++i) {
+        LirVal zero = { LIR_IMM, 0 };
+        move_val(g, f->loc[f->zero_init[i]], zero);
+    }
+
+    for (int i = 0; i < f->ncode; ++i) {
+        emit_inst(g, &f->code[i], i == f->ncode - 1);
+    }
+
+    emit(g, ".Lret_%d:\n", func_id);
+    if (g->ncallee > 0) {
+        emit(g, "    leaq -%d(%%rbp), %%rsp\n", g->ncallee * 8);
+        for (int r = X86_NREGS - 1; r >= 0; --r) {
+            if (f->callee_used & (1u << r)) emit(g, "    popq %s\n", x86_reg_name(r));
         }
-        gen_top_level_wrapper(prog, vars, var_count);
+        emit(g, "    popq %%rbp\n");
+    } else {
+        emit(g, "    leave\n");
+    }
+    emit_depth_leave(g);
+    emit(g, "    ret\n");
+}
+
+static void gen_program_o1(CodeGen *g) {
+    ir_build(g->ir);
+    LirProgram *lp = lir_lower(g->ir);
+    regalloc_program(lp);
+    g->lp = lp;
+
+    for (int i = 0; i < lp->nfuncs; ++i) {
+        emit(g, "\n");
+        emit_func_symbol(g, i);
+        emit(g, ":\n");
+        emit_lir_function(g, &lp->funcs[i], i + 1);
     }
 
-    /* 널 종료 보장 */
-    if (out_pos < bufsize) {
-        buffer[out_pos] = '\0';
+    emit_main_entry(g);
+    emit_lir_function(g, &lp->main, 0);
+    lir_free(lp);
+}
+
+/* === 프로그램 전체 코드 생성 === */
+
+static int gen_program(Program *prog, Output *out, int opt_level, const char **error) {
+    const char *reason = NULL;
+    IrProgram *ip = ir_new(prog, &reason);
+    if (ip && (reason = lir_check_native(ip)) != NULL) {
+        ir_free(ip);
+        ip = NULL;
+    }
+    if (!ip) {
+        if (error) *error = reason;
+        return -1;
+    }
+
+    CodeGen g;
+    memset(&g, 0, sizeof(g));
+    g.out = out;
+    g.ir = ip;
+    g.div_msg = ir_add_string(ip, "Error: division by zero\n");
+    g.mod_msg = ir_add_string(ip, "Error: modulo by zero\n");
+    g.call_depth_msg = ir_add_string(ip, "Error: maximum call depth exceeded\n");
+
+    emit(&g, "    # Mini-JS x86-64 (-O%d)\n", opt_level);
+    emit(&g, "    .text\n");
+    emit_runtime(&g);
+    emit_depth_overflow(&g);
+    if (opt_level > 0) {
+        gen_program_o1(&g);
     } else {
-        buffer[bufsize - 1] = '\0';
+        gen_program_o0(&g);
     }
+    emit_data(&g);
 
-    int result = out_pos;
-    out_buffer = NULL;
-    out_bufsize = 0;
-    out_pos = 0;
+    ir_free(ip);
+    return 0;
+}
 
-    return result;
+int gen_x86_program(Program *prog, Output *out, int opt_level, const char **error) {
+    if (error) *error = NULL;
+    return gen_program(prog, out, opt_level, error);
+}
+
+/* 버퍼로 출력 (Wasm용) */
+int gen_x86_to_buffer(Program *prog, char *buffer, int bufsize, int opt_level, const char **error) {
+    if (error) *error = NULL;
+    if (!buffer || bufsize <= 0) {
+        return 0;
+    }
+
+    Output out;
+    output_init_buffer(&out, buffer, bufsize);
+    if (gen_program(prog, &out, opt_level, error) != 0) {
+        return -1;
+    }
+    return out.pos;
 }
@@ -0,0 +1,216 @@
+/* Mini-JS 컨텍스트
+ * 재진입 스캐너 + 순수 파서 + 출력 대상을 묶어 한 스레드의 작업 단위로 제공
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "ast.h"
+#include "accum.h"
+#include "fold.h"
+#include "dce.h"
+#include "scanner.h"
+#include "parser.tab.h"
+#include "eval.h"
+#include "vm.h"
+#include "flat.h"
+#include "precompile.h"
+#include "jit_x86.h"
+#include "ir.h"
+#include "codegen_x86.h"
+#include "context.h"
+
+MiniJSContext *minijs_context_new(void) {
+    MiniJSContext *ctx = (MiniJSContext *)calloc(1, sizeof(MiniJSContext));
+    if (!ctx) return NULL;
+    ctx->scanner = scanner_create();
+    if (!ctx->scanner) {
+        free(ctx);
+        return NULL;
+    }
+    output_init_file(&ctx->out, stdout);
+    ctx->opt_level = X86_OPT_DEFAULT;
+    ctx->tier_threshold = EVAL_TIER_DEFAULT_THRESHOLD;
+    return ctx;
+}
+
+void minijs_context_free(MiniJSContext *ctx) {
+    if (!ctx) return;
+    minijs_release_program(ctx);
+    output_release(&ctx->out);
+    scanner_destroy(ctx->scanner);
+    free(ctx);
+}
+
+void minijs_release_program(MiniJSContext *ctx) {
+    if (ctx->program) {
+        free_program(ctx->program);
+        ctx->program = NULL;
+    }
+}
+
+/* 현재 프로그램의 x86-64 어셈블리 크기 (바이트, 생성 실패 시 -1) */
+static long assembly_size(MiniJSContext *ctx) {
+    Output out;
+    const char *error = NULL;
+    output_init_grow(&out);
+    long size = gen_x86_program(ctx->program, &out, ctx->opt_level, &error) == 0 ? (long)out.pos : -1;
+    output_release(&out);
+    return size;
+}
+
+/* 입력이 준비된 스캐너로 파싱 */
+static int parse_program(MiniJSContext *ctx) {
+    ctx->program = new_program();
+    if (yyparse(ctx->scanner, ctx->program) != 0) {
+        minijs_release_program(ctx);
+        return -1;
+    }
+    phase_mark(ctx->phases, "parse");
+    /* 빈 입력인지는 패스 전에 판정 (호출되지 않는 함수만 있으면 DCE 뒤에 items가 비어도 유효한 프로그램) */
+    if (!ctx->program->items) {
+        ctx->program->empty = 1;
+        return 0;
+    }
+    /* 문자열 리터럴은 소스 구간이므로 소스를 프로그램과 같은 수명으로 */
+    scanner_take_source(ctx->scanner, &ctx->program->source);
+    return 0;
+}
+
+void minijs_optimize(MiniJSContext *ctx) {
+    if (!ctx->program || ctx->program->empty || ctx->program->optimized) return;
+    ctx->program->optimized = 1;
+    accum_rewrite(ctx->program, ctx->accum_report);
+
+    FoldStats fs;
+    fold_program(ctx->program, &fs);
+    FILE *report = ctx->opt_report;
+    long before = 0;
+    if (report) {
+        fprintf(report, "=== Optimization Report ===\n");
+        fprintf(report, "fold: %d folded, %d simplified, %d propagated\n",
+                fs.folded, fs.simplified, fs.propagated);
+        before = assembly_size(ctx);
+        fprintf(report, "dce:\n");
+    }
+
+    DceStats ds;
+    dce_program(ctx->program, &ds, report);
+    if (report) {
+        fprintf(report, "dce: %d function(s), %d statement(s) removed\n", ds.functions, ds.statements);
+        long after = assembly_size(ctx);
+        if (before >= 0 && after >= 0) {
+            fprintf(report, "assembly (-O%d): %ld -> %ld bytes (%ld saved)\n",
+                    ctx->opt_level, before, after, before - after);
+        } else {
+            fprintf(report, "assembly (-O%d): n/a\n", ctx->opt_level);
+        }
+    }
+    phase_mark(ctx->phases, "optimize");
+}
+
+int minijs_parse_file(MiniJSContext *ctx, FILE *in) {
+    minijs_release_program(ctx);
+    yy_scan_file(in, ctx->scanner);
+    int result = parse_program(ctx);
+    yy_scan_file_release(ctx->scanner);
+    return result;
+}
+
+int minijs_parse_string(MiniJSContext *ctx, const char *source) {
+    minijs_release_program(ctx);
+    yy_scan_string_custom(source, ctx->scanner);
+    int result = parse_program(ctx);
+    yy_reset_input(ctx->scanner);
+    return result;
+}
+
+void minijs_set_output_file(MiniJSContext *ctx, FILE *file) {
+    output_release(&ctx->out);
+    output_init_file(&ctx->out, file);
+}
+
+void minijs_set_output_buffer(MiniJSContext *ctx, char *buffer, int bufsize) {
+    output_release(&ctx->out);
+    output_init_buffer(&ctx->out, buffer, bufsize);
+}
+
+void minijs_set_output_grow(MiniJSContext *ctx) {
+    output_release(&ctx->out);
+    output_init_grow(&ctx->out);
+}
+
+/* 엔진 선택 후 실행 (minijs_eval이 출력을 flush) */
+static int eval_engine(MiniJSContext *ctx, int engine, int *used_engine, const char **engine_error) {
+    if (used_engine) *used_engine = 0;
+    if (engine_error) *engine_error = NULL;
+    if (engine == MINIJS_ENGINE_VM) {
+        return vm_eval_program(ctx->program, &ctx->out, used_engine, engine_error);
+    }
+    if (engine == MINIJS_ENGINE_JIT) {
+        return jit_eval_program(ctx->program, &ctx->out, used_engine, engine_error);
+    }
+    if (engine == MINIJS_ENGINE_FLAT) {
+        return flat_eval_program(ctx->program, &ctx->out, used_engine, engine_error);
+    }
+    if (engine == MINIJS_ENGINE_TIER || ctx->memoize || ctx->stats) {
+        EvalOptions opts;
+        opts.tier = engine == MINIJS_ENGINE_TIER;
+        opts.tier_threshold = ctx->tier_threshold;
+        opts.tier_stats = ctx->tier_stats;
+        opts.memoize = ctx->memoize;
+        opts.memo_stats = ctx->memo_stats;
+        opts.stats = ctx->stats;
+        if (used_engine) *used_engine = 1;
+        return eval_program_with_options(ctx->program, &ctx->out, &opts);
+    }
+    return eval_program(ctx->program, &ctx->out);
+}
+
+int minijs_eval(MiniJSContext *ctx, int engine, int *used_engine, const char **engine_error) {
+    minijs_optimize(ctx);
+    long bytes = ctx->out.bytes;
+    int result = eval_engine(ctx, engine, used_engine, engine_error);
+    output_flush(&ctx->out);
+    if (ctx->stats) ctx->stats->output_bytes += ctx->out.bytes - bytes;
+    phase_mark(ctx->phases, "eval");
+    return result;
+}
+
+int minijs_compile(MiniJSContext *ctx, const char **error) {
+    minijs_optimize(ctx);
+    int result = gen_x86_program(ctx->program, &ctx->out, ctx->opt_level, error);
+    output_flush(&ctx->out);
+    phase_mark(ctx->phases, "codegen");
+    return result;
+}
+
+int minijs_emit_ir(MiniJSContext *ctx, const char **error) {
+    minijs_optimize(ctx);
+    IrProgram *ip = ir_new(ctx->program, error);
+    if (!ip) return -1;
+    ir_build(ip);
+    ir_print(ip, &ctx->out);
+    output_flush(&ctx->out);
+    ir_free(ip);
+    phase_mark(ctx->phases, "emit-ir");
+    return 0;
+}
+
+long minijs_precompile(MiniJSContext *ctx, FILE *out, const char **error) {
+    minijs_optimize(ctx);
+    long size = precompile_write(ctx->program, out, error);
+    phase_mark(ctx->phases, "precompile");
+    return size;
+}
+
+int minijs_eval_precompiled(MiniJSContext *ctx, const char *path, int *result, const char **error) {
+    FlatProgram *fp = precompile_load(path, error);
+    if (!fp) return -1;
+    phase_mark(ctx->phases, "load");
+    long bytes = ctx->out.bytes;
+    *result = flat_run(fp, &ctx->out);
+    output_flush(&ctx->out);
+    if (ctx->stats) ctx->stats->output_bytes += ctx->out.bytes - bytes;
+    precompile_unload(fp);
+    phase_mark(ctx->phases, "eval");
+    return 0;
+}
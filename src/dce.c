@@ -0,0 +1,317 @@
+/* 죽은 코드 / 호출되지 않는 함수 제거
+ * 1) 문장 리스트마다 다음 문장으로 넘어가지 않는 문장 뒤를 자르고 조건이 상수인 if/while을 정리
+ * 2) 남은 top-level 문장의 호출에서 시작해 호출 그래프를 따라 닿는 함수만 남김
+ *    (이름은 첫 정의로 해석, eval의 find_function과 동일)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "dce.h"
+
+/* 문장을 지운 이유 (보고서) */
+enum { DEAD_AFTER_RETURN, DEAD_CONST_IF, DEAD_WHILE_ZERO, DEAD_KINDS };
+
+static const char *dead_kind_names[DEAD_KINDS] = {
+    "after return", "under a constant if", "in while (0)"
+};
+
+typedef struct {
+    Program *prog;
+    FILE *report;
+    const char *unit;       /* 보고서용: 함수 이름 또는 "top-level" */
+    int unit_dead[DEAD_KINDS];  /* 현재 단위에서 지운 문장 수 */
+    DceStats st;
+} Dce;
+
+/* === 문장 === */
+
+/* 문장 수 (안에 든 문장 포함) */
+static int count_stmts(Stmt *s) {
+    if (!s) return 0;
+    switch (s->kind) {
+        case STMT_IF:
+            return 1 + count_stmts(s->u.if_stmt.then_stmt) + count_stmts(s->u.if_stmt.else_stmt);
+        case STMT_WHILE:
+            return 1 + count_stmts(s->u.while_stmt.body);
+        case STMT_FOR:
+            return 1 + count_stmts(s->u.for_stmt.init) + count_stmts(s->u.for_stmt.step) +
+                   count_stmts(s->u.for_stmt.body);
+        case STMT_BLOCK: {
+            int n = 1;
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) n += count_stmts(b);
+            return n;
+        }
+        default:
+            return 1;
+    }
+}
+
+int dce_always_returns(Stmt *s) {
+    if (!s) return 0;
+    switch (s->kind) {
+        case STMT_RETURN:
+            return 1;
+        case STMT_IF:
+            return s->u.if_stmt.else_stmt && dce_always_returns(s->u.if_stmt.then_stmt) &&
+                   dce_always_returns(s->u.if_stmt.else_stmt);
+        case STMT_WHILE:
+            return s->u.while_stmt.cond && s->u.while_stmt.cond->kind == EXPR_INT &&
+                   s->u.while_stmt.cond->u.int_value != 0;
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                if (dce_always_returns(b)) return 1;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+static void removed(Dce *d, int n, int kind) {
+    d->st.statements += n;
+    d->unit_dead[kind] += n;
+}
+
+/* 현재 단위의 보고서 한 줄씩 */
+static void end_unit(Dce *d) {
+    for (int k = 0; k < DEAD_KINDS; ++k) {
+        if (d->report && d->unit_dead[k] > 0) {
+            fprintf(d->report, "  %-16s %d statement(s) %s\n", d->unit, d->unit_dead[k], dead_kind_names[k]);
+        }
+        d->unit_dead[k] = 0;
+    }
+}
+
+static void prune_list(Dce *d, StmtList *list);
+
+/* 반환: s 대신 들어갈 문장 (NULL이면 지움) */
+static Stmt *prune_stmt(Dce *d, Stmt *s) {
+    if (!s) return NULL;
+
+    switch (s->kind) {
+        case STMT_IF: {
+            Expr *cond = s->u.if_stmt.cond;
+            if (cond && cond->kind == EXPR_INT) {
+                /* 조건식은 상수이므로 평가하지 않아도 됨 */
+                Stmt *taken = cond->u.int_value ? s->u.if_stmt.then_stmt : s->u.if_stmt.else_stmt;
+                Stmt *dropped = cond->u.int_value ? s->u.if_stmt.else_stmt : s->u.if_stmt.then_stmt;
+                removed(d, 1 + count_stmts(dropped), DEAD_CONST_IF);
+                return prune_stmt(d, taken);
+            }
+            s->u.if_stmt.then_stmt = prune_stmt(d, s->u.if_stmt.then_stmt);
+            s->u.if_stmt.else_stmt = prune_stmt(d, s->u.if_stmt.else_stmt);
+            if (!s->u.if_stmt.then_stmt) s->u.if_stmt.then_stmt = new_block_stmt(d->prog, NULL);
+            break;
+        }
+
+        case STMT_WHILE: {
+            Expr *cond = s->u.while_stmt.cond;
+            if (cond && cond->kind == EXPR_INT && cond->u.int_value == 0) {
+                removed(d, count_stmts(s), DEAD_WHILE_ZERO);
+                return NULL;
+            }
+            s->u.while_stmt.body = prune_stmt(d, s->u.while_stmt.body);
+            if (!s->u.while_stmt.body) s->u.while_stmt.body = new_block_stmt(d->prog, NULL);
+            break;
+        }
+
+        case STMT_FOR:
+            s->u.for_stmt.body = prune_stmt(d, s->u.for_stmt.body);
+            if (!s->u.for_stmt.body) s->u.for_stmt.body = new_block_stmt(d->prog, NULL);
+            break;
+
+        case STMT_BLOCK:
+            prune_list(d, s->u.block);
+            break;
+
+        default:
+            break;
+    }
+    return s;
+}
+
+static void prune_list(Dce *d, StmtList *list) {
+    if (!list) return;
+    Stmt *prev = NULL;
+    Stmt *s = list->head;
+    while (s) {
+        Stmt *next = s->next;
+        Stmt *r = prune_stmt(d, s);
+        if (!r) {
+            s = next;
+            continue;
+        }
+        if (prev) prev->next = r; else list->head = r;
+        prev = r;
+        if (dce_always_returns(r) && next) {
+            int n = 0;
+            for (Stmt *rest = next; rest; rest = rest->next) n += count_stmts(rest);
+            removed(d, n, DEAD_AFTER_RETURN);
+            next = NULL;
+        }
+        r->next = next;
+        s = next;
+    }
+    if (!prev) list->head = NULL;
+    list->tail = prev;
+}
+
+static void prune_items(Dce *d) {
+    Program *prog = d->prog;
+    d->unit = "top-level";
+    int returned = 0;
+    Item *prev = NULL;
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) {
+            Stmt *r = NULL;
+            if (returned) {
+                removed(d, count_stmts(item->u.stmt), DEAD_AFTER_RETURN);
+            } else {
+                r = prune_stmt(d, item->u.stmt);
+            }
+            if (!r) {
+                /* 항목 제거 (함수 정의는 호출 그래프가 결정) */
+                if (prev) prev->next = item->next; else prog->items = item->next;
+                continue;
+            }
+            r->next = NULL;
+            item->u.stmt = r;
+            if (dce_always_returns(r)) returned = 1;
+        }
+        prev = item;
+    }
+    prog->items_tail = prev;
+    end_unit(d);
+
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind != ITEM_FUNCTION) continue;
+        d->unit = item->u.function->name;
+        prune_list(d, item->u.function->body);
+        end_unit(d);
+    }
+}
+
+/* === 호출 그래프 === */
+
+typedef struct {
+    FuncTable table;            /* 호출 대상 (이름 → 첫 정의) */
+    unsigned char *reached;     /* Function.index → 닿음 */
+    Function **stack;
+    int sp;
+} Reach;
+
+static void reach_expr(Reach *r, Expr *e) {
+    if (!e) return;
+    switch (e->kind) {
+        case EXPR_BINOP:
+            reach_expr(r, e->u.binop.lhs);
+            reach_expr(r, e->u.binop.rhs);
+            break;
+        case EXPR_UNARY:
+            reach_expr(r, e->u.unary.operand);
+            break;
+        case EXPR_CALL: {
+            Function *f = func_table_find(&r->table, e->u.call.func_name);
+            if (f && !r->reached[f->index]) {
+                r->reached[f->index] = 1;
+                r->stack[r->sp++] = f;
+            }
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                reach_expr(r, arg->expr);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void reach_stmt(Reach *r, Stmt *s) {
+    if (!s) return;
+    switch (s->kind) {
+        case STMT_VARDECL:
+            reach_expr(r, s->u.vardecl.init_value);
+            break;
+        case STMT_ASSIGN:
+            reach_expr(r, s->u.assign.value);
+            break;
+        case STMT_EXPR:
+        case STMT_RETURN:
+        case STMT_PRINT:
+            reach_expr(r, s->u.expr);
+            break;
+        case STMT_IF:
+            reach_expr(r, s->u.if_stmt.cond);
+            reach_stmt(r, s->u.if_stmt.then_stmt);
+            reach_stmt(r, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            reach_expr(r, s->u.while_stmt.cond);
+            reach_stmt(r, s->u.while_stmt.body);
+            break;
+        case STMT_FOR:
+            reach_stmt(r, s->u.for_stmt.init);
+            reach_expr(r, s->u.for_stmt.cond);
+            reach_stmt(r, s->u.for_stmt.step);
+            reach_stmt(r, s->u.for_stmt.body);
+            break;
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                reach_stmt(r, b);
+            }
+            break;
+    }
+}
+
+static void remove_unreached(Dce *d) {
+    Program *prog = d->prog;
+    Reach r;
+    memset(&r, 0, sizeof(r));
+    func_table_build(&r.table, prog);
+    r.stack = (Function **)malloc(sizeof(Function *) * (prog->nfunctions + 1));
+    r.reached = (unsigned char *)calloc(prog->nfunctions + 1, 1);
+
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) reach_stmt(&r, item->u.stmt);
+    }
+    while (r.sp > 0) {
+        Function *f = r.stack[--r.sp];
+        for (Stmt *s = f->body ? f->body->head : NULL; s; s = s->next) {
+            reach_stmt(&r, s);
+        }
+    }
+
+    Item *prev = NULL;
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_FUNCTION && !r.reached[item->u.function->index]) {
+            Function *f = item->u.function;
+            d->st.functions++;
+            if (d->report) {
+                fprintf(d->report, "  %-16s function removed (%s)\n", f->name,
+                        func_table_find(&r.table, f->name) == f ? "never called" : "redefinition, first one wins");
+            }
+            if (prev) prev->next = item->next; else prog->items = item->next;
+            continue;
+        }
+        prev = item;
+    }
+    prog->items_tail = prev;
+
+    func_table_free(&r.table);
+    free(r.stack);
+    free(r.reached);
+}
+
+int dce_program(Program *prog, DceStats *stats, FILE *report) {
+    Dce d;
+    memset(&d, 0, sizeof(d));
+    d.prog = prog;
+    d.report = report;
+    if (prog) {
+        prune_items(&d);
+        remove_unreached(&d);
+    }
+    if (stats) *stats = d.st;
+    return d.st.functions + d.st.statements;
+}
@@ -7,86 +7,357 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <time.h>
+#if defined(__EMSCRIPTEN__)
+#include <emscripten/stack.h>
+#elif !defined(_WIN32)
+#include <sys/resource.h>
+#endif
 #include "ast.h"
 #include "eval.h"
 #include "symtab.h"  /* 10wk 기반 심볼 테이블 */
+#include "resolve.h"
+#include "purity.h"
+#include "output.h"
+#include "jit_x86.h"
+
+#define MAX_CALL_ARGS 16
+
+/* === 계층 실행 (eval_program_tiered) ===
+ * 함수마다 호출/루프 반복 수를 세다가 임계값에 이르면 다음 호출에서 JIT로 승격
+ * 이후 호출은 인자만 인터프리터에서 평가하고 기계어로 실행
+ * (이미 실행 중인 호출은 인터프리터에서 끝냄) */
+typedef enum {
+    TIER_INTERP,
+    TIER_NATIVE,
+    TIER_REJECTED       /* 승격 불가 (전역 변수 사용 등), 계속 인터프리터 */
+} TierState;
 
-/* === 출력 버퍼 === */
-static char *output_buffer = NULL;
-static int output_bufsize = 0;
-static int output_pos = 0;
-
-void eval_set_output_buffer(char *buffer, int bufsize) {
-    output_buffer = buffer;
-    output_bufsize = bufsize;
-    output_pos = 0;
-    if (buffer && bufsize > 0) {
-        buffer[0] = '\0';
-    }
+typedef struct {
+    TierState state;
+    long calls;             /* 인터프리터에서 실행한 호출 */
+    long back_edges;        /* 인터프리터에서 실행한 루프 반복 */
+    long native_calls;
+    long promoted_at;       /* 승격 시점 (프로그램 전체 호출 번호) */
+    double compile_us;
+    const char *reason;     /* TIER_REJECTED 이유 */
+    JitProgram *native;
+} TierInfo;
+
+/* === 메모이제이션 (--memoize) ===
+ * 순수 함수마다 인자 튜플 → 반환값 캐시 (오픈 어드레싱)
+ * EVAL_MEMO_MAX_ENTRIES까지 늘어나고, 그 뒤에는 새 결과가 자기 칸의 항목을 덮어씀 */
+typedef struct {
+    int nkeys;              /* 키 길이 (매개변수 수, 최대 MAX_CALL_ARGS) */
+    long *keys;             /* cap × nkeys */
+    long *results;
+    unsigned char *used;
+    int cap;                /* 0 또는 2의 거듭제곱 */
+    int count;
+    long hits;
+    long misses;
+    long uncached;          /* 호출 중 출력이 있어 캐시하지 않은 결과 */
+} MemoTable;
+
+/* === 실행 상태 ===
+ * eval_program 호출 하나가 소유 (전역 상태가 없으므로 스레드마다 독립 실행 가능) */
+typedef struct {
+    Output *out;
+    Program *prog;
+
+    /* 실행 중 등록된 함수: 이름 → Function (오픈 어드레싱, 빈 칸은 NULL)
+     * 같은 이름이 다시 등록되면 첫 정의를 유지 (resolve.c/ir.c와 동일) */
+    Function **func_index;
+    int func_index_cap;     /* 2의 거듭제곱 */
+    int nfuncs;
+
+    /* 호출 지점 → 바인딩된 함수 (Expr.u.call.site, 찾지 못한 호출은 NULL로 남김) */
+    Function **call_cache;
+
+    /* 10wk 심볼 테이블 (슬롯 해석 실패 시 동적 스코프) */
+    SymTab *sym;
+
+    /* 슬롯 프레임 (resolve_program 성공 시)
+     * 변수 참조가 (프레임, 슬롯)으로 해석된 프로그램은 심볼 테이블 대신
+     * 호출마다 평평한 슬롯 배열을 사용 (스택 재할당에 대비해 인덱스로 접근) */
+    int use_slots;
+    long *frame_stack;
+    long frame_cap;
+    long frame_base;
+    long frame_top;
+
+    long *global_values;
+    unsigned char *global_defined;
+
+    /* 계층 실행 (tier가 NULL이면 순수 인터프리터) */
+    TierInfo *tier;         /* Function.index → 카운터 */
+    TierInfo *cur_tier;     /* 실행 중인 함수 (top-level이면 NULL) */
+    long tier_threshold;
+    long total_calls;
+
+    /* 메모이제이션 (memo가 NULL이면 사용 안 함) */
+    MemoTable *memo;        /* Function.index → 캐시 (순수 함수만 사용) */
+
+    /* 실행 카운터 (--stats, NULL이면 세지 않음) */
+    ExecStats *stats;
+
+    /* 꼬리 자기 호출의 인자 (EvalResult.tail_call이 call_function까지 전달) */
+    long tail_args[MAX_CALL_ARGS];
+    int tail_argc;
+
+    int depth;              /* 실행 중인 함수 호출 수 (EVAL_MAX_CALL_DEPTH까지) */
+    uintptr_t stack_limit;  /* C 스택이 이 주소 아래로 내려가면 호출 거부 */
+} Eval;
+
+static void print_output(Eval *ev, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    output_vprintf(ev->out, fmt, args);
+    va_end(args);
 }
 
-void eval_reset_output_buffer(void) {
-    output_buffer = NULL;
-    output_bufsize = 0;
-    output_pos = 0;
+/* === 함수 테이블 === */
+
+/* name의 칸 (없으면 빈 칸), 이름은 인터닝된 포인터로 비교 */
+static Function **func_slot(Function **table, int cap, const char *name) {
+    unsigned i = INTERN_HASH(name) & (unsigned)(cap - 1);
+    while (table[i] && table[i]->name != name) i = (i + 1) & (unsigned)(cap - 1);
+    return &table[i];
 }
 
-const char *eval_get_output(void) {
-    return output_buffer ? output_buffer : "";
+static Function *find_function(Eval *ev, const char *name) {
+    if (ev->nfuncs == 0) return NULL;
+    return *func_slot(ev->func_index, ev->func_index_cap, name);
 }
 
-static void print_output(const char *fmt, ...) {
-    va_list args;
-    va_start(args, fmt);
+/* 함수 등록 (실행 중 동적 등록), 같은 이름은 첫 정의 유지
+ * 바인딩은 바뀌지 않으므로 호출 지점 캐시를 무효화할 필요가 없음 */
+static void register_function(Eval *ev, Function *func) {
+    if (!func) return;
+    if ((ev->nfuncs + 1) * 2 > ev->func_index_cap) {
+        int cap = ev->func_index_cap ? ev->func_index_cap * 2 : 64;
+        Function **table = (Function **)calloc(cap, sizeof(Function *));
+        if (!table) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        for (int i = 0; i < ev->func_index_cap; ++i) {
+            if (ev->func_index[i]) *func_slot(table, cap, ev->func_index[i]->name) = ev->func_index[i];
+        }
+        free(ev->func_index);
+        ev->func_index = table;
+        ev->func_index_cap = cap;
+    }
+    Function **slot = func_slot(ev->func_index, ev->func_index_cap, func->name);
+    if (*slot) return;
+    *slot = func;
+    ev->nfuncs++;
+}
 
-    if (output_buffer) {
-        int remaining = output_bufsize - output_pos;
-        if (remaining > 0) {
-            int written = vsnprintf(output_buffer + output_pos, remaining, fmt, args);
-            if (written > 0) {
-                output_pos += (written < remaining) ? written : (remaining - 1);
+static void reserve_frame(Eval *ev, long nslots) {
+    if (ev->frame_top + nslots <= ev->frame_cap) return;
+    long cap = ev->frame_cap ? ev->frame_cap : 1024;
+    while (ev->frame_top + nslots > cap) cap *= 2;
+    long *p = (long *)realloc(ev->frame_stack, cap * sizeof(long));
+    if (!p) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    ev->frame_stack = p;
+    ev->frame_cap = cap;
+}
+
+static long load_var(Eval *ev, const VarRef *ref, const char *name) {
+    long val;
+    switch (ref->kind) {
+        case VAR_LOCAL:
+            return ev->frame_stack[ev->frame_base + ref->slot];
+        case VAR_GLOBAL:
+            if (!ev->global_defined[ref->slot]) break;
+            return ev->global_values[ref->slot];
+        case VAR_UNDEFINED:
+            break;
+        default:
+            /* 10wk symtab 인터페이스 사용 */
+            if (sym_get(ev->sym, name, &val)) return val;
+            break;
+    }
+    print_output(ev, "Error: undefined variable '%s'\n", name);
+    return 0;
+}
+
+/* declare: let/var/const (현재 스코프에 선언), 아니면 대입 */
+static void store_var(Eval *ev, const VarRef *ref, const char *name, long val, int declare) {
+    switch (ref->kind) {
+        case VAR_LOCAL:
+            ev->frame_stack[ev->frame_base + ref->slot] = val;
+            break;
+        case VAR_GLOBAL:
+            ev->global_values[ref->slot] = val;
+            ev->global_defined[ref->slot] = 1;
+            break;
+        default:
+            if (declare) {
+                sym_declare(ev->sym, name, val);
+            } else {
+                sym_set(ev->sym, name, val);  /* 10wk sym_set 사용 */
             }
+            break;
+    }
+}
+
+/* === 계층 실행 === */
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void tier_promote(Eval *ev, Function *f, TierInfo *t) {
+    double t0 = now_us();
+    t->native = jit_compile_function(ev->prog, f, &t->reason);
+    t->compile_us = now_us() - t0;
+    t->promoted_at = ev->total_calls;
+    t->state = t->native ? TIER_NATIVE : TIER_REJECTED;
+}
+
+/* 승격 보고서 (--tier-stats): 호출된 함수만 */
+static void tier_report(Eval *ev, FILE *stats) {
+    fprintf(stats, "=== Tier Stats (threshold %ld) ===\n", ev->tier_threshold);
+    fprintf(stats, "  %-16s %12s %12s %12s  %s\n", "function", "interp calls", "loop iters",
+            "native calls", "tier");
+    for (Item *item = ev->prog->items; item; item = item->next) {
+        if (item->kind != ITEM_FUNCTION) continue;
+        Function *f = item->u.function;
+        TierInfo *t = &ev->tier[f->index];
+        if (t->calls == 0 && t->native_calls == 0) continue;
+        fprintf(stats, "  %-16s %12ld %12ld %12ld  ", f->name, t->calls, t->back_edges, t->native_calls);
+        switch (t->state) {
+            case TIER_NATIVE:
+                fprintf(stats, "native (promoted at call #%ld, compiled in %.0f us)\n",
+                        t->promoted_at, t->compile_us);
+                break;
+            case TIER_REJECTED:
+                fprintf(stats, "interpreter (not promoted: %s)\n", t->reason ? t->reason : "");
+                break;
+            default:
+                fprintf(stats, "interpreter\n");
+                break;
         }
-    } else {
-        vprintf(fmt, args);
     }
+    fprintf(stats, "  total calls: %ld\n", ev->total_calls);
+}
 
-    va_end(args);
+/* === 메모이제이션 === */
+
+static unsigned hash_args(const long *args, int n) {
+    unsigned long h = 14695981039346656037ul;
+    for (int i = 0; i < n; ++i) {
+        h ^= (unsigned long)args[i];
+        h *= 1099511628211ul;
+    }
+    return (unsigned)(h ^ (h >> 32));
 }
 
-/* === 전역 함수 리스트 === */
-static FunctionList *g_functions = NULL;
+/* key의 칸: 같은 키가 있는 칸, 없으면 빈 칸 (테이블이 가득 차 있으면 -1) */
+static int memo_slot(const MemoTable *m, const long *key) {
+    unsigned mask = (unsigned)m->cap - 1;
+    unsigned i = hash_args(key, m->nkeys) & mask;
+    for (int probe = 0; probe < m->cap; ++probe, i = (i + 1) & mask) {
+        if (!m->used[i]) return (int)i;
+        if (memcmp(m->keys + (long)i * m->nkeys, key, sizeof(long) * m->nkeys) == 0) return (int)i;
+    }
+    return -1;
+}
 
-static Function *find_function(const char *name) {
-    if (!g_functions) return NULL;
-    Function *f = g_functions->head;
-    while (f) {
-        if (strcmp(f->name, name) == 0) return f;
-        f = f->next;
+static int memo_lookup(MemoTable *m, const long *key, long *result) {
+    if (m->cap > 0) {
+        int i = memo_slot(m, key);
+        if (i >= 0 && m->used[i]) {
+            *result = m->results[i];
+            m->hits++;
+            return 1;
+        }
     }
-    return NULL;
+    m->misses++;
+    return 0;
 }
 
-/* 함수 등록 (실행 중 동적 등록) - 12wk function_list_append 재사용 */
-static void register_function(Function *func) {
-    if (!func) return;
-    g_functions = function_list_append(g_functions, func);
+static void memo_grow(MemoTable *m) {
+    MemoTable grown = *m;
+    grown.cap = m->cap ? m->cap * 2 : 64;
+    grown.keys = (long *)malloc(sizeof(long) * (size_t)grown.cap * (m->nkeys ? m->nkeys : 1));
+    grown.results = (long *)malloc(sizeof(long) * grown.cap);
+    grown.used = (unsigned char *)calloc(grown.cap, 1);
+    if (!grown.keys || !grown.results || !grown.used) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < m->cap; ++i) {
+        if (!m->used[i]) continue;
+        int j = memo_slot(&grown, m->keys + (long)i * m->nkeys);
+        memcpy(grown.keys + (long)j * m->nkeys, m->keys + (long)i * m->nkeys, sizeof(long) * m->nkeys);
+        grown.results[j] = m->results[i];
+        grown.used[j] = 1;
+    }
+    free(m->keys);
+    free(m->results);
+    free(m->used);
+    *m = grown;
+}
+
+static void memo_store(MemoTable *m, const long *key, long result) {
+    if ((m->count + 1) * 2 > m->cap && m->cap < EVAL_MEMO_MAX_ENTRIES) memo_grow(m);
+    int i;
+    if ((m->count + 1) * 2 > m->cap) {
+        /* 최대 크기: 자기 칸의 항목을 밀어냄 (다른 키의 탐색 경로는 그대로 채워져 있음) */
+        i = (int)(hash_args(key, m->nkeys) & ((unsigned)m->cap - 1));
+    } else {
+        i = memo_slot(m, key);
+    }
+    if (!m->used[i]) m->count++;
+    memcpy(m->keys + (long)i * m->nkeys, key, sizeof(long) * m->nkeys);
+    m->results[i] = result;
+    m->used[i] = 1;
+}
+
+/* 메모 보고서 (--memo-stats): 호출된 순수 함수만 */
+static void memo_report(Eval *ev, FILE *stats) {
+    fprintf(stats, "=== Memo Stats ===\n");
+    fprintf(stats, "  %-16s %12s %12s %12s %10s\n", "function", "hits", "misses", "uncached",
+            "entries");
+    int npure = 0;
+    for (Item *item = ev->prog->items; item; item = item->next) {
+        if (item->kind != ITEM_FUNCTION) continue;
+        Function *f = item->u.function;
+        if (!f->pure) continue;
+        npure++;
+        MemoTable *m = &ev->memo[f->index];
+        if (m->hits == 0 && m->misses == 0) continue;
+        fprintf(stats, "  %-16s %12ld %12ld %12ld %10d\n", f->name, m->hits, m->misses, m->uncached,
+                m->count);
+    }
+    fprintf(stats, "  pure functions: %d of %d\n", npure, ev->prog->nfunctions);
 }
 
 /* === 반환값 처리 === */
 typedef struct {
     int has_return;
     long return_value;
+    int tail_call;      /* return f(...)가 자기 호출: 인자는 Eval.tail_args */
 } EvalResult;
 
 /* === 전방 선언 (10wk symtab 사용으로 Env 매개변수 제거) === */
-static long eval_expr(Expr *e);
-static EvalResult eval_stmt(Stmt *s);
-static long eval_call(const char *func_name, ExprList *args);
+static long eval_expr(Eval *ev, Expr *e);
+static EvalResult eval_stmt(Eval *ev, Stmt *s);
+static long eval_call(Eval *ev, Expr *call);
+static long call_function(Eval *ev, Function *f, const long *arg_values, int arg_count);
 
 /* === 표현식 평가 (10wk sym_get 사용) === */
-static long eval_expr(Expr *e) {
+static long eval_expr(Eval *ev, Expr *e) {
     if (!e) return 0;
+    STAT_INC(ev->stats, exprs[e->kind]);
 
     switch (e->kind) {
         case EXPR_INT:
@@ -96,19 +367,12 @@ static long eval_expr(Expr *e) {
             /* 문자열은 console.log에서 별도 처리 */
             return 0;
 
-        case EXPR_VAR: {
-            long val;
-            /* 10wk symtab 인터페이스 사용 */
-            if (!sym_get(e->u.var_name, &val)) {
-                print_output("Error: undefined variable '%s'\n", e->u.var_name);
-                return 0;
-            }
-            return val;
-        }
+        case EXPR_VAR:
+            return load_var(ev, &e->ref, e->u.var_name);
 
         case EXPR_BINOP: {
-            long lhs = eval_expr(e->u.binop.lhs);
-            long rhs = eval_expr(e->u.binop.rhs);
+            long lhs = eval_expr(ev, e->u.binop.lhs);
+            long rhs = eval_expr(ev, e->u.binop.rhs);
 
             switch (e->u.binop.op) {
                 case BIN_ADD: return lhs + rhs;
@@ -116,13 +380,13 @@ static long eval_expr(Expr *e) {
                 case BIN_MUL: return lhs * rhs;
                 case BIN_DIV:
                     if (rhs == 0) {
-                        print_output("Error: division by zero\n");
+                        print_output(ev, "Error: division by zero\n");
                         return 0;
                     }
                     return lhs / rhs;
                 case BIN_MOD:
                     if (rhs == 0) {
-                        print_output("Error: modulo by zero\n");
+                        print_output(ev, "Error: modulo by zero\n");
                         return 0;
                     }
                     return lhs % rhs;
@@ -139,10 +403,10 @@ static long eval_expr(Expr *e) {
         }
 
         case EXPR_CALL:
-            return eval_call(e->u.call.func_name, e->u.call.args);
+            return eval_call(ev, e);
 
         case EXPR_UNARY: {
-            long val = eval_expr(e->u.unary.operand);
+            long val = eval_expr(ev, e->u.unary.operand);
             switch (e->u.unary.op) {
                 case UNARY_NEG: return -val;
                 case UNARY_NOT: return val ? 0 : 1;
@@ -155,32 +419,99 @@ static long eval_expr(Expr *e) {
 }
 
 /* === 함수 호출 (10wk symtab 스코프 사용) === */
-static long eval_call(const char *func_name, ExprList *args) {
-    Function *f = find_function(func_name);
+static long eval_call(Eval *ev, Expr *call) {
+    const char *func_name = call->u.call.func_name;
+    int site = call->u.call.site;
+    Function *f = site >= 0 ? ev->call_cache[site] : NULL;
     if (!f) {
-        print_output("Error: undefined function '%s'\n", func_name);
-        return 0;
+        f = find_function(ev, func_name);
+        if (!f) {
+            print_output(ev, "Error: undefined function '%s'\n", func_name);
+            return 0;
+        }
+        if (site >= 0) ev->call_cache[site] = f;
     }
 
     /* 인자값을 먼저 평가 (현재 스코프에서) */
-    long arg_values[16];
+    long arg_values[MAX_CALL_ARGS];
     int arg_count = 0;
-    ExprList *arg = args;
-    while (arg && arg_count < 16) {
-        arg_values[arg_count++] = eval_expr(arg->expr);
+    ExprList *arg = call->u.call.args;
+    while (arg && arg_count < MAX_CALL_ARGS) {
+        arg_values[arg_count++] = eval_expr(ev, arg->expr);
         arg = arg->next;
     }
 
-    /* 새 스코프 시작 (10wk symtab 확장) */
-    sym_push_scope();
+    if (ev->memo && f->pure) {
+        /* 키: 매개변수에 바인딩되는 값 (남는 인자는 버리고 모자란 매개변수는 0) */
+        MemoTable *m = &ev->memo[f->index];
+        long key[MAX_CALL_ARGS];
+        for (int i = 0; i < m->nkeys; ++i) key[i] = i < arg_count ? arg_values[i] : 0;
+        long result;
+        if (memo_lookup(m, key, &result)) return result;
+        long writes = ev->out->writes;
+        result = call_function(ev, f, arg_values, arg_count);
+        if (ev->out->writes == writes) {
+            memo_store(m, key, result);
+        } else {
+            m->uncached++;
+        }
+        return result;
+    }
+    return call_function(ev, f, arg_values, arg_count);
+}
+
+/* 인자 평가가 끝난 호출 실행 (계층 실행 승격 포함) */
+static long call_function(Eval *ev, Function *f, const long *arg_values, int arg_count) {
+    char mark;
+    if (ev->depth >= EVAL_MAX_CALL_DEPTH || (uintptr_t)&mark < ev->stack_limit) {
+        print_output(ev, "Error: maximum call depth exceeded\n");
+        return 0;
+    }
+    TierInfo *saved_tier = ev->cur_tier;
+    STAT_CALL_ENTER(ev->stats);
+    if (ev->tier) {
+        TierInfo *t = &ev->tier[f->index];
+        ev->total_calls++;
+        if (t->state == TIER_INTERP && t->calls + t->back_edges >= ev->tier_threshold) {
+            tier_promote(ev, f, t);
+        }
+        if (t->state == TIER_NATIVE) {
+            t->native_calls++;
+            long native = jit_call(t->native, ev->out, arg_values, arg_count, ev->depth);
+            STAT_CALL_LEAVE(ev->stats);
+            return native;
+        }
+        t->calls++;
+        ev->cur_tier = t;
+    }
 
-    /* 매개변수에 인자값 바인딩 (현재 스코프에 선언) */
-    Param *param = f->params ? f->params->head : NULL;
-    int i = 0;
-    while (param && i < arg_count) {
-        sym_declare(param->name, arg_values[i]);
-        param = param->next;
-        i++;
+    ev->depth++;
+    long saved_base = ev->frame_base;
+    if (ev->use_slots) {
+        /* 새 슬롯 프레임: 매개변수는 슬롯 0..n-1, 나머지 지역 슬롯은 0 */
+        reserve_frame(ev, f->nslots);
+        ev->frame_base = ev->frame_top;
+        ev->frame_top += f->nslots;
+        long *slots = ev->frame_stack + ev->frame_base;
+        int i = 0;
+        for (Param *param = f->params ? f->params->head : NULL; param && i < arg_count;
+             param = param->next) {
+            slots[i] = arg_values[i];
+            i++;
+        }
+        for (; i < f->nslots; ++i) slots[i] = 0;
+    } else {
+        /* 새 스코프 시작 (10wk symtab 확장) */
+        sym_push_scope(ev->sym);
+
+        /* 매개변수에 인자값 바인딩 (현재 스코프에 선언) */
+        Param *param = f->params ? f->params->head : NULL;
+        int i = 0;
+        while (param && i < arg_count) {
+            sym_declare(ev->sym, param->name, arg_values[i]);
+            param = param->next;
+            i++;
+        }
     }
 
     /* 함수 본문 실행 */
@@ -188,7 +519,22 @@ static long eval_call(const char *func_name, ExprList *args) {
     if (f->body) {
         Stmt *s = f->body->head;
         while (s) {
-            EvalResult r = eval_stmt(s);
+            EvalResult r = eval_stmt(ev, s);
+            if (r.tail_call) {
+                /* 꼬리 자기 호출: 같은 프레임에 다시 바인딩하고 본문 처음부터 (반복으로 계산) */
+                long *slots = ev->frame_stack + ev->frame_base;
+                int i = 0;
+                for (Param *param = f->params ? f->params->head : NULL; param && i < ev->tail_argc;
+                     param = param->next) {
+                    slots[i] = ev->tail_args[i];
+                    i++;
+                }
+                for (; i < f->nslots; ++i) slots[i] = 0;
+                if (ev->cur_tier) ev->cur_tier->back_edges++;
+                STAT_INC(ev->stats, calls);
+                s = f->body->head;
+                continue;
+            }
             if (r.has_return) {
                 result = r.return_value;
                 break;
@@ -198,117 +544,141 @@ static long eval_call(const char *func_name, ExprList *args) {
     }
 
     /* 스코프 종료 (10wk symtab 확장) */
-    sym_pop_scope();
+    if (ev->use_slots) {
+        ev->frame_top = ev->frame_base;
+        ev->frame_base = saved_base;
+    } else {
+        sym_pop_scope(ev->sym);
+    }
+    ev->cur_tier = saved_tier;
+    ev->depth--;
+    STAT_CALL_LEAVE(ev->stats);
 
     return result;
 }
 
 /* === 문장 실행 (10wk symtab 사용) === */
-static EvalResult eval_stmt(Stmt *s) {
-    EvalResult result = {0, 0};
+static EvalResult eval_stmt(Eval *ev, Stmt *s) {
+    EvalResult result = {0, 0, 0};
     if (!s) return result;
+    STAT_INC(ev->stats, stmts[s->kind]);
 
     switch (s->kind) {
         case STMT_VARDECL: {
             long val = 0;
             if (s->u.vardecl.init_value) {
-                val = eval_expr(s->u.vardecl.init_value);
+                val = eval_expr(ev, s->u.vardecl.init_value);
             }
-            sym_declare(s->u.vardecl.var_name, val);
+            store_var(ev, &s->ref, s->u.vardecl.var_name, val, 1);
             break;
         }
 
         case STMT_ASSIGN: {
-            /* 10wk sym_set 사용 */
-            long val = eval_expr(s->u.assign.value);
-            sym_set(s->u.assign.var_name, val);
+            long val = eval_expr(ev, s->u.assign.value);
+            store_var(ev, &s->ref, s->u.assign.var_name, val, 0);
             break;
         }
 
         case STMT_EXPR:
-            eval_expr(s->u.expr);
+            eval_expr(ev, s->u.expr);
             break;
 
         case STMT_RETURN:
             result.has_return = 1;
-            result.return_value = s->u.expr ? eval_expr(s->u.expr) : 0;
+            if (s->u.expr && s->u.expr->kind == EXPR_CALL && s->u.expr->u.call.tail) {
+                /* 인자만 평가하고 호출은 call_function의 본문 루프가 대신함
+                 * (인자 안의 호출도 tail_args를 쓰므로 다 평가한 뒤 복사) */
+                long args[MAX_CALL_ARGS];
+                int argc = 0;
+                for (ExprList *arg = s->u.expr->u.call.args; arg && argc < MAX_CALL_ARGS;
+                     arg = arg->next) {
+                    args[argc++] = eval_expr(ev, arg->expr);
+                }
+                memcpy(ev->tail_args, args, argc * sizeof(long));
+                ev->tail_argc = argc;
+                result.tail_call = 1;
+                return result;
+            }
+            result.return_value = s->u.expr ? eval_expr(ev, s->u.expr) : 0;
             return result;
 
         case STMT_PRINT: {
-            /* 문자열 리터럴인 경우 문자열 출력 */
+            /* 문자열 리터럴인 경우 소스 구간을 그대로 출력 */
             if (s->u.expr && s->u.expr->kind == EXPR_STRING) {
-                print_output("%s\n", s->u.expr->u.string_value);
+                output_line_strn(ev->out, AST_STRING_TEXT(ev->prog, s->u.expr), (int)s->u.expr->u.string.len);
             } else {
-                long val = eval_expr(s->u.expr);
-                print_output("%ld\n", val);
+                long val = eval_expr(ev, s->u.expr);
+                output_line_int(ev->out, val);
             }
             break;
         }
 
         case STMT_IF: {
-            long cond = eval_expr(s->u.if_stmt.cond);
+            long cond = eval_expr(ev, s->u.if_stmt.cond);
             if (cond) {
-                result = eval_stmt(s->u.if_stmt.then_stmt);
+                result = eval_stmt(ev, s->u.if_stmt.then_stmt);
             } else if (s->u.if_stmt.else_stmt) {
-                result = eval_stmt(s->u.if_stmt.else_stmt);
+                result = eval_stmt(ev, s->u.if_stmt.else_stmt);
             }
             break;
         }
 
         case STMT_WHILE: {
-            while (eval_expr(s->u.while_stmt.cond)) {
-                result = eval_stmt(s->u.while_stmt.body);
+            while (eval_expr(ev, s->u.while_stmt.cond)) {
+                result = eval_stmt(ev, s->u.while_stmt.body);
                 if (result.has_return) break;
+                if (ev->cur_tier) ev->cur_tier->back_edges++;
             }
             break;
         }
 
         case STMT_FOR: {
-            /* 새 스코프 (for문 변수용) - 10wk symtab 사용 */
-            sym_push_scope();
+            /* 새 스코프 (for문 변수용, 선언이 있을 때만) - 10wk symtab 사용 */
+            if (s->needs_scope) sym_push_scope(ev->sym);
 
             /* 초기화 */
             if (s->u.for_stmt.init) {
-                eval_stmt(s->u.for_stmt.init);
+                eval_stmt(ev, s->u.for_stmt.init);
             }
 
             /* 반복 */
             while (1) {
                 /* 조건 (없으면 항상 true) */
                 if (s->u.for_stmt.cond) {
-                    long cond = eval_expr(s->u.for_stmt.cond);
+                    long cond = eval_expr(ev, s->u.for_stmt.cond);
                     if (!cond) break;
                 }
 
                 /* 본문 */
-                result = eval_stmt(s->u.for_stmt.body);
+                result = eval_stmt(ev, s->u.for_stmt.body);
                 if (result.has_return) break;
 
                 /* 스텝 */
                 if (s->u.for_stmt.step) {
-                    eval_stmt(s->u.for_stmt.step);
+                    eval_stmt(ev, s->u.for_stmt.step);
                 }
+                if (ev->cur_tier) ev->cur_tier->back_edges++;
             }
 
             /* 스코프 종료 */
-            sym_pop_scope();
+            if (s->needs_scope) sym_pop_scope(ev->sym);
             break;
         }
 
         case STMT_BLOCK:
             if (s->u.block) {
-                /* 새 스코프 - 10wk symtab 사용 */
-                sym_push_scope();
+                /* 새 스코프 (선언이 있을 때만) - 10wk symtab 사용 */
+                if (s->needs_scope) sym_push_scope(ev->sym);
 
                 Stmt *curr = s->u.block->head;
                 while (curr) {
-                    result = eval_stmt(curr);
+                    result = eval_stmt(ev, curr);
                     if (result.has_return) break;
                     curr = curr->next;
                 }
 
                 /* 스코프 종료 */
-                sym_pop_scope();
+                if (s->needs_scope) sym_pop_scope(ev->sym);
             }
             break;
     }
@@ -316,18 +686,69 @@ static EvalResult eval_stmt(Stmt *s) {
     return result;
 }
 
+uintptr_t eval_stack_limit(void) {
+    char here;
+    size_t budget = EVAL_STACK_BUDGET_DEFAULT;
+#if defined(__EMSCRIPTEN__)
+    budget = emscripten_stack_get_free() / 4 * 3;
+#elif !defined(_WIN32)
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_STACK, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY) {
+        budget = (size_t)rl.rlim_cur / 4 * 3;
+    }
+#endif
+    uintptr_t base = (uintptr_t)&here;
+    return base > budget ? base - budget : 0;
+}
+
 /* === 프로그램 실행 (순차 처리) === */
-int eval_program(Program *prog) {
+static int run_program(Program *prog, Output *out, const EvalOptions *opts) {
+    Eval ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.out = out;
+    ev.prog = prog;
+    ev.stack_limit = eval_stack_limit();
+
     if (!prog) {
-        print_output("Error: No program to execute\n");
+        print_output(&ev, "Error: No program to execute\n");
         return -1;
     }
 
-    /* 함수 테이블 초기화 */
-    g_functions = NULL;
-
     /* 10wk symtab 초기화 */
-    sym_init();
+    ev.sym = sym_new();
+    if (opts && opts->stats) {
+        ev.stats = opts->stats;
+        sym_set_stats(ev.sym, ev.stats);
+    }
+    ev.call_cache = (Function **)calloc(prog->ncall_sites + 1, sizeof(Function *));
+
+    /* 변수 슬롯 해석 (실패하면 심볼 테이블로 실행) */
+    ev.use_slots = resolve_program(prog);
+    if (ev.use_slots) {
+        reserve_frame(&ev, prog->main_slots);
+        for (long i = 0; i < prog->main_slots; ++i) ev.frame_stack[i] = 0;
+        ev.frame_top = prog->main_slots;
+        ev.global_values = (long *)calloc(prog->nglobals + 1, sizeof(long));
+        ev.global_defined = (unsigned char *)calloc(prog->nglobals + 1, 1);
+    }
+    if (opts && opts->tier) {
+        ev.tier = (TierInfo *)calloc(prog->nfunctions + 1, sizeof(TierInfo));
+        ev.tier_threshold = opts->tier_threshold;
+    }
+    if (opts && opts->memoize) {
+        /* 순수 함수 분석은 슬롯 해석 결과(VAR_LOCAL)를 사용 */
+        purity_analyze(prog);
+        ev.memo = (MemoTable *)calloc(prog->nfunctions + 1, sizeof(MemoTable));
+        for (Item *it = prog->items; it; it = it->next) {
+            if (it->kind != ITEM_FUNCTION) continue;
+            int nparams = 0;
+            for (Param *param = it->u.function->params ? it->u.function->params->head : NULL; param;
+                 param = param->next) {
+                nparams++;
+            }
+            ev.memo[it->u.function->index].nkeys = nparams < MAX_CALL_ARGS ? nparams : MAX_CALL_ARGS;
+        }
+    }
 
     /* Top-level 항목 순차 처리 */
     long result = 0;
@@ -335,11 +756,11 @@ int eval_program(Program *prog) {
 
     while (item) {
         if (item->kind == ITEM_FUNCTION) {
-            /* 함수 정의 → 테이블에 등록 (12wk function_list_append 재사용) */
-            register_function(item->u.function);
+            /* 함수 정의 → 테이블에 등록 */
+            register_function(&ev, item->u.function);
         } else if (item->kind == ITEM_STMT) {
             /* 문장 → 즉시 실행 */
-            EvalResult r = eval_stmt(item->u.stmt);
+            EvalResult r = eval_stmt(&ev, item->u.stmt);
             if (r.has_return) {
                 result = r.return_value;
                 break;
@@ -348,6 +769,33 @@ int eval_program(Program *prog) {
         item = item->next;
     }
 
-    g_functions = NULL;
+    if (ev.memo) {
+        if (opts->memo_stats) memo_report(&ev, opts->memo_stats);
+        for (int i = 0; i < prog->nfunctions; ++i) {
+            free(ev.memo[i].keys);
+            free(ev.memo[i].results);
+            free(ev.memo[i].used);
+        }
+        free(ev.memo);
+    }
+    if (ev.tier) {
+        if (opts->tier_stats) tier_report(&ev, opts->tier_stats);
+        for (int i = 0; i < prog->nfunctions; ++i) jit_free(ev.tier[i].native);
+        free(ev.tier);
+    }
+    sym_free(ev.sym);
+    free(ev.func_index);
+    free(ev.call_cache);
+    free(ev.frame_stack);
+    free(ev.global_values);
+    free(ev.global_defined);
     return (int)result;
 }
+
+int eval_program(Program *prog, Output *out) {
+    return run_program(prog, out, NULL);
+}
+
+int eval_program_with_options(Program *prog, Output *out, const EvalOptions *opts) {
+    return run_program(prog, out, opts);
+}
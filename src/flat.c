@@ -0,0 +1,632 @@
+/* 평평한 AST: Program → 종류별 배열 변환과 그 위의 인터프리터
+ * 인터프리터는 eval.c의 슬롯 프레임 경로와 같은 규칙으로 실행
+ * (함수는 top-level 항목에 닿을 때 등록, 같은 이름은 첫 정의, 인자는 최대 FLAT_MAX_ARGS개 평가)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ast.h"
+#include "eval.h"
+#include "resolve.h"
+#include "output.h"
+#include "flat.h"
+
+#define FLAT_MAX_ARGS 16    /* eval_call과 동일한 인자 개수 제한 */
+
+static void *xrealloc(void *p, size_t size) {
+    p = realloc(p, size ? size : 1);
+    if (!p) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+/* === 만들기 === */
+
+typedef struct {
+    FlatProgram *fp;
+    int ecap, ccap, scap, lcap, ncap;
+    FuncTable defs;         /* 호출 대상 (이름 → 첫 정의) */
+} Builder;
+
+static int32_t add_name(Builder *b, const char *name) {
+    FlatProgram *fp = b->fp;
+    if (fp->nnames == b->ncap) {
+        b->ncap = b->ncap ? b->ncap * 2 : 64;
+        fp->names = (const char **)xrealloc(fp->names, sizeof(char *) * b->ncap);
+    }
+    fp->names[fp->nnames] = name;
+    return fp->nnames++;
+}
+
+/* list에 count칸 확보, 반환: 시작 인덱스 */
+static int32_t reserve_list(Builder *b, int count) {
+    FlatProgram *fp = b->fp;
+    if (fp->nlist + count > b->lcap) {
+        while (fp->nlist + count > b->lcap) b->lcap = b->lcap ? b->lcap * 2 : 256;
+        fp->list = (int32_t *)xrealloc(fp->list, sizeof(int32_t) * b->lcap);
+    }
+    int32_t first = fp->nlist;
+    fp->nlist += count;
+    return first;
+}
+
+static FlatId new_expr(Builder *b, ExprKind kind, int op) {
+    FlatProgram *fp = b->fp;
+    if (fp->nexprs == b->ecap) {
+        b->ecap = b->ecap ? b->ecap * 2 : 256;
+        fp->exprs = (FlatExpr *)xrealloc(fp->exprs, sizeof(FlatExpr) * b->ecap);
+    }
+    FlatId id = fp->nexprs++;
+    FlatExpr *x = &fp->exprs[id];
+    x->kind = (uint8_t)kind;
+    x->op = (uint8_t)op;
+    x->a = FLAT_NONE;
+    x->b = FLAT_NONE;
+    return id;
+}
+
+static FlatId new_stmt(Builder *b, StmtKind kind, int op) {
+    FlatProgram *fp = b->fp;
+    if (fp->nstmts == b->scap) {
+        b->scap = b->scap ? b->scap * 2 : 256;
+        fp->stmts = (FlatStmt *)xrealloc(fp->stmts, sizeof(FlatStmt) * b->scap);
+    }
+    FlatId id = fp->nstmts++;
+    FlatStmt *x = &fp->stmts[id];
+    x->kind = (uint8_t)kind;
+    x->op = (uint8_t)op;
+    x->a = FLAT_NONE;
+    x->b = FLAT_NONE;
+    x->c = FLAT_NONE;
+    x->d = FLAT_NONE;
+    return id;
+}
+
+/* 자식을 만드는 동안 배열이 옮겨질 수 있으므로 필드는 자식을 만든 뒤에 씀 */
+static FlatId build_expr(Builder *b, Expr *e) {
+    if (!e) return FLAT_NONE;
+    FlatId id, x;
+
+    switch (e->kind) {
+        case EXPR_INT:
+            id = new_expr(b, EXPR_INT, 0);
+            b->fp->exprs[id].a = e->u.int_value;
+            return id;
+
+        case EXPR_STRING:
+            id = new_expr(b, EXPR_STRING, 0);
+            b->fp->exprs[id].a = (int32_t)e->u.string.offset;
+            b->fp->exprs[id].b = (int32_t)e->u.string.len;
+            return id;
+
+        case EXPR_VAR:
+            id = new_expr(b, EXPR_VAR, e->ref.kind);
+            x = add_name(b, e->u.var_name);
+            b->fp->exprs[id].a = e->ref.slot;
+            b->fp->exprs[id].b = x;
+            return id;
+
+        case EXPR_BINOP:
+            id = new_expr(b, EXPR_BINOP, e->u.binop.op);
+            x = build_expr(b, e->u.binop.lhs);
+            b->fp->exprs[id].a = x;
+            x = build_expr(b, e->u.binop.rhs);
+            b->fp->exprs[id].b = x;
+            return id;
+
+        case EXPR_UNARY:
+            id = new_expr(b, EXPR_UNARY, e->u.unary.op);
+            x = build_expr(b, e->u.unary.operand);
+            b->fp->exprs[id].a = x;
+            return id;
+
+        case EXPR_CALL: {
+            FlatProgram *fp = b->fp;
+            id = new_expr(b, EXPR_CALL, e->u.call.tail ? 1 : 0);
+            if (fp->ncalls == b->ccap) {
+                b->ccap = b->ccap ? b->ccap * 2 : 64;
+                fp->calls = (FlatCall *)xrealloc(fp->calls, sizeof(FlatCall) * b->ccap);
+            }
+            int32_t ci = fp->ncalls++;
+            fp->exprs[id].a = ci;
+
+            int count = 0;
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) count++;
+            int32_t first = reserve_list(b, count);
+            fp->calls[ci].name = add_name(b, e->u.call.func_name);
+            Function *callee = func_table_find(&b->defs, e->u.call.func_name);
+            fp->calls[ci].func = callee ? callee->index : -1;
+            fp->calls[ci].first = first;
+            fp->calls[ci].count = count;
+
+            int i = 0;
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                x = build_expr(b, arg->expr);
+                fp->list[first + i++] = x;
+            }
+            return id;
+        }
+    }
+    return FLAT_NONE;
+}
+
+static FlatId build_stmt(Builder *b, Stmt *s);
+
+/* 문장 리스트 → list 구간, 반환: 시작 인덱스 (*count에 문장 수) */
+static int32_t build_list(Builder *b, StmtList *list, int32_t *count) {
+    int n = 0;
+    for (Stmt *s = list ? list->head : NULL; s; s = s->next) n++;
+    int32_t first = reserve_list(b, n);
+    int i = 0;
+    for (Stmt *s = list ? list->head : NULL; s; s = s->next) {
+        FlatId x = build_stmt(b, s);
+        b->fp->list[first + i++] = x;
+    }
+    *count = n;
+    return first;
+}
+
+static FlatId build_stmt(Builder *b, Stmt *s) {
+    if (!s) return FLAT_NONE;
+    FlatId id, x;
+
+    switch (s->kind) {
+        case STMT_EXPR:
+        case STMT_RETURN:
+        case STMT_PRINT:
+            id = new_stmt(b, s->kind, 0);
+            x = build_expr(b, s->u.expr);
+            b->fp->stmts[id].a = x;
+            return id;
+
+        case STMT_VARDECL:
+        case STMT_ASSIGN: {
+            int decl = s->kind == STMT_VARDECL;
+            id = new_stmt(b, s->kind, s->ref.kind);
+            x = build_expr(b, decl ? s->u.vardecl.init_value : s->u.assign.value);
+            b->fp->stmts[id].a = x;
+            b->fp->stmts[id].b = s->ref.slot;
+            x = add_name(b, decl ? s->u.vardecl.var_name : s->u.assign.var_name);
+            b->fp->stmts[id].c = x;
+            return id;
+        }
+
+        case STMT_IF:
+            id = new_stmt(b, STMT_IF, 0);
+            x = build_expr(b, s->u.if_stmt.cond);
+            b->fp->stmts[id].a = x;
+            x = build_stmt(b, s->u.if_stmt.then_stmt);
+            b->fp->stmts[id].b = x;
+            x = build_stmt(b, s->u.if_stmt.else_stmt);
+            b->fp->stmts[id].c = x;
+            return id;
+
+        case STMT_WHILE:
+            id = new_stmt(b, STMT_WHILE, 0);
+            x = build_expr(b, s->u.while_stmt.cond);
+            b->fp->stmts[id].a = x;
+            x = build_stmt(b, s->u.while_stmt.body);
+            b->fp->stmts[id].b = x;
+            return id;
+
+        case STMT_FOR:
+            id = new_stmt(b, STMT_FOR, s->needs_scope);
+            x = build_stmt(b, s->u.for_stmt.init);
+            b->fp->stmts[id].a = x;
+            x = build_expr(b, s->u.for_stmt.cond);
+            b->fp->stmts[id].b = x;
+            x = build_stmt(b, s->u.for_stmt.step);
+            b->fp->stmts[id].c = x;
+            x = build_stmt(b, s->u.for_stmt.body);
+            b->fp->stmts[id].d = x;
+            return id;
+
+        case STMT_BLOCK: {
+            int32_t count;
+            id = new_stmt(b, STMT_BLOCK, s->needs_scope);
+            x = build_list(b, s->u.block, &count);
+            b->fp->stmts[id].a = x;
+            b->fp->stmts[id].b = count;
+            return id;
+        }
+    }
+    return FLAT_NONE;
+}
+
+FlatProgram *flat_build(Program *prog) {
+    FlatProgram *fp = (FlatProgram *)calloc(1, sizeof(FlatProgram));
+    if (!fp) return NULL;
+    Builder b;
+    memset(&b, 0, sizeof(b));
+    b.fp = fp;
+
+    fp->resolved = prog->resolved;
+    fp->main_slots = prog->main_slots;
+    fp->nglobals = prog->nglobals;
+    fp->global_names = prog->global_names;
+    fp->text = prog->source.base;
+    fp->nfuncs = prog->nfunctions;
+    fp->funcs = (FlatFunc *)calloc(prog->nfunctions + 1, sizeof(FlatFunc));
+
+    /* 호출 대상: 같은 이름의 첫 정의 */
+    func_table_build(&b.defs, prog);
+    int nitems = 0;
+    for (Item *item = prog->items; item; item = item->next) nitems++;
+
+    /* 함수 본문을 먼저, top-level 문장은 항목 순서대로 */
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind != ITEM_FUNCTION) continue;
+        Function *f = item->u.function;
+        int32_t count;
+        int32_t first = build_list(&b, f->body, &count);
+        FlatFunc *ff = &fp->funcs[f->index];
+        ff->func = f;
+        ff->first = first;
+        ff->count = count;
+        ff->nslots = f->nslots;
+        for (Param *p = f->params ? f->params->head : NULL; p; p = p->next) ff->nparams++;
+    }
+
+    fp->items = (FlatItem *)malloc(sizeof(FlatItem) * (nitems + 1));
+    for (Item *item = prog->items; item; item = item->next) {
+        FlatItem *fi = &fp->items[fp->nitems++];
+        fi->kind = (uint8_t)item->kind;
+        if (item->kind == ITEM_FUNCTION) {
+            fi->index = item->u.function->index;
+        } else {
+            FlatId x = build_stmt(&b, item->u.stmt);
+            fp->items[fp->nitems - 1].index = x;
+        }
+    }
+
+    func_table_free(&b.defs);
+    return fp;
+}
+
+void flat_free(FlatProgram *fp) {
+    if (!fp) return;
+    free(fp->exprs);
+    free(fp->calls);
+    free(fp->stmts);
+    free(fp->list);
+    free(fp->names);
+    free(fp->funcs);
+    free(fp->items);
+    free(fp);
+}
+
+int flat_node_count(const FlatProgram *fp) {
+    return fp->nexprs + fp->nstmts;
+}
+
+size_t flat_bytes(const FlatProgram *fp) {
+    return (size_t)fp->nexprs * sizeof(FlatExpr) +
+           (size_t)fp->ncalls * sizeof(FlatCall) +
+           (size_t)fp->nstmts * sizeof(FlatStmt) +
+           (size_t)fp->nlist * sizeof(int32_t) +
+           (size_t)fp->nnames * sizeof(char *) +
+           (size_t)fp->nfuncs * sizeof(FlatFunc) +
+           (size_t)fp->nitems * sizeof(FlatItem);
+}
+
+int flat_expr_has_effects(const FlatProgram *fp, FlatId e) {
+    if (e == FLAT_NONE) return 0;
+    switch (fp->exprs[e].kind) {
+        case EXPR_INT:
+        case EXPR_STRING:
+            return 0;
+        case EXPR_VAR:
+            /* 전역은 정의 전에 읽으면 에러를 출력 */
+            return fp->exprs[e].op != VAR_LOCAL;
+        case EXPR_BINOP: {
+            FlatId rhs = fp->exprs[e].b;
+            if ((fp->exprs[e].op == BIN_DIV || fp->exprs[e].op == BIN_MOD) &&
+                !(rhs != FLAT_NONE && fp->exprs[rhs].kind == EXPR_INT && fp->exprs[rhs].a != 0)) {
+                return 1;
+            }
+            return flat_expr_has_effects(fp, fp->exprs[e].a) || flat_expr_has_effects(fp, rhs);
+        }
+        case EXPR_CALL:
+            return 1;
+        case EXPR_UNARY:
+            return flat_expr_has_effects(fp, fp->exprs[e].a);
+    }
+    return 1;
+}
+
+/* === 실행 === */
+
+/* 문장 실행 결과 */
+enum {
+    FLAT_NEXT,
+    FLAT_RETURN,        /* 값은 FlatEval.ret */
+    FLAT_TAIL           /* 꼬리 자기 호출, 인자는 FlatEval.tail_args */
+};
+
+typedef struct {
+    const FlatProgram *fp;
+    Output *out;
+
+    long *frame_stack;
+    long frame_cap;
+    long frame_base;
+    long frame_top;
+
+    long *global_values;
+    unsigned char *global_defined;
+    unsigned char *fdefined;    /* Function.index → top-level 항목에 닿음 */
+
+    long ret;
+    long tail_args[FLAT_MAX_ARGS];
+    int tail_argc;
+    int depth;                  /* 실행 중인 함수 호출 수 (EVAL_MAX_CALL_DEPTH까지) */
+    uintptr_t stack_limit;      /* C 스택이 이 주소 아래로 내려가면 호출 거부 */
+} FlatEval;
+
+static void reserve_frame(FlatEval *fe, long nslots) {
+    if (fe->frame_top + nslots <= fe->frame_cap) return;
+    long cap = fe->frame_cap ? fe->frame_cap : 1024;
+    while (fe->frame_top + nslots > cap) cap *= 2;
+    fe->frame_stack = (long *)xrealloc(fe->frame_stack, cap * sizeof(long));
+    fe->frame_cap = cap;
+}
+
+static long eval_expr(FlatEval *fe, FlatId e);
+static int exec_stmt(FlatEval *fe, FlatId s);
+
+static long call_function(FlatEval *fe, const FlatFunc *f, const long *args, int argc) {
+    char mark;
+    if (fe->depth >= EVAL_MAX_CALL_DEPTH || (uintptr_t)&mark < fe->stack_limit) {
+        output_printf(fe->out, "Error: maximum call depth exceeded\n");
+        return 0;
+    }
+    fe->depth++;
+    const FlatProgram *fp = fe->fp;
+    long saved_base = fe->frame_base;
+    reserve_frame(fe, f->nslots);
+    fe->frame_base = fe->frame_top;
+    fe->frame_top += f->nslots;
+    long *slots = fe->frame_stack + fe->frame_base;
+    int i = 0;
+    for (; i < f->nparams && i < argc; ++i) slots[i] = args[i];
+    for (; i < f->nslots; ++i) slots[i] = 0;
+
+    long result = 0;
+    for (int32_t k = 0; k < f->count; ++k) {
+        int r = exec_stmt(fe, fp->list[f->first + k]);
+        if (r == FLAT_TAIL) {
+            /* 같은 프레임에 다시 바인딩하고 본문 처음부터 */
+            slots = fe->frame_stack + fe->frame_base;
+            i = 0;
+            for (; i < f->nparams && i < fe->tail_argc; ++i) slots[i] = fe->tail_args[i];
+            for (; i < f->nslots; ++i) slots[i] = 0;
+            k = -1;
+            continue;
+        }
+        if (r == FLAT_RETURN) {
+            result = fe->ret;
+            break;
+        }
+    }
+
+    fe->frame_top = fe->frame_base;
+    fe->frame_base = saved_base;
+    fe->depth--;
+    return result;
+}
+
+/* 인자 평가 (최대 FLAT_MAX_ARGS개), 반환: 개수 */
+static int eval_args(FlatEval *fe, const FlatCall *c, long *args) {
+    int argc = 0;
+    for (int32_t k = 0; k < c->count && argc < FLAT_MAX_ARGS; ++k) {
+        args[argc++] = eval_expr(fe, fe->fp->list[c->first + k]);
+    }
+    return argc;
+}
+
+static long eval_call(FlatEval *fe, const FlatCall *c) {
+    if (c->func < 0 || !fe->fdefined[c->func]) {
+        /* eval_call과 같이 인자를 평가하지 않고 에러 */
+        output_printf(fe->out, "Error: undefined function '%s'\n", fe->fp->names[c->name]);
+        return 0;
+    }
+    long args[FLAT_MAX_ARGS];
+    int argc = eval_args(fe, c, args);
+    return call_function(fe, &fe->fp->funcs[c->func], args, argc);
+}
+
+static long eval_expr(FlatEval *fe, FlatId e) {
+    if (e == FLAT_NONE) return 0;
+    const FlatProgram *fp = fe->fp;
+
+    switch (fp->exprs[e].kind) {
+        case EXPR_INT:
+            return fp->exprs[e].a;
+
+        case EXPR_STRING:
+            return 0;
+
+        case EXPR_VAR:
+            switch (fp->exprs[e].op) {
+                case VAR_LOCAL:
+                    return fe->frame_stack[fe->frame_base + fp->exprs[e].a];
+                case VAR_GLOBAL:
+                    if (fe->global_defined[fp->exprs[e].a]) return fe->global_values[fp->exprs[e].a];
+                    break;
+                default:
+                    break;
+            }
+            output_printf(fe->out, "Error: undefined variable '%s'\n", fp->names[fp->exprs[e].b]);
+            return 0;
+
+        case EXPR_BINOP: {
+            long lhs = eval_expr(fe, fp->exprs[e].a);
+            long rhs = eval_expr(fe, fp->exprs[e].b);
+            switch (fp->exprs[e].op) {
+                case BIN_ADD: return lhs + rhs;
+                case BIN_SUB: return lhs - rhs;
+                case BIN_MUL: return lhs * rhs;
+                case BIN_DIV:
+                    if (rhs == 0) {
+                        output_printf(fe->out, "Error: division by zero\n");
+                        return 0;
+                    }
+                    return lhs / rhs;
+                case BIN_MOD:
+                    if (rhs == 0) {
+                        output_printf(fe->out, "Error: modulo by zero\n");
+                        return 0;
+                    }
+                    return lhs % rhs;
+                case BIN_LT: return lhs < rhs ? 1 : 0;
+                case BIN_GT: return lhs > rhs ? 1 : 0;
+                case BIN_LE: return lhs <= rhs ? 1 : 0;
+                case BIN_GE: return lhs >= rhs ? 1 : 0;
+                case BIN_EQ: return lhs == rhs ? 1 : 0;
+                case BIN_NE: return lhs != rhs ? 1 : 0;
+                case BIN_AND: return (lhs && rhs) ? 1 : 0;
+                case BIN_OR: return (lhs || rhs) ? 1 : 0;
+            }
+            return 0;
+        }
+
+        case EXPR_CALL:
+            return eval_call(fe, &fp->calls[fp->exprs[e].a]);
+
+        case EXPR_UNARY: {
+            long val = eval_expr(fe, fp->exprs[e].a);
+            return fp->exprs[e].op == UNARY_NEG ? -val : (val ? 0 : 1);
+        }
+    }
+    return 0;
+}
+
+static void store_var(FlatEval *fe, FlatId s, long val) {
+    const FlatProgram *fp = fe->fp;
+    int32_t slot = fp->stmts[s].b;
+    if (fp->stmts[s].op == VAR_GLOBAL) {
+        fe->global_values[slot] = val;
+        fe->global_defined[slot] = 1;
+    } else if (fp->stmts[s].op == VAR_LOCAL) {
+        fe->frame_stack[fe->frame_base + slot] = val;
+    }
+}
+
+static int exec_stmt(FlatEval *fe, FlatId s) {
+    if (s == FLAT_NONE) return FLAT_NEXT;
+    const FlatProgram *fp = fe->fp;
+
+    switch (fp->stmts[s].kind) {
+        case STMT_VARDECL:
+        case STMT_ASSIGN:
+            store_var(fe, s, eval_expr(fe, fp->stmts[s].a));
+            return FLAT_NEXT;
+
+        case STMT_EXPR:
+            eval_expr(fe, fp->stmts[s].a);
+            return FLAT_NEXT;
+
+        case STMT_RETURN: {
+            FlatId e = fp->stmts[s].a;
+            if (e != FLAT_NONE && fp->exprs[e].kind == EXPR_CALL && fp->exprs[e].op) {
+                /* 인자만 평가하고 호출은 call_function의 본문 루프가 대신함 */
+                long args[FLAT_MAX_ARGS];
+                int argc = eval_args(fe, &fp->calls[fp->exprs[e].a], args);
+                memcpy(fe->tail_args, args, argc * sizeof(long));
+                fe->tail_argc = argc;
+                return FLAT_TAIL;
+            }
+            fe->ret = eval_expr(fe, e);
+            return FLAT_RETURN;
+        }
+
+        case STMT_PRINT: {
+            FlatId e = fp->stmts[s].a;
+            if (e != FLAT_NONE && fp->exprs[e].kind == EXPR_STRING) {
+                output_line_strn(fe->out, fp->text + fp->exprs[e].a, fp->exprs[e].b);
+            } else {
+                output_line_int(fe->out, eval_expr(fe, e));
+            }
+            return FLAT_NEXT;
+        }
+
+        case STMT_IF:
+            if (eval_expr(fe, fp->stmts[s].a)) return exec_stmt(fe, fp->stmts[s].b);
+            return exec_stmt(fe, fp->stmts[s].c);
+
+        case STMT_WHILE:
+            while (eval_expr(fe, fp->stmts[s].a)) {
+                int r = exec_stmt(fe, fp->stmts[s].b);
+                if (r != FLAT_NEXT) return r;
+            }
+            return FLAT_NEXT;
+
+        case STMT_FOR:
+            exec_stmt(fe, fp->stmts[s].a);
+            while (fp->stmts[s].b == FLAT_NONE || eval_expr(fe, fp->stmts[s].b)) {
+                int r = exec_stmt(fe, fp->stmts[s].d);
+                if (r != FLAT_NEXT) return r;
+                exec_stmt(fe, fp->stmts[s].c);
+            }
+            return FLAT_NEXT;
+
+        case STMT_BLOCK: {
+            const int32_t *body = fp->list + fp->stmts[s].a;
+            for (int32_t k = 0; k < fp->stmts[s].b; ++k) {
+                int r = exec_stmt(fe, body[k]);
+                if (r != FLAT_NEXT) return r;
+            }
+            return FLAT_NEXT;
+        }
+    }
+    return FLAT_NEXT;
+}
+
+int flat_run(FlatProgram *fp, Output *out) {
+    FlatEval fe;
+    memset(&fe, 0, sizeof(fe));
+    fe.fp = fp;
+    fe.out = out;
+    fe.stack_limit = eval_stack_limit();
+    fe.global_values = (long *)calloc(fp->nglobals + 1, sizeof(long));
+    fe.global_defined = (unsigned char *)calloc(fp->nglobals + 1, 1);
+    fe.fdefined = (unsigned char *)calloc(fp->nfuncs + 1, 1);
+    reserve_frame(&fe, fp->main_slots);
+    for (long i = 0; i < fp->main_slots; ++i) fe.frame_stack[i] = 0;
+    fe.frame_top = fp->main_slots;
+
+    long result = 0;
+    for (int i = 0; i < fp->nitems; ++i) {
+        const FlatItem *item = &fp->items[i];
+        if (item->kind == ITEM_FUNCTION) {
+            fe.fdefined[item->index] = 1;
+        } else if (exec_stmt(&fe, item->index) == FLAT_RETURN) {
+            result = fe.ret;
+            break;
+        }
+    }
+
+    free(fe.frame_stack);
+    free(fe.global_values);
+    free(fe.global_defined);
+    free(fe.fdefined);
+    return (int)result;
+}
+
+int flat_eval_program(Program *prog, Output *out, int *used_flat, const char **error) {
+    if (used_flat) *used_flat = 0;
+    if (error) *error = NULL;
+    if (!prog || !resolve_program(prog)) {
+        if (error && prog) *error = prog->resolve_error;
+        return eval_program(prog, out);
+    }
+    FlatProgram *fp = flat_build(prog);
+    if (!fp) return eval_program(prog, out);
+    int result = flat_run(fp, out);
+    flat_free(fp);
+    if (used_flat) *used_flat = 1;
+    return result;
+}
@@ -0,0 +1,420 @@
+/* 상수 접기 / 상수 전파
+ * 1) 모든 식을 아래에서 위로 접음
+ * 2) resolve_program이 성공하면 슬롯별 선언/대입 수를 세어 상수 변수 읽기를 정수로 바꾸고
+ *    바뀐 값으로 다시 접음 (더 바뀌지 않을 때까지)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "ast.h"
+#include "resolve.h"
+#include "fold.h"
+
+typedef struct {
+    Program *prog;
+    FoldStats st;
+} Folder;
+
+/* === 상수 접기 === */
+
+static int is_int(const Expr *e, long value) {
+    return e && e->kind == EXPR_INT && e->u.int_value == value;
+}
+
+/* 값이 항상 0 또는 1인 식 (!, 비교, &&, ||) */
+static int is_boolean(const Expr *e) {
+    if (!e) return 0;
+    switch (e->kind) {
+        case EXPR_INT:
+            return e->u.int_value == 0 || e->u.int_value == 1;
+        case EXPR_UNARY:
+            return e->u.unary.op == UNARY_NOT;
+        case EXPR_BINOP:
+            return e->u.binop.op >= BIN_LT;
+        default:
+            return 0;
+    }
+}
+
+/* eval_expr와 같은 계산 (0으로 나누기는 에러를 출력해야 하므로 접지 않음) */
+static int compute_binop(BinOpKind op, long a, long b, long *out) {
+    switch (op) {
+        case BIN_ADD: *out = a + b; return 1;
+        case BIN_SUB: *out = a - b; return 1;
+        case BIN_MUL: *out = a * b; return 1;
+        case BIN_DIV:
+            if (b == 0) return 0;
+            *out = a / b;
+            return 1;
+        case BIN_MOD:
+            if (b == 0) return 0;
+            *out = a % b;
+            return 1;
+        case BIN_LT: *out = a < b; return 1;
+        case BIN_GT: *out = a > b; return 1;
+        case BIN_LE: *out = a <= b; return 1;
+        case BIN_GE: *out = a >= b; return 1;
+        case BIN_EQ: *out = a == b; return 1;
+        case BIN_NE: *out = a != b; return 1;
+        case BIN_AND: *out = a && b; return 1;
+        case BIN_OR: *out = a || b; return 1;
+    }
+    return 0;
+}
+
+/* 노드를 정수 상수로 (EXPR_INT는 int이므로 범위를 넘으면 그대로) */
+static int make_int(Expr *e, long value) {
+    if (value < INT_MIN || value > INT_MAX) return 0;
+    e->kind = EXPR_INT;
+    e->u.int_value = (int)value;
+    e->ref.kind = VAR_UNRESOLVED;
+    e->ref.slot = -1;
+    return 1;
+}
+
+/* truth: 값이 참/거짓으로만 쓰이는 위치 (조건, &&/||/!의 피연산자) */
+static Expr *fold_expr(Folder *fd, Expr *e, int truth) {
+    if (!e) return e;
+
+    switch (e->kind) {
+        case EXPR_BINOP: {
+            BinOpKind op = e->u.binop.op;
+            int logical = op == BIN_AND || op == BIN_OR;
+            Expr *lhs = e->u.binop.lhs = fold_expr(fd, e->u.binop.lhs, logical);
+            Expr *rhs = e->u.binop.rhs = fold_expr(fd, e->u.binop.rhs, logical);
+            long value;
+            if (lhs->kind == EXPR_INT && rhs->kind == EXPR_INT &&
+                compute_binop(op, lhs->u.int_value, rhs->u.int_value, &value) && make_int(e, value)) {
+                fd->st.folded++;
+                return e;
+            }
+            /* 항등원: 남는 쪽은 원래대로 한 번 평가됨 */
+            Expr *keep = NULL;
+            switch (op) {
+                case BIN_ADD:
+                    if (is_int(rhs, 0)) keep = lhs;
+                    else if (is_int(lhs, 0)) keep = rhs;
+                    break;
+                case BIN_SUB:
+                    if (is_int(rhs, 0)) keep = lhs;
+                    break;
+                case BIN_MUL:
+                    if (is_int(rhs, 1)) keep = lhs;
+                    else if (is_int(lhs, 1)) keep = rhs;
+                    break;
+                case BIN_DIV:
+                    if (is_int(rhs, 1)) keep = lhs;
+                    break;
+                default:
+                    break;
+            }
+            if (keep) {
+                fd->st.simplified++;
+                return keep;
+            }
+            return e;
+        }
+
+        case EXPR_UNARY: {
+            UnaryOpKind op = e->u.unary.op;
+            Expr *operand = e->u.unary.operand = fold_expr(fd, e->u.unary.operand, op == UNARY_NOT);
+            if (operand->kind == EXPR_INT) {
+                long v = operand->u.int_value;
+                if (make_int(e, op == UNARY_NEG ? -v : !v)) {
+                    fd->st.folded++;
+                    return e;
+                }
+            }
+            /* !!x → x */
+            if (op == UNARY_NOT && operand->kind == EXPR_UNARY && operand->u.unary.op == UNARY_NOT) {
+                Expr *inner = operand->u.unary.operand;
+                if (truth || is_boolean(inner)) {
+                    fd->st.simplified++;
+                    return inner;
+                }
+            }
+            return e;
+        }
+
+        case EXPR_CALL:
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                arg->expr = fold_expr(fd, arg->expr, 0);
+            }
+            return e;
+
+        default:
+            return e;
+    }
+}
+
+static void fold_stmt(Folder *fd, Stmt *s) {
+    if (!s) return;
+
+    switch (s->kind) {
+        case STMT_VARDECL:
+            s->u.vardecl.init_value = fold_expr(fd, s->u.vardecl.init_value, 0);
+            break;
+        case STMT_ASSIGN:
+            s->u.assign.value = fold_expr(fd, s->u.assign.value, 0);
+            break;
+        case STMT_EXPR:
+        case STMT_RETURN:
+        case STMT_PRINT:
+            s->u.expr = fold_expr(fd, s->u.expr, 0);
+            break;
+        case STMT_IF:
+            s->u.if_stmt.cond = fold_expr(fd, s->u.if_stmt.cond, 1);
+            fold_stmt(fd, s->u.if_stmt.then_stmt);
+            fold_stmt(fd, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            s->u.while_stmt.cond = fold_expr(fd, s->u.while_stmt.cond, 1);
+            fold_stmt(fd, s->u.while_stmt.body);
+            break;
+        case STMT_FOR:
+            fold_stmt(fd, s->u.for_stmt.init);
+            s->u.for_stmt.cond = fold_expr(fd, s->u.for_stmt.cond, 1);
+            fold_stmt(fd, s->u.for_stmt.step);
+            fold_stmt(fd, s->u.for_stmt.body);
+            break;
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                fold_stmt(fd, b);
+            }
+            break;
+    }
+}
+
+static void fold_all(Folder *fd) {
+    for (Item *item = fd->prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) {
+            fold_stmt(fd, item->u.stmt);
+        } else if (item->kind == ITEM_FUNCTION) {
+            Function *f = item->u.function;
+            for (Stmt *s = f->body ? f->body->head : NULL; s; s = s->next) {
+                fold_stmt(fd, s);
+            }
+        }
+    }
+}
+
+/* === 상수 전파 === */
+
+typedef struct {
+    int decls;
+    int writes;
+    int constant;       /* 초기값이 정수 상수 (없으면 0) */
+    int value;
+    int order;          /* 전역: 선언이 곧 top-level 항목인 경우 항목 번호, 아니면 -1 */
+} SlotInfo;
+
+/* 실행 단위 하나 (top-level 또는 함수)의 슬롯 정보 */
+typedef struct {
+    SlotInfo *locals;
+    int nlocals;
+    int nparams;        /* 매개변수 슬롯은 인자로 정해지므로 제외 */
+    SlotInfo *globals;
+    int nglobals;
+    int order;          /* 현재 top-level 항목 번호 (함수 안이면 -1) */
+} Unit;
+
+static SlotInfo *slot_info(Unit *u, const VarRef *ref) {
+    if (ref->kind == VAR_LOCAL && ref->slot >= 0 && ref->slot < u->nlocals) {
+        return &u->locals[ref->slot];
+    }
+    if (ref->kind == VAR_GLOBAL && ref->slot >= 0 && ref->slot < u->nglobals) {
+        return &u->globals[ref->slot];
+    }
+    return NULL;
+}
+
+static void collect_stmt(Unit *u, Stmt *s, int direct) {
+    if (!s) return;
+
+    switch (s->kind) {
+        case STMT_VARDECL: {
+            SlotInfo *info = slot_info(u, &s->ref);
+            if (!info) break;
+            Expr *init = s->u.vardecl.init_value;
+            info->decls++;
+            info->constant = !init || init->kind == EXPR_INT;
+            info->value = init && init->kind == EXPR_INT ? init->u.int_value : 0;
+            if (s->ref.kind == VAR_GLOBAL && direct) info->order = u->order;
+            break;
+        }
+        case STMT_ASSIGN: {
+            SlotInfo *info = slot_info(u, &s->ref);
+            if (info) info->writes++;
+            break;
+        }
+        case STMT_IF:
+            collect_stmt(u, s->u.if_stmt.then_stmt, 0);
+            collect_stmt(u, s->u.if_stmt.else_stmt, 0);
+            break;
+        case STMT_WHILE:
+            collect_stmt(u, s->u.while_stmt.body, 0);
+            break;
+        case STMT_FOR:
+            collect_stmt(u, s->u.for_stmt.init, 0);
+            collect_stmt(u, s->u.for_stmt.step, 0);
+            collect_stmt(u, s->u.for_stmt.body, 0);
+            break;
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                collect_stmt(u, b, 0);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static int propagatable(const Unit *u, const VarRef *ref, SlotInfo *info) {
+    if (!info || info->decls != 1 || info->writes != 0 || !info->constant) return 0;
+    if (ref->kind == VAR_LOCAL) return ref->slot >= u->nparams;
+    /* 전역: 선언 뒤에 실행되는 top-level 문장에서만 */
+    return u->order >= 0 && info->order >= 0 && info->order < u->order;
+}
+
+static void subst_expr(Folder *fd, Unit *u, Expr *e) {
+    if (!e) return;
+
+    switch (e->kind) {
+        case EXPR_VAR: {
+            SlotInfo *info = slot_info(u, &e->ref);
+            if (propagatable(u, &e->ref, info) && make_int(e, info->value)) fd->st.propagated++;
+            break;
+        }
+        case EXPR_BINOP:
+            subst_expr(fd, u, e->u.binop.lhs);
+            subst_expr(fd, u, e->u.binop.rhs);
+            break;
+        case EXPR_UNARY:
+            subst_expr(fd, u, e->u.unary.operand);
+            break;
+        case EXPR_CALL:
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                subst_expr(fd, u, arg->expr);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void subst_stmt(Folder *fd, Unit *u, Stmt *s) {
+    if (!s) return;
+
+    switch (s->kind) {
+        case STMT_VARDECL:
+            subst_expr(fd, u, s->u.vardecl.init_value);
+            break;
+        case STMT_ASSIGN:
+            subst_expr(fd, u, s->u.assign.value);
+            break;
+        case STMT_EXPR:
+        case STMT_RETURN:
+        case STMT_PRINT:
+            subst_expr(fd, u, s->u.expr);
+            break;
+        case STMT_IF:
+            subst_expr(fd, u, s->u.if_stmt.cond);
+            subst_stmt(fd, u, s->u.if_stmt.then_stmt);
+            subst_stmt(fd, u, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            subst_expr(fd, u, s->u.while_stmt.cond);
+            subst_stmt(fd, u, s->u.while_stmt.body);
+            break;
+        case STMT_FOR:
+            subst_stmt(fd, u, s->u.for_stmt.init);
+            subst_expr(fd, u, s->u.for_stmt.cond);
+            subst_stmt(fd, u, s->u.for_stmt.step);
+            subst_stmt(fd, u, s->u.for_stmt.body);
+            break;
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                subst_stmt(fd, u, b);
+            }
+            break;
+    }
+}
+
+static void unit_begin(Unit *u, int nlocals, int nparams) {
+    u->nlocals = nlocals;
+    u->nparams = nparams;
+    u->locals = (SlotInfo *)calloc(nlocals + 1, sizeof(SlotInfo));
+}
+
+static void collect_function(Unit *u, Function *f) {
+    for (Stmt *s = f->body ? f->body->head : NULL; s; s = s->next) {
+        collect_stmt(u, s, 0);
+    }
+}
+
+/* 한 번 전파, 반환: 바꾼 읽기 수 */
+static int propagate(Folder *fd) {
+    Program *prog = fd->prog;
+    int before = fd->st.propagated;
+    Unit u;
+    memset(&u, 0, sizeof(u));
+    u.nglobals = prog->nglobals;
+    u.globals = (SlotInfo *)calloc(u.nglobals + 1, sizeof(SlotInfo));
+    for (int g = 0; g < u.nglobals; ++g) u.globals[g].order = -1;
+
+    /* 전역 대입은 함수 안에서도 생기므로 모든 단위를 먼저 셈 */
+    unit_begin(&u, prog->main_slots, 0);
+    int order = 0;
+    for (Item *item = prog->items; item; item = item->next, ++order) {
+        u.order = order;
+        if (item->kind == ITEM_STMT) collect_stmt(&u, item->u.stmt, 1);
+    }
+    u.order = -1;
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind != ITEM_FUNCTION) continue;
+        Unit fu = u;
+        unit_begin(&fu, 0, 0);
+        collect_function(&fu, item->u.function);
+        free(fu.locals);
+    }
+
+    /* top-level */
+    order = 0;
+    for (Item *item = prog->items; item; item = item->next, ++order) {
+        u.order = order;
+        if (item->kind == ITEM_STMT) subst_stmt(fd, &u, item->u.stmt);
+    }
+    free(u.locals);
+
+    /* 함수: 지역 슬롯만 (전역은 order = -1이라 바꾸지 않음) */
+    u.order = -1;
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind != ITEM_FUNCTION) continue;
+        Function *f = item->u.function;
+        int nparams = 0;
+        for (Param *p = f->params ? f->params->head : NULL; p; p = p->next) nparams++;
+        unit_begin(&u, f->nslots, nparams);
+        collect_function(&u, f);
+        for (Stmt *s = f->body ? f->body->head : NULL; s; s = s->next) {
+            subst_stmt(fd, &u, s);
+        }
+        free(u.locals);
+    }
+    free(u.globals);
+    return fd->st.propagated - before;
+}
+
+int fold_program(Program *prog, FoldStats *stats) {
+    Folder fd;
+    memset(&fd, 0, sizeof(fd));
+    fd.prog = prog;
+    if (prog) {
+        fold_all(&fd);
+        if (resolve_program(prog)) {
+            while (propagate(&fd) > 0) fold_all(&fd);
+        }
+    }
+    if (stats) *stats = fd.st;
+    return fd.st.folded + fd.st.simplified + fd.st.propagated;
+}
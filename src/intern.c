@@ -0,0 +1,73 @@
+/* 이름 인터닝: 내용 해시(FNV-1a) → 아레나 문자열, 적재율 1/2
+ * 칸에 해시와 길이를 같이 두어 다른 이름은 문자열을 읽지 않고 넘어감
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "intern.h"
+
+#define INITIAL_CAP 256
+
+static unsigned hash_bytes(const char *s, size_t len) {
+    unsigned h = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+unsigned intern_hash(const char *name) {
+    uint64_t x = (uint64_t)(uintptr_t)name;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (unsigned)x;
+}
+
+void intern_init(InternTable *t) {
+    memset(t, 0, sizeof(*t));
+}
+
+void intern_free(InternTable *t) {
+    free(t->slots);
+    intern_init(t);
+}
+
+static void grow(InternTable *t) {
+    int cap = t->cap ? t->cap * 2 : INITIAL_CAP;
+    InternSlot *slots = (InternSlot *)calloc(cap, sizeof(InternSlot));
+    if (!slots) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    for (int i = 0; i < t->cap; ++i) {
+        if (!t->slots[i].name) continue;
+        unsigned j = t->slots[i].hash & (unsigned)(cap - 1);
+        while (slots[j].name) j = (j + 1) & (unsigned)(cap - 1);
+        slots[j] = t->slots[i];
+    }
+    free(t->slots);
+    t->slots = slots;
+    t->cap = cap;
+}
+
+char *intern_name(InternTable *t, Arena *a, const char *s, size_t len) {
+    if ((t->count + 1) * 2 > t->cap) grow(t);
+    unsigned h = hash_bytes(s, len);
+    unsigned mask = (unsigned)(t->cap - 1);
+    unsigned i = h & mask;
+    while (t->slots[i].name) {
+        InternSlot *slot = &t->slots[i];
+        if (slot->hash == h && slot->len == len && memcmp(slot->name, s, len) == 0) return slot->name;
+        i = (i + 1) & mask;
+    }
+    char *p = arena_strndup(a, s, len);
+    t->slots[i].name = p;
+    t->slots[i].hash = h;
+    t->slots[i].len = (unsigned)len;
+    t->count++;
+    t->bytes += len + 1;
+    return p;
+}
@@ -0,0 +1,1047 @@
+/* SSA IR 구성과 출력
+ * 슬롯 해석이 끝난 AST를 함수마다 SSA 형태로 바꿈 (구성 방법은 ir.h)
+ * 평가 순서와 에러 메시지는 eval_program / vm_run과 동일
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "resolve.h"
+#include "ir.h"
+
+/* === 테이블 === */
+
+static unsigned hash_name(const char *s) {
+    unsigned h = 2166136261u;   /* FNV-1a */
+    for (; *s; ++s) h = (h ^ (unsigned char)*s) * 16777619u;
+    return h;
+}
+
+static const char *func_key(IrProgram *ip, int i) { return ip->funcs[i].func->name; }
+static const char *string_key(IrProgram *ip, int i) { return ip->strings[i]; }
+
+/* 해시 칸 찾기: 같은 키의 칸 또는 빈 칸
+ * 함수 이름은 인터닝된 포인터로, 문자열 상수(에러 메시지 포함)는 내용으로 비교 */
+static int *index_slot(IrProgram *ip, int *table, int cap, const char *name,
+                       const char *(*key)(IrProgram *, int)) {
+    int interned = key == func_key;
+    unsigned i = (interned ? INTERN_HASH(name) : hash_name(name)) & (cap - 1);
+    while (table[i] >= 0) {
+        const char *k = key(ip, table[i]);
+        if (interned ? k == name : strcmp(k, name) == 0) break;
+        i = (i + 1) & (cap - 1);
+    }
+    return &table[i];
+}
+
+/* count개가 들어 있는 해시를 필요하면 두 배로 키워 다시 채움 */
+static int *index_reserve(IrProgram *ip, int *table, int *cap, int count,
+                          const char *(*key)(IrProgram *, int)) {
+    if ((count + 1) * 2 <= *cap) return table;
+    int new_cap = *cap ? *cap * 2 : 64;
+    while ((count + 1) * 2 > new_cap) new_cap *= 2;
+    free(table);
+    table = (int *)malloc(new_cap * sizeof(int));
+    memset(table, -1, new_cap * sizeof(int));
+    *cap = new_cap;
+    for (int i = 0; i < count; ++i) {
+        *index_slot(ip, table, new_cap, key(ip, i), key) = i;
+    }
+    return table;
+}
+
+int ir_find_func(IrProgram *ip, const char *name) {
+    if (ip->func_index_cap == 0) return -1;
+    return *index_slot(ip, ip->func_index, ip->func_index_cap, name, func_key);
+}
+
+int ir_add_string(IrProgram *ip, const char *str) {
+    ip->string_index = index_reserve(ip, ip->string_index, &ip->string_index_cap,
+                                     ip->nstrings, string_key);
+    int *slot = index_slot(ip, ip->string_index, ip->string_index_cap, str, string_key);
+    if (*slot >= 0) return *slot;
+    if (ip->nstrings == ip->strings_cap) {
+        ip->strings_cap = ip->strings_cap ? ip->strings_cap * 2 : 16;
+        ip->strings = (char **)realloc(ip->strings, ip->strings_cap * sizeof(char *));
+    }
+    ip->strings[ip->nstrings] = strdup(str);
+    *slot = ip->nstrings;
+    return ip->nstrings++;
+}
+
+int ir_add_text(IrProgram *ip, const char *text, size_t len) {
+    char *str = (char *)malloc(len + 1);
+    memcpy(str, text, len);
+    str[len] = '\0';
+    int index = ir_add_string(ip, str);
+    free(str);
+    return index;
+}
+
+static int add_message(IrProgram *ip, const char *fmt, const char *name) {
+    size_t size = strlen(fmt) + strlen(name) + 1;
+    char *msg = (char *)malloc(size);
+    snprintf(msg, size, fmt, name);
+    int index = ir_add_string(ip, msg);
+    free(msg);
+    return index;
+}
+
+int ir_undefined_var_msg(IrProgram *ip, const char *name) {
+    return add_message(ip, "Error: undefined variable '%s'\n", name);
+}
+
+int ir_undefined_func_msg(IrProgram *ip, const char *name) {
+    return add_message(ip, "Error: undefined function '%s'\n", name);
+}
+
+/* 함수 테이블 (같은 이름은 첫 정의만 사용, vm.c의 build_tables와 동일) */
+static void build_tables(IrProgram *ip) {
+    int seen_stmt = 0;
+    int cap = 0;
+    for (Item *item = ip->prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) {
+            seen_stmt = 1;
+            continue;
+        }
+        if (item->kind != ITEM_FUNCTION || ir_find_func(ip, item->u.function->name) >= 0) {
+            continue;
+        }
+        if (ip->nfuncs == cap) {
+            cap = cap ? cap * 2 : 16;
+            ip->funcs = (IrFunc *)realloc(ip->funcs, cap * sizeof(IrFunc));
+        }
+        ip->func_index = index_reserve(ip, ip->func_index, &ip->func_index_cap,
+                                       ip->nfuncs, func_key);
+        *index_slot(ip, ip->func_index, ip->func_index_cap, item->u.function->name, func_key) = ip->nfuncs;
+        IrFunc *f = &ip->funcs[ip->nfuncs++];
+        memset(f, 0, sizeof(*f));
+        f->func = item->u.function;
+        f->needs_check = seen_stmt;
+        f->nslots = f->func->nslots;
+        for (Param *p = f->func->params ? f->func->params->head : NULL; p; p = p->next) {
+            f->nparams++;
+        }
+    }
+    ip->main.nslots = ip->prog->main_slots;
+    ip->nglobals = ip->prog->nglobals;
+}
+
+IrProgram *ir_new(Program *prog, const char **error) {
+    if (error) *error = NULL;
+    if (!prog) {
+        if (error) *error = "no program";
+        return NULL;
+    }
+    if (!resolve_program(prog)) {
+        if (error) *error = prog->resolve_error;
+        return NULL;
+    }
+
+    IrProgram *ip = (IrProgram *)calloc(1, sizeof(IrProgram));
+    ip->prog = prog;
+    arena_init(&ip->arena);
+    build_tables(ip);
+    return ip;
+}
+
+/* === 연산자 === */
+
+int ir_negate_cc(int cc) {
+    switch (cc) {
+        case BIN_LT: return BIN_GE;
+        case BIN_GT: return BIN_LE;
+        case BIN_LE: return BIN_GT;
+        case BIN_GE: return BIN_LT;
+        case BIN_EQ: return BIN_NE;
+        default:     return BIN_EQ;
+    }
+}
+
+int ir_swap_cc(int cc) {
+    switch (cc) {
+        case BIN_LT: return BIN_GT;
+        case BIN_GT: return BIN_LT;
+        case BIN_LE: return BIN_GE;
+        case BIN_GE: return BIN_LE;
+        default:     return cc;
+    }
+}
+
+int ir_expr_has_effects(const Expr *e) {
+    if (!e) return 0;
+    switch (e->kind) {
+        case EXPR_INT:
+        case EXPR_STRING:
+            return 0;
+        case EXPR_VAR:
+            /* 전역은 정의 전에 읽으면 에러를 출력 */
+            return e->ref.kind != VAR_LOCAL;
+        case EXPR_BINOP: {
+            const Expr *rhs = e->u.binop.rhs;
+            if ((e->u.binop.op == BIN_DIV || e->u.binop.op == BIN_MOD) &&
+                !(rhs && rhs->kind == EXPR_INT && rhs->u.int_value != 0)) {
+                return 1;
+            }
+            return ir_expr_has_effects(e->u.binop.lhs) || ir_expr_has_effects(rhs);
+        }
+        case EXPR_CALL:
+            return 1;
+        case EXPR_UNARY:
+            return ir_expr_has_effects(e->u.unary.operand);
+    }
+    return 1;
+}
+
+const char *ir_op_name(IrOp op) {
+    static const char *names[IR_OP_COUNT] = {
+        [IR_CONST] = "const", [IR_PARAM] = "param", [IR_PHI] = "phi",
+        [IR_ADD] = "add", [IR_SUB] = "sub", [IR_MUL] = "mul",
+        [IR_DIV] = "div", [IR_MOD] = "mod", [IR_CMP] = "cmp",
+        [IR_AND] = "and", [IR_OR] = "or", [IR_NEG] = "neg", [IR_NOT] = "not",
+        [IR_LOADG] = "loadg", [IR_STOREG] = "storeg", [IR_CALL] = "call",
+        [IR_PRINT_INT] = "print", [IR_PRINT_STR] = "print_str", [IR_ERROR] = "error",
+        [IR_DEFFN] = "defn", [IR_JMP] = "jmp", [IR_BR] = "br",
+        [IR_CHKFN] = "chkfn", [IR_RET] = "ret",
+    };
+    return op < IR_OP_COUNT ? names[op] : "?";
+}
+
+int ir_is_terminator(IrOp op) {
+    return op == IR_JMP || op == IR_BR || op == IR_CHKFN || op == IR_RET;
+}
+
+IrInst *ir_terminator(IrFunc *f, int block) {
+    IrBlock *blk = &f->blocks[block];
+    if (blk->ninsts == 0) return NULL;
+    IrInst *in = &f->insts[blk->insts[blk->ninsts - 1]];
+    return ir_is_terminator(in->op) ? in : NULL;
+}
+
+/* === 구성: 명령어와 블록 === */
+
+typedef struct {
+    IrProgram *ip;
+    IrFunc *f;
+    int cur;            /* 명령어를 추가할 블록 */
+    int body;           /* 꼬리 자기 호출이 점프할 본문 시작 블록 (없으면 -1) */
+} Builder;
+
+/* 배열에 칸 하나를 확보 (count가 cap에 닿으면 두 배로) */
+static void *reserve(void *array, int count, int *cap, size_t elem) {
+    if (count < *cap) return array;
+    *cap = *cap ? *cap * 2 : 8;
+    return realloc(array, *cap * elem);
+}
+
+static int *new_args(Builder *b, int n) {
+    return n > 0 ? (int *)arena_alloc(&b->ip->arena, n * sizeof(int)) : NULL;
+}
+
+static int new_inst(Builder *b, IrOp op, IrType type) {
+    IrFunc *f = b->f;
+    f->insts = (IrInst *)reserve(f->insts, f->ninsts, &f->insts_cap, sizeof(IrInst));
+    IrInst *in = &f->insts[f->ninsts];
+    memset(in, 0, sizeof(*in));
+    in->op = op;
+    in->type = type;
+    in->block = -1;
+    in->repl = -1;
+    return f->ninsts++;
+}
+
+static void block_append(Builder *b, int block, int v) {
+    IrBlock *blk = &b->f->blocks[block];
+    blk->insts = (int *)reserve(blk->insts, blk->ninsts, &blk->insts_cap, sizeof(int));
+    blk->insts[blk->ninsts++] = v;
+    b->f->insts[v].block = block;
+}
+
+/* phi 바로 뒤에 끼워 넣음 (phi와 나중에 필요해진 상수용) */
+static void block_insert_front(Builder *b, int block, int v) {
+    IrFunc *f = b->f;
+    IrBlock *blk = &f->blocks[block];
+    blk->insts = (int *)reserve(blk->insts, blk->ninsts, &blk->insts_cap, sizeof(int));
+    int pos = 0;
+    while (pos < blk->ninsts && f->insts[blk->insts[pos]].op == IR_PHI) pos++;
+    memmove(&blk->insts[pos + 1], &blk->insts[pos], (blk->ninsts - pos) * sizeof(int));
+    blk->insts[pos] = v;
+    blk->ninsts++;
+    f->insts[v].block = block;
+}
+
+/* 현재 블록에 명령어 추가 */
+static int emit(Builder *b, IrOp op, IrType type) {
+    int v = new_inst(b, op, type);
+    block_append(b, b->cur, v);
+    return v;
+}
+
+static int emit_unary(Builder *b, IrOp op, IrType type, int a) {
+    int v = emit(b, op, type);
+    b->f->insts[v].args = new_args(b, 1);
+    b->f->insts[v].args[0] = a;
+    b->f->insts[v].nargs = 1;
+    return v;
+}
+
+static int emit_binary(Builder *b, IrOp op, IrType type, int a, int c) {
+    int v = emit(b, op, type);
+    b->f->insts[v].args = new_args(b, 2);
+    b->f->insts[v].args[0] = a;
+    b->f->insts[v].args[1] = c;
+    b->f->insts[v].nargs = 2;
+    return v;
+}
+
+static int emit_const(Builder *b, long value) {
+    int v = emit(b, IR_CONST, IR_I64);
+    b->f->insts[v].imm = value;
+    return v;
+}
+
+/* 블록 앞쪽의 상수 (정의 전 지역 변수 읽기) */
+static int insert_const(Builder *b, int block, long value) {
+    int v = new_inst(b, IR_CONST, IR_I64);
+    b->f->insts[v].imm = value;
+    block_insert_front(b, block, v);
+    return v;
+}
+
+static int new_block(Builder *b) {
+    IrFunc *f = b->f;
+    f->blocks = (IrBlock *)reserve(f->blocks, f->nblocks, &f->blocks_cap, sizeof(IrBlock));
+    memset(&f->blocks[f->nblocks], 0, sizeof(IrBlock));
+    return f->nblocks++;
+}
+
+static void add_edge(Builder *b, int from, int to) {
+    IrBlock *src = &b->f->blocks[from];
+    src->succ[src->nsucc++] = to;
+    IrBlock *dst = &b->f->blocks[to];
+    dst->preds = (int *)reserve(dst->preds, dst->npreds, &dst->preds_cap, sizeof(int));
+    dst->preds[dst->npreds++] = from;
+}
+
+/* === 종결 명령어 === */
+
+static void term_jmp(Builder *b, int target) {
+    emit(b, IR_JMP, IR_VOID);
+    add_edge(b, b->cur, target);
+}
+
+static void term_br(Builder *b, int cond, int if_true, int if_false) {
+    emit_unary(b, IR_BR, IR_VOID, cond);
+    add_edge(b, b->cur, if_true);
+    add_edge(b, b->cur, if_false);
+}
+
+static void term_chkfn(Builder *b, int fi, int str, int ok, int fail) {
+    int v = emit(b, IR_CHKFN, IR_VOID);
+    b->f->insts[v].index = fi;
+    b->f->insts[v].str = str;
+    add_edge(b, b->cur, ok);
+    add_edge(b, b->cur, fail);
+}
+
+/* === 구성: 변수 (Braun et al.) === */
+
+static int resolve_value(IrFunc *f, int v) {
+    while (f->insts[v].repl >= 0) v = f->insts[v].repl;
+    return v;
+}
+
+static void write_var(Builder *b, int slot, int block, int value) {
+    IrBlock *blk = &b->f->blocks[block];
+    if (!blk->defs) {
+        blk->defs = (int *)malloc(b->f->nslots * sizeof(int));
+        memset(blk->defs, -1, b->f->nslots * sizeof(int));
+    }
+    blk->defs[slot] = value;
+}
+
+static int new_phi(Builder *b, int block) {
+    int v = new_inst(b, IR_PHI, IR_I64);
+    block_insert_front(b, block, v);
+    return v;
+}
+
+/* 모든 인자가 같은 값(또는 자기 자신)인 phi는 그 값으로 치환 */
+static int try_remove_trivial_phi(Builder *b, int phi) {
+    IrFunc *f = b->f;
+    int same = -1;
+    for (int i = 0; i < f->insts[phi].nargs; ++i) {
+        int op = resolve_value(f, f->insts[phi].args[i]);
+        if (op == same || op == phi) continue;
+        if (same >= 0) return phi;
+        same = op;
+    }
+    if (same < 0) {
+        /* 도달할 수 없는 블록이나 자기 자신만 가리키는 루프 */
+        same = insert_const(b, f->insts[phi].block, 0);
+    }
+    f->insts[phi].repl = same;
+    return same;
+}
+
+static int read_var(Builder *b, int slot, int block);
+
+static int add_phi_operands(Builder *b, int slot, int phi) {
+    IrFunc *f = b->f;
+    int block = f->insts[phi].block;
+    int n = f->blocks[block].npreds;
+    int *args = new_args(b, n);
+    for (int i = 0; i < n; ++i) {
+        args[i] = read_var(b, slot, f->blocks[block].preds[i]);
+    }
+    f->insts[phi].args = args;
+    f->insts[phi].nargs = n;
+    return try_remove_trivial_phi(b, phi);
+}
+
+static int read_var_recursive(Builder *b, int slot, int block) {
+    IrBlock *blk = &b->f->blocks[block];
+    int v;
+    if (!blk->sealed) {
+        v = new_phi(b, block);
+        blk = &b->f->blocks[block];
+        blk->incomplete = (int *)reserve(blk->incomplete, blk->nincomplete * 2,
+                                         &blk->incomplete_cap, 2 * sizeof(int));
+        blk->incomplete[blk->nincomplete * 2] = slot;
+        blk->incomplete[blk->nincomplete * 2 + 1] = v;
+        blk->nincomplete++;
+    } else if (blk->npreds == 0) {
+        /* 진입 블록 (또는 도달할 수 없는 블록): 매개변수가 아닌 지역 변수는 0 */
+        v = insert_const(b, block, 0);
+    } else if (blk->npreds == 1) {
+        v = read_var(b, slot, blk->preds[0]);
+    } else {
+        v = new_phi(b, block);
+        write_var(b, slot, block, v);
+        v = add_phi_operands(b, slot, v);
+    }
+    write_var(b, slot, block, v);
+    return v;
+}
+
+static int read_var(Builder *b, int slot, int block) {
+    IrBlock *blk = &b->f->blocks[block];
+    if (blk->defs && blk->defs[slot] >= 0) return resolve_value(b->f, blk->defs[slot]);
+    return read_var_recursive(b, slot, block);
+}
+
+/* 선행 블록이 모두 정해짐: 미뤄 둔 phi의 인자를 채움 */
+static void seal_block(Builder *b, int block) {
+    for (int i = 0; i < b->f->blocks[block].nincomplete; ++i) {
+        int *pair = &b->f->blocks[block].incomplete[i * 2];
+        add_phi_operands(b, pair[0], pair[1]);
+    }
+    IrBlock *blk = &b->f->blocks[block];
+    free(blk->incomplete);
+    blk->incomplete = NULL;
+    blk->nincomplete = 0;
+    blk->sealed = 1;
+}
+
+/* 새 블록을 봉인된 상태로 시작 (return 뒤처럼 선행 블록이 없는 코드) */
+static void start_unreachable(Builder *b) {
+    b->cur = new_block(b);
+    b->f->blocks[b->cur].sealed = 1;
+}
+
+/* === 구성: 표현식 === */
+
+static int build_expr(Builder *b, Expr *e);
+
+static int build_call(Builder *b, Expr *e) {
+    IrProgram *ip = b->ip;
+    int fi = ir_find_func(ip, e->u.call.func_name);
+    if (fi < 0) {
+        /* eval_call과 같이 인자를 평가하지 않고 에러 */
+        int err = emit(b, IR_ERROR, IR_VOID);
+        b->f->insts[err].str = ir_undefined_func_msg(ip, e->u.call.func_name);
+        return emit_const(b, 0);
+    }
+
+    /* 등록 전이면 인자를 평가하지 않고 0: chkfn → (ok: 호출) → join에서 phi */
+    int needs_check = ip->funcs[fi].needs_check;
+    int zero = -1, join = -1, from = -1;
+    if (needs_check) {
+        zero = emit_const(b, 0);
+        int ok = new_block(b);
+        join = new_block(b);
+        from = b->cur;
+        term_chkfn(b, fi, ir_undefined_func_msg(ip, e->u.call.func_name), ok, join);
+        seal_block(b, ok);
+        b->cur = ok;
+    }
+
+    int vals[16];
+    int argc = 0;
+    for (ExprList *arg = e->u.call.args; arg && argc < 16; arg = arg->next) {
+        vals[argc++] = build_expr(b, arg->expr);
+    }
+    int call = emit(b, IR_CALL, IR_I64);
+    IrInst *in = &b->f->insts[call];
+    in->index = fi;
+    in->args = new_args(b, argc);
+    in->nargs = argc;
+    if (argc > 0) memcpy(in->args, vals, argc * sizeof(int));
+
+    if (!needs_check) return call;
+
+    term_jmp(b, join);
+    seal_block(b, join);
+    b->cur = join;
+    int phi = new_phi(b, join);
+    IrBlock *blk = &b->f->blocks[join];
+    int *args = new_args(b, blk->npreds);
+    for (int i = 0; i < blk->npreds; ++i) {
+        args[i] = blk->preds[i] == from ? zero : call;
+    }
+    b->f->insts[phi].args = args;
+    b->f->insts[phi].nargs = blk->npreds;
+    return phi;
+}
+
+static int build_expr(Builder *b, Expr *e) {
+    if (!e) return emit_const(b, 0);
+
+    switch (e->kind) {
+        case EXPR_INT:
+            return emit_const(b, e->u.int_value);
+
+        case EXPR_STRING:
+            /* eval_expr와 같이 문자열 값은 0 */
+            return emit_const(b, 0);
+
+        case EXPR_VAR:
+            if (e->ref.kind == VAR_LOCAL) {
+                return read_var(b, e->ref.slot, b->cur);
+            } else if (e->ref.kind == VAR_GLOBAL) {
+                int v = emit(b, IR_LOADG, IR_I64);
+                b->f->insts[v].index = e->ref.slot;
+                b->f->insts[v].str = ir_undefined_var_msg(b->ip, e->u.var_name);
+                return v;
+            } else {
+                int v = emit(b, IR_ERROR, IR_VOID);
+                b->f->insts[v].str = ir_undefined_var_msg(b->ip, e->u.var_name);
+                return emit_const(b, 0);
+            }
+
+        case EXPR_BINOP: {
+            static const IrOp ops[] = {
+                [BIN_ADD] = IR_ADD, [BIN_SUB] = IR_SUB, [BIN_MUL] = IR_MUL,
+                [BIN_DIV] = IR_DIV, [BIN_MOD] = IR_MOD,
+                [BIN_LT] = IR_CMP, [BIN_GT] = IR_CMP, [BIN_LE] = IR_CMP,
+                [BIN_GE] = IR_CMP, [BIN_EQ] = IR_CMP, [BIN_NE] = IR_CMP,
+                [BIN_AND] = IR_AND, [BIN_OR] = IR_OR,
+            };
+            /* eval_expr와 같이 lhs 먼저, 값으로 쓰인 &&, ||는 양쪽을 모두 평가 */
+            IrOp op = ops[e->u.binop.op];
+            int a = build_expr(b, e->u.binop.lhs);
+            int c = build_expr(b, e->u.binop.rhs);
+            int v = emit_binary(b, op, op == IR_CMP || op == IR_AND || op == IR_OR ? IR_BOOL : IR_I64, a, c);
+            b->f->insts[v].cc = e->u.binop.op;
+            return v;
+        }
+
+        case EXPR_CALL:
+            return build_call(b, e);
+
+        case EXPR_UNARY: {
+            int a = build_expr(b, e->u.unary.operand);
+            if (e->u.unary.op == UNARY_NEG) return emit_unary(b, IR_NEG, IR_I64, a);
+            return emit_unary(b, IR_NOT, IR_BOOL, a);
+        }
+    }
+    return emit_const(b, 0);
+}
+
+/* 조건 분기: 참이면 if_true, 거짓이면 if_false 블록으로 (현재 블록을 닫음)
+ * - 비교는 cmp + br (백엔드에서 cmp와 조건 점프로 합쳐짐)
+ * - &&, ||는 rhs에 효과가 없을 때만 단락 평가, 아니면 값을 만들어 분기 */
+static void build_cond(Builder *b, Expr *e, int if_true, int if_false) {
+    if (e && e->kind == EXPR_UNARY && e->u.unary.op == UNARY_NOT) {
+        build_cond(b, e->u.unary.operand, if_false, if_true);
+        return;
+    }
+    if (e && e->kind == EXPR_BINOP) {
+        BinOpKind op = e->u.binop.op;
+        if ((op == BIN_AND || op == BIN_OR) && !ir_expr_has_effects(e->u.binop.rhs)) {
+            int rhs = new_block(b);
+            if (op == BIN_AND) {
+                build_cond(b, e->u.binop.lhs, rhs, if_false);
+            } else {
+                build_cond(b, e->u.binop.lhs, if_true, rhs);
+            }
+            seal_block(b, rhs);
+            b->cur = rhs;
+            build_cond(b, e->u.binop.rhs, if_true, if_false);
+            return;
+        }
+    }
+    term_br(b, build_expr(b, e), if_true, if_false);
+}
+
+/* === 구성: 문장 === */
+
+static void build_store(Builder *b, const VarRef *ref, Expr *value) {
+    int v = build_expr(b, value);
+    if (ref->kind == VAR_GLOBAL) {
+        int st = emit_unary(b, IR_STOREG, IR_VOID, v);
+        b->f->insts[st].index = ref->slot;
+    } else {
+        write_var(b, ref->slot, b->cur, v);
+    }
+}
+
+/* 꼬리 자기 호출: 매개변수/지역 슬롯에 새 값을 쓰고 본문 블록으로 (루프의 back edge) */
+static void build_tail_call(Builder *b, Expr *e) {
+    int vals[16];
+    int argc = 0;
+    for (ExprList *arg = e->u.call.args; arg && argc < 16; arg = arg->next) {
+        vals[argc++] = build_expr(b, arg->expr);
+    }
+    /* 남는 인자는 버리고 나머지 지역 슬롯은 0 (IR_CALL과 동일) */
+    for (int i = 0; i < b->f->nparams && i < argc; ++i) {
+        write_var(b, i, b->cur, vals[i]);
+    }
+    if (b->f->nparams < b->f->nslots) {
+        int zero = emit_const(b, 0);
+        for (int i = b->f->nparams; i < b->f->nslots; ++i) write_var(b, i, b->cur, zero);
+    }
+    term_jmp(b, b->body);
+}
+
+static void build_stmt(Builder *b, Stmt *s) {
+    if (!s) return;
+
+    switch (s->kind) {
+        case STMT_VARDECL:
+            build_store(b, &s->ref, s->u.vardecl.init_value);
+            break;
+
+        case STMT_ASSIGN:
+            build_store(b, &s->ref, s->u.assign.value);
+            break;
+
+        case STMT_EXPR:
+            build_expr(b, s->u.expr);
+            break;
+
+        case STMT_RETURN:
+            if (b->body >= 0 && s->u.expr && s->u.expr->kind == EXPR_CALL &&
+                s->u.expr->u.call.tail) {
+                build_tail_call(b, s->u.expr);
+            } else {
+                emit_unary(b, IR_RET, IR_VOID, build_expr(b, s->u.expr));
+            }
+            start_unreachable(b);
+            break;
+
+        case STMT_PRINT:
+            if (s->u.expr && s->u.expr->kind == EXPR_STRING) {
+                int v = emit(b, IR_PRINT_STR, IR_VOID);
+                b->f->insts[v].str = ir_add_text(b->ip, AST_STRING_TEXT(b->ip->prog, s->u.expr),
+                                                 s->u.expr->u.string.len);
+            } else {
+                emit_unary(b, IR_PRINT_INT, IR_VOID, build_expr(b, s->u.expr));
+            }
+            break;
+
+        case STMT_IF: {
+            int then_block = new_block(b);
+            int else_block = s->u.if_stmt.else_stmt ? new_block(b) : -1;
+            int join = new_block(b);
+            build_cond(b, s->u.if_stmt.cond, then_block, else_block >= 0 ? else_block : join);
+
+            seal_block(b, then_block);
+            b->cur = then_block;
+            build_stmt(b, s->u.if_stmt.then_stmt);
+            term_jmp(b, join);
+            if (else_block >= 0) {
+                seal_block(b, else_block);
+                b->cur = else_block;
+                build_stmt(b, s->u.if_stmt.else_stmt);
+                term_jmp(b, join);
+            }
+            seal_block(b, join);
+            b->cur = join;
+            break;
+        }
+
+        case STMT_WHILE: {
+            int header = new_block(b);
+            int body = new_block(b);
+            int exit = new_block(b);
+            term_jmp(b, header);
+            b->cur = header;
+            build_cond(b, s->u.while_stmt.cond, body, exit);
+
+            seal_block(b, body);
+            b->cur = body;
+            build_stmt(b, s->u.while_stmt.body);
+            term_jmp(b, header);
+            seal_block(b, header);
+            seal_block(b, exit);
+            b->cur = exit;
+            break;
+        }
+
+        case STMT_FOR: {
+            build_stmt(b, s->u.for_stmt.init);
+            int header = new_block(b);
+            int body = new_block(b);
+            int exit = new_block(b);
+            term_jmp(b, header);
+            b->cur = header;
+            if (s->u.for_stmt.cond) {
+                build_cond(b, s->u.for_stmt.cond, body, exit);
+            } else {
+                term_jmp(b, body);
+            }
+
+            seal_block(b, body);
+            b->cur = body;
+            build_stmt(b, s->u.for_stmt.body);
+            build_stmt(b, s->u.for_stmt.step);
+            term_jmp(b, header);
+            seal_block(b, header);
+            seal_block(b, exit);
+            b->cur = exit;
+            break;
+        }
+
+        case STMT_BLOCK:
+            if (s->u.block) {
+                for (Stmt *cur = s->u.block->head; cur; cur = cur->next) {
+                    build_stmt(b, cur);
+                }
+            }
+            break;
+    }
+}
+
+/* === 구성 마무리 === */
+
+/* block의 idx번째 선행 블록과 phi 인자를 제거 */
+static void remove_pred(IrFunc *f, int block, int idx) {
+    IrBlock *blk = &f->blocks[block];
+    for (int i = 0; i < blk->ninsts && f->insts[blk->insts[i]].op == IR_PHI; ++i) {
+        IrInst *phi = &f->insts[blk->insts[i]];
+        if (idx < phi->nargs) {
+            memmove(&phi->args[idx], &phi->args[idx + 1], (phi->nargs - idx - 1) * sizeof(int));
+            phi->nargs--;
+        }
+    }
+    memmove(&blk->preds[idx], &blk->preds[idx + 1], (blk->npreds - idx - 1) * sizeof(int));
+    blk->npreds--;
+}
+
+/* 진입 블록에서 도달할 수 없는 블록 제거 (return 뒤의 코드 등), 블록 번호를 다시 매김 */
+static void remove_unreachable(IrFunc *f) {
+    int n = f->nblocks;
+    char *reach = (char *)calloc(n, 1);
+    int *stack = (int *)malloc(n * sizeof(int));
+    int sp = 0;
+    reach[0] = 1;
+    stack[sp++] = 0;
+    while (sp > 0) {
+        IrBlock *blk = &f->blocks[stack[--sp]];
+        for (int i = 0; i < blk->nsucc; ++i) {
+            if (!reach[blk->succ[i]]) {
+                reach[blk->succ[i]] = 1;
+                stack[sp++] = blk->succ[i];
+            }
+        }
+    }
+
+    /* 도달 가능한 블록에서 죽은 선행 블록 제거 */
+    for (int b = 0; b < n; ++b) {
+        if (!reach[b]) continue;
+        for (int i = f->blocks[b].npreds - 1; i >= 0; --i) {
+            if (!reach[f->blocks[b].preds[i]]) remove_pred(f, b, i);
+        }
+    }
+
+    int *remap = stack;
+    int m = 0;
+    for (int b = 0; b < n; ++b) {
+        IrBlock *blk = &f->blocks[b];
+        if (!reach[b]) {
+            for (int i = 0; i < blk->ninsts; ++i) f->insts[blk->insts[i]].block = -1;
+            free(blk->insts);
+            free(blk->preds);
+            free(blk->defs);
+            free(blk->incomplete);
+            remap[b] = -1;
+            continue;
+        }
+        remap[b] = m;
+        if (m != b) f->blocks[m] = *blk;
+        m++;
+    }
+    f->nblocks = m;
+    for (int b = 0; b < m; ++b) {
+        IrBlock *blk = &f->blocks[b];
+        for (int i = 0; i < blk->nsucc; ++i) blk->succ[i] = remap[blk->succ[i]];
+        for (int i = 0; i < blk->npreds; ++i) blk->preds[i] = remap[blk->preds[i]];
+        for (int i = 0; i < blk->ninsts; ++i) f->insts[blk->insts[i]].block = b;
+    }
+    free(reach);
+    free(stack);
+}
+
+/* 자명한 phi를 더 없을 때까지 제거하고 모든 피연산자를 치환된 값으로 */
+static void finish_func(Builder *b) {
+    IrFunc *f = b->f;
+    remove_unreachable(f);
+
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int bi = 0; bi < f->nblocks; ++bi) {
+            for (int i = 0; i < f->blocks[bi].ninsts; ++i) {
+                int v = f->blocks[bi].insts[i];
+                if (f->insts[v].op != IR_PHI) break;
+                if (f->insts[v].repl < 0 && try_remove_trivial_phi(b, v) != v) changed = 1;
+            }
+        }
+    }
+
+    for (int bi = 0; bi < f->nblocks; ++bi) {
+        IrBlock *blk = &f->blocks[bi];
+        int m = 0;
+        for (int i = 0; i < blk->ninsts; ++i) {
+            IrInst *in = &f->insts[blk->insts[i]];
+            if (in->repl >= 0) {
+                in->block = -1;
+                continue;
+            }
+            for (int k = 0; k < in->nargs; ++k) in->args[k] = resolve_value(f, in->args[k]);
+            blk->insts[m++] = blk->insts[i];
+        }
+        blk->ninsts = m;
+        free(blk->defs);
+        blk->defs = NULL;
+    }
+}
+
+static void begin_func(Builder *b, IrFunc *f) {
+    b->f = f;
+    b->cur = new_block(b);
+    f->blocks[b->cur].sealed = 1;
+}
+
+static void build_function(Builder *b, IrFunc *f) {
+    begin_func(b, f);
+    for (int i = 0; i < f->nparams; ++i) {
+        int p = emit(b, IR_PARAM, IR_I64);
+        f->insts[p].index = i;
+        write_var(b, i, b->cur, p);
+    }
+    b->body = -1;
+    if (f->func->tail_calls) {
+        /* 꼬리 자기 호출이 돌아올 본문 블록 (모든 back edge를 만든 뒤 봉인) */
+        b->body = new_block(b);
+        term_jmp(b, b->body);
+        b->cur = b->body;
+    }
+    if (f->func->body) {
+        for (Stmt *s = f->func->body->head; s; s = s->next) {
+            build_stmt(b, s);
+        }
+    }
+    emit_unary(b, IR_RET, IR_VOID, emit_const(b, 0));
+    if (b->body >= 0) seal_block(b, b->body);
+    finish_func(b);
+}
+
+static void build_main(Builder *b) {
+    IrProgram *ip = b->ip;
+    begin_func(b, &ip->main);
+    for (Item *item = ip->prog->items; item; item = item->next) {
+        if (item->kind == ITEM_FUNCTION) {
+            int fi = ir_find_func(ip, item->u.function->name);
+            if (ip->funcs[fi].func == item->u.function && ip->funcs[fi].needs_check) {
+                int v = emit(b, IR_DEFFN, IR_VOID);
+                ip->main.insts[v].index = fi;
+            }
+        } else if (item->kind == ITEM_STMT) {
+            build_stmt(b, item->u.stmt);
+        }
+    }
+    emit_unary(b, IR_RET, IR_VOID, emit_const(b, 0));
+    finish_func(b);
+}
+
+void ir_build(IrProgram *ip) {
+    Builder b;
+    memset(&b, 0, sizeof(b));
+    b.ip = ip;
+    build_main(&b);
+    for (int i = 0; i < ip->nfuncs; ++i) {
+        build_function(&b, &ip->funcs[i]);
+    }
+}
+
+/* === 출력 === */
+
+static const char *type_name(IrType t) {
+    return t == IR_BOOL ? "bool" : "i64";
+}
+
+static const char *cc_name(int cc) {
+    switch (cc) {
+        case BIN_LT: return "lt";
+        case BIN_GT: return "gt";
+        case BIN_LE: return "le";
+        case BIN_GE: return "ge";
+        case BIN_EQ: return "eq";
+        default:     return "ne";
+    }
+}
+
+static void print_string(Output *out, const char *s) {
+    output_printf(out, "\"");
+    for (; *s; ++s) {
+        switch (*s) {
+            case '\n': output_printf(out, "\\n"); break;
+            case '\t': output_printf(out, "\\t"); break;
+            case '"':  output_printf(out, "\\\""); break;
+            case '\\': output_printf(out, "\\\\"); break;
+            default:   output_printf(out, "%c", *s); break;
+        }
+    }
+    output_printf(out, "\"");
+}
+
+static void print_args(Output *out, const IrInst *in, int from) {
+    for (int i = from; i < in->nargs; ++i) {
+        output_printf(out, "%s%%%d", i > from ? ", " : "", in->args[i]);
+    }
+}
+
+static void print_inst(IrProgram *ip, IrFunc *f, int v, Output *out) {
+    IrInst *in = &f->insts[v];
+    IrBlock *blk = &f->blocks[in->block];
+    output_printf(out, "    ");
+    if (in->type != IR_VOID) output_printf(out, "%%%d:%s = ", v, type_name(in->type));
+    output_printf(out, "%s", in->op == IR_CMP ? cc_name(in->cc) : ir_op_name(in->op));
+
+    switch (in->op) {
+        case IR_CONST:
+            output_printf(out, " %ld", in->imm);
+            break;
+        case IR_PARAM:
+            output_printf(out, " %d", in->index);
+            break;
+        case IR_PHI:
+            for (int i = 0; i < in->nargs; ++i) {
+                output_printf(out, "%s [%%%d, b%d]", i > 0 ? "," : "", in->args[i], blk->preds[i]);
+            }
+            break;
+        case IR_LOADG:
+            output_printf(out, " @%s", ip->prog->global_names[in->index]);
+            break;
+        case IR_STOREG:
+            output_printf(out, " @%s, %%%d", ip->prog->global_names[in->index], in->args[0]);
+            break;
+        case IR_CALL:
+            output_printf(out, " %s(", ip->funcs[in->index].func->name);
+            print_args(out, in, 0);
+            output_printf(out, ")");
+            break;
+        case IR_PRINT_STR:
+        case IR_ERROR:
+            output_printf(out, " ");
+            print_string(out, ip->strings[in->str]);
+            break;
+        case IR_DEFFN:
+            output_printf(out, " %s", ip->funcs[in->index].func->name);
+            break;
+        case IR_JMP:
+            output_printf(out, " b%d", blk->succ[0]);
+            break;
+        case IR_BR:
+            output_printf(out, " %%%d, b%d, b%d", in->args[0], blk->succ[0], blk->succ[1]);
+            break;
+        case IR_CHKFN:
+            output_printf(out, " %s, b%d, b%d", ip->funcs[in->index].func->name,
+                          blk->succ[0], blk->succ[1]);
+            break;
+        default:
+            if (in->nargs > 0) output_printf(out, " ");
+            print_args(out, in, 0);
+            break;
+    }
+    output_printf(out, "\n");
+}
+
+static void print_func(IrProgram *ip, IrFunc *f, Output *out) {
+    if (f->func) {
+        output_printf(out, "function %s(", f->func->name);
+        int i = 0;
+        for (Param *p = f->func->params ? f->func->params->head : NULL; p; p = p->next) {
+            output_printf(out, "%s%s", i++ > 0 ? ", " : "", p->name);
+        }
+        output_printf(out, ") {\n");
+    } else {
+        output_printf(out, "top-level {\n");
+    }
+
+    for (int b = 0; b < f->nblocks; ++b) {
+        IrBlock *blk = &f->blocks[b];
+        output_printf(out, "b%d:", b);
+        if (blk->npreds > 0) {
+            output_printf(out, "%*s; preds", b < 10 ? 30 : 29, "");
+            for (int i = 0; i < blk->npreds; ++i) {
+                output_printf(out, "%s b%d", i > 0 ? "," : "", blk->preds[i]);
+            }
+        }
+        output_printf(out, "\n");
+        for (int i = 0; i < blk->ninsts; ++i) {
+            print_inst(ip, f, blk->insts[i], out);
+        }
+    }
+    output_printf(out, "}\n");
+}
+
+void ir_print(IrProgram *ip, Output *out) {
+    for (int i = 0; i < ip->nfuncs; ++i) {
+        print_func(ip, &ip->funcs[i], out);
+        output_printf(out, "\n");
+    }
+    print_func(ip, &ip->main, out);
+}
+
+/* === 해제 === */
+
+static void free_func(IrFunc *f) {
+    for (int b = 0; b < f->nblocks; ++b) {
+        free(f->blocks[b].insts);
+        free(f->blocks[b].preds);
+        free(f->blocks[b].defs);
+        free(f->blocks[b].incomplete);
+    }
+    free(f->blocks);
+    free(f->insts);
+}
+
+void ir_free(IrProgram *ip) {
+    if (!ip) return;
+    for (int i = 0; i < ip->nfuncs; ++i) {
+        free_func(&ip->funcs[i]);
+    }
+    free_func(&ip->main);
+    free(ip->funcs);
+    for (int i = 0; i < ip->nstrings; ++i) {
+        free(ip->strings[i]);
+    }
+    free(ip->strings);
+    free(ip->func_index);
+    free(ip->string_index);
+    arena_free(&ip->arena);
+    free(ip);
+}
@@ -0,0 +1,1051 @@
+/* Mini-JS x86-64 인프로세스 JIT
+ * codegen_x86.c의 -O1 출력(emit_lir_function/emit_inst)과 같은 명령어를 기계어로 직접 인코딩
+ * - 점프/호출은 모두 rel32, 레이블과 데이터 참조는 fixup으로 모았다가 배치 후에 채움
+ * - 메모리 배치: [코드 + 문자열 (R+X)] [데이터 (R+W): 전역 값, 정의 여부, 함수 등록 여부]
+ *   데이터는 코드 바로 뒤 페이지라 어셈블리 출력과 같이 %rip 기준으로 접근
+ * - 런타임 스텁은 %rax 외의 레지스터를 모두 보존하고 C 런타임(rt_*)을 절대 주소로 호출
+ * - 함수 진입/복귀에서 데이터 영역의 호출 깊이를 세어 EVAL_MAX_CALL_DEPTH를 넘는 호출은
+ *   에러 후 0 (codegen_x86.c의 .Lcall_depth와 같음)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "ast.h"
+#include "output.h"
+#include "eval.h"
+#include "ir.h"
+#include "lir.h"
+#include "regalloc.h"
+#include "jit_x86.h"
+
+#if defined(__x86_64__) && !defined(__EMSCRIPTEN__) && !defined(_WIN32)
+#define JIT_SUPPORTED 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define JIT_SUPPORTED 0
+#endif
+
+struct JitProgram {
+    unsigned char *mem;     /* mmap 영역 (코드 페이지 + 데이터 페이지) */
+    size_t mem_size;
+    size_t code_size;       /* 코드 + 문자열 바이트 수 */
+    size_t data_offset;     /* 데이터 시작 (페이지 경계) */
+    size_t data_size;
+    size_t depth_offset;    /* 호출 깊이 카운터 (데이터 영역 기준, long) */
+    unsigned char *entry;   /* top-level 코드 또는 승격한 함수 */
+    Output *out;            /* 실행 중 출력 대상 (런타임이 참조) */
+};
+
+#if JIT_SUPPORTED
+
+/* === 런타임 (스텁이 System V 규약으로 호출) === */
+
+static void rt_print_int(JitProgram *jp, long value) {
+    output_line_int(jp->out, value);
+}
+
+static void rt_print_str(JitProgram *jp, const char *str) {
+    output_line_str(jp->out, str);
+}
+
+static void rt_error(JitProgram *jp, const char *msg) {
+    output_printf(jp->out, "%s", msg);
+}
+
+/* === 인코딩 상태 (jit_compile 호출마다 하나) === */
+
+typedef enum {
+    FIX_LABEL,      /* rel32 → 레이블 */
+    FIX_DATA        /* rel32 → 데이터 영역 + target */
+} FixupKind;
+
+typedef struct {
+    FixupKind kind;
+    int pos;        /* rel32 위치 */
+    int end;        /* 명령어 끝 (%rip 값) */
+    int target;
+} Fixup;
+
+typedef struct {
+    unsigned char *code;
+    int len;
+    int cap;
+    int *labels;            /* 레이블 → 코드 오프셋 (-1: 아직 없음) */
+    int nlabels;
+    int labels_cap;
+    Fixup *fixups;
+    int nfixups;
+    int fixups_cap;
+    int failed;             /* 메모리 부족 */
+
+    JitProgram *jp;
+    IrProgram *ir;
+    int div_msg;            /* "division by zero" 문자열 인덱스 */
+    int mod_msg;
+    int str_base;           /* 문자열 i의 레이블 = str_base + i */
+    int func_base;          /* ir->funcs[i] 진입 레이블 = func_base + i */
+    int rt_print_int;       /* 런타임 스텁 레이블 */
+    int rt_print_str;
+    int rt_error;
+    int rt_depth;           /* 호출 깊이 초과 처리 레이블 */
+    int depth_msg;          /* "maximum call depth exceeded" 문자열 인덱스 */
+    int gdef_offset;        /* 데이터 영역 안의 오프셋 (전역 값은 0부터) */
+    int fdef_offset;
+    int depth_offset;
+
+    /* 현재 함수 */
+    LirFunc *f;
+    int block_base;         /* LIR 레이블 i = block_base + i */
+    int ret_label;
+    int ncallee;            /* 프롤로그에서 push한 callee-saved 레지스터 수 */
+} Jit;
+
+static int grow(void **buf, int *cap, int need, size_t elem) {
+    if (need <= *cap) return 1;
+    int ncap = *cap ? *cap * 2 : 256;
+    while (ncap < need) ncap *= 2;
+    void *p = realloc(*buf, (size_t)ncap * elem);
+    if (!p) return 0;
+    *buf = p;
+    *cap = ncap;
+    return 1;
+}
+
+static void put8(Jit *j, int b) {
+    if (!grow((void **)&j->code, &j->cap, j->len + 1, 1)) {
+        j->failed = 1;
+        return;
+    }
+    j->code[j->len++] = (unsigned char)b;
+}
+
+static void put32(Jit *j, long v) {
+    for (int i = 0; i < 4; ++i) put8(j, (int)((v >> (8 * i)) & 0xFF));
+}
+
+static void put64(Jit *j, long v) {
+    for (int i = 0; i < 8; ++i) put8(j, (int)(((unsigned long)v >> (8 * i)) & 0xFF));
+}
+
+static int new_label(Jit *j) {
+    if (!grow((void **)&j->labels, &j->labels_cap, j->nlabels + 1, sizeof(int))) {
+        j->failed = 1;
+        return 0;
+    }
+    j->labels[j->nlabels] = -1;
+    return j->nlabels++;
+}
+
+/* 연속된 레이블 n개, 반환: 첫 번째 */
+static int new_labels(Jit *j, int n) {
+    int first = j->nlabels;
+    for (int i = 0; i < n; ++i) new_label(j);
+    return first;
+}
+
+static void bind_label(Jit *j, int label) {
+    if (label < j->nlabels) j->labels[label] = j->len;
+}
+
+static void add_fixup(Jit *j, FixupKind kind, int pos, int end, int target) {
+    if (!grow((void **)&j->fixups, &j->fixups_cap, j->nfixups + 1, sizeof(Fixup))) {
+        j->failed = 1;
+        return;
+    }
+    Fixup *fx = &j->fixups[j->nfixups++];
+    fx->kind = kind;
+    fx->pos = pos;
+    fx->end = end;
+    fx->target = target;
+}
+
+/* === 피연산자와 ModRM === */
+
+typedef enum {
+    OPND_REG,
+    OPND_IMM,
+    OPND_FRAME,     /* value(%rbp) */
+    OPND_DATA,      /* 데이터 영역 + value (%rip 기준) */
+    OPND_LABEL      /* 레이블 value (%rip 기준, 문자열) */
+} OpndKind;
+
+typedef struct {
+    OpndKind kind;
+    int reg;
+    long value;
+} Opnd;
+
+static Opnd opnd_reg(int reg) {
+    Opnd o = { OPND_REG, reg, 0 };
+    return o;
+}
+
+static Opnd opnd_imm(long value) {
+    Opnd o = { OPND_IMM, 0, value };
+    return o;
+}
+
+static Opnd opnd_data(long offset) {
+    Opnd o = { OPND_DATA, 0, offset };
+    return o;
+}
+
+static int fits8(long v) {
+    return v >= -128 && v <= 127;
+}
+
+static int fits32(long v) {
+    return v >= INT32_MIN && v <= INT32_MAX;
+}
+
+/* ModRM(+disp), imm_size: 뒤따르는 즉시값 바이트 수 (%rip 기준 주소는 명령어 끝에서 계산) */
+static void put_modrm(Jit *j, int reg, Opnd rm, int imm_size) {
+    reg &= 7;
+    switch (rm.kind) {
+        case OPND_REG:
+            put8(j, 0xC0 | reg << 3 | (rm.reg & 7));
+            break;
+        case OPND_FRAME:
+            if (fits8(rm.value)) {
+                put8(j, 0x45 | reg << 3);
+                put8(j, (int)(rm.value & 0xFF));
+            } else {
+                put8(j, 0x85 | reg << 3);
+                put32(j, rm.value);
+            }
+            break;
+        case OPND_DATA:
+        case OPND_LABEL:
+            put8(j, 0x05 | reg << 3);
+            add_fixup(j, rm.kind == OPND_DATA ? FIX_DATA : FIX_LABEL,
+                      j->len, j->len + 4 + imm_size, (int)rm.value);
+            put32(j, 0);
+            break;
+        case OPND_IMM:
+            break;
+    }
+}
+
+/* [REX] opcode(1~2바이트) ModRM
+ * - w: 64비트 피연산자 (REX.W)
+ * - reg: ModRM.reg (레지스터 번호 또는 /digit) */
+static void put_op(Jit *j, int w, unsigned opcode, int reg, Opnd rm, int imm_size) {
+    int rex = (w ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((rm.kind == OPND_REG && (rm.reg & 8)) ? 1 : 0);
+    if (rex) put8(j, 0x40 | rex);
+    if (opcode > 0xFF) put8(j, (int)(opcode >> 8));
+    put8(j, (int)(opcode & 0xFF));
+    put_modrm(j, reg, rm, imm_size);
+}
+
+/* === 명령어 === */
+
+enum { ALU_ADD = 0, ALU_OR = 1, ALU_AND = 4, ALU_SUB = 5, ALU_XOR = 6, ALU_CMP = 7 };
+
+/* dst op= src (즉시값은 32비트 부호 확장, 둘 다 메모리일 수 없음) */
+static void enc_alu(Jit *j, int alu, Opnd dst, Opnd src) {
+    if (src.kind == OPND_IMM) {
+        if (fits8(src.value)) {
+            put_op(j, 1, 0x83, alu, dst, 1);
+            put8(j, (int)(src.value & 0xFF));
+        } else {
+            put_op(j, 1, 0x81, alu, dst, 4);
+            put32(j, src.value);
+        }
+    } else if (src.kind == OPND_REG) {
+        put_op(j, 1, (unsigned)(alu * 8 + 1), src.reg, dst, 0);
+    } else {
+        put_op(j, 1, (unsigned)(alu * 8 + 3), dst.reg, src, 0);
+    }
+}
+
+/* imulq src, dst */
+static void enc_imul(Jit *j, int dst, Opnd src) {
+    if (src.kind == OPND_IMM) {
+        if (fits8(src.value)) {
+            put_op(j, 1, 0x6B, dst, opnd_reg(dst), 1);
+            put8(j, (int)(src.value & 0xFF));
+        } else {
+            put_op(j, 1, 0x69, dst, opnd_reg(dst), 4);
+            put32(j, src.value);
+        }
+    } else {
+        put_op(j, 1, 0x0FAF, dst, src, 0);
+    }
+}
+
+/* movq src, dst (메모리끼리는 불가) */
+static void enc_mov(Jit *j, Opnd dst, Opnd src) {
+    if (src.kind == OPND_IMM) {
+        if (fits32(src.value)) {
+            put_op(j, 1, 0xC7, 0, dst, 4);
+            put32(j, src.value);
+        } else if (dst.kind == OPND_REG) {
+            /* movabsq */
+            put8(j, 0x48 | ((dst.reg & 8) ? 1 : 0));
+            put8(j, 0xB8 + (dst.reg & 7));
+            put64(j, src.value);
+        } else {
+            /* 메모리에 64비트 상수: 32비트씩 두 번 */
+            Opnd hi = dst;
+            hi.value += 4;
+            put_op(j, 0, 0xC7, 0, dst, 4);
+            put32(j, src.value);
+            put_op(j, 0, 0xC7, 0, hi, 4);
+            put32(j, src.value >> 32);
+        }
+    } else if (src.kind == OPND_REG) {
+        put_op(j, 1, 0x89, src.reg, dst, 0);
+    } else {
+        put_op(j, 1, 0x8B, dst.reg, src, 0);
+    }
+}
+
+static void enc_movabs(Jit *j, int reg, long value) {
+    put8(j, 0x48 | ((reg & 8) ? 1 : 0));
+    put8(j, 0xB8 + (reg & 7));
+    put64(j, value);
+}
+
+/* xorl reg32, reg32 */
+static void enc_zero(Jit *j, int reg) {
+    put_op(j, 0, 0x31, reg, opnd_reg(reg), 0);
+}
+
+static void enc_test(Jit *j, int reg) {
+    put_op(j, 1, 0x85, reg, opnd_reg(reg), 0);
+}
+
+/* set<cc> %al */
+static void enc_setcc_al(Jit *j, int cc) {
+    put_op(j, 0, 0x0F90u + (unsigned)cc, 0, opnd_reg(X86_RAX), 0);
+}
+
+/* movzbl %al, reg32 */
+static void enc_movzx_al(Jit *j, int reg) {
+    put_op(j, 0, 0x0FB6, reg, opnd_reg(X86_RAX), 0);
+}
+
+static void enc_push(Jit *j, int reg) {
+    if (reg & 8) put8(j, 0x41);
+    put8(j, 0x50 + (reg & 7));
+}
+
+static void enc_pop(Jit *j, int reg) {
+    if (reg & 8) put8(j, 0x41);
+    put8(j, 0x58 + (reg & 7));
+}
+
+static void enc_jmp(Jit *j, int label) {
+    put8(j, 0xE9);
+    add_fixup(j, FIX_LABEL, j->len, j->len + 4, label);
+    put32(j, 0);
+}
+
+static void enc_jcc(Jit *j, int cc, int label) {
+    put8(j, 0x0F);
+    put8(j, 0x80 + cc);
+    add_fixup(j, FIX_LABEL, j->len, j->len + 4, label);
+    put32(j, 0);
+}
+
+static void enc_call(Jit *j, int label) {
+    put8(j, 0xE8);
+    add_fixup(j, FIX_LABEL, j->len, j->len + 4, label);
+    put32(j, 0);
+}
+
+/* cmpb $imm, mem / movb $imm, mem */
+static void enc_cmpb(Jit *j, Opnd mem, int imm) {
+    put_op(j, 0, 0x80, ALU_CMP, mem, 1);
+    put8(j, imm);
+}
+
+static void enc_movb(Jit *j, Opnd mem, int imm) {
+    put_op(j, 0, 0xC6, 0, mem, 1);
+    put8(j, imm);
+}
+
+/* 조건 코드 (Jcc/SETcc 하위 4비트) */
+enum { CC_E = 0x4, CC_NE = 0x5, CC_L = 0xC, CC_GE = 0xD, CC_LE = 0xE, CC_G = 0xF };
+
+static int cc_code(int op) {
+    switch (op) {
+        case BIN_LT: return CC_L;
+        case BIN_GT: return CC_G;
+        case BIN_LE: return CC_LE;
+        case BIN_GE: return CC_GE;
+        case BIN_EQ: return CC_E;
+        default:     return CC_NE;
+    }
+}
+
+/* === 공통: 런타임 스텁, 에러, 전역 변수 (codegen_x86.c와 같은 순서) === */
+
+/* 인자/결과는 %rax, %rax 외의 레지스터는 모두 보존하고 스택을 16바이트로 맞춤 */
+static void emit_stub(Jit *j, int label, long fn) {
+    static const X86Reg saved[] = {
+        X86_RCX, X86_RDX, X86_RSI, X86_RDI, X86_R8, X86_R9, X86_R10, X86_R11
+    };
+    int n = (int)(sizeof(saved) / sizeof(saved[0]));
+    bind_label(j, label);
+    for (int i = 0; i < n; ++i) enc_push(j, saved[i]);
+    enc_push(j, X86_RBP);
+    enc_mov(j, opnd_reg(X86_RBP), opnd_reg(X86_RSP));
+    enc_alu(j, ALU_AND, opnd_reg(X86_RSP), opnd_imm(-16));
+    enc_mov(j, opnd_reg(X86_RSI), opnd_reg(X86_RAX));
+    enc_movabs(j, X86_RDI, (long)(uintptr_t)j->jp);
+    enc_movabs(j, X86_RAX, fn);
+    put8(j, 0xFF);      /* call *%rax */
+    put8(j, 0xD0);
+    enc_mov(j, opnd_reg(X86_RSP), opnd_reg(X86_RBP));
+    enc_pop(j, X86_RBP);
+    for (int i = n - 1; i >= 0; --i) enc_pop(j, saved[i]);
+    put8(j, 0xC3);
+}
+
+static void emit_runtime(Jit *j) {
+    emit_stub(j, j->rt_print_int, (long)(uintptr_t)rt_print_int);
+    emit_stub(j, j->rt_print_str, (long)(uintptr_t)rt_print_str);
+    emit_stub(j, j->rt_error, (long)(uintptr_t)rt_error);
+}
+
+/* leaq str(%rip), %rax */
+static void emit_load_str(Jit *j, int str) {
+    Opnd o = { OPND_LABEL, 0, j->str_base + str };
+    put_op(j, 1, 0x8D, X86_RAX, o, 0);
+}
+
+/* 에러 메시지 출력 (%rax만 바뀜) */
+static void emit_error(Jit *j, int str) {
+    emit_load_str(j, str);
+    enc_call(j, j->rt_error);
+}
+
+/* 호출 깊이 초과: 함수 진입에서 프레임을 만들기 전에 오므로 에러 후 0을 호출자에게 바로 반환 */
+static void emit_depth_overflow(Jit *j) {
+    bind_label(j, j->rt_depth);
+    emit_error(j, j->depth_msg);
+    enc_zero(j, X86_RAX);
+    put8(j, 0xC3);
+}
+
+/* %rax = globals[index], 정의 전이면 에러 후 0 */
+static void emit_load_global(Jit *j, int index, int msg) {
+    int ok = new_label(j);
+    int done = new_label(j);
+    enc_cmpb(j, opnd_data(j->gdef_offset + index), 0);
+    enc_jcc(j, CC_NE, ok);
+    emit_error(j, msg);
+    enc_zero(j, X86_RAX);
+    enc_jmp(j, done);
+    bind_label(j, ok);
+    enc_mov(j, opnd_reg(X86_RAX), opnd_data(index * 8L));
+    bind_label(j, done);
+}
+
+/* %rax = %rax / %rcx (또는 %), 0으로 나누면 에러 후 0 */
+static void emit_divmod(Jit *j, int is_mod) {
+    int ok = new_label(j);
+    int done = new_label(j);
+    enc_test(j, X86_RCX);
+    enc_jcc(j, CC_NE, ok);
+    emit_error(j, is_mod ? j->mod_msg : j->div_msg);
+    enc_zero(j, X86_RAX);
+    enc_jmp(j, done);
+    bind_label(j, ok);
+    put8(j, 0x48);      /* cqto */
+    put8(j, 0x99);
+    put_op(j, 1, 0xF7, 7, opnd_reg(X86_RCX), 0);    /* idivq %rcx */
+    if (is_mod) enc_mov(j, opnd_reg(X86_RAX), opnd_reg(X86_RDX));
+    bind_label(j, done);
+}
+
+/* 등록 전 함수 호출 검사: 등록 전이면 에러 후 %rax = 0으로 skip 레이블로 */
+static void emit_check_func(Jit *j, int fi, int msg, int skip) {
+    int ok = new_label(j);
+    enc_cmpb(j, opnd_data(j->fdef_offset + fi), 0);
+    enc_jcc(j, CC_NE, ok);
+    emit_error(j, msg);
+    enc_zero(j, X86_RAX);
+    enc_jmp(j, skip);
+    bind_label(j, ok);
+}
+
+/* === 레지스터 할당된 LIR 인코딩 (codegen_x86.c -O1과 같은 선택) === */
+
+static Opnd loc_opnd(Jit *j, int loc) {
+    if (LIR_LOC_IS_REG(loc)) return opnd_reg(loc);
+    Opnd o = { OPND_FRAME, 0, -8L * (j->ncallee + LIR_LOC_SLOT(loc) + 1) };
+    return o;
+}
+
+static int val_loc(Jit *j, LirVal v) {
+    return v.kind == LIR_VREG ? j->f->loc[v.value] : -1;
+}
+
+static Opnd val_opnd(Jit *j, LirVal v) {
+    return v.kind == LIR_IMM ? opnd_imm(v.value) : loc_opnd(j, val_loc(j, v));
+}
+
+static int val_is_mem(Jit *j, LirVal v) {
+    return v.kind == LIR_VREG && !LIR_LOC_IS_REG(val_loc(j, v));
+}
+
+/* reg = v */
+static void load_reg(Jit *j, int reg, LirVal v) {
+    if (v.kind == LIR_IMM && v.value == 0) {
+        enc_zero(j, reg);
+        return;
+    }
+    if (val_loc(j, v) == reg) return;
+    enc_mov(j, opnd_reg(reg), val_opnd(j, v));
+}
+
+/* loc = reg */
+static void store_reg(Jit *j, int loc, int reg) {
+    if (loc == reg) return;
+    enc_mov(j, loc_opnd(j, loc), opnd_reg(reg));
+}
+
+/* loc = v (메모리끼리는 %rax 경유) */
+static void move_val(Jit *j, int loc, LirVal v) {
+    if (v.kind == LIR_VREG && val_loc(j, v) == loc) return;
+    if (LIR_LOC_IS_REG(loc)) {
+        load_reg(j, loc, v);
+    } else if (val_is_mem(j, v)) {
+        load_reg(j, X86_RAX, v);
+        store_reg(j, loc, X86_RAX);
+    } else {
+        enc_mov(j, loc_opnd(j, loc), val_opnd(j, v));
+    }
+}
+
+static void emit_regmove(Jit *j, const RegMove *m) {
+    if (m->src_imm) {
+        LirVal v = { LIR_IMM, m->imm };
+        move_val(j, m->dst, v);
+        return;
+    }
+    if (!LIR_LOC_IS_REG(m->src) && !LIR_LOC_IS_REG(m->dst)) {
+        enc_mov(j, opnd_reg(X86_RAX), loc_opnd(j, m->src));
+        enc_mov(j, loc_opnd(j, m->dst), opnd_reg(X86_RAX));
+    } else {
+        enc_mov(j, loc_opnd(j, m->dst), loc_opnd(j, m->src));
+    }
+}
+
+/* dst(레지스터) op= src */
+static void enc_arith(Jit *j, LirOp op, int dst, Opnd src) {
+    if (op == LIR_MUL) {
+        enc_imul(j, dst, src);
+    } else {
+        enc_alu(j, op == LIR_ADD ? ALU_ADD : ALU_SUB, opnd_reg(dst), src);
+    }
+}
+
+/* dst = a op b (add, sub, imul) */
+static void emit_arith(Jit *j, const LirInst *in, int commutative) {
+    int d = j->f->loc[in->dst];
+    int b_in_d = val_loc(j, in->b) == d;
+
+    if (LIR_LOC_IS_REG(d) && !b_in_d) {
+        move_val(j, d, in->a);
+        enc_arith(j, in->op, d, val_opnd(j, in->b));
+    } else if (LIR_LOC_IS_REG(d) && commutative) {
+        enc_arith(j, in->op, d, val_opnd(j, in->a));
+    } else {
+        load_reg(j, X86_RAX, in->a);
+        enc_arith(j, in->op, X86_RAX, val_opnd(j, in->b));
+        store_reg(j, d, X86_RAX);
+    }
+}
+
+/* %al의 0/1을 dst로 */
+static void store_flag(Jit *j, int d) {
+    if (LIR_LOC_IS_REG(d)) {
+        enc_movzx_al(j, d);
+    } else {
+        enc_movzx_al(j, X86_RAX);
+        store_reg(j, d, X86_RAX);
+    }
+}
+
+/* 비교: 왼쪽은 레지스터 또는 메모리여야 하고 둘 다 메모리일 수 없음 */
+static void emit_compare(Jit *j, LirVal a, LirVal b) {
+    Opnd aop;
+    if (a.kind == LIR_IMM || (val_is_mem(j, a) && val_is_mem(j, b))) {
+        load_reg(j, X86_RAX, a);
+        aop = opnd_reg(X86_RAX);
+    } else {
+        aop = val_opnd(j, a);
+    }
+    enc_alu(j, ALU_CMP, aop, val_opnd(j, b));
+}
+
+/* 비교 후 바로 조건 점프 (상수는 오른쪽으로, 0과 비교는 testq) */
+static void emit_jcc(Jit *j, const LirInst *in) {
+    LirVal a = in->a, b = in->b;
+    int cc = in->cc;
+    if (a.kind == LIR_IMM && b.kind != LIR_IMM) {
+        LirVal t = a;
+        a = b;
+        b = t;
+        cc = ir_swap_cc(cc);
+    }
+    if (b.kind == LIR_IMM && b.value == 0 && a.kind == LIR_VREG && !val_is_mem(j, a)) {
+        enc_test(j, val_loc(j, a));
+    } else {
+        emit_compare(j, a, b);
+    }
+    enc_jcc(j, cc_code(cc), j->block_base + in->label);
+}
+
+static void emit_call(Jit *j, const LirInst *in) {
+    RegMove moves[LIR_MAX_REG_PARAMS], seq[2 * LIR_MAX_REG_PARAMS];
+    int n = in->nargs < LIR_MAX_REG_PARAMS ? in->nargs : LIR_MAX_REG_PARAMS;
+    for (int i = 0; i < n; ++i) {
+        moves[i].dst = x86_arg_regs[i];
+        moves[i].src_imm = in->args[i].kind == LIR_IMM;
+        moves[i].src = moves[i].src_imm ? -1 : val_loc(j, in->args[i]);
+        moves[i].imm = in->args[i].value;
+    }
+    int nseq = regalloc_sequence_moves(moves, n, X86_RAX, seq);
+    for (int i = 0; i < nseq; ++i) emit_regmove(j, &seq[i]);
+
+    enc_call(j, j->func_base + in->index);
+    store_reg(j, j->f->loc[in->dst], X86_RAX);
+}
+
+static void emit_inst(Jit *j, const LirInst *in, int is_last) {
+    int d = in->dst >= 0 ? j->f->loc[in->dst] : -1;
+
+    switch (in->op) {
+        case LIR_LABEL:
+            bind_label(j, j->block_base + in->label);
+            break;
+
+        case LIR_MOV:
+            move_val(j, d, in->a);
+            break;
+
+        case LIR_LOADG:
+            emit_load_global(j, in->index, in->str);
+            store_reg(j, d, X86_RAX);
+            break;
+
+        case LIR_STOREG: {
+            Opnd a;
+            if (val_is_mem(j, in->a)) {
+                load_reg(j, X86_RAX, in->a);
+                a = opnd_reg(X86_RAX);
+            } else {
+                a = val_opnd(j, in->a);
+            }
+            enc_mov(j, opnd_data(in->index * 8L), a);
+            enc_movb(j, opnd_data(j->gdef_offset + in->index), 1);
+            break;
+        }
+
+        case LIR_ADD:
+        case LIR_MUL:
+            emit_arith(j, in, 1);
+            break;
+
+        case LIR_SUB:
+            emit_arith(j, in, 0);
+            break;
+
+        case LIR_DIV:
+        case LIR_MOD:
+            load_reg(j, X86_RCX, in->b);
+            load_reg(j, X86_RAX, in->a);
+            emit_divmod(j, in->op == LIR_MOD);
+            store_reg(j, d, X86_RAX);
+            break;
+
+        case LIR_SETCC:
+            emit_compare(j, in->a, in->b);
+            enc_setcc_al(j, cc_code(in->cc));
+            store_flag(j, d);
+            break;
+
+        case LIR_LAND:
+            load_reg(j, X86_RAX, in->a);
+            load_reg(j, X86_RCX, in->b);
+            enc_test(j, X86_RAX);
+            enc_setcc_al(j, CC_NE);
+            enc_test(j, X86_RCX);
+            put_op(j, 0, 0x0F90u + CC_NE, 0, opnd_reg(X86_RCX), 0);    /* setne %cl */
+            put_op(j, 0, 0x20, X86_RCX, opnd_reg(X86_RAX), 0);          /* andb %cl, %al */
+            store_flag(j, d);
+            break;
+
+        case LIR_LOR:
+            load_reg(j, X86_RAX, in->a);
+            enc_alu(j, ALU_OR, opnd_reg(X86_RAX), val_opnd(j, in->b));
+            enc_setcc_al(j, CC_NE);
+            store_flag(j, d);
+            break;
+
+        case LIR_NEG:
+            if (LIR_LOC_IS_REG(d)) {
+                move_val(j, d, in->a);
+                put_op(j, 1, 0xF7, 3, opnd_reg(d), 0);
+            } else {
+                load_reg(j, X86_RAX, in->a);
+                put_op(j, 1, 0xF7, 3, opnd_reg(X86_RAX), 0);
+                store_reg(j, d, X86_RAX);
+            }
+            break;
+
+        case LIR_NOT: {
+            LirVal zero = { LIR_IMM, 0 };
+            emit_compare(j, in->a, zero);
+            enc_setcc_al(j, CC_E);
+            store_flag(j, d);
+            break;
+        }
+
+        case LIR_JMP:
+            enc_jmp(j, j->block_base + in->label);
+            break;
+
+        case LIR_JCC:
+            emit_jcc(j, in);
+            break;
+
+        case LIR_CALL:
+            emit_call(j, in);
+            break;
+
+        case LIR_RET:
+            load_reg(j, X86_RAX, in->a);
+            if (!is_last) enc_jmp(j, j->ret_label);
+            break;
+
+        case LIR_PRINT_INT:
+            load_reg(j, X86_RAX, in->a);
+            enc_call(j, j->rt_print_int);
+            break;
+
+        case LIR_PRINT_STR:
+            emit_load_str(j, in->str);
+            enc_call(j, j->rt_print_str);
+            break;
+
+        case LIR_ERROR:
+            emit_error(j, in->str);
+            break;
+
+        case LIR_DEFFN:
+            enc_movb(j, opnd_data(j->fdef_offset + in->index), 1);
+            break;
+
+        case LIR_CHKFN:
+            emit_check_func(j, in->index, in->str, j->block_base + in->label);
+            break;
+
+        case LIR_OP_COUNT:
+            break;
+    }
+}
+
+/* 프롤로그: rbp 프레임, 사용한 callee-saved 저장, 스필 영역 (16바이트 정렬)
+ * is_main이 아니면 진입/복귀에서 호출 깊이를 셈 (한계에 이르면 rt_depth로) */
+static void emit_lir_function(Jit *j, LirFunc *f, int is_main) {
+    j->f = f;
+    j->ncallee = 0;
+    j->block_base = new_labels(j, f->nlabels);
+    j->ret_label = new_label(j);
+
+    if (!is_main) {
+        enc_alu(j, ALU_CMP, opnd_data(j->depth_offset), opnd_imm(EVAL_MAX_CALL_DEPTH));
+        enc_jcc(j, CC_GE, j->rt_depth);
+        enc_alu(j, ALU_ADD, opnd_data(j->depth_offset), opnd_imm(1));
+    }
+    enc_push(j, X86_RBP);
+    enc_mov(j, opnd_reg(X86_RBP), opnd_reg(X86_RSP));
+    for (int r = 0; r < X86_NREGS; ++r) {
+        if (f->callee_used & (1u << r)) {
+            enc_push(j, r);
+            j->ncallee++;
+        }
+    }
+    int frame = (j->ncallee + f->nspills) * 8;
+    frame = ((frame + 15) & ~15) - j->ncallee * 8;
+    if (frame > 0) enc_alu(j, ALU_SUB, opnd_reg(X86_RSP), opnd_imm(frame));
+
+    /* 매개변수를 할당된 위치로 (병렬 이동) */
+    RegMove moves[LIR_MAX_REG_PARAMS], seq[2 * LIR_MAX_REG_PARAMS];
+    for (int i = 0; i < f->nparams; ++i) {
+        moves[i].dst = f->loc[i];
+        moves[i].src = x86_arg_regs[i];
+        moves[i].src_imm = 0;
+        moves[i].imm = 0;
+    }
+    int nseq = regalloc_sequence_moves(moves, f->nparams, X86_RAX, seq);
+    for (int i = 0; i < nseq; ++i) emit_regmove(j, &seq[i]);
+
+    for (int i = 0; i < f->nzero_init; ++i) {
+        LirVal zero = { LIR_IMM, 0 };
+        move_val(j, f->loc[f->zero_init[i]], zero);
+    }
+
+    for (int i = 0; i < f->ncode; ++i) {
+        emit_inst(j, &f->code[i], i == f->ncode - 1);
+    }
+
+    bind_label(j, j->ret_label);
+    if (j->ncallee > 0) {
+        Opnd saved = { OPND_FRAME, 0, -8L * j->ncallee };
+        put_op(j, 1, 0x8D, X86_RSP, saved, 0);      /* leaq -n(%rbp), %rsp */
+        for (int r = X86_NREGS - 1; r >= 0; --r) {
+            if (f->callee_used & (1u << r)) enc_pop(j, r);
+        }
+        enc_pop(j, X86_RBP);
+    } else {
+        put8(j, 0xC9);      /* leave */
+    }
+    if (!is_main) enc_alu(j, ALU_SUB, opnd_data(j->depth_offset), opnd_imm(1));
+    put8(j, 0xC3);
+}
+
+/* 문자열 리터럴/에러 메시지를 코드 뒤에 배치 (읽기 전용) */
+static void emit_strings(Jit *j) {
+    IrProgram *ip = j->ir;
+    for (int i = 0; i < ip->nstrings; ++i) {
+        bind_label(j, j->str_base + i);
+        for (const char *p = ip->strings[i]; *p; ++p) put8(j, (unsigned char)*p);
+        put8(j, 0);
+    }
+}
+
+static size_t round_page(size_t n, size_t page) {
+    if (n == 0) n = 1;
+    return (n + page - 1) / page * page;
+}
+
+/* 코드를 mmap 영역에 배치하고 fixup을 채운 뒤 코드 페이지를 R+X로 (W^X) */
+static int place(Jit *j, JitProgram *jp, int entry_label, size_t data_bytes) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    jp->code_size = (size_t)j->len;
+    jp->data_offset = round_page((size_t)j->len, page);
+    jp->data_size = round_page(data_bytes, page);
+    jp->mem_size = jp->data_offset + jp->data_size;
+
+    void *mem = mmap(NULL, jp->mem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return -1;
+    jp->mem = (unsigned char *)mem;
+    memcpy(jp->mem, j->code, (size_t)j->len);
+
+    for (int i = 0; i < j->nfixups; ++i) {
+        const Fixup *fx = &j->fixups[i];
+        long target = fx->kind == FIX_LABEL ? j->labels[fx->target]
+                                            : (long)jp->data_offset + fx->target;
+        int32_t rel = (int32_t)(target - fx->end);
+        memcpy(jp->mem + fx->pos, &rel, sizeof(rel));
+    }
+
+    if (mprotect(jp->mem, jp->data_offset, PROT_READ | PROT_EXEC) != 0) return -1;
+    jp->entry = jp->mem + j->labels[entry_label];
+    return 0;
+}
+
+/* 함수 fi가 호출하는 함수를 모두 표시 (mark[fi] 포함)
+ * 반환: 승격할 수 없는 이유, 없으면 NULL */
+static const char *mark_callees(IrProgram *ip, int fi, unsigned char *mark) {
+    if (mark[fi]) return NULL;
+    mark[fi] = 1;
+    IrFunc *f = &ip->funcs[fi];
+    for (int i = 0; i < f->ninsts; ++i) {
+        IrInst *in = &f->insts[i];
+        if (in->block < 0) continue;
+        if (in->op == IR_LOADG || in->op == IR_STOREG) {
+            return "uses global variables";
+        }
+        if (in->op == IR_CHKFN) {
+            return "calls a function defined after top-level code";
+        }
+        if (in->op == IR_CALL) {
+            const char *reason = mark_callees(ip, in->index, mark);
+            if (reason) return reason;
+        }
+    }
+    return NULL;
+}
+
+/* 기계어 생성: entry_func가 NULL이면 프로그램 전체 (top-level이 진입점),
+ * 아니면 entry_func와 그 함수가 호출하는 함수만 */
+static JitProgram *compile(Program *prog, const Function *entry_func, const char **error) {
+    if (error) *error = NULL;
+    const char *reason = NULL;
+    IrProgram *ip = ir_new(prog, &reason);
+    if (ip && (reason = lir_check_native(ip)) != NULL) {
+        ir_free(ip);
+        ip = NULL;
+    }
+    if (!ip) {
+        if (error) *error = reason;
+        return NULL;
+    }
+
+    int entry_fi = -1;
+    unsigned char *mark = NULL;
+    ir_build(ip);
+    if (entry_func) {
+        entry_fi = ir_find_func(ip, entry_func->name);
+        mark = (unsigned char *)calloc((size_t)ip->nfuncs + 1, 1);
+        if (entry_fi < 0 || ip->funcs[entry_fi].func != entry_func) {
+            reason = "not the first definition of its name";
+        } else if (!mark) {
+            reason = "out of memory";
+        } else {
+            reason = mark_callees(ip, entry_fi, mark);
+        }
+        if (reason) {
+            free(mark);
+            ir_free(ip);
+            if (error) *error = reason;
+            return NULL;
+        }
+    }
+
+    JitProgram *jp = (JitProgram *)calloc(1, sizeof(JitProgram));
+    if (!jp) {
+        free(mark);
+        ir_free(ip);
+        if (error) *error = "out of memory";
+        return NULL;
+    }
+
+    Jit j;
+    memset(&j, 0, sizeof(j));
+    j.jp = jp;
+    j.ir = ip;
+    j.div_msg = ir_add_string(ip, "Error: division by zero\n");
+    j.mod_msg = ir_add_string(ip, "Error: modulo by zero\n");
+    j.depth_msg = ir_add_string(ip, "Error: maximum call depth exceeded\n");
+    j.gdef_offset = ip->nglobals * 8;
+    j.fdef_offset = j.gdef_offset + ip->nglobals;
+    j.depth_offset = (j.fdef_offset + ip->nfuncs + 7) & ~7;
+    jp->depth_offset = (size_t)j.depth_offset;
+
+    LirProgram *lp = lir_lower(ip);
+    regalloc_program(lp);
+
+    j.rt_print_int = new_label(&j);
+    j.rt_print_str = new_label(&j);
+    j.rt_error = new_label(&j);
+    j.rt_depth = new_label(&j);
+    j.func_base = new_labels(&j, lp->nfuncs);
+    j.str_base = new_labels(&j, ip->nstrings);
+    int entry = entry_fi >= 0 ? j.func_base + entry_fi : new_label(&j);
+
+    emit_runtime(&j);
+    emit_depth_overflow(&j);
+    for (int i = 0; i < lp->nfuncs; ++i) {
+        if (mark && !mark[i]) continue;
+        bind_label(&j, j.func_base + i);
+        emit_lir_function(&j, &lp->funcs[i], 0);
+    }
+    if (entry_fi < 0) {
+        bind_label(&j, entry);
+        emit_lir_function(&j, &lp->main, 1);
+    }
+    emit_strings(&j);
+    lir_free(lp);
+
+    int ok = !j.failed && place(&j, jp, entry, (size_t)j.depth_offset + sizeof(long)) == 0;
+    free(j.code);
+    free(j.labels);
+    free(j.fixups);
+    free(mark);
+    ir_free(ip);
+    if (!ok) {
+        jit_free(jp);
+        if (error) *error = "cannot map executable memory";
+        return NULL;
+    }
+    return jp;
+}
+
+JitProgram *jit_compile(Program *prog, const char **error) {
+    return compile(prog, NULL, error);
+}
+
+JitProgram *jit_compile_function(Program *prog, const Function *func, const char **error) {
+    return compile(prog, func, error);
+}
+
+int jit_run(JitProgram *jp, Output *out) {
+    memset(jp->mem + jp->data_offset, 0, jp->data_size);
+    jp->out = out;
+    long result = ((long (*)(void))(void *)jp->entry)();
+    jp->out = NULL;
+    return (int)result;
+}
+
+long jit_call(JitProgram *jp, Output *out, const long *args, int nargs, int depth) {
+    typedef long (*NativeFunc)(long, long, long, long, long, long);
+    long a[LIR_MAX_REG_PARAMS] = { 0 };
+    for (int i = 0; i < nargs && i < LIR_MAX_REG_PARAMS; ++i) a[i] = args[i];
+    *(long *)(jp->mem + jp->data_offset + jp->depth_offset) = depth;
+    jp->out = out;
+    return ((NativeFunc)(void *)jp->entry)(a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+void jit_free(JitProgram *jp) {
+    if (!jp) return;
+    if (jp->mem) munmap(jp->mem, jp->mem_size);
+    free(jp);
+}
+
+#else /* !JIT_SUPPORTED */
+
+JitProgram *jit_compile(Program *prog, const char **error) {
+    (void)prog;
+    if (error) *error = "JIT requires an x86-64 host";
+    return NULL;
+}
+
+JitProgram *jit_compile_function(Program *prog, const Function *func, const char **error) {
+    (void)prog;
+    (void)func;
+    if (error) *error = "JIT requires an x86-64 host";
+    return NULL;
+}
+
+int jit_run(JitProgram *jp, Output *out) {
+    (void)jp;
+    (void)out;
+    return 0;
+}
+
+long jit_call(JitProgram *jp, Output *out, const long *args, int nargs, int depth) {
+    (void)jp;
+    (void)out;
+    (void)args;
+    (void)nargs;
+    (void)depth;
+    return 0;
+}
+
+void jit_free(JitProgram *jp) {
+    free(jp);
+}
+
+#endif /* JIT_SUPPORTED */
+
+int jit_eval_program(Program *prog, Output *out, int *used_jit, const char **error) {
+    JitProgram *jp = jit_compile(prog, error);
+    if (!jp) {
+        if (used_jit) *used_jit = 0;
+        return eval_program(prog, out);
+    }
+    int result = jit_run(jp, out);
+    jit_free(jp);
+    if (used_jit) *used_jit = 1;
+    return result;
+}
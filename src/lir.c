@@ -0,0 +1,381 @@
+/* SSA IR → LIR 낮추기 (phi 제거)
+ * IR 블록 순서를 그대로 배치하고, 다음 블록으로 가는 점프는 생략
+ * - br의 조건이 같은 블록에서 한 번만 쓰이는 cmp면 cmp + 조건 점프(JCC) 하나로
+ * - phi는 선행 블록 끝의 병렬 이동, 분기가 둘인 블록에서 오는 간선은 중간 레이블에서 이동
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir.h"
+#include "lir.h"
+#include "regalloc.h"
+
+typedef struct {
+    int from, to;       /* IR 블록 간선 */
+    int label;          /* 이동을 둘 중간 레이블 */
+} SplitEdge;
+
+typedef struct {
+    IrFunc *irf;
+    LirFunc *f;
+    int *vreg;          /* IR 값 → vreg (-1: 상수이거나 값 없음) */
+    int *uses;          /* IR 값 사용 횟수 */
+    SplitEdge *splits;
+    int nsplits;
+    int splits_cap;
+} Lower;
+
+/* === 명령어 방출 === */
+
+static LirVal vreg_val(int v) {
+    LirVal val = { LIR_VREG, v };
+    return val;
+}
+
+static LirVal imm_val(long v) {
+    LirVal val = { LIR_IMM, v };
+    return val;
+}
+
+static int new_vreg(Lower *l) {
+    return l->f->nvregs++;
+}
+
+static int new_label(Lower *l) {
+    return l->f->nlabels++;
+}
+
+static LirInst *emit(Lower *l, LirOp op) {
+    LirFunc *f = l->f;
+    if (f->ncode == f->code_cap) {
+        f->code_cap = f->code_cap ? f->code_cap * 2 : 64;
+        f->code = (LirInst *)realloc(f->code, f->code_cap * sizeof(LirInst));
+    }
+    LirInst *in = &f->code[f->ncode++];
+    memset(in, 0, sizeof(*in));
+    in->op = op;
+    in->dst = -1;
+    return in;
+}
+
+static void emit_label(Lower *l, int label) {
+    emit(l, LIR_LABEL)->label = label;
+}
+
+static void emit_goto(Lower *l, int label) {
+    emit(l, LIR_JMP)->label = label;
+}
+
+/* IR 값 → 피연산자 (상수는 즉시값) */
+static LirVal value(Lower *l, int v) {
+    IrInst *in = &l->irf->insts[v];
+    if (in->op == IR_CONST) return imm_val(in->imm);
+    return vreg_val(l->vreg[v]);
+}
+
+/* === phi 이동 === */
+
+static int has_phis(Lower *l, int block) {
+    IrBlock *blk = &l->irf->blocks[block];
+    return blk->ninsts > 0 && l->irf->insts[blk->insts[0]].op == IR_PHI;
+}
+
+/* from → to 간선의 phi 이동 (동시에 일어나야 하므로 regalloc_sequence_moves로 순서를 정함) */
+static void emit_edge_moves(Lower *l, int from, int to) {
+    IrFunc *irf = l->irf;
+    IrBlock *blk = &irf->blocks[to];
+    int p = 0;
+    while (p < blk->npreds && blk->preds[p] != from) p++;
+
+    int nphis = 0;
+    while (nphis < blk->ninsts && irf->insts[blk->insts[nphis]].op == IR_PHI) nphis++;
+    if (nphis == 0) return;
+
+    RegMove *moves = (RegMove *)malloc(nphis * sizeof(RegMove));
+    RegMove *seq = (RegMove *)malloc(2 * nphis * sizeof(RegMove));
+    for (int i = 0; i < nphis; ++i) {
+        int phi = blk->insts[i];
+        LirVal src = value(l, irf->insts[phi].args[p]);
+        moves[i].dst = l->vreg[phi];
+        moves[i].src_imm = src.kind == LIR_IMM;
+        moves[i].src = src.kind == LIR_IMM ? -1 : (int)src.value;
+        moves[i].imm = src.value;
+    }
+    int scratch = l->f->nvregs;
+    int nseq = regalloc_sequence_moves(moves, nphis, scratch, seq);
+    for (int i = 0; i < nseq; ++i) {
+        if (seq[i].dst == scratch && scratch == l->f->nvregs) new_vreg(l);  /* 순환을 끊는 임시 vreg */
+        LirInst *in = emit(l, LIR_MOV);
+        in->dst = seq[i].dst;
+        in->a = seq[i].src_imm ? imm_val(seq[i].imm) : vreg_val(seq[i].src);
+    }
+    free(moves);
+    free(seq);
+}
+
+/* 분기가 둘인 블록에서 to로 가는 레이블 (to에 phi가 있으면 이동을 둘 중간 레이블) */
+static int edge_label(Lower *l, int from, int to) {
+    if (!has_phis(l, to)) return to;
+    if (l->nsplits == l->splits_cap) {
+        l->splits_cap = l->splits_cap ? l->splits_cap * 2 : 8;
+        l->splits = (SplitEdge *)realloc(l->splits, l->splits_cap * sizeof(SplitEdge));
+    }
+    SplitEdge *e = &l->splits[l->nsplits++];
+    e->from = from;
+    e->to = to;
+    e->label = new_label(l);
+    return e->label;
+}
+
+/* === 분기 === */
+
+/* if (a cc b) goto if_true else goto if_false, next는 바로 뒤에 놓일 레이블 */
+static void emit_branch(Lower *l, int cc, LirVal a, LirVal b, int if_true, int if_false, int next) {
+    if (a.kind == LIR_IMM && b.kind == LIR_IMM) {
+        long x = a.value, y = b.value;
+        int taken = cc == BIN_LT ? x < y : cc == BIN_GT ? x > y :
+                    cc == BIN_LE ? x <= y : cc == BIN_GE ? x >= y :
+                    cc == BIN_EQ ? x == y : x != y;
+        int target = taken ? if_true : if_false;
+        if (target != next) emit_goto(l, target);
+        return;
+    }
+    if (if_true == next) {
+        cc = ir_negate_cc(cc);
+        if_true = if_false;
+        if_false = next;
+    }
+    LirInst *in = emit(l, LIR_JCC);
+    in->cc = cc;
+    in->a = a;
+    in->b = b;
+    in->label = if_true;
+    if (if_false != next) emit_goto(l, if_false);
+}
+
+/* br의 조건으로만 쓰이는 같은 블록의 cmp (값을 만들지 않고 JCC로 합침) */
+static int fused_compare(Lower *l, int block, int cond) {
+    IrInst *in = &l->irf->insts[cond];
+    IrInst *term = ir_terminator(l->irf, block);
+    return in->op == IR_CMP && in->block == block && l->uses[cond] == 1 &&
+           term && term->op == IR_BR && term->args[0] == cond;
+}
+
+/* === 명령어 === */
+
+static LirOp binary_op(IrOp op) {
+    switch (op) {
+        case IR_ADD: return LIR_ADD;
+        case IR_SUB: return LIR_SUB;
+        case IR_MUL: return LIR_MUL;
+        case IR_DIV: return LIR_DIV;
+        case IR_MOD: return LIR_MOD;
+        case IR_CMP: return LIR_SETCC;
+        case IR_AND: return LIR_LAND;
+        default:     return LIR_LOR;
+    }
+}
+
+static void lower_inst(Lower *l, int block, int v, int next) {
+    IrFunc *irf = l->irf;
+    IrInst *in = &irf->insts[v];
+    IrBlock *blk = &irf->blocks[block];
+    LirInst *out;
+
+    switch (in->op) {
+        case IR_CONST:
+        case IR_PARAM:
+        case IR_PHI:
+            break;
+
+        case IR_ADD:
+        case IR_SUB:
+        case IR_MUL:
+        case IR_DIV:
+        case IR_MOD:
+        case IR_CMP:
+        case IR_AND:
+        case IR_OR:
+            if (fused_compare(l, block, v)) break;
+            out = emit(l, binary_op(in->op));
+            out->dst = l->vreg[v];
+            out->a = value(l, in->args[0]);
+            out->b = value(l, in->args[1]);
+            out->cc = in->cc;
+            break;
+
+        case IR_NEG:
+        case IR_NOT:
+            out = emit(l, in->op == IR_NEG ? LIR_NEG : LIR_NOT);
+            out->dst = l->vreg[v];
+            out->a = value(l, in->args[0]);
+            break;
+
+        case IR_LOADG:
+            out = emit(l, LIR_LOADG);
+            out->dst = l->vreg[v];
+            out->index = in->index;
+            out->str = in->str;
+            break;
+
+        case IR_STOREG:
+            out = emit(l, LIR_STOREG);
+            out->index = in->index;
+            out->a = value(l, in->args[0]);
+            break;
+
+        case IR_CALL:
+            out = emit(l, LIR_CALL);
+            out->dst = l->vreg[v];
+            out->index = in->index;
+            out->nargs = in->nargs;
+            if (in->nargs > 0) {
+                out->args = (LirVal *)malloc(in->nargs * sizeof(LirVal));
+                for (int i = 0; i < in->nargs; ++i) out->args[i] = value(l, in->args[i]);
+            }
+            break;
+
+        case IR_PRINT_INT:
+            emit(l, LIR_PRINT_INT)->a = value(l, in->args[0]);
+            break;
+
+        case IR_PRINT_STR:
+            emit(l, LIR_PRINT_STR)->str = in->str;
+            break;
+
+        case IR_ERROR:
+            emit(l, LIR_ERROR)->str = in->str;
+            break;
+
+        case IR_DEFFN:
+            emit(l, LIR_DEFFN)->index = in->index;
+            break;
+
+        case IR_JMP:
+            emit_edge_moves(l, block, blk->succ[0]);
+            if (blk->succ[0] != next) emit_goto(l, blk->succ[0]);
+            break;
+
+        case IR_BR: {
+            int cond = in->args[0];
+            int if_true = edge_label(l, block, blk->succ[0]);
+            int if_false = edge_label(l, block, blk->succ[1]);
+            if (fused_compare(l, block, cond)) {
+                IrInst *cmp = &irf->insts[cond];
+                emit_branch(l, cmp->cc, value(l, cmp->args[0]), value(l, cmp->args[1]),
+                            if_true, if_false, next);
+            } else {
+                emit_branch(l, BIN_NE, value(l, cond), imm_val(0), if_true, if_false, next);
+            }
+            break;
+        }
+
+        case IR_CHKFN: {
+            int ok = edge_label(l, block, blk->succ[0]);
+            out = emit(l, LIR_CHKFN);
+            out->index = in->index;
+            out->str = in->str;
+            out->label = edge_label(l, block, blk->succ[1]);
+            if (ok != next) emit_goto(l, ok);
+            break;
+        }
+
+        case IR_RET:
+            emit(l, LIR_RET)->a = value(l, in->args[0]);
+            break;
+
+        case IR_OP_COUNT:
+            break;
+    }
+}
+
+/* === 함수/프로그램 === */
+
+static void lower_func(Lower *l, IrFunc *irf, LirFunc *f) {
+    memset(l, 0, sizeof(*l));
+    l->irf = irf;
+    l->f = f;
+    f->nparams = irf->nparams;
+    f->nvregs = irf->nparams;
+    f->nlabels = irf->nblocks;   /* IR 블록 b는 레이블 b */
+
+    l->vreg = (int *)malloc((irf->ninsts + 1) * sizeof(int));
+    l->uses = (int *)calloc(irf->ninsts + 1, sizeof(int));
+    for (int b = 0; b < irf->nblocks; ++b) {
+        IrBlock *blk = &irf->blocks[b];
+        for (int i = 0; i < blk->ninsts; ++i) {
+            int v = blk->insts[i];
+            IrInst *in = &irf->insts[v];
+            if (in->op == IR_PARAM) {
+                l->vreg[v] = in->index;
+            } else if (in->type == IR_VOID || in->op == IR_CONST) {
+                l->vreg[v] = -1;
+            } else {
+                l->vreg[v] = new_vreg(l);
+            }
+            for (int k = 0; k < in->nargs; ++k) l->uses[in->args[k]]++;
+        }
+    }
+
+    for (int b = 0; b < irf->nblocks; ++b) {
+        IrBlock *blk = &irf->blocks[b];
+        int next = b + 1 < irf->nblocks ? b + 1 : -1;
+        emit_label(l, b);
+        for (int i = 0; i < blk->ninsts; ++i) {
+            lower_inst(l, b, blk->insts[i], next);
+        }
+    }
+
+    /* 분할한 간선: 이동 후 원래 블록으로 */
+    for (int i = 0; i < l->nsplits; ++i) {
+        emit_label(l, l->splits[i].label);
+        emit_edge_moves(l, l->splits[i].from, l->splits[i].to);
+        emit_goto(l, l->splits[i].to);
+    }
+
+    free(l->vreg);
+    free(l->uses);
+    free(l->splits);
+}
+
+const char *lir_check_native(IrProgram *ip) {
+    for (int i = 0; i < ip->nfuncs; ++i) {
+        if (ip->funcs[i].nparams > LIR_MAX_REG_PARAMS) {
+            return "functions with more than 6 parameters are not supported";
+        }
+    }
+    return NULL;
+}
+
+LirProgram *lir_lower(IrProgram *ip) {
+    LirProgram *lp = (LirProgram *)calloc(1, sizeof(LirProgram));
+    lp->ir = ip;
+    lp->nfuncs = ip->nfuncs;
+    lp->funcs = (LirFunc *)calloc(ip->nfuncs > 0 ? ip->nfuncs : 1, sizeof(LirFunc));
+
+    Lower l;
+    lower_func(&l, &ip->main, &lp->main);
+    for (int i = 0; i < ip->nfuncs; ++i) {
+        lower_func(&l, &ip->funcs[i], &lp->funcs[i]);
+    }
+    return lp;
+}
+
+static void free_func(LirFunc *f) {
+    for (int i = 0; i < f->ncode; ++i) {
+        free(f->code[i].args);
+    }
+    free(f->code);
+    free(f->loc);
+    free(f->zero_init);
+}
+
+void lir_free(LirProgram *lp) {
+    if (!lp) return;
+    for (int i = 0; i < lp->nfuncs; ++i) {
+        free_func(&lp->funcs[i]);
+    }
+    free_func(&lp->main);
+    free(lp->funcs);
+    free(lp);
+}
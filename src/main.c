@@ -2,31 +2,82 @@
 #include <stdlib.h>
 #include <string.h>
 #include "ast.h"
-#include "codegen_x86.h"
 #include "eval.h"
-
-/* 외부 파서 함수 */
-extern int yyparse(void);
-extern FILE *yyin;
-
-/* 전역 프로그램 (parser.y에서 설정) */
-extern Program *g_program;
+#include "context.h"
+#include "codegen_x86.h"
+#include "precompile.h"
+#include "server.h"
+#include "stats.h"
 
 void print_usage(const char *prog) {
-    fprintf(stderr, "Usage: %s [options] <input.js>\n", prog);
+    fprintf(stderr, "Usage: %s [options] <input.js | input.mjsc>\n", prog);
     fprintf(stderr, "Options:\n");
     fprintf(stderr, "  -e, --eval     Interpret and execute the program\n");
+    fprintf(stderr, "      --vm       Interpret on the bytecode VM (with -e)\n");
+    fprintf(stderr, "      --flat     Interpret on the flattened index-based AST (with -e)\n");
+    fprintf(stderr, "  -j, --jit      Compile to x86-64 in memory and run it (like -e)\n");
+    fprintf(stderr, "      --tier     Interpret, promoting hot functions to the JIT (like -e)\n");
+    fprintf(stderr, "      --tier-threshold <n>  Calls + loop iterations before promotion (default %d)\n",
+            EVAL_TIER_DEFAULT_THRESHOLD);
+    fprintf(stderr, "      --tier-stats  Print which functions were promoted and when (stderr)\n");
+    fprintf(stderr, "      --memoize  Cache results of pure functions by argument values (like -e)\n");
+    fprintf(stderr, "      --memo-stats  Print memo cache hits and misses per function (stderr)\n");
+    fprintf(stderr, "      --accum-report  Print which recursive functions got an accumulator (stderr)\n");
+    fprintf(stderr, "      --opt-report    Print folded constants, removed dead code and size saved (stderr)\n");
     fprintf(stderr, "  -c, --compile  Generate x86-64 assembly (default)\n");
     fprintf(stderr, "  -o <file>      Output file (default: out.s for compile)\n");
+    fprintf(stderr, "  -O<n>          Codegen level: -O0 stack machine, -O1 register allocation\n");
+    fprintf(stderr, "                 (default -O%d)\n", X86_OPT_DEFAULT);
+    fprintf(stderr, "      --emit-ir  Print the SSA IR used by -O1 (stdout, or -o <file>)\n");
+    fprintf(stderr, "      --precompile  Save the optimized AST for -e without parsing (default: out.mjsc)\n");
     fprintf(stderr, "  -q, --quiet    Suppress interpreter banners and summary\n");
+    fprintf(stderr, "      --mem-stats  Print AST arena usage by node kind (stderr)\n");
+    fprintf(stderr, "      --time-phases  Print wall time and peak RSS of each phase (stderr)\n");
+    fprintf(stderr, "      --stats    Count evaluated nodes, symtab lookups, scopes and calls (like -e, stderr)\n");
+    fprintf(stderr, "      --serve <socket>  Run as a daemon on a Unix socket\n");
+    fprintf(stderr, "      --workers <n>     Worker threads for --serve (default %d)\n",
+            SERVER_DEFAULT_WORKERS);
     fprintf(stderr, "  -h, --help     Show this help message\n");
 }
 
+/* AST 아레나 사용량 출력 (--mem-stats) */
+static void print_mem_stats(const Program *prog) {
+    size_t total = 0;
+    int nodes = 0;
+    fprintf(stderr, "=== AST Memory (arena) ===\n");
+    fprintf(stderr, "  %-14s %10s %12s\n", "kind", "count", "bytes");
+    for (int k = 0; k < AST_MEM_KIND_COUNT; ++k) {
+        if (prog->mem_nodes[k] == 0) continue;
+        fprintf(stderr, "  %-14s %10d %12zu\n", ast_mem_kind_name(k),
+                prog->mem_nodes[k], prog->mem_bytes[k]);
+        total += prog->mem_bytes[k];
+        nodes += prog->mem_nodes[k];
+    }
+    fprintf(stderr, "  %-14s %10d %12zu\n", "total", nodes, total);
+    fprintf(stderr, "  arena: %d chunk(s), %zu bytes reserved, %zu bytes used (with alignment)\n",
+            prog->arena.nchunks, prog->arena.bytes_reserved, prog->arena.bytes_used);
+}
+
 int main(int argc, char *argv[]) {
     const char *input_file = NULL;
-    const char *output_file = "out.s";
-    int mode_eval = 0;  /* 0: compile, 1: eval */
+    const char *output_file = NULL;     /* 기본: 컴파일은 out.s, --emit-ir는 stdout */
+    int mode_eval = 0;  /* 0: compile, 1: eval, 2: emit IR, 3: precompile */
     int quiet_mode = 0;
+    int engine = MINIJS_ENGINE_TREE;    /* -e 실행 엔진 (--vm, -j) */
+    int mem_stats = 0;  /* --mem-stats: AST 아레나 사용량 출력 */
+    const char *serve_socket = NULL;    /* --serve: 상주 서버 모드 */
+    int workers = 0;
+    int opt_level = X86_OPT_DEFAULT;    /* -O<n>: x86-64 코드 생성 수준 */
+    long tier_threshold = EVAL_TIER_DEFAULT_THRESHOLD;
+    int tier_stats = 0;                 /* --tier-stats: 승격 보고서 출력 */
+    int memoize = 0;                    /* --memoize: 순수 함수 메모이제이션 */
+    int memo_stats = 0;                 /* --memo-stats: 적중/실패 보고서 출력 */
+    int accum_report = 0;               /* --accum-report: 누산기 도입 보고서 출력 */
+    int opt_report = 0;                 /* --opt-report: 상수 접기/죽은 코드 제거 보고서 출력 */
+    int time_phases = 0;                /* --time-phases: 단계별 시간/최대 RSS 출력 */
+    int exec_stats = 0;                 /* --stats: 실행 카운터 출력 */
+    PhaseTimer phases;
+    ExecStats stats;
 
     /* 인자 파싱 */
     for (int i = 1; i < argc; i++) {
@@ -35,6 +86,65 @@ int main(int argc, char *argv[]) {
             return 0;
         } else if (strcmp(argv[i], "-e") == 0 || strcmp(argv[i], "--eval") == 0) {
             mode_eval = 1;
+        } else if (strcmp(argv[i], "--emit-ir") == 0) {
+            mode_eval = 2;
+        } else if (strcmp(argv[i], "--precompile") == 0) {
+            mode_eval = 3;
+        } else if (strcmp(argv[i], "--vm") == 0) {
+            engine = MINIJS_ENGINE_VM;
+        } else if (strcmp(argv[i], "--flat") == 0) {
+            engine = MINIJS_ENGINE_FLAT;
+        } else if (strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--jit") == 0) {
+            mode_eval = 1;
+            engine = MINIJS_ENGINE_JIT;
+        } else if (strcmp(argv[i], "--tier") == 0) {
+            mode_eval = 1;
+            engine = MINIJS_ENGINE_TIER;
+        } else if (strcmp(argv[i], "--tier-stats") == 0) {
+            mode_eval = 1;
+            engine = MINIJS_ENGINE_TIER;
+            tier_stats = 1;
+        } else if (strcmp(argv[i], "--memoize") == 0) {
+            mode_eval = 1;
+            memoize = 1;
+        } else if (strcmp(argv[i], "--memo-stats") == 0) {
+            mode_eval = 1;
+            memoize = 1;
+            memo_stats = 1;
+        } else if (strcmp(argv[i], "--accum-report") == 0) {
+            accum_report = 1;
+        } else if (strcmp(argv[i], "--opt-report") == 0) {
+            opt_report = 1;
+        } else if (strcmp(argv[i], "--tier-threshold") == 0) {
+            if (i + 1 < argc) {
+                tier_threshold = atol(argv[++i]);
+            } else {
+                fprintf(stderr, "Error: --tier-threshold requires an argument\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--mem-stats") == 0) {
+            mem_stats = 1;
+        } else if (strcmp(argv[i], "--time-phases") == 0) {
+            time_phases = 1;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            mode_eval = 1;
+            exec_stats = 1;
+        } else if (strcmp(argv[i], "--serve") == 0) {
+            if (i + 1 < argc) {
+                serve_socket = argv[++i];
+            } else {
+                fprintf(stderr, "Error: --serve requires a socket path\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--workers") == 0) {
+            if (i + 1 < argc) {
+                workers = atoi(argv[++i]);
+            } else {
+                fprintf(stderr, "Error: --workers requires an argument\n");
+                return 1;
+            }
+        } else if (strncmp(argv[i], "-O", 2) == 0) {
+            opt_level = argv[i][2] ? atoi(argv[i] + 2) : 1;
         } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--compile") == 0) {
             mode_eval = 0;
         } else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quiet") == 0) {
@@ -55,71 +165,198 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (serve_socket) {
+        return server_run(serve_socket, workers, opt_level);
+    }
+
+    MiniJSContext *ctx = minijs_context_new();
+    if (!ctx) {
+        fprintf(stderr, "Error: Cannot create context\n");
+        return 1;
+    }
+    ctx->opt_level = opt_level;
+    ctx->tier_threshold = tier_threshold;
+    if (tier_stats) ctx->tier_stats = stderr;
+    ctx->memoize = memoize;
+    if (memo_stats) ctx->memo_stats = stderr;
+    if (accum_report) ctx->accum_report = stderr;
+    if (opt_report) ctx->opt_report = stderr;
+    if (exec_stats) {
+        memset(&stats, 0, sizeof(stats));
+        ctx->stats = &stats;
+    }
+    if (time_phases) {
+        phase_timer_start(&phases);
+        ctx->phases = &phases;
+    }
+
+    /* 미리 컴파일한 파일 (.mjsc): 파싱 없이 평평한 AST 인터프리터로 실행 */
+    if (input_file && precompile_detect(input_file)) {
+        if (mode_eval != 1 || (engine != MINIJS_ENGINE_TREE && engine != MINIJS_ENGINE_FLAT)) {
+            fprintf(stderr, "Error: precompiled file '%s' can only be run with -e\n", input_file);
+            minijs_context_free(ctx);
+            return 1;
+        }
+        if (!quiet_mode) {
+            printf("=== Mini-JS Interpreter ===\n");
+        }
+        int result = 0;
+        const char *load_error = NULL;
+        if (minijs_eval_precompiled(ctx, input_file, &result, &load_error) != 0) {
+            fprintf(stderr, "Error: Cannot load precompiled file '%s': %s\n", input_file,
+                    load_error ? load_error : "");
+            minijs_context_free(ctx);
+            return 1;
+        }
+        if (memoize) {
+            fprintf(stderr, "Note: --memoize applies to the tree interpreter and --tier only\n");
+        }
+        if (!quiet_mode) {
+            printf("=== Return Value: %d ===\n", result);
+        }
+        if (exec_stats) {
+            fprintf(stderr, "Note: --stats counts nodes, lookups and calls in the tree interpreter and --tier only\n");
+            exec_stats_report(&stats, stderr);
+        }
+        minijs_context_free(ctx);
+        if (time_phases) {
+            phase_mark(&phases, "free");
+            phase_report(&phases, stderr);
+        }
+        return 0;
+    }
+
     /* 입력 파일 열기 */
+    FILE *in = stdin;
     if (input_file) {
-        yyin = fopen(input_file, "r");
-        if (!yyin) {
+        in = fopen(input_file, "r");
+        if (!in) {
             fprintf(stderr, "Error: Cannot open file '%s'\n", input_file);
+            minijs_context_free(ctx);
             return 1;
         }
-    } else {
-        yyin = stdin;
-        if (!quiet_mode) {
-            fprintf(stderr, "Reading from stdin...\n");
-        }
+    } else if (!quiet_mode) {
+        fprintf(stderr, "Reading from stdin...\n");
     }
 
     /* 파싱 */
-    g_program = new_program();
-    if (yyparse() != 0) {
+    int parse_result = minijs_parse_file(ctx, in);
+    if (in != stdin) fclose(in);
+    if (parse_result != 0) {
         fprintf(stderr, "Parse failed.\n");
-        if (input_file) fclose(yyin);
-        free_program(g_program);
-        g_program = NULL;
+        minijs_context_free(ctx);
         return 1;
     }
 
-    if (input_file) fclose(yyin);
-
-    if (!g_program || !g_program->items) {
+    Program *prog = ctx->program;
+    if (prog->empty) {
         fprintf(stderr, "No program parsed.\n");
-        if (g_program) free_program(g_program);
+        minijs_context_free(ctx);
         return 1;
     }
+    minijs_optimize(ctx);
 
-    if (mode_eval) {
+    if (mode_eval == 2) {
+        /* IR 출력 모드 */
+        FILE *out = output_file ? fopen(output_file, "w") : stdout;
+        if (!out) {
+            fprintf(stderr, "Error: Cannot open output file '%s'\n", output_file);
+            minijs_context_free(ctx);
+            return 1;
+        }
+        minijs_set_output_file(ctx, out);
+        const char *ir_error = NULL;
+        int built = minijs_emit_ir(ctx, &ir_error);
+        if (out != stdout) fclose(out);
+        minijs_set_output_file(ctx, stdout);
+        if (built != 0) {
+            fprintf(stderr, "Error: Cannot build IR: %s\n", ir_error ? ir_error : "");
+            if (output_file) remove(output_file);
+            minijs_context_free(ctx);
+            return 1;
+        }
+    } else if (mode_eval == 3) {
+        /* 미리 컴파일 모드 */
+        if (!output_file) output_file = "out.mjsc";
+        FILE *out = fopen(output_file, "wb");
+        if (!out) {
+            fprintf(stderr, "Error: Cannot open output file '%s'\n", output_file);
+            minijs_context_free(ctx);
+            return 1;
+        }
+        const char *precompile_error = NULL;
+        long written = minijs_precompile(ctx, out, &precompile_error);
+        fclose(out);
+        if (written < 0) {
+            fprintf(stderr, "Error: Cannot precompile: %s\n", precompile_error ? precompile_error : "");
+            remove(output_file);
+            minijs_context_free(ctx);
+            return 1;
+        }
+        printf("Precompiled AST written to '%s' (%ld bytes)\n", output_file, written);
+    } else if (mode_eval) {
         /* 인터프리터 모드 */
         if (!quiet_mode) {
             printf("=== Mini-JS Interpreter ===\n");
         }
-        int result = eval_program(g_program);
+        int used_engine = 0;
+        const char *engine_error = NULL;
+        int result = minijs_eval(ctx, engine, &used_engine, &engine_error);
+        int other_engine = engine == MINIJS_ENGINE_VM || engine == MINIJS_ENGINE_JIT ||
+                           engine == MINIJS_ENGINE_FLAT;
+        if (memoize && other_engine) {
+            fprintf(stderr, "Note: --memoize applies to the tree interpreter and --tier only\n");
+        }
+        if (exec_stats && other_engine) {
+            fprintf(stderr, "Note: --stats counts nodes, lookups and calls in the tree interpreter and --tier only\n");
+        }
+        if (engine != MINIJS_ENGINE_TREE && !used_engine) {
+            fprintf(stderr, "Note: %s unavailable (%s), used tree interpreter\n",
+                    engine == MINIJS_ENGINE_VM ? "bytecode VM" :
+                    engine == MINIJS_ENGINE_FLAT ? "flattened AST interpreter" : "JIT",
+                    engine_error ? engine_error : "");
+        }
         if (!quiet_mode) {
             printf("=== Return Value: %d ===\n", result);
         }
+        if (exec_stats) {
+            exec_stats_report(&stats, stderr);
+        }
     } else {
         /* 컴파일러 모드 */
+        if (!output_file) output_file = "out.s";
         FILE *out = fopen(output_file, "w");
         if (!out) {
             fprintf(stderr, "Error: Cannot open output file '%s'\n", output_file);
-            free_program(g_program);
+            minijs_context_free(ctx);
             return 1;
         }
 
-        /* stdout을 임시로 변경 */
-        FILE *old_stdout = stdout;
-        stdout = out;
-
-        gen_x86_program(g_program);
-
-        stdout = old_stdout;
+        minijs_set_output_file(ctx, out);
+        const char *compile_error = NULL;
+        int compiled = minijs_compile(ctx, &compile_error);
         fclose(out);
+        minijs_set_output_file(ctx, stdout);
 
+        if (compiled != 0) {
+            fprintf(stderr, "Error: Cannot compile: %s\n", compile_error ? compile_error : "");
+            remove(output_file);
+            minijs_context_free(ctx);
+            return 1;
+        }
         printf("Assembly written to '%s'\n", output_file);
     }
 
+    if (mem_stats) {
+        print_mem_stats(prog);
+    }
+
     /* 메모리 해제 */
-    free_program(g_program);
-    g_program = NULL;
+    minijs_context_free(ctx);
+    if (time_phases) {
+        phase_mark(&phases, "free");
+        phase_report(&phases, stderr);
+    }
 
     return 0;
 }
@@ -0,0 +1,231 @@
+/* 출력 대상 (파일 또는 버퍼)
+ * eval.c와 codegen_x86.c가 각자 static으로 갖고 있던 출력 버퍼를 통합
+ *
+ * console.log는 서식 문자열을 해석하지 않는 output_line_int/output_line_str로 출력
+ * (정수는 두 자리씩 표에서 복사해 뒤에서부터 채움)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#include "output.h"
+
+#define OUTPUT_GROW_INITIAL 4096
+
+void output_init_file(Output *out, FILE *file) {
+    out->kind = OUTPUT_FILE;
+    out->file = file;
+    out->buffer = NULL;     /* 첫 출력에서 할당 */
+    out->bufsize = 0;
+    out->pos = 0;
+    out->line_flush = 0;
+#ifndef _WIN32
+    out->line_flush = isatty(fileno(file ? file : stdout));
+#endif
+    out->writes = 0;
+    out->bytes = 0;
+    out->truncated = 0;
+}
+
+void output_init_buffer(Output *out, char *buffer, int bufsize) {
+    out->kind = OUTPUT_FIXED;
+    out->file = NULL;
+    out->buffer = buffer;
+    out->bufsize = bufsize;
+    out->pos = 0;
+    out->line_flush = 0;
+    out->writes = 0;
+    out->bytes = 0;
+    out->truncated = 0;
+    if (buffer && bufsize > 0) {
+        buffer[0] = '\0';
+    }
+}
+
+void output_init_grow(Output *out) {
+    out->kind = OUTPUT_GROW;
+    out->file = NULL;
+    out->buffer = (char *)malloc(OUTPUT_GROW_INITIAL);
+    if (!out->buffer) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    out->buffer[0] = '\0';
+    out->bufsize = OUTPUT_GROW_INITIAL;
+    out->pos = 0;
+    out->line_flush = 0;
+    out->writes = 0;
+    out->bytes = 0;
+    out->truncated = 0;
+}
+
+void output_flush(Output *out) {
+    if (out->kind != OUTPUT_FILE || out->pos == 0) return;
+    FILE *f = out->file ? out->file : stdout;
+    fwrite(out->buffer, 1, out->pos, f);
+    fflush(f);
+    out->pos = 0;
+}
+
+void output_release(Output *out) {
+    output_flush(out);
+    if (out->kind != OUTPUT_FIXED) free(out->buffer);
+    out->buffer = NULL;
+    out->bufsize = 0;
+    out->pos = 0;
+}
+
+/* len바이트를 더 쓸 자리 확보 (OUTPUT_GROW/OUTPUT_FILE 버퍼가 없으면 할당)
+ * - 반환: 쓸 수 있는 바이트 수 (OUTPUT_FIXED는 널 종료 자리를 뺀 남은 공간) */
+static int reserve(Output *out, int len) {
+    switch (out->kind) {
+        case OUTPUT_FILE:
+            if (!out->buffer) {
+                out->buffer = (char *)malloc(OUTPUT_FILE_BUFSIZE);
+                if (!out->buffer) {
+                    fprintf(stderr, "out of memory\n");
+                    exit(1);
+                }
+                out->bufsize = OUTPUT_FILE_BUFSIZE;
+            }
+            if (out->bufsize - out->pos < len) output_flush(out);
+            return out->bufsize - out->pos;
+        case OUTPUT_GROW:
+            if (out->bufsize - out->pos <= len) {
+                int size = out->bufsize;
+                while (size - out->pos <= len) size *= 2;
+                char *grown = (char *)realloc(out->buffer, size);
+                if (!grown) {
+                    fprintf(stderr, "out of memory\n");
+                    exit(1);
+                }
+                out->buffer = grown;
+                out->bufsize = size;
+            }
+            return out->bufsize - out->pos - 1;
+        case OUTPUT_FIXED:
+        default:
+            return out->bufsize - out->pos - 1;
+    }
+}
+
+/* 쓴 뒤 처리 (널 종료, 터미널 줄 flush) */
+static void wrote(Output *out, int len) {
+    out->pos += len;
+    out->bytes += len;
+    if (out->kind != OUTPUT_FILE) {
+        if (out->buffer && out->bufsize > 0) out->buffer[out->pos] = '\0';
+    } else if (out->line_flush && len > 0 && out->buffer[out->pos - 1] == '\n') {
+        output_flush(out);
+    }
+}
+
+/* data 출력 (writes는 호출자가 셈) */
+static void put(Output *out, const char *data, int len) {
+    if (out->kind == OUTPUT_FILE && len > OUTPUT_FILE_BUFSIZE) {
+        /* 버퍼보다 큰 출력은 바로 파일로 */
+        output_flush(out);
+        fwrite(data, 1, len, out->file ? out->file : stdout);
+        out->bytes += len;
+        return;
+    }
+    int room = reserve(out, len);
+    if (len > room) {               /* OUTPUT_FIXED만 해당 */
+        out->truncated = 1;
+        if (room <= 0) return;
+        len = room;
+    }
+    memcpy(out->buffer + out->pos, data, len);
+    wrote(out, len);
+}
+
+void output_write(Output *out, const char *data, int len) {
+    out->writes++;
+    put(out, data, len);
+}
+
+void output_vprintf(Output *out, const char *fmt, va_list args) {
+    out->writes++;
+    if (out->kind == OUTPUT_FIXED && out->bufsize - out->pos <= 0) return;
+    reserve(out, 1);
+
+    /* 남은 공간에 바로 서식화, 넘치면 공간을 확보해 다시 (OUTPUT_FIXED는 잘라냄) */
+    va_list copy;
+    va_copy(copy, args);
+    int avail = out->bufsize - out->pos;
+    int len = vsnprintf(out->buffer + out->pos, avail, fmt, args);
+    if (len >= 0 && len < avail) {
+        wrote(out, len);
+    } else if (len >= 0 && out->kind == OUTPUT_FIXED) {
+        wrote(out, avail - 1);
+        out->truncated = 1;
+    } else if (len >= 0 && out->kind == OUTPUT_FILE && len >= OUTPUT_FILE_BUFSIZE) {
+        output_flush(out);
+        vfprintf(out->file ? out->file : stdout, fmt, copy);
+        out->bytes += len;
+    } else if (len >= 0) {
+        reserve(out, len + 1);
+        vsnprintf(out->buffer + out->pos, len + 1, fmt, copy);
+        wrote(out, len);
+    }
+    va_end(copy);
+}
+
+void output_printf(Output *out, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    output_vprintf(out, fmt, args);
+    va_end(args);
+}
+
+/* 00 ~ 99 */
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+void output_line_int(Output *out, long value) {
+    char tmp[24];
+    char *end = tmp + sizeof(tmp);
+    char *p = end;
+    *--p = '\n';
+    /* 음수는 절댓값을 unsigned로 (LONG_MIN도 표현 가능) */
+    unsigned long v = value < 0 ? 0ul - (unsigned long)value : (unsigned long)value;
+    while (v >= 100) {
+        unsigned long q = v / 100;
+        const char *d = digit_pairs + (v - q * 100) * 2;
+        p -= 2;
+        p[0] = d[0];
+        p[1] = d[1];
+        v = q;
+    }
+    if (v >= 10) {
+        p -= 2;
+        p[0] = digit_pairs[v * 2];
+        p[1] = digit_pairs[v * 2 + 1];
+    } else {
+        *--p = (char)('0' + v);
+    }
+    if (value < 0) *--p = '-';
+    output_write(out, p, (int)(end - p));
+}
+
+void output_line_str(Output *out, const char *str) {
+    output_line_strn(out, str, (int)strlen(str));
+}
+
+void output_line_strn(Output *out, const char *str, int len) {
+    out->writes++;
+    put(out, str, len);
+    put(out, "\n", 1);
+}
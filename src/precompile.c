@@ -0,0 +1,578 @@
+/* 미리 컴파일한 AST 파일 (.mjsc)
+ * 파일 배치: 헤더 | exprs | calls | stmts | list | funcs | items | names | strings | text
+ * 각 구간은 8바이트 정렬, 헤더의 (offset, count)로 찾음
+ * 레코드는 flat.h 구조체 그대로 (패딩 바이트는 0), 이름은 strings 구간의 오프셋
+ * 문자열 리터럴은 소스에서 쓰인 바이트만 text 구간에 모음 (EXPR_STRING의 a는 text 오프셋)
+ * 읽을 때는 헤더와 구간 범위에 더해 레코드 안의 모든 인덱스를 한 번 훑어 검사 (validate)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ast.h"
+#include "flat.h"
+#include "resolve.h"
+#include "precompile.h"
+
+#define BYTE_ORDER_MARK 0x01020304u
+
+enum {
+    SEC_EXPRS,
+    SEC_CALLS,
+    SEC_STMTS,
+    SEC_LIST,
+    SEC_FUNCS,
+    SEC_ITEMS,
+    SEC_NAMES,      /* 이름별 strings 오프셋 (uint32_t) */
+    SEC_STRINGS,    /* NUL로 끝나는 문자열들 (count = 바이트 수) */
+    SEC_TEXT,       /* 문자열 리터럴 바이트 (count = 바이트 수) */
+    SEC_COUNT
+};
+
+typedef struct {
+    uint32_t offset;    /* 파일 처음부터 */
+    uint32_t count;     /* 레코드 수 */
+} Section;
+
+/* 파일 안의 함수 (FlatFunc에서 Function 포인터를 뺀 것) */
+typedef struct {
+    int32_t nparams;
+    int32_t nslots;
+    int32_t first;
+    int32_t count;
+} FileFunc;
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint8_t sizes[4];       /* sizeof FlatExpr, FlatStmt, FlatCall, FlatItem */
+    int32_t main_slots;
+    int32_t nglobals;
+    Section sections[SEC_COUNT];
+} Header;
+
+static const size_t record_size[SEC_COUNT] = {
+    sizeof(FlatExpr), sizeof(FlatCall), sizeof(FlatStmt), sizeof(int32_t),
+    sizeof(FileFunc), sizeof(FlatItem), sizeof(uint32_t), 1, 1
+};
+
+static void fill_sizes(uint8_t sizes[4]) {
+    sizes[0] = (uint8_t)sizeof(FlatExpr);
+    sizes[1] = (uint8_t)sizeof(FlatStmt);
+    sizes[2] = (uint8_t)sizeof(FlatCall);
+    sizes[3] = (uint8_t)sizeof(FlatItem);
+}
+
+static uint64_t align8(uint64_t n) {
+    return (n + 7) & ~(uint64_t)7;
+}
+
+/* === 쓰기 === */
+
+static void pad_to(FILE *out, uint64_t *pos, uint64_t target) {
+    while (*pos < target) {
+        fputc(0, out);
+        (*pos)++;
+    }
+}
+
+/* 패딩을 0으로 채운 복사본으로 씀 (쓰레기 바이트가 파일에 남지 않도록)
+ * 문자열 리터럴의 오프셋은 text 구간 기준으로 바꿈 (write_text와 같은 순서) */
+static void write_exprs(FILE *out, const FlatProgram *fp) {
+    int32_t text = 0;
+    for (int i = 0; i < fp->nexprs; ++i) {
+        FlatExpr x;
+        memset(&x, 0, sizeof(x));
+        x.kind = fp->exprs[i].kind;
+        x.op = fp->exprs[i].op;
+        x.a = fp->exprs[i].a;
+        x.b = fp->exprs[i].b;
+        if (x.kind == EXPR_STRING) {
+            x.a = text;
+            text += x.b;
+        }
+        fwrite(&x, sizeof(x), 1, out);
+    }
+}
+
+static uint64_t text_bytes(const FlatProgram *fp) {
+    uint64_t n = 0;
+    for (int i = 0; i < fp->nexprs; ++i) {
+        if (fp->exprs[i].kind == EXPR_STRING) n += (uint64_t)fp->exprs[i].b;
+    }
+    return n;
+}
+
+static void write_text(FILE *out, const FlatProgram *fp) {
+    for (int i = 0; i < fp->nexprs; ++i) {
+        if (fp->exprs[i].kind == EXPR_STRING) fwrite(fp->text + fp->exprs[i].a, 1, fp->exprs[i].b, out);
+    }
+}
+
+static void write_stmts(FILE *out, const FlatProgram *fp) {
+    for (int i = 0; i < fp->nstmts; ++i) {
+        FlatStmt x;
+        memset(&x, 0, sizeof(x));
+        x.kind = fp->stmts[i].kind;
+        x.op = fp->stmts[i].op;
+        x.a = fp->stmts[i].a;
+        x.b = fp->stmts[i].b;
+        x.c = fp->stmts[i].c;
+        x.d = fp->stmts[i].d;
+        fwrite(&x, sizeof(x), 1, out);
+    }
+}
+
+static void write_funcs(FILE *out, const FlatProgram *fp) {
+    for (int i = 0; i < fp->nfuncs; ++i) {
+        FileFunc f;
+        f.nparams = fp->funcs[i].nparams;
+        f.nslots = fp->funcs[i].nslots;
+        f.first = fp->funcs[i].first;
+        f.count = fp->funcs[i].count;
+        fwrite(&f, sizeof(f), 1, out);
+    }
+}
+
+static void write_items(FILE *out, const FlatProgram *fp) {
+    for (int i = 0; i < fp->nitems; ++i) {
+        FlatItem x;
+        memset(&x, 0, sizeof(x));
+        x.kind = fp->items[i].kind;
+        x.index = fp->items[i].index;
+        fwrite(&x, sizeof(x), 1, out);
+    }
+}
+
+static long write_flat(const FlatProgram *fp, FILE *out, const char **error) {
+    Header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, PRECOMPILE_MAGIC, 4);
+    h.version = PRECOMPILE_VERSION;
+    h.byte_order = BYTE_ORDER_MARK;
+    fill_sizes(h.sizes);
+    h.main_slots = fp->main_slots;
+    h.nglobals = fp->nglobals;
+
+    uint64_t nstrings = 0;
+    for (int i = 0; i < fp->nnames; ++i) nstrings += strlen(fp->names[i]) + 1;
+
+    const uint64_t counts[SEC_COUNT] = {
+        (uint64_t)fp->nexprs, (uint64_t)fp->ncalls, (uint64_t)fp->nstmts, (uint64_t)fp->nlist,
+        (uint64_t)fp->nfuncs, (uint64_t)fp->nitems, (uint64_t)fp->nnames, nstrings, text_bytes(fp)
+    };
+    uint64_t pos = align8(sizeof(Header));
+    for (int s = 0; s < SEC_COUNT; ++s) {
+        if (pos > UINT32_MAX || counts[s] > UINT32_MAX) {
+            if (error) *error = "program too large for the precompiled format";
+            return -1;
+        }
+        h.sections[s].offset = (uint32_t)pos;
+        h.sections[s].count = (uint32_t)counts[s];
+        pos = align8(pos + counts[s] * record_size[s]);
+    }
+    uint64_t total = pos;
+    if (total > UINT32_MAX) {
+        if (error) *error = "program too large for the precompiled format";
+        return -1;
+    }
+
+    pos = 0;
+    fwrite(&h, sizeof(h), 1, out);
+    pos += sizeof(h);
+    for (int s = 0; s < SEC_COUNT; ++s) {
+        pad_to(out, &pos, h.sections[s].offset);
+        switch (s) {
+            case SEC_EXPRS: write_exprs(out, fp); break;
+            case SEC_CALLS: fwrite(fp->calls, sizeof(FlatCall), fp->ncalls, out); break;
+            case SEC_STMTS: write_stmts(out, fp); break;
+            case SEC_LIST: fwrite(fp->list, sizeof(int32_t), fp->nlist, out); break;
+            case SEC_FUNCS: write_funcs(out, fp); break;
+            case SEC_ITEMS: write_items(out, fp); break;
+            case SEC_NAMES: {
+                uint32_t offset = 0;
+                for (int i = 0; i < fp->nnames; ++i) {
+                    fwrite(&offset, sizeof(offset), 1, out);
+                    offset += (uint32_t)strlen(fp->names[i]) + 1;
+                }
+                break;
+            }
+            case SEC_STRINGS:
+                for (int i = 0; i < fp->nnames; ++i) fwrite(fp->names[i], 1, strlen(fp->names[i]) + 1, out);
+                break;
+            case SEC_TEXT: write_text(out, fp); break;
+        }
+        pos += counts[s] * record_size[s];
+    }
+    pad_to(out, &pos, total);
+
+    if (ferror(out)) {
+        if (error) *error = "write failed";
+        return -1;
+    }
+    return (long)total;
+}
+
+long precompile_write(Program *prog, FILE *out, const char **error) {
+    if (error) *error = NULL;
+    if (!resolve_program(prog)) {
+        if (error) *error = prog->resolve_error;
+        return -1;
+    }
+    FlatProgram *fp = flat_build(prog);
+    if (!fp) {
+        if (error) *error = "out of memory";
+        return -1;
+    }
+    long written = write_flat(fp, out, error);
+    flat_free(fp);
+    return written;
+}
+
+/* === 읽기 === */
+
+/* precompile_load가 돌려주는 FlatProgram은 이 구조체의 첫 멤버 */
+typedef struct {
+    FlatProgram fp;
+    void *map;
+    size_t map_size;
+} Image;
+
+int precompile_detect(const char *path) {
+    /* 파이프/FIFO는 읽으면 소스가 사라지고 mmap도 안 되므로 일반 파일만 확인 */
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) return 0;
+    FILE *in = fopen(path, "rb");
+    if (!in) return 0;
+    char magic[4];
+    size_t n = fread(magic, 1, 4, in);
+    fclose(in);
+    return n == 4 && memcmp(magic, PRECOMPILE_MAGIC, 4) == 0;
+}
+
+static const char *check_header(const Header *h, size_t size) {
+    uint8_t sizes[4];
+    fill_sizes(sizes);
+    if (memcmp(h->magic, PRECOMPILE_MAGIC, 4) != 0) return "not a precompiled file";
+    if (h->version != PRECOMPILE_VERSION) return "unsupported format version";
+    if (h->byte_order != BYTE_ORDER_MARK || memcmp(h->sizes, sizes, 4) != 0) {
+        return "written by an incompatible build";
+    }
+    if (h->main_slots < 0 || h->nglobals < 0) return "corrupt header";
+    for (int s = 0; s < SEC_COUNT; ++s) {
+        const Section *sec = &h->sections[s];
+        if (sec->offset % 4 != 0 || sec->count > INT32_MAX ||
+            (uint64_t)sec->offset + (uint64_t)sec->count * record_size[s] > size) {
+            return "truncated or corrupt file";
+        }
+    }
+    return NULL;
+}
+
+/* === 검사 ===
+ * 레코드 안의 인덱스를 모두 한 번씩 확인 (실행기는 파일을 믿고 검사 없이 따라감)
+ * flat_build는 노드를 전위 순회 순서로 만들므로 같은 배열 안의 자식은 항상 부모보다 뒤
+ * → 문장, 식 순서로 앞에서부터 읽으며 자식에 부모의 프레임 크기를 넘겨주면 한 번에 끝남
+ * 모든 노드는 부모가 정확히 하나 (나무 구조): 순환이나 공유 노드로 실행이 끝나지 않거나
+ * 지수적으로 늘어나는 파일을 거부 */
+typedef struct {
+    const FlatProgram *fp;
+    uint32_t ntext;
+    int32_t *stmt_frame;    /* 문장이 실행되는 프레임의 슬롯 수, 부모가 없으면 -1 */
+    int32_t *expr_frame;
+    const char *bad;
+} Validator;
+
+static void invalid(Validator *v, const char *reason) {
+    if (!v->bad) v->bad = reason;
+}
+
+static int in_range(int64_t first, int64_t count, int64_t n) {
+    return first >= 0 && count >= 0 && first + count <= n;
+}
+
+static void check_name(Validator *v, int32_t name) {
+    if (name < 0 || name >= v->fp->nnames) invalid(v, "corrupt name index");
+}
+
+/* VarRefKind + 슬롯 */
+static void check_slot(Validator *v, int kind, int32_t slot, int32_t frame) {
+    switch (kind) {
+        case VAR_LOCAL:
+            if (slot < 0 || slot >= frame) invalid(v, "local slot out of range");
+            break;
+        case VAR_GLOBAL:
+            if (slot < 0 || slot >= v->fp->nglobals) invalid(v, "global slot out of range");
+            break;
+        case VAR_UNRESOLVED:
+        case VAR_UNDEFINED:
+            break;
+        default:
+            invalid(v, "corrupt variable reference");
+            break;
+    }
+}
+
+/* id를 parent(같은 배열, 없으면 -1)의 자식으로 (FLAT_NONE은 없는 자식) */
+static void claim(Validator *v, int32_t *frames, int32_t n, FlatId parent, FlatId id, int32_t frame) {
+    if (id == FLAT_NONE) return;
+    if (id <= parent || id >= n) {
+        invalid(v, "corrupt node index");
+    } else if (frames[id] >= 0) {
+        invalid(v, "node with more than one parent");
+    } else {
+        frames[id] = frame;
+    }
+}
+
+static void claim_stmt(Validator *v, FlatId parent, FlatId id, int32_t frame) {
+    claim(v, v->stmt_frame, v->fp->nstmts, parent, id, frame);
+}
+
+static void claim_expr(Validator *v, FlatId parent, FlatId id, int32_t frame) {
+    claim(v, v->expr_frame, v->fp->nexprs, parent, id, frame);
+}
+
+static void check_stmt(Validator *v, FlatId s) {
+    const FlatStmt *x = &v->fp->stmts[s];
+    int32_t frame = v->stmt_frame[s];
+    if (frame < 0) {
+        invalid(v, "unreachable statement");
+        return;
+    }
+    switch (x->kind) {
+        case STMT_EXPR:
+        case STMT_RETURN:
+        case STMT_PRINT:
+            claim_expr(v, -1, x->a, frame);
+            break;
+        case STMT_VARDECL:
+        case STMT_ASSIGN:
+            claim_expr(v, -1, x->a, frame);
+            check_slot(v, x->op, x->b, frame);
+            check_name(v, x->c);
+            break;
+        case STMT_IF:
+            claim_expr(v, -1, x->a, frame);
+            claim_stmt(v, s, x->b, frame);
+            claim_stmt(v, s, x->c, frame);
+            break;
+        case STMT_WHILE:
+            claim_expr(v, -1, x->a, frame);
+            claim_stmt(v, s, x->b, frame);
+            break;
+        case STMT_FOR:
+            claim_stmt(v, s, x->a, frame);
+            claim_expr(v, -1, x->b, frame);
+            claim_stmt(v, s, x->c, frame);
+            claim_stmt(v, s, x->d, frame);
+            break;
+        case STMT_BLOCK:
+            if (!in_range(x->a, x->b, v->fp->nlist)) {
+                invalid(v, "corrupt statement list");
+                break;
+            }
+            for (int32_t k = 0; k < x->b; ++k) claim_stmt(v, s, v->fp->list[x->a + k], frame);
+            break;
+        default:
+            invalid(v, "corrupt statement kind");
+            break;
+    }
+}
+
+static void check_expr(Validator *v, FlatId e) {
+    const FlatProgram *fp = v->fp;
+    const FlatExpr *x = &fp->exprs[e];
+    int32_t frame = v->expr_frame[e];
+    if (frame < 0) {
+        invalid(v, "unreachable expression");
+        return;
+    }
+    switch (x->kind) {
+        case EXPR_INT:
+            break;
+        case EXPR_STRING:
+            if (!in_range(x->a, x->b, v->ntext)) invalid(v, "corrupt string literal");
+            break;
+        case EXPR_VAR:
+            check_slot(v, x->op, x->a, frame);
+            check_name(v, x->b);
+            break;
+        case EXPR_BINOP:
+            if (x->op > BIN_OR) invalid(v, "corrupt operator");
+            claim_expr(v, e, x->a, frame);
+            claim_expr(v, e, x->b, frame);
+            break;
+        case EXPR_UNARY:
+            if (x->op > UNARY_NOT) invalid(v, "corrupt operator");
+            claim_expr(v, e, x->a, frame);
+            break;
+        case EXPR_CALL: {
+            if (x->a < 0 || x->a >= fp->ncalls) {
+                invalid(v, "corrupt call index");
+                break;
+            }
+            const FlatCall *c = &fp->calls[x->a];
+            check_name(v, c->name);
+            if (c->func < -1 || c->func >= fp->nfuncs) invalid(v, "corrupt call target");
+            if (!in_range(c->first, c->count, fp->nlist)) {
+                invalid(v, "corrupt argument list");
+                break;
+            }
+            for (int32_t k = 0; k < c->count; ++k) claim_expr(v, e, fp->list[c->first + k], frame);
+            break;
+        }
+        default:
+            invalid(v, "corrupt expression kind");
+            break;
+    }
+}
+
+/* 반환: 거부 이유, 문제가 없으면 NULL */
+static const char *validate(const FlatProgram *fp, uint32_t ntext) {
+    /* 전역과 top-level 지역 변수는 각각 선언문이 하나 이상 있음 */
+    if (fp->main_slots > fp->nstmts || fp->nglobals > fp->nstmts) return "corrupt header";
+
+    Validator v;
+    v.fp = fp;
+    v.ntext = ntext;
+    v.bad = NULL;
+    v.stmt_frame = (int32_t *)malloc(sizeof(int32_t) * (fp->nstmts + 1));
+    v.expr_frame = (int32_t *)malloc(sizeof(int32_t) * (fp->nexprs + 1));
+    memset(v.stmt_frame, 0xff, sizeof(int32_t) * (fp->nstmts + 1));
+    memset(v.expr_frame, 0xff, sizeof(int32_t) * (fp->nexprs + 1));
+
+    /* 뿌리: 함수 본문은 함수 프레임, top-level 문장은 main 프레임 */
+    for (int i = 0; i < fp->nfuncs && !v.bad; ++i) {
+        const FlatFunc *f = &fp->funcs[i];
+        if (f->nparams < 0 || f->nslots < f->nparams || f->nslots - f->nparams > fp->nstmts ||
+            !in_range(f->first, f->count, fp->nlist)) {
+            invalid(&v, "corrupt function table");
+            break;
+        }
+        for (int32_t k = 0; k < f->count; ++k) claim_stmt(&v, -1, fp->list[f->first + k], f->nslots);
+    }
+    for (int i = 0; i < fp->nitems && !v.bad; ++i) {
+        const FlatItem *item = &fp->items[i];
+        if (item->kind == ITEM_FUNCTION) {
+            if (item->index < 0 || item->index >= fp->nfuncs) invalid(&v, "corrupt item");
+        } else if (item->kind == ITEM_STMT) {
+            claim_stmt(&v, -1, item->index, fp->main_slots);
+        } else {
+            invalid(&v, "corrupt item");
+        }
+    }
+
+    /* 자식은 부모보다 뒤에 있으므로 차례로 읽을 때 프레임이 이미 정해져 있음 (식은 문장이 정함) */
+    for (FlatId s = 0; s < fp->nstmts && !v.bad; ++s) check_stmt(&v, s);
+    for (FlatId e = 0; e < fp->nexprs && !v.bad; ++e) check_expr(&v, e);
+
+    free(v.stmt_frame);
+    free(v.expr_frame);
+    return v.bad;
+}
+
+FlatProgram *precompile_load(const char *path, const char **error) {
+    if (error) *error = NULL;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        if (error) *error = "cannot open file";
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Header)) {
+        close(fd);
+        if (error) *error = "not a precompiled file";
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        if (error) *error = "mmap failed";
+        return NULL;
+    }
+
+    const unsigned char *base = (const unsigned char *)map;
+    const Header *h = (const Header *)map;
+    const char *bad = check_header(h, size);
+
+    /* 이름: strings 안의 오프셋 → 포인터 (문자열은 NUL로 끝나야 함) */
+    const Section *names = &h->sections[SEC_NAMES];
+    const Section *strings = &h->sections[SEC_STRINGS];
+    const char *strbase = (const char *)(base + strings->offset);
+    if (!bad && strings->count > 0 && strbase[strings->count - 1] != '\0') bad = "corrupt string table";
+    Image *img = NULL;
+    if (!bad) {
+        img = (Image *)calloc(1, sizeof(Image));
+        img->fp.names = (const char **)malloc(sizeof(char *) * (names->count + 1));
+        img->fp.funcs = (FlatFunc *)calloc(h->sections[SEC_FUNCS].count + 1, sizeof(FlatFunc));
+        const uint32_t *offsets = (const uint32_t *)(base + names->offset);
+        for (uint32_t i = 0; i < names->count && !bad; ++i) {
+            if (offsets[i] >= strings->count) bad = "corrupt string table";
+            else img->fp.names[i] = strbase + offsets[i];
+        }
+    }
+    if (bad) {
+        if (img) {
+            free(img->fp.names);
+            free(img->fp.funcs);
+            free(img);
+        }
+        munmap(map, size);
+        if (error) *error = bad;
+        return NULL;
+    }
+
+    FlatProgram *fp = &img->fp;
+    img->map = map;
+    img->map_size = size;
+    fp->exprs = (FlatExpr *)(base + h->sections[SEC_EXPRS].offset);
+    fp->nexprs = (int)h->sections[SEC_EXPRS].count;
+    fp->calls = (FlatCall *)(base + h->sections[SEC_CALLS].offset);
+    fp->ncalls = (int)h->sections[SEC_CALLS].count;
+    fp->stmts = (FlatStmt *)(base + h->sections[SEC_STMTS].offset);
+    fp->nstmts = (int)h->sections[SEC_STMTS].count;
+    fp->list = (int32_t *)(base + h->sections[SEC_LIST].offset);
+    fp->nlist = (int)h->sections[SEC_LIST].count;
+    fp->nnames = (int)names->count;
+    fp->text = (const char *)(base + h->sections[SEC_TEXT].offset);
+    fp->items = (FlatItem *)(base + h->sections[SEC_ITEMS].offset);
+    fp->nitems = (int)h->sections[SEC_ITEMS].count;
+
+    /* 함수 표는 Function 포인터 자리가 있으므로 복사 (func = NULL) */
+    const FileFunc *ff = (const FileFunc *)(base + h->sections[SEC_FUNCS].offset);
+    fp->nfuncs = (int)h->sections[SEC_FUNCS].count;
+    for (int i = 0; i < fp->nfuncs; ++i) {
+        fp->funcs[i].nparams = ff[i].nparams;
+        fp->funcs[i].nslots = ff[i].nslots;
+        fp->funcs[i].first = ff[i].first;
+        fp->funcs[i].count = ff[i].count;
+    }
+
+    fp->resolved = 1;
+    fp->main_slots = h->main_slots;
+    fp->nglobals = h->nglobals;
+
+    bad = validate(fp, h->sections[SEC_TEXT].count);
+    if (bad) {
+        precompile_unload(fp);
+        if (error) *error = bad;
+        return NULL;
+    }
+    return fp;
+}
+
+void precompile_unload(FlatProgram *fp) {
+    if (!fp) return;
+    Image *img = (Image *)fp;
+    free(fp->names);
+    free(fp->funcs);
+    munmap(img->map, img->map_size);
+    free(img);
+}
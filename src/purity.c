@@ -0,0 +1,110 @@
+/* 순수 함수 분석
+ * 모든 함수를 순수하다고 가정하고, 문장/표현식 검사에서 걸리거나
+ * 순수하지 않은 함수를 호출하는 함수를 더 바뀌지 않을 때까지 제외
+ * (서로 재귀하는 순수 함수도 순수로 남음)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "purity.h"
+
+/* === 검사 ===
+ * 반환: 순수하지 않으면 0 (호출 대상은 현재까지의 Function.pure로 판단) */
+
+static int expr_pure(const FuncTable *t, Expr *e) {
+    if (!e) return 1;
+    switch (e->kind) {
+        case EXPR_INT:
+        case EXPR_STRING:
+            return 1;
+        case EXPR_VAR:
+            return e->ref.kind == VAR_LOCAL;
+        case EXPR_BINOP:
+            return expr_pure(t, e->u.binop.lhs) && expr_pure(t, e->u.binop.rhs);
+        case EXPR_UNARY:
+            return expr_pure(t, e->u.unary.operand);
+        case EXPR_CALL: {
+            Function *callee = func_table_find(t, e->u.call.func_name);
+            if (!callee || !callee->pure) return 0;
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                if (!expr_pure(t, arg->expr)) return 0;
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int stmt_pure(const FuncTable *t, Stmt *s) {
+    if (!s) return 1;
+    switch (s->kind) {
+        case STMT_EXPR:
+        case STMT_RETURN:
+            return expr_pure(t, s->u.expr);
+        case STMT_PRINT:
+            return 0;
+        case STMT_VARDECL:
+            return s->ref.kind == VAR_LOCAL && expr_pure(t, s->u.vardecl.init_value);
+        case STMT_ASSIGN:
+            return s->ref.kind == VAR_LOCAL && expr_pure(t, s->u.assign.value);
+        case STMT_IF:
+            return expr_pure(t, s->u.if_stmt.cond) && stmt_pure(t, s->u.if_stmt.then_stmt) &&
+                   stmt_pure(t, s->u.if_stmt.else_stmt);
+        case STMT_WHILE:
+            return expr_pure(t, s->u.while_stmt.cond) && stmt_pure(t, s->u.while_stmt.body);
+        case STMT_FOR:
+            return stmt_pure(t, s->u.for_stmt.init) && expr_pure(t, s->u.for_stmt.cond) &&
+                   stmt_pure(t, s->u.for_stmt.step) && stmt_pure(t, s->u.for_stmt.body);
+        case STMT_BLOCK:
+            for (Stmt *b = s->u.block ? s->u.block->head : NULL; b; b = b->next) {
+                if (!stmt_pure(t, b)) return 0;
+            }
+            return 1;
+    }
+    return 0;
+}
+
+static int function_pure(const FuncTable *t, Function *f) {
+    for (Stmt *s = f->body ? f->body->head : NULL; s; s = s->next) {
+        if (!stmt_pure(t, s)) return 0;
+    }
+    return 1;
+}
+
+/* === 분석 === */
+int purity_analyze(Program *prog) {
+    if (!prog) return 0;
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_FUNCTION) item->u.function->pure = 0;
+    }
+    if (!prog->resolved || prog->nfunctions == 0) return 0;
+
+    /* 호출 대상 해석 (이름 → 첫 정의) */
+    FuncTable t;
+    func_table_build(&t, prog);
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_FUNCTION) item->u.function->pure = 1;
+    }
+
+    /* 더 이상 제외되는 함수가 없을 때까지 반복 */
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (Item *item = prog->items; item; item = item->next) {
+            if (item->kind != ITEM_FUNCTION) continue;
+            Function *f = item->u.function;
+            if (f->pure && !function_pure(&t, f)) {
+                f->pure = 0;
+                changed = 1;
+            }
+        }
+    }
+
+    int count = 0;
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_FUNCTION && item->u.function->pure) count++;
+    }
+    func_table_free(&t);
+    return count;
+}
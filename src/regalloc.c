@@ -0,0 +1,428 @@
+/* LIR 선형 스캔 레지스터 할당
+ * 위치(position): 함수 진입(매개변수 정의)은 0, 명령어 i의 사용은 2i+2, 정의는 2i+3
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "lir.h"
+#include "regalloc.h"
+
+const X86Reg x86_arg_regs[LIR_MAX_REG_PARAMS] = {
+    X86_RDI, X86_RSI, X86_RDX, X86_RCX, X86_R8, X86_R9
+};
+
+static const char *reg_names[X86_NREGS] = {
+    "%rax", "%rcx", "%rdx", "%rbx", "%rsp", "%rbp", "%rsi", "%rdi",
+    "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15"
+};
+
+static const char *reg_names32[X86_NREGS] = {
+    "%eax", "%ecx", "%edx", "%ebx", "%esp", "%ebp", "%esi", "%edi",
+    "%r8d", "%r9d", "%r10d", "%r11d", "%r12d", "%r13d", "%r14d", "%r15d"
+};
+
+static const char *reg_names8[X86_NREGS] = {
+    "%al", "%cl", "%dl", "%bl", "%spl", "%bpl", "%sil", "%dil",
+    "%r8b", "%r9b", "%r10b", "%r11b", "%r12b", "%r13b", "%r14b", "%r15b"
+};
+
+const char *x86_reg_name(int reg) { return reg_names[reg]; }
+const char *x86_reg_name32(int reg) { return reg_names32[reg]; }
+const char *x86_reg_name8(int reg) { return reg_names8[reg]; }
+
+int x86_is_callee_saved(int reg) {
+    return reg == X86_RBX || reg == X86_RBP || (reg >= X86_R12 && reg <= X86_R15);
+}
+
+/* 할당 가능한 레지스터 (앞쪽을 먼저 사용) */
+static const X86Reg caller_saved_pool[] = { X86_RSI, X86_RDI, X86_R8, X86_R9, X86_R10, X86_R11 };
+static const X86Reg callee_saved_pool[] = { X86_RBX, X86_R12, X86_R13, X86_R14, X86_R15 };
+#define NCALLER (int)(sizeof(caller_saved_pool) / sizeof(caller_saved_pool[0]))
+#define NCALLEE (int)(sizeof(callee_saved_pool) / sizeof(callee_saved_pool[0]))
+
+/* === 비트셋 === */
+typedef unsigned long Word;
+#define WORD_BITS (int)(sizeof(Word) * 8)
+
+static int bs_words(int n) { return (n + WORD_BITS - 1) / WORD_BITS; }
+static void bs_set(Word *bs, int i) { bs[i / WORD_BITS] |= (Word)1 << (i % WORD_BITS); }
+static int bs_test(const Word *bs, int i) { return (bs[i / WORD_BITS] >> (i % WORD_BITS)) & 1; }
+
+/* === 사용/정의 === */
+
+/* 명령어가 읽는 vreg들 (반환: 개수) */
+static int inst_uses(const LirInst *in, int *uses) {
+    int n = 0;
+    if (in->a.kind == LIR_VREG) uses[n++] = (int)in->a.value;
+    if (in->b.kind == LIR_VREG) uses[n++] = (int)in->b.value;
+    for (int i = 0; i < in->nargs; ++i) {
+        if (in->args[i].kind == LIR_VREG) uses[n++] = (int)in->args[i].value;
+    }
+    return n;
+}
+
+/* 호출 규약상 caller-saved 레지스터를 망가뜨리는 명령어
+ * (출력/에러는 레지스터를 보존하는 런타임 스텁을 거치므로 제외) */
+static int inst_clobbers(const LirInst *in) {
+    return in->op == LIR_CALL;
+}
+
+static int ends_block(LirOp op) {
+    return op == LIR_JMP || op == LIR_JCC || op == LIR_RET || op == LIR_CHKFN;
+}
+
+/* === 기본 블록 === */
+typedef struct {
+    int first, last;    /* 명령어 범위 [first, last] */
+    int succ[2];
+    int nsucc;
+    Word *use, *def, *live_in, *live_out;
+} Block;
+
+typedef struct {
+    int vreg;
+    int start, end;
+    int hint;           /* MOV로 연결된 vreg (같은 레지스터 선호), 없으면 -1 */
+    int crosses_call;
+} Interval;
+
+static int build_blocks(LirFunc *f, Block **out_blocks) {
+    int n = f->ncode;
+    char *leader = (char *)calloc(n + 1, 1);
+    int *label_block = (int *)malloc((f->nlabels + 1) * sizeof(int));
+    if (n > 0) leader[0] = 1;
+    for (int i = 0; i < n; ++i) {
+        if (f->code[i].op == LIR_LABEL) leader[i] = 1;
+        if (ends_block(f->code[i].op) && i + 1 < n) leader[i + 1] = 1;
+    }
+
+    int nblocks = 0;
+    for (int i = 0; i < n; ++i) nblocks += leader[i];
+    Block *blocks = (Block *)calloc(nblocks ? nblocks : 1, sizeof(Block));
+    int b = -1;
+    for (int i = 0; i < n; ++i) {
+        if (leader[i]) {
+            b++;
+            blocks[b].first = i;
+        }
+        blocks[b].last = i;
+        if (f->code[i].op == LIR_LABEL) label_block[f->code[i].label] = b;
+    }
+
+    for (b = 0; b < nblocks; ++b) {
+        const LirInst *last = &f->code[blocks[b].last];
+        Block *blk = &blocks[b];
+        switch (last->op) {
+            case LIR_JMP:
+                blk->succ[blk->nsucc++] = label_block[last->label];
+                break;
+            case LIR_JCC:
+            case LIR_CHKFN:
+                blk->succ[blk->nsucc++] = label_block[last->label];
+                if (b + 1 < nblocks) blk->succ[blk->nsucc++] = b + 1;
+                break;
+            case LIR_RET:
+                break;
+            default:
+                if (b + 1 < nblocks) blk->succ[blk->nsucc++] = b + 1;
+                break;
+        }
+    }
+
+    free(leader);
+    free(label_block);
+    *out_blocks = blocks;
+    return nblocks;
+}
+
+/* 블록별 use/def와 반복 생존 분석 */
+static void compute_liveness(LirFunc *f, Block *blocks, int nblocks, int words) {
+    int uses[LIR_MAX_ARGS + 2];
+    for (int b = 0; b < nblocks; ++b) {
+        Block *blk = &blocks[b];
+        blk->use = (Word *)calloc(words, sizeof(Word));
+        blk->def = (Word *)calloc(words, sizeof(Word));
+        blk->live_in = (Word *)calloc(words, sizeof(Word));
+        blk->live_out = (Word *)calloc(words, sizeof(Word));
+        for (int i = blk->first; i <= blk->last; ++i) {
+            const LirInst *in = &f->code[i];
+            int nu = inst_uses(in, uses);
+            for (int k = 0; k < nu; ++k) {
+                if (!bs_test(blk->def, uses[k])) bs_set(blk->use, uses[k]);
+            }
+            if (in->dst >= 0) bs_set(blk->def, in->dst);
+        }
+    }
+
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int b = nblocks - 1; b >= 0; --b) {
+            Block *blk = &blocks[b];
+            for (int w = 0; w < words; ++w) {
+                Word out = 0;
+                for (int s = 0; s < blk->nsucc; ++s) out |= blocks[blk->succ[s]].live_in[w];
+                Word in = blk->use[w] | (out & ~blk->def[w]);
+                if (out != blk->live_out[w] || in != blk->live_in[w]) {
+                    blk->live_out[w] = out;
+                    blk->live_in[w] = in;
+                    changed = 1;
+                }
+            }
+        }
+    }
+}
+
+#define USE_POS(i) (2 * (i) + 2)
+#define DEF_POS(i) (2 * (i) + 3)
+
+static void extend(Interval *iv, int pos) {
+    if (iv->start < 0 || pos < iv->start) iv->start = pos;
+    if (pos > iv->end) iv->end = pos;
+}
+
+static int cmp_start(const void *a, const void *b) {
+    const Interval *x = *(Interval * const *)a, *y = *(Interval * const *)b;
+    if (x->start != y->start) return x->start - y->start;
+    return x->vreg - y->vreg;
+}
+
+/* === 선형 스캔 === */
+
+typedef struct {
+    Interval **active;  /* end 오름차순 */
+    int nactive;
+    int reg_owner[X86_NREGS];   /* 레지스터를 가진 vreg, 없으면 -1 */
+    int *loc;
+    int nspills;
+} Scan;
+
+static void expire(Scan *sc, int pos) {
+    int k = 0;
+    for (int i = 0; i < sc->nactive; ++i) {
+        Interval *iv = sc->active[i];
+        if (iv->end < pos) {
+            sc->reg_owner[sc->loc[iv->vreg]] = -1;
+        } else {
+            sc->active[k++] = iv;
+        }
+    }
+    sc->nactive = k;
+}
+
+static void add_active(Scan *sc, Interval *iv, int reg) {
+    sc->loc[iv->vreg] = reg;
+    sc->reg_owner[reg] = iv->vreg;
+    int i = sc->nactive++;
+    while (i > 0 && sc->active[i - 1]->end > iv->end) {
+        sc->active[i] = sc->active[i - 1];
+        i--;
+    }
+    sc->active[i] = iv;
+}
+
+static int usable(const Interval *iv, int reg) {
+    return !iv->crosses_call || x86_is_callee_saved(reg);
+}
+
+static int pick_free(Scan *sc, const Interval *iv) {
+    /* MOV 힌트 vreg가 쓰던 레지스터가 비어 있으면 우선 */
+    if (iv->hint >= 0) {
+        int r = sc->loc[iv->hint];
+        if (r >= 0 && LIR_LOC_IS_REG(r) && sc->reg_owner[r] < 0 && usable(iv, r)) return r;
+    }
+    if (!iv->crosses_call) {
+        for (int i = 0; i < NCALLER; ++i) {
+            if (sc->reg_owner[caller_saved_pool[i]] < 0) return caller_saved_pool[i];
+        }
+    }
+    for (int i = 0; i < NCALLEE; ++i) {
+        if (sc->reg_owner[callee_saved_pool[i]] < 0) return callee_saved_pool[i];
+    }
+    return -1;
+}
+
+static void spill_at(Scan *sc, Interval *iv) {
+    /* 끝이 가장 먼 활성 구간 중 iv가 쓸 수 있는 레지스터를 가진 것 */
+    for (int i = sc->nactive - 1; i >= 0; --i) {
+        Interval *victim = sc->active[i];
+        int reg = sc->loc[victim->vreg];
+        if (!usable(iv, reg)) continue;
+        if (victim->end > iv->end) {
+            sc->loc[victim->vreg] = LIR_LOC_SPILL_BASE + sc->nspills++;
+            memmove(&sc->active[i], &sc->active[i + 1], (sc->nactive - i - 1) * sizeof(Interval *));
+            sc->nactive--;
+            sc->reg_owner[reg] = -1;
+            add_active(sc, iv, reg);
+            return;
+        }
+        break;
+    }
+    sc->loc[iv->vreg] = LIR_LOC_SPILL_BASE + sc->nspills++;
+}
+
+void regalloc_func(LirFunc *f) {
+    int nv = f->nvregs;
+    int words = bs_words(nv > 0 ? nv : 1);
+    Block *blocks;
+    int nblocks = build_blocks(f, &blocks);
+    compute_liveness(f, blocks, nblocks, words);
+
+    /* 생존 구간 */
+    Interval *ivs = (Interval *)malloc((nv > 0 ? nv : 1) * sizeof(Interval));
+    for (int v = 0; v < nv; ++v) {
+        ivs[v].vreg = v;
+        ivs[v].start = -1;
+        ivs[v].end = -1;
+        ivs[v].hint = -1;
+        ivs[v].crosses_call = 0;
+    }
+    /* 매개변수는 진입 시 정의, 정의 전에 읽힐 수 있는 vreg는 진입 시 0 */
+    free(f->zero_init);
+    f->zero_init = (int *)malloc((nv > 0 ? nv : 1) * sizeof(int));
+    f->nzero_init = 0;
+    for (int v = 0; v < f->nparams; ++v) extend(&ivs[v], 0);
+    if (nblocks > 0) {
+        for (int v = f->nparams; v < nv; ++v) {
+            if (bs_test(blocks[0].live_in, v)) {
+                extend(&ivs[v], 0);
+                f->zero_init[f->nzero_init++] = v;
+            }
+        }
+    }
+
+    int uses[LIR_MAX_ARGS + 2];
+    for (int b = 0; b < nblocks; ++b) {
+        Block *blk = &blocks[b];
+        int bstart = USE_POS(blk->first), bend = DEF_POS(blk->last);
+        for (int w = 0; w < words; ++w) {
+            for (Word bits = blk->live_in[w]; bits; bits &= bits - 1) {
+                extend(&ivs[w * WORD_BITS + __builtin_ctzl(bits)], bstart);
+            }
+            for (Word bits = blk->live_out[w]; bits; bits &= bits - 1) {
+                extend(&ivs[w * WORD_BITS + __builtin_ctzl(bits)], bend);
+            }
+        }
+        for (int i = blk->first; i <= blk->last; ++i) {
+            const LirInst *in = &f->code[i];
+            int nu = inst_uses(in, uses);
+            for (int k = 0; k < nu; ++k) extend(&ivs[uses[k]], USE_POS(i));
+            if (in->dst >= 0) extend(&ivs[in->dst], DEF_POS(i));
+            if (in->op == LIR_MOV && in->a.kind == LIR_VREG && in->dst >= 0) {
+                ivs[in->dst].hint = (int)in->a.value;
+            }
+        }
+    }
+
+    /* 호출 위치 (정렬됨): 구간 안쪽에 호출이 있으면 callee-saved 필요 */
+    int *calls = (int *)malloc((f->ncode + 1) * sizeof(int));
+    int ncalls = 0;
+    for (int i = 0; i < f->ncode; ++i) {
+        if (inst_clobbers(&f->code[i])) calls[ncalls++] = i;
+    }
+    Interval **order = (Interval **)malloc((nv > 0 ? nv : 1) * sizeof(Interval *));
+    int norder = 0;
+    for (int v = 0; v < nv; ++v) {
+        Interval *iv = &ivs[v];
+        if (iv->start < 0) continue;
+        int lo = 0, hi = ncalls;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (USE_POS(calls[mid]) > iv->start) hi = mid; else lo = mid + 1;
+        }
+        iv->crosses_call = lo < ncalls && DEF_POS(calls[lo]) < iv->end;
+        order[norder++] = iv;
+    }
+    qsort(order, norder, sizeof(Interval *), cmp_start);
+
+    Scan sc;
+    memset(&sc, 0, sizeof(sc));
+    sc.active = (Interval **)malloc((norder + 1) * sizeof(Interval *));
+    for (int r = 0; r < X86_NREGS; ++r) sc.reg_owner[r] = -1;
+    free(f->loc);
+    f->loc = (int *)malloc((nv > 0 ? nv : 1) * sizeof(int));
+    for (int v = 0; v < nv; ++v) f->loc[v] = -1;
+    sc.loc = f->loc;
+
+    for (int i = 0; i < norder; ++i) {
+        Interval *iv = order[i];
+        expire(&sc, iv->start);
+        int reg = pick_free(&sc, iv);
+        if (reg >= 0) {
+            add_active(&sc, iv, reg);
+        } else {
+            spill_at(&sc, iv);
+        }
+    }
+
+    /* 한 번도 쓰이지 않은 vreg도 유효한 위치를 갖도록 (코드 생성 단순화) */
+    f->callee_used = 0;
+    for (int v = 0; v < nv; ++v) {
+        if (f->loc[v] < 0) f->loc[v] = X86_RAX;
+        if (LIR_LOC_IS_REG(f->loc[v]) && x86_is_callee_saved(f->loc[v])) {
+            f->callee_used |= 1u << f->loc[v];
+        }
+    }
+    f->nspills = sc.nspills;
+
+    for (int b = 0; b < nblocks; ++b) {
+        free(blocks[b].use);
+        free(blocks[b].def);
+        free(blocks[b].live_in);
+        free(blocks[b].live_out);
+    }
+    free(blocks);
+    free(ivs);
+    free(calls);
+    free(order);
+    free(sc.active);
+}
+
+void regalloc_program(LirProgram *lp) {
+    regalloc_func(&lp->main);
+    for (int i = 0; i < lp->nfuncs; ++i) {
+        regalloc_func(&lp->funcs[i]);
+    }
+}
+
+/* === 병렬 이동 === */
+
+int regalloc_sequence_moves(const RegMove *moves, int n, int scratch, RegMove *out) {
+    RegMove buf[LIR_MAX_ARGS];
+    RegMove *pending = n <= LIR_MAX_ARGS ? buf : (RegMove *)malloc(n * sizeof(RegMove));
+    int np = 0;
+    int nout = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!moves[i].src_imm && moves[i].src == moves[i].dst) continue;
+        pending[np++] = moves[i];
+    }
+
+    while (np > 0) {
+        int progress = 0;
+        for (int i = 0; i < np; ++i) {
+            /* 다른 이동이 아직 읽어야 하는 곳에는 쓰지 않음 */
+            int blocked = 0;
+            for (int k = 0; k < np; ++k) {
+                if (k != i && !pending[k].src_imm && pending[k].src == pending[i].dst) {
+                    blocked = 1;
+                    break;
+                }
+            }
+            if (blocked) continue;
+            out[nout++] = pending[i];
+            pending[i] = pending[--np];
+            progress = 1;
+            i--;
+        }
+        if (progress || np == 0) continue;
+
+        /* 순환: 첫 이동의 목적지 값을 scratch로 옮겨 두고 원본을 바꿈 */
+        int d = pending[0].dst;
+        RegMove save = { scratch, d, 0, 0 };
+        out[nout++] = save;
+        for (int k = 0; k < np; ++k) {
+            if (!pending[k].src_imm && pending[k].src == d) pending[k].src = scratch;
+        }
+    }
+    if (pending != buf) free(pending);
+    return nout;
+}
@@ -0,0 +1,857 @@
+/* 변수 슬롯 해석 (resolver)
+ * eval.c와 vm.c가 실행 중에 이름을 조회하지 않도록
+ * 변수 참조마다 (프레임, 슬롯)을 미리 계산해 AST에 기록
+ *
+ * eval의 심볼 테이블은 호출 스택 전체를 검색하는 동적 스코프이므로,
+ * 함수 안의 자유 이름이 호출자의 지역 변수로 해석될 수 있는 프로그램은
+ * 해석을 포기하고 심볼 테이블 경로로 실행
+ * 전역에 대한 대입도 그 시점에 전역이 정의돼 있지 않으면 지역 변수를 만들므로,
+ * 전역이 확실히 정의되기 전에 실행될 수 있는 대입이 있어도 포기
+ * (읽기는 실행기가 전역별 정의 여부를 확인해 같은 에러를 냄)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "resolve.h"
+
+#define MAX_CALL_ARGS 16        /* eval_call과 동일한 인자 개수 제한 */
+
+/* === 분석 자료구조 === */
+
+/* 이름 집합 (작을 때는 선형 검색, 커지면 해시 인덱스)
+ * 이름은 모두 같은 Program에 인터닝된 포인터이므로 포인터로 비교/해시 */
+#define NAMESET_LINEAR_MAX 8
+
+typedef struct {
+    const char **names;
+    int count;
+    int cap;
+    int *index;         /* 오픈 어드레싱: names 인덱스, 빈 칸은 -1 */
+    int index_cap;      /* 0 또는 2의 거듭제곱 */
+} NameSet;
+
+static void nameset_index_insert(NameSet *s, int id) {
+    unsigned int i = INTERN_HASH(s->names[id]) & (s->index_cap - 1);
+    while (s->index[i] >= 0) i = (i + 1) & (s->index_cap - 1);
+    s->index[i] = id;
+}
+
+static int nameset_find(const NameSet *s, const char *name) {
+    if (s->index_cap == 0) {
+        for (int i = 0; i < s->count; ++i) {
+            if (s->names[i] == name) return i;
+        }
+        return -1;
+    }
+    unsigned int i = INTERN_HASH(name) & (s->index_cap - 1);
+    while (s->index[i] >= 0) {
+        if (s->names[s->index[i]] == name) return s->index[i];
+        i = (i + 1) & (s->index_cap - 1);
+    }
+    return -1;
+}
+
+/* 이름 추가, 반환: 이름의 인덱스 (이미 있으면 기존 인덱스) */
+static int nameset_add(NameSet *s, const char *name) {
+    int found = nameset_find(s, name);
+    if (found >= 0) return found;
+    if (s->count == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 8;
+        s->names = (const char **)realloc(s->names, s->cap * sizeof(const char *));
+    }
+    int id = s->count++;
+    s->names[id] = name;
+
+    if (s->count > NAMESET_LINEAR_MAX && s->count * 2 > s->index_cap) {
+        /* 적재율 1/2 유지 */
+        s->index_cap = s->index_cap ? s->index_cap * 2 : 4 * NAMESET_LINEAR_MAX;
+        s->index = (int *)realloc(s->index, s->index_cap * sizeof(int));
+        memset(s->index, 0xff, s->index_cap * sizeof(int));
+        for (int i = 0; i < s->count; ++i) nameset_index_insert(s, i);
+    } else if (s->index_cap > 0) {
+        nameset_index_insert(s, id);
+    }
+    return id;
+}
+
+static void nameset_free(NameSet *s) {
+    free(s->names);
+    free(s->index);
+}
+
+typedef struct {
+    int *items;
+    int count;
+    int cap;
+} IntList;
+
+/* 중복은 허용 (도달 가능성 계산에서 방문 표시로 걸러짐) */
+static void intlist_add(IntList *l, int v) {
+    if (l->count == l->cap) {
+        l->cap = l->cap ? l->cap * 2 : 8;
+        l->items = (int *)realloc(l->items, l->cap * sizeof(int));
+    }
+    l->items[l->count++] = v;
+}
+
+/* 함수별 분석 정보 */
+typedef struct {
+    Function *func;         /* 같은 이름의 첫 정의 (eval의 find_function과 동일) */
+    int nparams;
+    NameSet binders;        /* 이 함수가 지역으로 만들 수 있는 이름 */
+    IntList callees;        /* 직접 호출하는 함수 */
+    IntList global_writes;  /* 전역 슬롯으로 해석한 대입 */
+    int first_call;         /* top-level에서 처음 호출될 수 있는 시각 (0: 호출되지 않음) */
+} FuncInfo;
+
+typedef struct {
+    const char *name;
+    int slot;
+} Local;
+
+typedef struct {
+    Program *prog;
+
+    FuncInfo *funcs;
+    int nfuncs;
+    NameSet func_names;         /* funcs와 같은 순서 */
+    NameSet globals;            /* 스코프 0 이름 */
+    NameSet tl_binders;         /* top-level 블록 안에서 생기는 이름 */
+    IntList tl_callees;         /* top-level 블록 안에서 호출하는 함수 */
+
+    /* 이름 → 그 이름을 지역으로 만드는 함수들 */
+    NameSet binder_names;
+    IntList *binder_funcs;
+    int binder_funcs_cap;
+
+    /* 이름 → 그 이름의 지역 변수를 가진 채 호출될 수 있는 함수 (지연 계산) */
+    NameSet capture_names;
+    unsigned char **capture_reach;
+    int capture_reach_cap;
+    unsigned char *gstate;      /* top-level 순차 정의 상태: 0 없음, 1 정의됨, 2 조건부 */
+    int *gdef_time;             /* 전역이 확실히 정의된 시각 (0: 아직) */
+    int clock;                  /* top-level 해석 순서 = 실행 순서 (정의/호출마다 증가) */
+    int *call_stack;            /* first_call 표시용 */
+
+    /* 현재 해석 단위 */
+    int cur_func;               /* -1: top-level */
+    Local *locals;
+    int nlocals;
+    int locals_cap;
+    int scope_base;
+    int scope_depth;
+    int max_slots;
+
+    const char *error;
+} Resolver;
+
+static void fail(Resolver *r, const char *reason) {
+    if (!r->error) r->error = reason;
+}
+
+static int find_func(Resolver *r, const char *name) {
+    return nameset_find(&r->func_names, name);
+}
+
+/* === 사전 분석 === */
+
+/* 스코프 0에서 생기는 이름 (top-level 문장, 블록이 아닌 if/while 본문) */
+static void collect_globals(Resolver *r, Stmt *s) {
+    if (!s) return;
+    switch (s->kind) {
+        case STMT_VARDECL:
+            nameset_add(&r->globals, s->u.vardecl.var_name);
+            break;
+        case STMT_ASSIGN:
+            nameset_add(&r->globals, s->u.assign.var_name);
+            break;
+        case STMT_IF:
+            collect_globals(r, s->u.if_stmt.then_stmt);
+            collect_globals(r, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            collect_globals(r, s->u.while_stmt.body);
+            break;
+        default:
+            break;
+    }
+}
+
+static void scan_expr(Resolver *r, Expr *e, IntList *calls) {
+    if (!e) return;
+    switch (e->kind) {
+        case EXPR_BINOP:
+            scan_expr(r, e->u.binop.lhs, calls);
+            scan_expr(r, e->u.binop.rhs, calls);
+            break;
+        case EXPR_UNARY:
+            scan_expr(r, e->u.unary.operand, calls);
+            break;
+        case EXPR_CALL: {
+            int fi = find_func(r, e->u.call.func_name);
+            if (fi >= 0) intlist_add(calls, fi);
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                scan_expr(r, arg->expr, calls);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/* 지역 이름과 호출 대상 수집 (전역에 대한 대입은 지역을 만들지 않음) */
+static void scan_stmt(Resolver *r, Stmt *s, NameSet *binders, IntList *calls) {
+    if (!s) return;
+    switch (s->kind) {
+        case STMT_VARDECL:
+            nameset_add(binders, s->u.vardecl.var_name);
+            scan_expr(r, s->u.vardecl.init_value, calls);
+            break;
+        case STMT_ASSIGN:
+            if (nameset_find(&r->globals, s->u.assign.var_name) < 0) {
+                nameset_add(binders, s->u.assign.var_name);
+            }
+            scan_expr(r, s->u.assign.value, calls);
+            break;
+        case STMT_EXPR:
+        case STMT_RETURN:
+        case STMT_PRINT:
+            scan_expr(r, s->u.expr, calls);
+            break;
+        case STMT_IF:
+            scan_expr(r, s->u.if_stmt.cond, calls);
+            scan_stmt(r, s->u.if_stmt.then_stmt, binders, calls);
+            scan_stmt(r, s->u.if_stmt.else_stmt, binders, calls);
+            break;
+        case STMT_WHILE:
+            scan_expr(r, s->u.while_stmt.cond, calls);
+            scan_stmt(r, s->u.while_stmt.body, binders, calls);
+            break;
+        case STMT_FOR:
+            scan_stmt(r, s->u.for_stmt.init, binders, calls);
+            scan_expr(r, s->u.for_stmt.cond, calls);
+            scan_stmt(r, s->u.for_stmt.step, binders, calls);
+            scan_stmt(r, s->u.for_stmt.body, binders, calls);
+            break;
+        case STMT_BLOCK:
+            if (s->u.block) {
+                for (Stmt *cur = s->u.block->head; cur; cur = cur->next) {
+                    scan_stmt(r, cur, binders, calls);
+                }
+            }
+            break;
+    }
+}
+
+/* top-level 문장 중 스코프가 열리는 부분만 tl_binders/tl_callees로 수집 */
+static void scan_toplevel_stmt(Resolver *r, Stmt *s) {
+    if (!s) return;
+    switch (s->kind) {
+        case STMT_IF:
+            scan_toplevel_stmt(r, s->u.if_stmt.then_stmt);
+            scan_toplevel_stmt(r, s->u.if_stmt.else_stmt);
+            break;
+        case STMT_WHILE:
+            scan_toplevel_stmt(r, s->u.while_stmt.body);
+            break;
+        case STMT_FOR:
+        case STMT_BLOCK:
+            scan_stmt(r, s, &r->tl_binders, &r->tl_callees);
+            break;
+        default:
+            break;
+    }
+}
+
+/* from에서 호출로 도달 가능한 함수를 reach에 표시 (명시적 스택) */
+static void mark_reach(Resolver *r, unsigned char *reach, const IntList *from, int *stack) {
+    int sp = 0;
+    for (int i = 0; i < from->count; ++i) {
+        if (!reach[from->items[i]]) {
+            reach[from->items[i]] = 1;
+            stack[sp++] = from->items[i];
+        }
+    }
+    while (sp > 0) {
+        const IntList *callees = &r->funcs[stack[--sp]].callees;
+        for (int i = 0; i < callees->count; ++i) {
+            int f = callees->items[i];
+            if (!reach[f]) {
+                reach[f] = 1;
+                stack[sp++] = f;
+            }
+        }
+    }
+}
+
+/* top-level 호출: fi와 fi에서 도달 가능한 함수가 아직 호출된 적 없으면 지금 처음 호출될 수 있음
+ * (이미 표시된 함수에서 닿는 함수는 그때 함께 표시됐으므로 더 따라가지 않음) */
+static void mark_first_call(Resolver *r, int fi) {
+    if (r->funcs[fi].first_call) return;
+    int now = ++r->clock;
+    int sp = 0;
+    r->funcs[fi].first_call = now;
+    r->call_stack[sp++] = fi;
+    while (sp > 0) {
+        const IntList *callees = &r->funcs[r->call_stack[--sp]].callees;
+        for (int i = 0; i < callees->count; ++i) {
+            int f = callees->items[i];
+            if (!r->funcs[f].first_call) {
+                r->funcs[f].first_call = now;
+                r->call_stack[sp++] = f;
+            }
+        }
+    }
+}
+
+/* 이름을 지역으로 가진 함수(또는 top-level 블록)에서 도달 가능한 함수 집합 */
+static const unsigned char *capture_set(Resolver *r, const char *name) {
+    int id = nameset_find(&r->capture_names, name);
+    if (id >= 0) return r->capture_reach[id];
+
+    unsigned char *reach = (unsigned char *)calloc(r->nfuncs + 1, 1);
+    int *stack = (int *)malloc((r->nfuncs + 1) * sizeof(int));
+    int b = nameset_find(&r->binder_names, name);
+    if (b >= 0) {
+        const IntList *binders = &r->binder_funcs[b];
+        for (int i = 0; i < binders->count; ++i) {
+            mark_reach(r, reach, &r->funcs[binders->items[i]].callees, stack);
+        }
+    }
+    if (nameset_find(&r->tl_binders, name) >= 0) {
+        mark_reach(r, reach, &r->tl_callees, stack);
+    }
+    free(stack);
+
+    id = nameset_add(&r->capture_names, name);
+    if (id >= r->capture_reach_cap) {
+        r->capture_reach_cap = r->capture_reach_cap ? r->capture_reach_cap * 2 : 8;
+        r->capture_reach = (unsigned char **)realloc(r->capture_reach,
+                                                     r->capture_reach_cap * sizeof(unsigned char *));
+    }
+    r->capture_reach[id] = reach;
+    return reach;
+}
+
+/* 함수 g 안의 자유 이름이 호출자의 지역 변수로 해석될 수 있는지 */
+static int may_capture(Resolver *r, const char *name, int g) {
+    return capture_set(r, name)[g];
+}
+
+static void analyze(Resolver *r) {
+    /* 함수 테이블 (같은 이름은 첫 정의만 사용) */
+    int cap = 0;
+    for (Item *item = r->prog->items; item; item = item->next) {
+        if (item->kind != ITEM_FUNCTION || find_func(r, item->u.function->name) >= 0) {
+            continue;
+        }
+        if (r->nfuncs == cap) {
+            cap = cap ? cap * 2 : 16;
+            r->funcs = (FuncInfo *)realloc(r->funcs, cap * sizeof(FuncInfo));
+        }
+        nameset_add(&r->func_names, item->u.function->name);
+        FuncInfo *fi = &r->funcs[r->nfuncs++];
+        memset(fi, 0, sizeof(*fi));
+        fi->func = item->u.function;
+        for (Param *p = fi->func->params ? fi->func->params->head : NULL; p; p = p->next) {
+            fi->nparams++;
+        }
+    }
+
+    for (Item *item = r->prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) collect_globals(r, item->u.stmt);
+    }
+    r->gstate = (unsigned char *)calloc(r->globals.count + 1, 1);
+    r->gdef_time = (int *)calloc(r->globals.count + 1, sizeof(int));
+    r->call_stack = (int *)malloc((r->nfuncs + 1) * sizeof(int));
+
+    /* 함수별 지역 이름과 호출 그래프 */
+    for (int i = 0; i < r->nfuncs; ++i) {
+        Function *f = r->funcs[i].func;
+        for (Param *p = f->params ? f->params->head : NULL; p; p = p->next) {
+            nameset_add(&r->funcs[i].binders, p->name);
+        }
+        if (f->body) {
+            for (Stmt *s = f->body->head; s; s = s->next) {
+                scan_stmt(r, s, &r->funcs[i].binders, &r->funcs[i].callees);
+            }
+        }
+
+        const NameSet *binders = &r->funcs[i].binders;
+        for (int k = 0; k < binders->count; ++k) {
+            int b = nameset_add(&r->binder_names, binders->names[k]);
+            if (b >= r->binder_funcs_cap) {
+                int old_cap = r->binder_funcs_cap;
+                r->binder_funcs_cap = old_cap ? old_cap * 2 : 16;
+                r->binder_funcs = (IntList *)realloc(r->binder_funcs,
+                                                     r->binder_funcs_cap * sizeof(IntList));
+                memset(r->binder_funcs + old_cap, 0,
+                       (r->binder_funcs_cap - old_cap) * sizeof(IntList));
+            }
+            intlist_add(&r->binder_funcs[b], i);
+        }
+    }
+    for (Item *item = r->prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) scan_toplevel_stmt(r, item->u.stmt);
+    }
+}
+
+/* === 스코프 === */
+
+static int find_local(Resolver *r, const char *name) {
+    for (int i = r->nlocals - 1; i >= 0; --i) {
+        if (r->locals[i].name == name) return r->locals[i].slot;
+    }
+    return -1;
+}
+
+static int find_local_in_scope(Resolver *r, const char *name) {
+    for (int i = r->nlocals - 1; i >= r->scope_base; --i) {
+        if (r->locals[i].name == name) return r->locals[i].slot;
+    }
+    return -1;
+}
+
+static int add_local(Resolver *r, const char *name) {
+    if (r->nlocals == r->locals_cap) {
+        r->locals_cap = r->locals_cap ? r->locals_cap * 2 : 16;
+        r->locals = (Local *)realloc(r->locals, r->locals_cap * sizeof(Local));
+    }
+    /* 슬롯 번호 == 지역 변수 인덱스 (스코프가 닫히면 재사용) */
+    int slot = r->nlocals;
+    r->locals[r->nlocals].name = name;
+    r->locals[r->nlocals].slot = slot;
+    r->nlocals++;
+    if (r->nlocals > r->max_slots) r->max_slots = r->nlocals;
+    return slot;
+}
+
+static int scope_enter(Resolver *r) {
+    int saved = r->scope_base;
+    r->scope_base = r->nlocals;
+    r->scope_depth++;
+    return saved;
+}
+
+static void scope_leave(Resolver *r, int saved) {
+    r->nlocals = r->scope_base;
+    r->scope_base = saved;
+    r->scope_depth--;
+}
+
+static int at_global_scope(Resolver *r) {
+    return r->cur_func < 0 && r->scope_depth == 0;
+}
+
+static void set_ref(VarRef *ref, VarRefKind kind, int slot) {
+    ref->kind = kind;
+    ref->slot = slot;
+}
+
+/* === 표현식 해석 === */
+
+static void resolve_expr(Resolver *r, Expr *e) {
+    if (!e || r->error) return;
+
+    switch (e->kind) {
+        case EXPR_VAR: {
+            const char *name = e->u.var_name;
+            int slot = find_local(r, name);
+            if (slot >= 0) {
+                set_ref(&e->ref, VAR_LOCAL, slot);
+                break;
+            }
+            if (r->cur_func >= 0 && may_capture(r, name, r->cur_func)) {
+                fail(r, "function reads a caller's local variable (dynamic scope)");
+                break;
+            }
+            int g = nameset_find(&r->globals, name);
+            if (g >= 0) {
+                set_ref(&e->ref, VAR_GLOBAL, g);
+            } else {
+                set_ref(&e->ref, VAR_UNDEFINED, -1);
+            }
+            break;
+        }
+
+        case EXPR_BINOP:
+            resolve_expr(r, e->u.binop.lhs);
+            resolve_expr(r, e->u.binop.rhs);
+            break;
+
+        case EXPR_CALL: {
+            /* eval_call과 같이 정의되지 않은 함수의 인자와 제한을 넘는 인자는 평가되지 않음 */
+            int fi = find_func(r, e->u.call.func_name);
+            if (fi < 0) break;
+            int argc = 0;
+            for (ExprList *arg = e->u.call.args; arg && argc < MAX_CALL_ARGS; arg = arg->next) {
+                resolve_expr(r, arg->expr);
+                argc++;
+            }
+            /* 빠진 매개변수는 eval_call이 선언하지 않으므로 호출자 스코프에서 조회됨 */
+            if (fi >= 0 && argc < r->funcs[fi].nparams) {
+                fail(r, "call passes fewer arguments than parameters");
+            }
+            if (r->cur_func < 0) mark_first_call(r, fi);
+            break;
+        }
+
+        case EXPR_UNARY:
+            resolve_expr(r, e->u.unary.operand);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* === 문장 해석 === */
+
+/* 새 지역 변수 (cond: if/while/for 본문에 블록 없이 바로 온 문장) */
+static void bind_new_local(Resolver *r, VarRef *ref, const char *name, int cond) {
+    if (cond) {
+        fail(r, "conditional declaration outside a block");
+        return;
+    }
+    set_ref(ref, VAR_LOCAL, add_local(r, name));
+}
+
+static void bind_global(Resolver *r, VarRef *ref, int g, int cond) {
+    set_ref(ref, VAR_GLOBAL, g);
+    if (at_global_scope(r) && r->gstate[g] != 1) {
+        r->gstate[g] = cond ? 2 : 1;
+        if (!cond) r->gdef_time[g] = ++r->clock;
+    }
+}
+
+static void resolve_stmt(Resolver *r, Stmt *s, int cond);
+
+static void resolve_body(Resolver *r, Stmt *s) {
+    resolve_stmt(r, s, s && s->kind != STMT_BLOCK);
+}
+
+static void resolve_stmt(Resolver *r, Stmt *s, int cond) {
+    if (!s || r->error) return;
+
+    switch (s->kind) {
+        case STMT_VARDECL: {
+            const char *name = s->u.vardecl.var_name;
+            resolve_expr(r, s->u.vardecl.init_value);
+            if (at_global_scope(r)) {
+                bind_global(r, &s->ref, nameset_find(&r->globals, name), cond);
+            } else {
+                int slot = find_local_in_scope(r, name);
+                if (slot >= 0) {
+                    set_ref(&s->ref, VAR_LOCAL, slot);
+                } else {
+                    bind_new_local(r, &s->ref, name, cond);
+                }
+            }
+            break;
+        }
+
+        case STMT_ASSIGN: {
+            const char *name = s->u.assign.var_name;
+            resolve_expr(r, s->u.assign.value);
+            int slot = find_local(r, name);
+            if (slot >= 0) {
+                set_ref(&s->ref, VAR_LOCAL, slot);
+                break;
+            }
+            int g = nameset_find(&r->globals, name);
+            if (at_global_scope(r)) {
+                bind_global(r, &s->ref, g, cond);
+            } else if (r->cur_func < 0) {
+                /* top-level 블록: 그 시점에 전역이 정의돼 있어야 전역 갱신 */
+                if (g >= 0 && r->gstate[g] == 2) {
+                    fail(r, "assignment to a conditionally declared global");
+                } else if (g >= 0 && r->gstate[g] == 1) {
+                    set_ref(&s->ref, VAR_GLOBAL, g);
+                } else if (g >= 0) {
+                    /* 블록 지역이 되지만 호출된 함수가 같은 이름을 전역으로 읽을 수 있음 */
+                    fail(r, "assignment in a block before the global is declared");
+                } else {
+                    bind_new_local(r, &s->ref, name, cond);
+                }
+            } else if (may_capture(r, name, r->cur_func)) {
+                fail(r, "function writes a caller's local variable (dynamic scope)");
+            } else if (g >= 0) {
+                /* 호출 시점에 전역이 정의됐는지는 top-level을 모두 본 뒤 확인 */
+                set_ref(&s->ref, VAR_GLOBAL, g);
+                intlist_add(&r->funcs[r->cur_func].global_writes, g);
+            } else {
+                bind_new_local(r, &s->ref, name, cond);
+            }
+            break;
+        }
+
+        case STMT_EXPR:
+        case STMT_PRINT:
+            resolve_expr(r, s->u.expr);
+            break;
+
+        case STMT_RETURN: {
+            Expr *e = s->u.expr;
+            resolve_expr(r, e);
+            /* 꼬리 자기 호출: 실행기는 프레임을 새로 만들지 않고 매개변수를 다시 바인딩
+             * (슬롯 해석된 프로그램에서만 호출자 프레임을 버려도 결과가 같음) */
+            if (e && e->kind == EXPR_CALL && r->cur_func >= 0 &&
+                find_func(r, e->u.call.func_name) == r->cur_func) {
+                e->u.call.tail = 1;
+                r->funcs[r->cur_func].func->tail_calls++;
+            }
+            break;
+        }
+
+        case STMT_IF:
+            resolve_expr(r, s->u.if_stmt.cond);
+            resolve_body(r, s->u.if_stmt.then_stmt);
+            resolve_body(r, s->u.if_stmt.else_stmt);
+            break;
+
+        case STMT_WHILE:
+            resolve_expr(r, s->u.while_stmt.cond);
+            resolve_body(r, s->u.while_stmt.body);
+            break;
+
+        case STMT_FOR: {
+            int saved = scope_enter(r);
+            resolve_stmt(r, s->u.for_stmt.init, 0);
+            resolve_expr(r, s->u.for_stmt.cond);
+            resolve_body(r, s->u.for_stmt.body);
+            /* step은 첫 반복 이후에만 실행되므로 새 이름을 만들면 조건부 */
+            resolve_stmt(r, s->u.for_stmt.step, 1);
+            scope_leave(r, saved);
+            break;
+        }
+
+        case STMT_BLOCK:
+            if (s->u.block) {
+                int saved = scope_enter(r);
+                for (Stmt *cur = s->u.block->head; cur; cur = cur->next) {
+                    resolve_stmt(r, cur, 0);
+                }
+                scope_leave(r, saved);
+            }
+            break;
+    }
+}
+
+static void begin_unit(Resolver *r, int func_index) {
+    r->cur_func = func_index;
+    r->nlocals = 0;
+    r->scope_base = 0;
+    r->scope_depth = 0;
+    r->max_slots = 0;
+}
+
+static void resolve_function(Resolver *r, Function *f, int fi) {
+    begin_unit(r, fi);
+    f->tail_calls = 0;
+
+    /* 매개변수는 슬롯 0..nparams-1 (eval_call의 바인딩 순서) */
+    for (Param *p = f->params ? f->params->head : NULL; p; p = p->next) {
+        if (find_local(r, p->name) >= 0) {
+            fail(r, "duplicate parameter name");
+            return;
+        }
+        add_local(r, p->name);
+    }
+
+    /* 함수 본문은 매개변수와 같은 스코프에서 실행 */
+    if (f->body) {
+        for (Stmt *s = f->body->head; s; s = s->next) {
+            resolve_stmt(r, s, 0);
+        }
+    }
+    f->nslots = r->max_slots;
+}
+
+/* === 심볼 테이블 스코프 표시 / 해석 취소 === */
+
+/* 현재 스코프에 이름을 만들 수 있는 문장인지 (블록이 아닌 if/while 본문 포함) */
+static int binds_directly(Stmt *s) {
+    if (!s) return 0;
+    switch (s->kind) {
+        case STMT_VARDECL:
+        case STMT_ASSIGN:
+            return 1;
+        case STMT_IF:
+            return binds_directly(s->u.if_stmt.then_stmt) ||
+                   binds_directly(s->u.if_stmt.else_stmt);
+        case STMT_WHILE:
+            return binds_directly(s->u.while_stmt.body);
+        default:
+            return 0;
+    }
+}
+
+static void clear_expr(Expr *e) {
+    if (!e) return;
+    set_ref(&e->ref, VAR_UNRESOLVED, -1);
+    switch (e->kind) {
+        case EXPR_BINOP:
+            clear_expr(e->u.binop.lhs);
+            clear_expr(e->u.binop.rhs);
+            break;
+        case EXPR_UNARY:
+            clear_expr(e->u.unary.operand);
+            break;
+        case EXPR_CALL:
+            e->u.call.tail = 0;
+            for (ExprList *arg = e->u.call.args; arg; arg = arg->next) {
+                clear_expr(arg->expr);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* resolved가 0이면 참조를 모두 VAR_UNRESOLVED로 되돌림
+ * 블록/for문은 선언이 있을 때만 심볼 테이블 스코프를 사용 */
+static void mark_stmt(Stmt *s, int resolved) {
+    if (!s) return;
+    if (!resolved) set_ref(&s->ref, VAR_UNRESOLVED, -1);
+    s->needs_scope = 0;
+
+    switch (s->kind) {
+        case STMT_VARDECL:
+            if (!resolved) clear_expr(s->u.vardecl.init_value);
+            break;
+        case STMT_ASSIGN:
+            if (!resolved) clear_expr(s->u.assign.value);
+            break;
+        case STMT_EXPR:
+        case STMT_RETURN:
+        case STMT_PRINT:
+            if (!resolved) clear_expr(s->u.expr);
+            break;
+        case STMT_IF:
+            if (!resolved) clear_expr(s->u.if_stmt.cond);
+            mark_stmt(s->u.if_stmt.then_stmt, resolved);
+            mark_stmt(s->u.if_stmt.else_stmt, resolved);
+            break;
+        case STMT_WHILE:
+            if (!resolved) clear_expr(s->u.while_stmt.cond);
+            mark_stmt(s->u.while_stmt.body, resolved);
+            break;
+        case STMT_FOR:
+            if (!resolved) clear_expr(s->u.for_stmt.cond);
+            mark_stmt(s->u.for_stmt.init, resolved);
+            mark_stmt(s->u.for_stmt.step, resolved);
+            mark_stmt(s->u.for_stmt.body, resolved);
+            s->needs_scope = !resolved &&
+                (binds_directly(s->u.for_stmt.init) || binds_directly(s->u.for_stmt.step) ||
+                 binds_directly(s->u.for_stmt.body));
+            break;
+        case STMT_BLOCK:
+            if (s->u.block) {
+                for (Stmt *cur = s->u.block->head; cur; cur = cur->next) {
+                    mark_stmt(cur, resolved);
+                    if (!resolved && binds_directly(cur)) s->needs_scope = 1;
+                }
+            }
+            break;
+    }
+}
+
+static void mark_program(Program *prog, int resolved) {
+    for (Item *item = prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) {
+            mark_stmt(item->u.stmt, resolved);
+        } else if (item->kind == ITEM_FUNCTION) {
+            Function *f = item->u.function;
+            if (!resolved) {
+                f->nslots = 0;
+                f->tail_calls = 0;
+            }
+            for (Stmt *s = f->body ? f->body->head : NULL; s; s = s->next) {
+                mark_stmt(s, resolved);
+            }
+        }
+    }
+}
+
+static void resolver_cleanup(Resolver *r) {
+    for (int i = 0; i < r->nfuncs; ++i) {
+        nameset_free(&r->funcs[i].binders);
+        free(r->funcs[i].callees.items);
+        free(r->funcs[i].global_writes.items);
+    }
+    free(r->funcs);
+    nameset_free(&r->func_names);
+    nameset_free(&r->tl_binders);
+    free(r->tl_callees.items);
+    for (int i = 0; i < r->binder_names.count; ++i) {
+        free(r->binder_funcs[i].items);
+    }
+    free(r->binder_funcs);
+    nameset_free(&r->binder_names);
+    for (int i = 0; i < r->capture_names.count; ++i) {
+        free(r->capture_reach[i]);
+    }
+    free(r->capture_reach);
+    nameset_free(&r->capture_names);
+    free(r->gstate);
+    free(r->gdef_time);
+    free(r->call_stack);
+    free(r->locals);
+}
+
+int resolve_program(Program *prog) {
+    if (!prog) return 0;
+    prog->resolve_error = NULL;
+
+    Resolver r;
+    memset(&r, 0, sizeof(r));
+    r.prog = prog;
+
+    analyze(&r);
+
+    /* top-level (스코프 0은 전역 프레임, 블록 안은 top-level 프레임) */
+    begin_unit(&r, -1);
+    for (Item *item = prog->items; item && !r.error; item = item->next) {
+        if (item->kind == ITEM_STMT) resolve_stmt(&r, item->u.stmt, 0);
+    }
+    prog->main_slots = r.max_slots;
+
+    /* 중복 정의된 함수는 호출되지 않으므로 첫 정의만 해석 */
+    for (int i = 0; i < r.nfuncs && !r.error; ++i) {
+        resolve_function(&r, r.funcs[i].func, i);
+    }
+
+    /* 함수 안의 전역 대입은 그 함수가 처음 호출될 수 있기 전에 전역이 확실히 정의돼야 함
+     * (아니면 eval은 함수 지역 변수를 만듦) */
+    for (int i = 0; i < r.nfuncs && !r.error; ++i) {
+        const FuncInfo *fi = &r.funcs[i];
+        for (int k = 0; k < fi->global_writes.count && fi->first_call; ++k) {
+            int t = r.gdef_time[fi->global_writes.items[k]];
+            if (t == 0 || t > fi->first_call) {
+                fail(&r, "function assigns a global before it is declared");
+                break;
+            }
+        }
+    }
+
+    free(prog->global_names);
+    prog->global_names = NULL;
+    prog->nglobals = 0;
+    prog->resolved = !r.error;
+
+    if (r.error) {
+        prog->resolve_error = r.error;
+        prog->main_slots = 0;
+        free(r.globals.names);
+    } else {
+        prog->global_names = (char **)r.globals.names;
+        prog->nglobals = r.globals.count;
+    }
+    free(r.globals.index);
+    mark_program(prog, prog->resolved);
+
+    resolver_cleanup(&r);
+    return prog->resolved;
+}
@@ -0,0 +1,587 @@
+/* Mini-JS 상주 서버
+ * 이벤트 스레드(server_run)가 대기 중인 연결을 poll하며 논블로킹으로 읽어, 요청 하나가
+ * 통째로 버퍼에 모인 연결만 작업 큐에 넣고, 워커 스레드가 꺼내 요청을 처리한 뒤 연결을 돌려줌
+ * - 워커마다 MiniJSContext와 출력 버퍼를 하나씩 두고 재사용
+ * - 요청 단위로 워커에 배분: 연결 수가 워커 수보다 많아도 놀고 있거나 요청을 보내다
+ *   멈춘 연결이 워커를 점유하지 않음 (한 연결의 요청은 순서대로 처리)
+ * - 요청을 보내다 SERVER_IO_TIMEOUT_MS 넘게 멈춘 연결은 이벤트 스레드가 닫음
+ * - 요청 처리 시간은 응답 헤더와 서버 카운터에 기록
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "ast.h"
+#include "codegen_x86.h"
+#include "context.h"
+#include "output.h"
+#include "server.h"
+
+#define QUEUE_CAP 256           /* 요청이 도착해 워커를 기다리는 연결 수 */
+#define LATENCY_SAMPLES 8192    /* 백분위 계산용 최근 요청 수 */
+#define POLL_MS 200             /* 종료 플래그 확인 주기 */
+#define MAX_WORKERS 256
+#define HEADER_MAX 128          /* 요청 헤더 줄 최대 길이 ('\n' 포함) */
+#define CONN_BUF_INITIAL 4096
+#define CONN_BUF_KEEP 65536     /* 비었을 때 이보다 큰 읽기 버퍼는 해제 */
+
+/* 시그널 핸들러가 쓰고 모든 스레드가 읽음 (lock-free atomic이라 핸들러에서 안전) */
+static atomic_int stop_requested = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+/* === 카운터 === */
+
+typedef struct {
+    pthread_mutex_t lock;
+    double start;
+    long requests;
+    long errors;
+    long bytes_in;
+    long bytes_out;
+    long total_us;
+    long max_us;
+    long samples[LATENCY_SAMPLES];  /* 최근 요청 처리 시간 (링 버퍼) */
+    long nsamples;
+} Stats;
+
+typedef struct Conn {
+    int fd;             /* 논블로킹 */
+    char *buf;          /* 읽기 버퍼 [pos, len): 아직 처리하지 않은 바이트 (요청 하나가 다 들어가도록 늘어남) */
+    long len;
+    long pos;
+    long cap;
+    double since;       /* 덜 받은 요청이 버퍼에 남은 시각 (0: 없음, 수신 제한 시간 기준) */
+    struct Conn *next;  /* 반환 목록 */
+} Conn;
+
+typedef struct {
+    Conn *conns[QUEUE_CAP];
+    int head;
+    int count;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    int closed;
+} ConnQueue;
+
+typedef struct {
+    Stats stats;
+    ConnQueue queue;
+    /* 워커 → 이벤트 스레드: 요청을 마친 연결 */
+    pthread_mutex_t returned_lock;
+    Conn *returned;
+    int wake_pipe[2];
+} Server;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void stats_record(Stats *st, long us, int error, long in, long out) {
+    pthread_mutex_lock(&st->lock);
+    st->requests++;
+    if (error) st->errors++;
+    st->bytes_in += in;
+    st->bytes_out += out;
+    st->total_us += us;
+    if (us > st->max_us) st->max_us = us;
+    st->samples[st->nsamples % LATENCY_SAMPLES] = us;
+    st->nsamples++;
+    pthread_mutex_unlock(&st->lock);
+}
+
+static int cmp_long(const void *a, const void *b) {
+    long x = *(const long *)a, y = *(const long *)b;
+    return (x > y) - (x < y);
+}
+
+/* 카운터를 텍스트로 (STATS 응답과 종료 시 출력 공용) */
+static int stats_format(Stats *st, char *buf, int size) {
+    static long sorted[LATENCY_SAMPLES];
+    static pthread_mutex_t sorted_lock = PTHREAD_MUTEX_INITIALIZER;
+
+    pthread_mutex_lock(&sorted_lock);
+    pthread_mutex_lock(&st->lock);
+    long n = st->nsamples < LATENCY_SAMPLES ? st->nsamples : LATENCY_SAMPLES;
+    memcpy(sorted, st->samples, n * sizeof(long));
+    long requests = st->requests, errors = st->errors;
+    long bytes_in = st->bytes_in, bytes_out = st->bytes_out;
+    long total_us = st->total_us, max_us = st->max_us;
+    double uptime = now_sec() - st->start;
+    pthread_mutex_unlock(&st->lock);
+
+    qsort(sorted, n, sizeof(long), cmp_long);
+    long p50 = n ? sorted[(n - 1) * 50 / 100] : 0;
+    long p99 = n ? sorted[(n - 1) * 99 / 100] : 0;
+    pthread_mutex_unlock(&sorted_lock);
+
+    int len = snprintf(buf, size,
+        "requests: %ld (errors: %ld)\n"
+        "bytes in/out: %ld / %ld\n"
+        "uptime: %.1f s, throughput: %.1f req/s\n"
+        "latency (us): avg %ld, p50 %ld, p99 %ld, max %ld (last %ld requests)\n",
+        requests, errors, bytes_in, bytes_out,
+        uptime, uptime > 0 ? requests / uptime : 0.0,
+        requests ? total_us / requests : 0, p50, p99, max_us, n);
+    return len < size ? len : size - 1;
+}
+
+/* === 연결 큐 === */
+
+static int queue_push(ConnQueue *q, Conn *c) {
+    pthread_mutex_lock(&q->lock);
+    while (q->count == QUEUE_CAP && !q->closed) {
+        pthread_cond_wait(&q->not_full, &q->lock);
+    }
+    if (q->closed) {
+        pthread_mutex_unlock(&q->lock);
+        return -1;
+    }
+    q->conns[(q->head + q->count) % QUEUE_CAP] = c;
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+/* 반환: 연결, 큐가 닫혔으면 NULL */
+static Conn *queue_pop(ConnQueue *q) {
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0 && !q->closed) {
+        pthread_cond_wait(&q->not_empty, &q->lock);
+    }
+    Conn *c = NULL;
+    if (q->count > 0) {
+        c = q->conns[q->head];
+        q->head = (q->head + 1) % QUEUE_CAP;
+        q->count--;
+        pthread_cond_signal(&q->not_full);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return c;
+}
+
+static void queue_close(ConnQueue *q) {
+    pthread_mutex_lock(&q->lock);
+    q->closed = 1;
+    pthread_cond_broadcast(&q->not_empty);
+    pthread_cond_broadcast(&q->not_full);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/* === 소켓 입출력 === */
+
+static void conn_close(Conn *c) {
+    close(c->fd);
+    free(c->buf);
+    free(c);
+}
+
+/* 버퍼에 있는 다음 요청 확인
+ * - 반환: 1 요청 하나가 다 도착함 (cmd, *size: 헤더 내용, *body: pos에서 본문까지 거리)
+ *         0 아직 덜 도착함 (*need: pos부터 필요한 바이트 수, 헤더를 못 읽었으면 HEADER_MAX)
+ *        -1 잘못된 헤더 (너무 긴 줄, 형식 오류, SERVER_MAX_SOURCE 초과) */
+static int request_parse(Conn *c, char *cmd, long *size, long *body, long *need) {
+    long avail = c->len - c->pos;
+    *need = HEADER_MAX;
+    if (avail == 0) return 0;
+    const char *start = c->buf + c->pos;
+    const char *nl = (const char *)memchr(start, '\n', avail < HEADER_MAX ? avail : HEADER_MAX);
+    if (!nl) return avail < HEADER_MAX ? 0 : -1;
+
+    char line[HEADER_MAX];
+    int n = (int)(nl - start);
+    memcpy(line, start, n);
+    line[n] = '\0';
+    *size = -1;
+    if (sscanf(line, "%15s %ld", cmd, size) != 2 || *size < 0 || *size > SERVER_MAX_SOURCE) {
+        return -1;
+    }
+    *body = n + 1;
+    *need = *body + *size;
+    return avail >= *need ? 1 : 0;
+}
+
+/* 이벤트 스레드: 읽을 수 있는 만큼 읽음 (요청 하나가 다 모이면 멈춤)
+ * - 반환: 1 처리할 요청이 있음 (잘못된 헤더 포함, 워커가 응답)
+ *         0 더 기다림, -1 연결 종료 (EOF/오류) */
+static int conn_pump(Conn *c) {
+    char cmd[16];
+    long size, body, need;
+    for (;;) {
+        if (request_parse(c, cmd, &size, &body, &need) != 0) return 1;
+        /* 처리한 바이트를 버리고 요청 하나가 들어갈 자리 확보 */
+        if (c->pos > 0) {
+            memmove(c->buf, c->buf + c->pos, c->len - c->pos);
+            c->len -= c->pos;
+            c->pos = 0;
+        }
+        if (need > c->cap || !c->buf) {
+            long cap = need > CONN_BUF_INITIAL ? need : CONN_BUF_INITIAL;
+            char *p = (char *)realloc(c->buf, cap);
+            if (!p) return -1;
+            c->buf = p;
+            c->cap = cap;
+        }
+        ssize_t n = read(c->fd, c->buf + c->len, c->cap - c->len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 0;
+        if (n <= 0) return -1;
+        c->len += n;
+    }
+}
+
+/* 응답 쓰기 (상대가 SERVER_IO_TIMEOUT_MS 동안 읽지 않으면 실패) */
+static int write_all(int fd, const char *data, long size) {
+    double deadline = now_sec() + SERVER_IO_TIMEOUT_MS / 1000.0;
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (now_sec() > deadline) return -1;
+            struct pollfd p = { fd, POLLOUT, 0 };
+            poll(&p, 1, POLL_MS);
+            continue;
+        }
+        if (n <= 0) return -1;
+        data += n;
+        size -= n;
+    }
+    return 0;
+}
+
+/* === 워커 === */
+
+typedef struct {
+    Server *server;
+    MiniJSContext *ctx;
+    char *out;          /* 출력 버퍼 (SERVER_OUTPUT_SIZE) */
+    char *src;          /* 요청 소스 (널 종료) */
+    long src_cap;
+} Worker;
+
+/* 요청 하나 처리, 반환: 응답 본문 길이 (*error: 1이면 ERR 응답, *truncated: 1이면 본문이 잘림) */
+static int run_request(Worker *w, const char *cmd, int *ret, int *error, int *truncated) {
+    *ret = 0;
+    *error = 0;
+    *truncated = 0;
+    if (strcmp(cmd, "STATS") == 0) {
+        return stats_format(&w->server->stats, w->out, SERVER_OUTPUT_SIZE);
+    }
+
+    int mode_asm = strcmp(cmd, "ASM") == 0;
+    int use_vm = strcmp(cmd, "VM") == 0;
+    if (!mode_asm && !use_vm && strcmp(cmd, "EVAL") != 0) {
+        *error = 1;
+        return snprintf(w->out, SERVER_OUTPUT_SIZE, "Unknown command: %s\n", cmd);
+    }
+
+    if (minijs_parse_string(w->ctx, w->src) != 0) {
+        *error = 1;
+        return snprintf(w->out, SERVER_OUTPUT_SIZE, "Parse failed.\n");
+    }
+    if (w->ctx->program->empty) {
+        minijs_release_program(w->ctx);
+        *error = 1;
+        return snprintf(w->out, SERVER_OUTPUT_SIZE, "No program parsed.\n");
+    }
+    minijs_optimize(w->ctx);
+
+    int len;
+    if (mode_asm) {
+        const char *asm_error = NULL;
+        Output out;
+        output_init_buffer(&out, w->out, SERVER_OUTPUT_SIZE);
+        if (gen_x86_program(w->ctx->program, &out, w->ctx->opt_level, &asm_error) == 0) {
+            len = out.pos;
+            *truncated = out.truncated;
+        } else {
+            *error = 1;
+            len = snprintf(w->out, SERVER_OUTPUT_SIZE, "Cannot compile: %s\n",
+                           asm_error ? asm_error : "");
+        }
+    } else {
+        minijs_set_output_buffer(w->ctx, w->out, SERVER_OUTPUT_SIZE);
+        *ret = minijs_eval(w->ctx, use_vm ? MINIJS_ENGINE_VM : MINIJS_ENGINE_TREE, NULL, NULL);
+        len = w->ctx->out.pos;
+        *truncated = w->ctx->out.truncated;
+    }
+    minijs_release_program(w->ctx);
+    return len;
+}
+
+/* 버퍼에 다 모인 요청 하나를 처리하고 응답
+ * - 반환: 1 처리함, 0 처리할 요청 없음 (덜 받은 요청은 버퍼에 남김), -1 연결 종료 (잘못된 헤더/송신 실패) */
+static int serve_request(Worker *w, Conn *c) {
+    char cmd[16], header[96];
+    long size, body, need;
+    int r = request_parse(c, cmd, &size, &body, &need);
+    if (r == 0) return 0;
+    if (r < 0) {
+        const char *msg = "Bad request header\n";
+        int hlen = snprintf(header, sizeof(header), "ERR 0 %d 0\n", (int)strlen(msg));
+        write_all(c->fd, header, hlen);
+        write_all(c->fd, msg, strlen(msg));
+        return -1;
+    }
+    if (size + 1 > w->src_cap) {
+        char *p = (char *)realloc(w->src, size + 1);
+        if (!p) return -1;
+        w->src = p;
+        w->src_cap = size + 1;
+    }
+    memcpy(w->src, c->buf + c->pos + body, size);
+    w->src[size] = '\0';
+    c->pos += body + size;
+
+    double t0 = now_sec();
+    int ret, error, truncated;
+    int len = run_request(w, cmd, &ret, &error, &truncated);
+    long us = (long)((now_sec() - t0) * 1e6);
+
+    int hlen = snprintf(header, sizeof(header), "%s %d %d %ld\n",
+                        error ? "ERR" : truncated ? "TRUNC" : "OK", ret, len, us);
+    int failed = write_all(c->fd, header, hlen) != 0 || write_all(c->fd, w->out, len) != 0;
+    stats_record(&w->server->stats, us, error, size, len);
+    return failed ? -1 : 1;
+}
+
+/* 처리를 마친 연결을 이벤트 스레드에 돌려줌 */
+static void return_conn(Server *s, Conn *c) {
+    pthread_mutex_lock(&s->returned_lock);
+    c->next = s->returned;
+    s->returned = c;
+    pthread_mutex_unlock(&s->returned_lock);
+    char b = 0;
+    if (write(s->wake_pipe[1], &b, 1) < 0) {
+        /* 파이프가 가득 참: 이미 깨울 바이트가 있음 */
+    }
+}
+
+static void *worker_main(void *arg) {
+    Worker *w = (Worker *)arg;
+    Conn *c;
+    while ((c = queue_pop(&w->server->queue)) != NULL) {
+        /* 이벤트 스레드가 받아 둔 요청을 모두 처리 (파이프라이닝) */
+        int r;
+        while ((r = serve_request(w, c)) > 0) {
+        }
+        if (r == 0) {
+            if (c->pos == c->len && c->cap > CONN_BUF_KEEP) {
+                free(c->buf);
+                c->buf = NULL;
+                c->cap = c->len = c->pos = 0;
+            }
+            return_conn(w->server, c);
+        } else {
+            conn_close(c);
+        }
+    }
+    return NULL;
+}
+
+/* === 수락 루프 === */
+
+static int open_socket(const char *path) {
+    struct sockaddr_un addr;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Error: socket path too long: %s\n", path);
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    unlink(path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 128) != 0) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int server_run(const char *socket_path, int nworkers, int opt_level) {
+    if (nworkers <= 0) nworkers = SERVER_DEFAULT_WORKERS;
+    if (nworkers > MAX_WORKERS) nworkers = MAX_WORKERS;
+
+    int listen_fd = open_socket(socket_path);
+    if (listen_fd < 0) return 1;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;     /* SA_RESTART 없음: poll이 EINTR로 깨어남 */
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    Server *server = (Server *)calloc(1, sizeof(Server));
+    Worker *workers = (Worker *)calloc(nworkers, sizeof(Worker));
+    pthread_t *threads = (pthread_t *)calloc(nworkers, sizeof(pthread_t));
+    if (!server || !workers || !threads) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    if (pipe(server->wake_pipe) != 0) {
+        perror("pipe");
+        close(listen_fd);
+        return 1;
+    }
+    fcntl(server->wake_pipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(server->wake_pipe[1], F_SETFL, O_NONBLOCK);
+    pthread_mutex_init(&server->stats.lock, NULL);
+    pthread_mutex_init(&server->returned_lock, NULL);
+    pthread_mutex_init(&server->queue.lock, NULL);
+    pthread_cond_init(&server->queue.not_empty, NULL);
+    pthread_cond_init(&server->queue.not_full, NULL);
+    server->stats.start = now_sec();
+
+    int started = 0;
+    for (; started < nworkers; ++started) {
+        Worker *w = &workers[started];
+        w->server = server;
+        w->ctx = minijs_context_new();
+        if (w->ctx) w->ctx->opt_level = opt_level;
+        w->out = (char *)malloc(SERVER_OUTPUT_SIZE);
+        if (!w->ctx || !w->out ||
+            pthread_create(&threads[started], NULL, worker_main, w) != 0) {
+            fprintf(stderr, "Error: Cannot start worker %d\n", started);
+            minijs_context_free(w->ctx);
+            free(w->out);
+            stop_requested = 1;
+            break;
+        }
+    }
+
+    if (!stop_requested) {
+        fprintf(stderr, "Listening on %s (%d workers)\n", socket_path, nworkers);
+    }
+
+    /* 이벤트 루프: [0] 깨우기 파이프, [1] 수락 소켓, [2..] 대기 중인 연결 */
+    Conn **idle = NULL;
+    int nidle = 0, idle_cap = 0;
+    struct pollfd *pfds = NULL;
+    while (!stop_requested) {
+        pthread_mutex_lock(&server->returned_lock);
+        Conn *back = server->returned;
+        server->returned = NULL;
+        pthread_mutex_unlock(&server->returned_lock);
+        for (; back; back = back->next) {
+            if (nidle == idle_cap) {
+                idle_cap = idle_cap ? idle_cap * 2 : 64;
+                idle = (Conn **)realloc(idle, idle_cap * sizeof(Conn *));
+                pfds = (struct pollfd *)realloc(pfds, (idle_cap + 2) * sizeof(struct pollfd));
+                if (!idle || !pfds) {
+                    fprintf(stderr, "out of memory\n");
+                    exit(1);
+                }
+            }
+            /* 덜 받은 요청이 남았으면 지금부터 수신 제한 시간을 잼 */
+            if (back->pos < back->len && back->since == 0) back->since = now_sec();
+            idle[nidle++] = back;
+        }
+        if (!pfds) {
+            pfds = (struct pollfd *)malloc(2 * sizeof(struct pollfd));
+            if (!pfds) {
+                fprintf(stderr, "out of memory\n");
+                exit(1);
+            }
+        }
+
+        pfds[0].fd = server->wake_pipe[0];
+        pfds[1].fd = listen_fd;
+        for (int i = 0; i < nidle; ++i) pfds[i + 2].fd = idle[i]->fd;
+        for (int i = 0; i < nidle + 2; ++i) {
+            pfds[i].events = POLLIN;
+            pfds[i].revents = 0;
+        }
+        if (poll(pfds, nidle + 2, POLL_MS) < 0) continue;
+
+        if (pfds[0].revents) {
+            char drain[64];
+            while (read(server->wake_pipe[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        /* 요청이 다 도착한 연결 → 작업 큐, 끊기거나 요청을 보내다 멈춘 연결은 닫음 */
+        double now = now_sec();
+        int kept = 0;
+        for (int i = 0; i < nidle; ++i) {
+            Conn *c = idle[i];
+            int r = pfds[i + 2].revents ? conn_pump(c) : 0;
+            if (r > 0) {
+                c->since = 0;
+                if (queue_push(&server->queue, c) != 0) conn_close(c);
+            } else if (r < 0 || (c->since > 0 && now - c->since > SERVER_IO_TIMEOUT_MS / 1000.0)) {
+                conn_close(c);
+            } else {
+                if (c->pos < c->len && c->since == 0) c->since = now;
+                idle[kept++] = c;
+            }
+        }
+        nidle = kept;
+        /* 새 연결은 돌려받은 연결과 같은 경로로 대기 목록에 추가 */
+        if (pfds[1].revents) {
+            int fd = accept(listen_fd, NULL, NULL);
+            Conn *c = fd >= 0 ? (Conn *)calloc(1, sizeof(Conn)) : NULL;
+            if (c) {
+                c->fd = fd;
+                fcntl(fd, F_SETFL, O_NONBLOCK);
+                return_conn(server, c);
+            } else if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    /* 종료: 새 요청을 받지 않고, 워커는 처리 중인 요청을 끝낸 뒤 빠져나옴 */
+    close(listen_fd);
+    unlink(socket_path);
+    queue_close(&server->queue);
+    for (int i = 0; i < started; ++i) {
+        pthread_join(threads[i], NULL);
+        minijs_context_free(workers[i].ctx);
+        free(workers[i].out);
+        free(workers[i].src);
+    }
+    Conn *c;
+    while ((c = queue_pop(&server->queue)) != NULL) conn_close(c);
+    for (int i = 0; i < nidle; ++i) conn_close(idle[i]);
+    while ((c = server->returned) != NULL) {
+        server->returned = c->next;
+        conn_close(c);
+    }
+    free(idle);
+    free(pfds);
+    close(server->wake_pipe[0]);
+    close(server->wake_pipe[1]);
+
+    char report[512];
+    stats_format(&server->stats, report, sizeof(report));
+    fprintf(stderr, "=== Server Stats ===\n%s", report);
+
+    int status = started == nworkers ? 0 : 1;
+    free(threads);
+    free(workers);
+    free(server);
+    return status;
+}
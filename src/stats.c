@@ -0,0 +1,101 @@
+/* 단계별 측정과 실행 카운터 출력 (--time-phases, --stats) */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#define HAVE_GETRUSAGE 1
+#endif
+#include "ast.h"
+#include "stats.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* 프로세스의 최대 RSS (KB, 알 수 없으면 0) */
+static long peak_rss_kb(void) {
+#ifdef HAVE_GETRUSAGE
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024;     /* macOS는 바이트 */
+#else
+    return ru.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+/* === 단계별 측정 === */
+
+void phase_timer_start(PhaseTimer *t) {
+    memset(t, 0, sizeof(*t));
+    t->start_rss_kb = peak_rss_kb();
+    t->start = now_sec();
+}
+
+void phase_mark(PhaseTimer *t, const char *name) {
+    if (!t) return;
+    double now = now_sec();
+    PhaseTime *p;
+    if (t->count < PHASE_MAX) {
+        p = &t->phases[t->count++];
+        p->name = name;
+        p->seconds = 0;
+    } else {
+        p = &t->phases[PHASE_MAX - 1];
+    }
+    p->seconds += now - t->start;
+    p->peak_rss_kb = peak_rss_kb();
+    t->start = now_sec();
+}
+
+void phase_report(const PhaseTimer *t, FILE *out) {
+    double total = 0;
+    long prev = t->start_rss_kb;
+    fprintf(out, "=== Phases ===\n");
+    fprintf(out, "  %-12s %12s %16s %14s\n", "phase", "wall (ms)", "peak RSS (KB)", "growth (KB)");
+    for (int i = 0; i < t->count; ++i) {
+        const PhaseTime *p = &t->phases[i];
+        fprintf(out, "  %-12s %12.3f %16ld %14ld\n", p->name, p->seconds * 1e3,
+                p->peak_rss_kb, p->peak_rss_kb - prev);
+        total += p->seconds;
+        prev = p->peak_rss_kb;
+    }
+    fprintf(out, "  %-12s %12.3f %16ld\n", "total", total * 1e3, prev);
+}
+
+/* === 실행 카운터 === */
+
+static const char *expr_kind_names[] = { "int", "string", "var", "binop", "call", "unary" };
+static const char *stmt_kind_names[] = {
+    "expr", "return", "vardecl", "assign", "print", "if", "while", "for", "block"
+};
+
+void exec_stats_report(const ExecStats *s, FILE *out) {
+    long nexprs = 0, nstmts = 0;
+    fprintf(out, "=== Execution Stats ===\n");
+#ifdef MINIJS_NO_STATS
+    fprintf(out, "  (counters compiled out: built with MINIJS_NO_STATS)\n");
+#endif
+    for (int k = 0; k <= EXPR_UNARY; ++k) nexprs += s->exprs[k];
+    for (int k = 0; k <= STMT_BLOCK; ++k) nstmts += s->stmts[k];
+    fprintf(out, "  expressions evaluated: %ld\n", nexprs);
+    for (int k = 0; k <= EXPR_UNARY; ++k) {
+        if (s->exprs[k]) fprintf(out, "    %-10s %14ld\n", expr_kind_names[k], s->exprs[k]);
+    }
+    fprintf(out, "  statements executed: %ld\n", nstmts);
+    for (int k = 0; k <= STMT_BLOCK; ++k) {
+        if (s->stmts[k]) fprintf(out, "    %-10s %14ld\n", stmt_kind_names[k], s->stmts[k]);
+    }
+    fprintf(out, "  symtab lookups: %ld (%ld entries probed", s->sym_lookups, s->sym_probes);
+    if (s->sym_lookups) fprintf(out, ", %.2f per lookup", (double)s->sym_probes / s->sym_lookups);
+    fprintf(out, ")\n");
+    fprintf(out, "  scope pushes/pops: %ld / %ld\n", s->scope_pushes, s->scope_pops);
+    fprintf(out, "  function calls: %ld (max depth %ld)\n", s->calls, s->max_depth);
+    fprintf(out, "  output bytes: %ld\n", s->output_bytes);
+}
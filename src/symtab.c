@@ -1,83 +1,183 @@
 /* 심볼 테이블 (10wk/minic_exec 기반 + 스코프 지원)
  * 원본: 10wk/minic_exec/src/symtab.c
+ *
+ * 구조 (해시 + 섀도 체인 + undo 로그):
+ * - 이름 → NameInfo: 오픈 어드레싱 해시 테이블
+ *   (이름은 인터닝된 포인터라 복사하지 않고 포인터로 비교/해시)
+ * - NameInfo.top: 그 이름의 가장 안쪽 바인딩
+ * - 바인딩 배열 = undo 로그: 항상 현재 스코프에 생성되므로 스코프 순서대로 쌓임
+ *   스코프 종료 시 로그를 되감으며 섀도 체인을 복원 → O(스코프의 변수 수)
+ * - 모든 상태는 SymTab 객체 안에 있음 (실행마다 따로 생성, 스레드 간 공유 없음)
  */
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include "intern.h"
+#include "stats.h"
 #include "symtab.h"
 
-#define MAX_SYMS 1024
+#define INITIAL_INDEX_CAP 64
 
-/* 10wk 원본 구조 + scope_level 추가 */
+/* 이름별 정보 (인덱스는 sym_init 전까지 고정) */
 typedef struct {
-    char name[32];
+    const char *name;
+    unsigned int hash;
+    int top;            /* 가장 안쪽 바인딩 인덱스, 없으면 -1 */
+} NameInfo;
+
+/* 10wk 원본 구조 + scope_level, 섀도 체인 */
+typedef struct {
+    int name_id;
     long value;
-    int in_use;
     int initialized;
     int scope_level;    /* 확장: 변수가 속한 스코프 레벨 */
+    int shadow;         /* 같은 이름의 바깥 바인딩, 없으면 -1 */
 } Sym;
 
-static Sym table[MAX_SYMS];
-static int current_scope = 0;   /* 확장: 현재 스코프 레벨 */
+struct SymTab {
+    NameInfo *names;
+    int name_count;
+    int name_cap;
 
-/* 10wk 원본: 테이블 초기화 */
-void sym_init(void)
+    int *name_index;    /* 오픈 어드레싱: names 인덱스, 빈 칸은 -1 */
+    int index_cap;      /* 2의 거듭제곱 */
+
+    Sym *table;         /* 바인딩 스택 (undo 로그) */
+    int sym_count;
+    int sym_cap;
+
+    int *scope_marks;   /* 스코프 시작 시점의 sym_count */
+    int scope_cap;
+    int current_scope;  /* 확장: 현재 스코프 레벨 */
+
+    ExecStats *stats;   /* 조회/스코프 카운터 (NULL이면 세지 않음) */
+};
+
+static void *xrealloc(void *p, size_t size)
 {
-    memset(table, 0, sizeof(table));
-    current_scope = 0;
+    p = realloc(p, size);
+    if (!p) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    return p;
 }
 
-/* 10wk 원본: 이름으로 심볼 찾기 (현재 스코프부터 상위로) */
-static Sym *find_sym(const char *name)
+static void rebuild_index(SymTab *st, int cap)
 {
-    /* 현재 스코프부터 상위 스코프까지 검색 */
-    for (int scope = current_scope; scope >= 0; scope--) {
-        for (int i = 0; i < MAX_SYMS; ++i) {
-            if (table[i].in_use &&
-                table[i].scope_level == scope &&
-                strcmp(table[i].name, name) == 0) {
-                return &table[i];
-            }
-        }
+    free(st->name_index);
+    st->name_index = (int *)xrealloc(NULL, cap * sizeof(int));
+    memset(st->name_index, 0xff, cap * sizeof(int));
+    st->index_cap = cap;
+    for (int id = 0; id < st->name_count; ++id) {
+        unsigned int i = st->names[id].hash & (cap - 1);
+        while (st->name_index[i] >= 0) i = (i + 1) & (cap - 1);
+        st->name_index[i] = id;
     }
-    return NULL;
 }
 
-/* 현재 스코프에서만 심볼 찾기 (변수 섀도잉 허용) */
-static Sym *find_sym_in_current_scope(const char *name)
+/* 이름 → NameInfo 인덱스 (create가 0이면 없을 때 -1) */
+static int lookup_name(SymTab *st, const char *name, int create)
 {
-    for (int i = 0; i < MAX_SYMS; ++i) {
-        if (table[i].in_use &&
-            table[i].scope_level == current_scope &&
-            strcmp(table[i].name, name) == 0) {
-            return &table[i];
+    unsigned int h = INTERN_HASH(name);
+    STAT_INC(st->stats, sym_lookups);
+    if (st->index_cap > 0) {
+        unsigned int mask = st->index_cap - 1;
+        unsigned int i = h & mask;
+        while (st->name_index[i] >= 0) {
+            NameInfo *n = &st->names[st->name_index[i]];
+            STAT_INC(st->stats, sym_probes);
+            if (n->name == name) return st->name_index[i];
+            i = (i + 1) & mask;
         }
     }
-    return NULL;
+    if (!create) return -1;
+
+    /* 적재율 1/2 유지 */
+    if ((st->name_count + 1) * 2 > st->index_cap) {
+        rebuild_index(st, st->index_cap ? st->index_cap * 2 : INITIAL_INDEX_CAP);
+    }
+    if (st->name_count == st->name_cap) {
+        st->name_cap = st->name_cap ? st->name_cap * 2 : INITIAL_INDEX_CAP / 2;
+        st->names = (NameInfo *)xrealloc(st->names, st->name_cap * sizeof(NameInfo));
+    }
+
+    NameInfo *n = &st->names[st->name_count];
+    n->name = name;
+    n->hash = h;
+    n->top = -1;
+
+    unsigned int mask = st->index_cap - 1;
+    unsigned int i = h & mask;
+    while (st->name_index[i] >= 0) i = (i + 1) & mask;
+    st->name_index[i] = st->name_count;
+    return st->name_count++;
 }
 
-static Sym *create_sym_in_current_scope(const char *name)
+SymTab *sym_new(void)
 {
-    for (int i = 0; i < MAX_SYMS; ++i) {
-        if (!table[i].in_use) {
-            table[i].in_use = 1;
-            table[i].initialized = 0;
-            table[i].scope_level = current_scope;
-            strncpy(table[i].name, name, sizeof(table[i].name) - 1);
-            table[i].name[sizeof(table[i].name) - 1] = '\0';
-            return &table[i];
-        }
+    return (SymTab *)calloc(1, sizeof(SymTab));
+}
+
+void sym_free(SymTab *st)
+{
+    if (!st) return;
+    free(st->names);
+    free(st->name_index);
+    free(st->table);
+    free(st->scope_marks);
+    free(st);
+}
+
+/* 10wk 원본: 테이블 초기화 */
+void sym_init(SymTab *st)
+{
+    st->name_count = 0;
+    if (st->index_cap > 0) {
+        memset(st->name_index, 0xff, st->index_cap * sizeof(int));
     }
-    fprintf(stderr, "symbol table full\n");
-    return NULL;
+    st->sym_count = 0;
+    st->current_scope = 0;
+}
+
+/* 10wk 원본: 이름으로 심볼 찾기 (가장 안쪽 스코프의 바인딩) */
+static Sym *find_sym(SymTab *st, const char *name)
+{
+    int id = lookup_name(st, name, 0);
+    if (id < 0 || st->names[id].top < 0) return NULL;
+    return &st->table[st->names[id].top];
+}
+
+/* 현재 스코프에서만 심볼 찾기 (변수 섀도잉 허용) */
+static Sym *find_sym_in_current_scope(SymTab *st, const char *name)
+{
+    Sym *s = find_sym(st, name);
+    return (s && s->scope_level == st->current_scope) ? s : NULL;
 }
 
-int sym_declare(const char *name, long value)
+static Sym *create_sym_in_current_scope(SymTab *st, const char *name)
 {
-    Sym *s = find_sym_in_current_scope(name);
+    int id = lookup_name(st, name, 1);
+    if (st->sym_count == st->sym_cap) {
+        st->sym_cap = st->sym_cap ? st->sym_cap * 2 : 256;
+        st->table = (Sym *)xrealloc(st->table, st->sym_cap * sizeof(Sym));
+    }
+    Sym *s = &st->table[st->sym_count];
+    s->name_id = id;
+    s->value = 0;
+    s->initialized = 0;
+    s->scope_level = st->current_scope;
+    s->shadow = st->names[id].top;
+    st->names[id].top = st->sym_count++;
+    return s;
+}
+
+int sym_declare(SymTab *st, const char *name, long value)
+{
+    Sym *s = find_sym_in_current_scope(st, name);
     if (!s) {
-        s = create_sym_in_current_scope(name);
+        s = create_sym_in_current_scope(st, name);
     }
-    if (!s) return 0;
     s->value = value;
     s->initialized = 1;
     return 1;
@@ -85,22 +185,21 @@ int sym_declare(const char *name, long value)
 
 /* 10wk 기반: 변수 설정 (수정됨)
  * 가장 가까운 스코프의 변수를 갱신하고, 없으면 현재 스코프에 생성 */
-int sym_set(const char *name, long value)
+int sym_set(SymTab *st, const char *name, long value)
 {
-    Sym *s = find_sym(name);
+    Sym *s = find_sym(st, name);
     if (!s) {
-        s = create_sym_in_current_scope(name);
+        s = create_sym_in_current_scope(st, name);
     }
-    if (!s) return 0;
     s->value = value;
     s->initialized = 1;
     return 1;
 }
 
 /* 10wk 원본: 변수 조회 */
-int sym_get(const char *name, long *out)
+int sym_get(SymTab *st, const char *name, long *out)
 {
-    Sym *s = find_sym(name);
+    Sym *s = find_sym(st, name);
     if (!s || !s->initialized) return 0;
     if (out) *out = s->value;
     return 1;
@@ -108,28 +207,39 @@ int sym_get(const char *name, long *out)
 
 /* === 스코프 지원 (확장) === */
 
-/* 새 스코프 시작 */
-void sym_push_scope(void)
+/* 새 스코프 시작: undo 로그 위치 기록 */
+void sym_push_scope(SymTab *st)
 {
-    current_scope++;
+    if (st->current_scope + 1 >= st->scope_cap) {
+        st->scope_cap = st->scope_cap ? st->scope_cap * 2 : 64;
+        st->scope_marks = (int *)xrealloc(st->scope_marks, st->scope_cap * sizeof(int));
+    }
+    STAT_INC(st->stats, scope_pushes);
+    st->current_scope++;
+    st->scope_marks[st->current_scope] = st->sym_count;
 }
 
-/* 스코프 종료: 현재 스코프의 모든 변수 제거 */
-void sym_pop_scope(void)
+/* 스코프 종료: 현재 스코프에서 만든 바인딩만 되감기 */
+void sym_pop_scope(SymTab *st)
 {
-    for (int i = 0; i < MAX_SYMS; ++i) {
-        if (table[i].in_use && table[i].scope_level == current_scope) {
-            table[i].in_use = 0;
-            table[i].initialized = 0;
-        }
+    int mark = (st->current_scope > 0) ? st->scope_marks[st->current_scope] : 0;
+    STAT_INC(st->stats, scope_pops);
+    while (st->sym_count > mark) {
+        Sym *s = &st->table[--st->sym_count];
+        st->names[s->name_id].top = s->shadow;
     }
-    if (current_scope > 0) {
-        current_scope--;
+    if (st->current_scope > 0) {
+        st->current_scope--;
     }
 }
 
 /* 현재 스코프 레벨 반환 */
-int sym_get_scope_level(void)
+int sym_get_scope_level(SymTab *st)
+{
+    return st->current_scope;
+}
+
+void sym_set_stats(SymTab *st, ExecStats *stats)
 {
-    return current_scope;
+    st->stats = stats;
 }
@@ -0,0 +1,774 @@
+/* Mini-JS 바이트코드 VM
+ * Program을 선형 바이트코드로 한 번 컴파일한 뒤 스택 머신으로 실행
+ *
+ * - 변수 슬롯은 resolve.c가 AST에 기록한 (지역 슬롯 | 전역 인덱스)를 사용
+ * - eval.c와 같은 출력/에러 메시지를 내도록 동작을 맞춤
+ * - 해석에 실패한 프로그램(동적 스코프 필요 등)은
+ *   컴파일을 거부하고 트리 인터프리터로 넘김
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "eval.h"
+#include "resolve.h"
+#include "output.h"
+#include "vm.h"
+
+#if defined(__GNUC__) && !defined(VM_NO_COMPUTED_GOTO)
+#define VM_COMPUTED_GOTO 1
+#else
+#define VM_COMPUTED_GOTO 0
+#endif
+
+#define VM_MAX_ARGS 16          /* eval_call과 동일한 인자 개수 제한 */
+#define VM_STACK_INIT 65536
+#define VM_FRAMES_INIT 1024
+
+/* === 명령어 === */
+typedef enum {
+    OP_CONST,       /* imm          : push imm */
+    OP_LOAD,        /* slot         : push bp[slot] */
+    OP_STORE,       /* slot         : bp[slot] = pop */
+    OP_GLOAD,       /* g            : push globals[g] (미정의면 에러) */
+    OP_GSTORE,      /* g            : globals[g] = pop */
+    OP_UNDEF_VAR,   /* str          : 에러 출력 후 push 0 */
+    OP_POP,
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD,
+    OP_LT, OP_GT, OP_LE, OP_GE, OP_EQ, OP_NE,
+    OP_AND, OP_OR,
+    OP_NEG, OP_NOT,
+    OP_JMP,         /* target */
+    OP_JZ,          /* target       : pop, 0이면 점프 */
+    OP_CALL,        /* f argc */
+    OP_CHKFN,       /* f target     : 아직 등록 안 된 함수면 에러, push 0, 점프 */
+    OP_DEFFN,       /* f            : 함수 등록 (top-level 순서 보존) */
+    OP_UNDEF_FN,    /* str          : 에러 출력 후 push 0 */
+    OP_RET,
+    OP_HALT,        /* top-level 종료, pop한 값이 반환값 */
+    OP_PRINT_INT,
+    OP_PRINT_STR,   /* str */
+    OP_COUNT
+} OpCode;
+
+/* 스택 깊이 변화량 (최대 스택 계산용, OP_CALL은 별도 처리) */
+static const int op_stack_effect[OP_COUNT] = {
+    [OP_CONST] = 1, [OP_LOAD] = 1, [OP_STORE] = -1,
+    [OP_GLOAD] = 1, [OP_GSTORE] = -1, [OP_UNDEF_VAR] = 1, [OP_POP] = -1,
+    [OP_ADD] = -1, [OP_SUB] = -1, [OP_MUL] = -1, [OP_DIV] = -1, [OP_MOD] = -1,
+    [OP_LT] = -1, [OP_GT] = -1, [OP_LE] = -1, [OP_GE] = -1, [OP_EQ] = -1, [OP_NE] = -1,
+    [OP_AND] = -1, [OP_OR] = -1,
+    [OP_NEG] = 0, [OP_NOT] = 0,
+    [OP_JMP] = 0, [OP_JZ] = -1,
+    [OP_CALL] = 1, [OP_CHKFN] = 0, [OP_DEFFN] = 0, [OP_UNDEF_FN] = 1,
+    [OP_RET] = -1, [OP_HALT] = -1,
+    [OP_PRINT_INT] = -1, [OP_PRINT_STR] = 0,
+};
+
+/* === 컴파일된 프로그램 === */
+typedef struct {
+    Function *func;     /* 첫 번째 정의 (eval의 find_function과 동일) */
+    int nparams;
+    int nslots;         /* 매개변수 + 지역 변수 슬롯 */
+    int max_stack;      /* 피연산자 스택 최대 깊이 */
+    int entry;          /* 코드 시작 위치 */
+    int needs_check;    /* 첫 top-level 문장 이후에 정의됨 */
+} VMFunc;
+
+struct VMProgram {
+    int *code;
+    int code_len;
+    int code_cap;
+
+    VMFunc *funcs;
+    int nfuncs;
+
+    char **globals;         /* 전역(스코프 0) 변수 이름 (Program 소유) */
+    int nglobals;
+
+    const char **strings;   /* 문자열 리터럴(소스 구간) 및 에러 메시지용 이름 */
+    int *string_lens;       /* strings[i]의 길이 (리터럴은 NUL로 끝나지 않음) */
+    int nstrings;
+    int strings_cap;
+
+    int main_slots;
+    int main_max_stack;
+};
+
+typedef struct {
+    VMProgram *vp;
+    Program *prog;
+
+    /* 현재 코드 단위 */
+    int cur_func;               /* -1: top-level */
+    int depth;
+    int max_depth;
+} Compiler;
+
+/* === 이름 테이블 === */
+
+static int find_func(Compiler *c, const char *name) {
+    for (int i = 0; i < c->vp->nfuncs; ++i) {
+        if (c->vp->funcs[i].func->name == name) return i;
+    }
+    return -1;
+}
+
+static int add_string(Compiler *c, const char *str, int len) {
+    VMProgram *vp = c->vp;
+    for (int i = 0; i < vp->nstrings; ++i) {
+        if (vp->strings[i] == str && vp->string_lens[i] == len) return i;
+    }
+    if (vp->nstrings == vp->strings_cap) {
+        vp->strings_cap = vp->strings_cap ? vp->strings_cap * 2 : 16;
+        vp->strings = (const char **)realloc(vp->strings, vp->strings_cap * sizeof(const char *));
+        vp->string_lens = (int *)realloc(vp->string_lens, vp->strings_cap * sizeof(int));
+    }
+    vp->strings[vp->nstrings] = str;
+    vp->string_lens[vp->nstrings] = len;
+    return vp->nstrings++;
+}
+
+static int add_name(Compiler *c, const char *name) {
+    return add_string(c, name, (int)strlen(name));
+}
+
+/* === 코드 방출 === */
+
+static int emit_word(Compiler *c, int w) {
+    VMProgram *vp = c->vp;
+    if (vp->code_len == vp->code_cap) {
+        vp->code_cap = vp->code_cap ? vp->code_cap * 2 : 256;
+        vp->code = (int *)realloc(vp->code, vp->code_cap * sizeof(int));
+    }
+    vp->code[vp->code_len] = w;
+    return vp->code_len++;
+}
+
+static void track_depth(Compiler *c, int delta) {
+    c->depth += delta;
+    if (c->depth > c->max_depth) c->max_depth = c->depth;
+}
+
+static void emit_op(Compiler *c, OpCode op) {
+    emit_word(c, op);
+    track_depth(c, op_stack_effect[op]);
+}
+
+static void emit_op1(Compiler *c, OpCode op, int a) {
+    emit_op(c, op);
+    emit_word(c, a);
+}
+
+/* 점프 방출, 나중에 patch_jump로 목적지 기록 */
+static int emit_jump(Compiler *c, OpCode op) {
+    emit_op(c, op);
+    return emit_word(c, -1);
+}
+
+static void patch_jump(Compiler *c, int at) {
+    c->vp->code[at] = c->vp->code_len;
+}
+
+/* === 표현식 컴파일 === */
+static void compile_expr(Compiler *c, Expr *e);
+
+static void compile_var(Compiler *c, Expr *e) {
+    switch (e->ref.kind) {
+        case VAR_LOCAL:
+            emit_op1(c, OP_LOAD, e->ref.slot);
+            break;
+        case VAR_GLOBAL:
+            emit_op1(c, OP_GLOAD, e->ref.slot);
+            break;
+        default:
+            emit_op1(c, OP_UNDEF_VAR, add_name(c, e->u.var_name));
+            break;
+    }
+}
+
+static void compile_call(Compiler *c, Expr *e) {
+    int fi = find_func(c, e->u.call.func_name);
+    if (fi < 0) {
+        /* eval_call과 같이 인자를 평가하지 않고 에러 */
+        emit_op1(c, OP_UNDEF_FN, add_name(c, e->u.call.func_name));
+        return;
+    }
+
+    /* 인자 수 부족은 resolve_program이 거부하므로 argc >= nparams */
+    int argc = 0;
+    for (ExprList *arg = e->u.call.args; arg && argc < VM_MAX_ARGS; arg = arg->next) {
+        argc++;
+    }
+
+    int chk = -1;
+    if (c->vp->funcs[fi].needs_check) {
+        emit_op1(c, OP_CHKFN, fi);
+        chk = emit_word(c, -1);
+    }
+
+    int n = 0;
+    for (ExprList *arg = e->u.call.args; arg && n < VM_MAX_ARGS; arg = arg->next) {
+        compile_expr(c, arg->expr);
+        n++;
+    }
+
+    emit_op(c, OP_CALL);
+    emit_word(c, fi);
+    emit_word(c, argc);
+    track_depth(c, -argc);
+
+    if (chk >= 0) patch_jump(c, chk);
+}
+
+static void compile_expr(Compiler *c, Expr *e) {
+    if (!e) {
+        emit_op1(c, OP_CONST, 0);
+        return;
+    }
+
+    switch (e->kind) {
+        case EXPR_INT:
+            emit_op1(c, OP_CONST, e->u.int_value);
+            break;
+
+        case EXPR_STRING:
+            /* eval_expr와 같이 문자열 값은 0 */
+            emit_op1(c, OP_CONST, 0);
+            break;
+
+        case EXPR_VAR:
+            compile_var(c, e);
+            break;
+
+        case EXPR_BINOP: {
+            static const OpCode binops[] = {
+                [BIN_ADD] = OP_ADD, [BIN_SUB] = OP_SUB, [BIN_MUL] = OP_MUL,
+                [BIN_DIV] = OP_DIV, [BIN_MOD] = OP_MOD,
+                [BIN_LT] = OP_LT, [BIN_GT] = OP_GT, [BIN_LE] = OP_LE,
+                [BIN_GE] = OP_GE, [BIN_EQ] = OP_EQ, [BIN_NE] = OP_NE,
+                [BIN_AND] = OP_AND, [BIN_OR] = OP_OR,
+            };
+            /* eval_expr와 같이 &&, ||도 양쪽을 모두 평가 */
+            compile_expr(c, e->u.binop.lhs);
+            compile_expr(c, e->u.binop.rhs);
+            emit_op(c, binops[e->u.binop.op]);
+            break;
+        }
+
+        case EXPR_CALL:
+            compile_call(c, e);
+            break;
+
+        case EXPR_UNARY:
+            compile_expr(c, e->u.unary.operand);
+            emit_op(c, e->u.unary.op == UNARY_NEG ? OP_NEG : OP_NOT);
+            break;
+    }
+}
+
+/* === 문장 컴파일 === */
+
+/* VARDECL/ASSIGN 저장 (슬롯은 resolve.c가 결정) */
+static void compile_store(Compiler *c, const VarRef *ref) {
+    emit_op1(c, ref->kind == VAR_GLOBAL ? OP_GSTORE : OP_STORE, ref->slot);
+}
+
+/* 꼬리 자기 호출: 인자를 매개변수 슬롯에 다시 저장하고 함수 시작으로 점프 (프레임 재사용) */
+static void compile_tail_call(Compiler *c, Expr *e) {
+    const VMFunc *vf = &c->vp->funcs[c->cur_func];
+    int argc = 0;
+    for (ExprList *arg = e->u.call.args; arg && argc < VM_MAX_ARGS; arg = arg->next) {
+        compile_expr(c, arg->expr);
+        argc++;
+    }
+    /* 남는 인자는 버리고 나머지 지역 슬롯은 0 (OP_CALL과 동일) */
+    for (int i = argc - 1; i >= 0; --i) {
+        if (i < vf->nparams) {
+            emit_op1(c, OP_STORE, i);
+        } else {
+            emit_op(c, OP_POP);
+        }
+    }
+    for (int i = vf->nparams; i < vf->func->nslots; ++i) {
+        emit_op1(c, OP_CONST, 0);
+        emit_op1(c, OP_STORE, i);
+    }
+    emit_op1(c, OP_JMP, vf->entry);
+}
+
+static void compile_stmt(Compiler *c, Stmt *s) {
+    if (!s) return;
+
+    switch (s->kind) {
+        case STMT_VARDECL:
+            compile_expr(c, s->u.vardecl.init_value);
+            compile_store(c, &s->ref);
+            break;
+
+        case STMT_ASSIGN:
+            compile_expr(c, s->u.assign.value);
+            compile_store(c, &s->ref);
+            break;
+
+        case STMT_EXPR:
+            compile_expr(c, s->u.expr);
+            emit_op(c, OP_POP);
+            break;
+
+        case STMT_RETURN:
+            if (s->u.expr && s->u.expr->kind == EXPR_CALL && s->u.expr->u.call.tail) {
+                compile_tail_call(c, s->u.expr);
+                break;
+            }
+            compile_expr(c, s->u.expr);
+            emit_op(c, c->cur_func >= 0 ? OP_RET : OP_HALT);
+            break;
+
+        case STMT_PRINT:
+            if (s->u.expr && s->u.expr->kind == EXPR_STRING) {
+                Expr *str = s->u.expr;
+                emit_op1(c, OP_PRINT_STR, add_string(c, AST_STRING_TEXT(c->prog, str), (int)str->u.string.len));
+            } else {
+                compile_expr(c, s->u.expr);
+                emit_op(c, OP_PRINT_INT);
+            }
+            break;
+
+        case STMT_IF: {
+            compile_expr(c, s->u.if_stmt.cond);
+            int jz = emit_jump(c, OP_JZ);
+            compile_stmt(c, s->u.if_stmt.then_stmt);
+            if (s->u.if_stmt.else_stmt) {
+                int jend = emit_jump(c, OP_JMP);
+                patch_jump(c, jz);
+                compile_stmt(c, s->u.if_stmt.else_stmt);
+                patch_jump(c, jend);
+            } else {
+                patch_jump(c, jz);
+            }
+            break;
+        }
+
+        case STMT_WHILE: {
+            int top = c->vp->code_len;
+            compile_expr(c, s->u.while_stmt.cond);
+            int jz = emit_jump(c, OP_JZ);
+            compile_stmt(c, s->u.while_stmt.body);
+            emit_op1(c, OP_JMP, top);
+            patch_jump(c, jz);
+            break;
+        }
+
+        case STMT_FOR: {
+            compile_stmt(c, s->u.for_stmt.init);
+            int top = c->vp->code_len;
+            int jz = -1;
+            if (s->u.for_stmt.cond) {
+                compile_expr(c, s->u.for_stmt.cond);
+                jz = emit_jump(c, OP_JZ);
+            }
+            compile_stmt(c, s->u.for_stmt.body);
+            compile_stmt(c, s->u.for_stmt.step);
+            emit_op1(c, OP_JMP, top);
+            if (jz >= 0) patch_jump(c, jz);
+            break;
+        }
+
+        case STMT_BLOCK:
+            if (s->u.block) {
+                for (Stmt *cur = s->u.block->head; cur; cur = cur->next) {
+                    compile_stmt(c, cur);
+                }
+            }
+            break;
+    }
+}
+
+/* === 함수/프로그램 컴파일 === */
+
+static void begin_unit(Compiler *c, int func_index) {
+    c->cur_func = func_index;
+    c->depth = 0;
+    c->max_depth = 0;
+}
+
+static void compile_function(Compiler *c, int fi) {
+    VMFunc *vf = &c->vp->funcs[fi];
+    Function *f = vf->func;
+
+    begin_unit(c, fi);
+    vf->entry = c->vp->code_len;
+
+    /* 매개변수는 슬롯 0..nparams-1 */
+    if (f->body) {
+        for (Stmt *s = f->body->head; s; s = s->next) {
+            compile_stmt(c, s);
+        }
+    }
+    emit_op1(c, OP_CONST, 0);
+    emit_op(c, OP_RET);
+
+    vf->nslots = f->nslots;
+    vf->max_stack = c->max_depth;
+}
+
+static void compile_main(Compiler *c) {
+    begin_unit(c, -1);
+
+    for (Item *item = c->prog->items; item; item = item->next) {
+        if (item->kind == ITEM_FUNCTION) {
+            int fi = find_func(c, item->u.function->name);
+            if (c->vp->funcs[fi].func == item->u.function && c->vp->funcs[fi].needs_check) {
+                emit_op1(c, OP_DEFFN, fi);
+            }
+        } else if (item->kind == ITEM_STMT) {
+            compile_stmt(c, item->u.stmt);
+        }
+    }
+    emit_op1(c, OP_CONST, 0);
+    emit_op(c, OP_HALT);
+
+    c->vp->main_slots = c->prog->main_slots;
+    c->vp->main_max_stack = c->max_depth;
+}
+
+/* 함수 테이블과 전역 이름 (슬롯 정보는 resolve.c) */
+static void build_tables(Compiler *c) {
+    VMProgram *vp = c->vp;
+    int seen_stmt = 0;
+
+    /* 함수 테이블 (같은 이름은 첫 정의만 사용) */
+    int cap = 0;
+    for (Item *item = c->prog->items; item; item = item->next) {
+        if (item->kind == ITEM_STMT) {
+            seen_stmt = 1;
+            continue;
+        }
+        if (item->kind != ITEM_FUNCTION || find_func(c, item->u.function->name) >= 0) {
+            continue;
+        }
+        if (vp->nfuncs == cap) {
+            cap = cap ? cap * 2 : 16;
+            vp->funcs = (VMFunc *)realloc(vp->funcs, cap * sizeof(VMFunc));
+        }
+        VMFunc *vf = &vp->funcs[vp->nfuncs++];
+        memset(vf, 0, sizeof(*vf));
+        vf->func = item->u.function;
+        vf->needs_check = seen_stmt;
+        for (Param *p = vf->func->params ? vf->func->params->head : NULL; p; p = p->next) {
+            vf->nparams++;
+        }
+    }
+
+    vp->globals = c->prog->global_names;
+    vp->nglobals = c->prog->nglobals;
+}
+
+VMProgram *vm_compile(Program *prog, const char **error) {
+    if (error) *error = NULL;
+    if (!prog) {
+        if (error) *error = "no program";
+        return NULL;
+    }
+
+    /* 변수 슬롯 해석 */
+    if (!resolve_program(prog)) {
+        if (error) *error = prog->resolve_error;
+        return NULL;
+    }
+
+    Compiler c;
+    memset(&c, 0, sizeof(c));
+    c.prog = prog;
+    c.vp = (VMProgram *)calloc(1, sizeof(VMProgram));
+
+    build_tables(&c);
+
+    /* top-level 코드가 0번지부터 */
+    compile_main(&c);
+    for (int i = 0; i < c.vp->nfuncs; ++i) {
+        compile_function(&c, i);
+    }
+    return c.vp;
+}
+
+void vm_free(VMProgram *vp) {
+    if (!vp) return;
+    free(vp->code);
+    free(vp->funcs);
+    free(vp->strings);
+    free(vp->string_lens);
+    free(vp);
+}
+
+/* === 실행 === */
+
+typedef struct {
+    const int *ret_pc;
+    long bp;            /* 호출자 프레임 시작 (스택 재할당에 대비해 인덱스) */
+} VMFrame;
+
+int vm_run(VMProgram *vp, Output *out) {
+    if (!vp) return -1;
+
+#if VM_COMPUTED_GOTO
+    static void *dispatch[OP_COUNT] = {
+        [OP_CONST] = &&L_OP_CONST, [OP_LOAD] = &&L_OP_LOAD, [OP_STORE] = &&L_OP_STORE,
+        [OP_GLOAD] = &&L_OP_GLOAD, [OP_GSTORE] = &&L_OP_GSTORE,
+        [OP_UNDEF_VAR] = &&L_OP_UNDEF_VAR, [OP_POP] = &&L_OP_POP,
+        [OP_ADD] = &&L_OP_ADD, [OP_SUB] = &&L_OP_SUB, [OP_MUL] = &&L_OP_MUL,
+        [OP_DIV] = &&L_OP_DIV, [OP_MOD] = &&L_OP_MOD,
+        [OP_LT] = &&L_OP_LT, [OP_GT] = &&L_OP_GT, [OP_LE] = &&L_OP_LE,
+        [OP_GE] = &&L_OP_GE, [OP_EQ] = &&L_OP_EQ, [OP_NE] = &&L_OP_NE,
+        [OP_AND] = &&L_OP_AND, [OP_OR] = &&L_OP_OR,
+        [OP_NEG] = &&L_OP_NEG, [OP_NOT] = &&L_OP_NOT,
+        [OP_JMP] = &&L_OP_JMP, [OP_JZ] = &&L_OP_JZ,
+        [OP_CALL] = &&L_OP_CALL, [OP_CHKFN] = &&L_OP_CHKFN, [OP_DEFFN] = &&L_OP_DEFFN,
+        [OP_UNDEF_FN] = &&L_OP_UNDEF_FN, [OP_RET] = &&L_OP_RET, [OP_HALT] = &&L_OP_HALT,
+        [OP_PRINT_INT] = &&L_OP_PRINT_INT, [OP_PRINT_STR] = &&L_OP_PRINT_STR,
+    };
+#define VM_CASE(op) L_##op:
+#define VM_NEXT() goto *dispatch[*pc++]
+#define VM_DISPATCH() VM_NEXT();
+#define VM_END_DISPATCH()
+#else
+#define VM_CASE(op) case op:
+#define VM_NEXT() continue
+#define VM_DISPATCH() for (;;) switch (*pc++) {
+#define VM_END_DISPATCH() default: goto done; }
+#endif
+
+    long stack_cap = VM_STACK_INIT;
+    while (stack_cap < (long)vp->main_slots + vp->main_max_stack) stack_cap *= 2;
+    long *stack = (long *)calloc(stack_cap, sizeof(long));
+    int frames_cap = VM_FRAMES_INIT;
+    int nframes = 0;
+    VMFrame *frames = (VMFrame *)malloc(frames_cap * sizeof(VMFrame));
+    long *globals = (long *)calloc(vp->nglobals + 1, sizeof(long));
+    unsigned char *gdefined = (unsigned char *)calloc(vp->nglobals + 1, 1);
+    unsigned char *fdefined = (unsigned char *)calloc(vp->nfuncs + 1, 1);
+    for (int i = 0; i < vp->nfuncs; ++i) {
+        fdefined[i] = !vp->funcs[i].needs_check;
+    }
+
+    const int *code = vp->code;
+    const int *pc = code;
+    long *bp = stack;
+    long *sp = stack + vp->main_slots;
+    long result = 0;
+
+    VM_DISPATCH()
+
+    VM_CASE(OP_CONST)
+        *sp++ = *pc++;
+        VM_NEXT();
+
+    VM_CASE(OP_LOAD)
+        *sp++ = bp[*pc++];
+        VM_NEXT();
+
+    VM_CASE(OP_STORE)
+        bp[*pc++] = *--sp;
+        VM_NEXT();
+
+    VM_CASE(OP_GLOAD) {
+        int g = *pc++;
+        if (!gdefined[g]) {
+            output_printf(out, "Error: undefined variable '%s'\n", vp->globals[g]);
+            *sp++ = 0;
+        } else {
+            *sp++ = globals[g];
+        }
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_GSTORE) {
+        int g = *pc++;
+        globals[g] = *--sp;
+        gdefined[g] = 1;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_UNDEF_VAR)
+        output_printf(out, "Error: undefined variable '%s'\n", vp->strings[*pc++]);
+        *sp++ = 0;
+        VM_NEXT();
+
+    VM_CASE(OP_POP)
+        sp--;
+        VM_NEXT();
+
+#define VM_BINOP(op, expr) \
+    VM_CASE(op) { \
+        long rhs = *--sp; \
+        long lhs = sp[-1]; \
+        sp[-1] = (expr); \
+        VM_NEXT(); \
+    }
+
+    VM_BINOP(OP_ADD, lhs + rhs)
+    VM_BINOP(OP_SUB, lhs - rhs)
+    VM_BINOP(OP_MUL, lhs * rhs)
+    VM_BINOP(OP_LT, lhs < rhs)
+    VM_BINOP(OP_GT, lhs > rhs)
+    VM_BINOP(OP_LE, lhs <= rhs)
+    VM_BINOP(OP_GE, lhs >= rhs)
+    VM_BINOP(OP_EQ, lhs == rhs)
+    VM_BINOP(OP_NE, lhs != rhs)
+    VM_BINOP(OP_AND, lhs && rhs)
+    VM_BINOP(OP_OR, lhs || rhs)
+#undef VM_BINOP
+
+    VM_CASE(OP_DIV) {
+        long rhs = *--sp;
+        if (rhs == 0) {
+            output_printf(out, "Error: division by zero\n");
+            sp[-1] = 0;
+        } else {
+            sp[-1] = sp[-1] / rhs;
+        }
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_MOD) {
+        long rhs = *--sp;
+        if (rhs == 0) {
+            output_printf(out, "Error: modulo by zero\n");
+            sp[-1] = 0;
+        } else {
+            sp[-1] = sp[-1] % rhs;
+        }
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_NEG)
+        sp[-1] = -sp[-1];
+        VM_NEXT();
+
+    VM_CASE(OP_NOT)
+        sp[-1] = !sp[-1];
+        VM_NEXT();
+
+    VM_CASE(OP_JMP)
+        pc = code + *pc;
+        VM_NEXT();
+
+    VM_CASE(OP_JZ)
+        if (*--sp == 0) {
+            pc = code + *pc;
+        } else {
+            pc++;
+        }
+        VM_NEXT();
+
+    VM_CASE(OP_CALL) {
+        const VMFunc *f = &vp->funcs[pc[0]];
+        int argc = pc[1];
+        pc += 2;
+
+        /* 호출 깊이 한계: 인자를 버리고 0 (eval.c와 동일) */
+        if (nframes >= EVAL_MAX_CALL_DEPTH) {
+            output_printf(out, "Error: maximum call depth exceeded\n");
+            sp -= argc;
+            *sp++ = 0;
+            VM_NEXT();
+        }
+
+        /* 스택/프레임 공간 확보 (부족하면 재할당 후 포인터 재계산) */
+        if ((sp - stack) - argc + f->nslots + f->max_stack > stack_cap) {
+            long sp_off = sp - stack;
+            long bp_off = bp - stack;
+            while (sp_off - argc + f->nslots + f->max_stack > stack_cap) stack_cap *= 2;
+            stack = (long *)realloc(stack, stack_cap * sizeof(long));
+            sp = stack + sp_off;
+            bp = stack + bp_off;
+        }
+        if (nframes == frames_cap) {
+            frames_cap *= 2;
+            frames = (VMFrame *)realloc(frames, frames_cap * sizeof(VMFrame));
+        }
+        frames[nframes].ret_pc = pc;
+        frames[nframes].bp = bp - stack;
+        nframes++;
+
+        /* 남는 인자는 버리고 (이미 평가됨) 나머지 지역 슬롯은 0 */
+        bp = sp - argc;
+        sp = bp + f->nparams;
+        for (long *p = sp; p < bp + f->nslots; ++p) *p = 0;
+        sp = bp + f->nslots;
+        pc = code + f->entry;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_CHKFN) {
+        int fi = pc[0];
+        if (!fdefined[fi]) {
+            output_printf(out, "Error: undefined function '%s'\n", vp->funcs[fi].func->name);
+            *sp++ = 0;
+            pc = code + pc[1];
+        } else {
+            pc += 2;
+        }
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_DEFFN)
+        fdefined[*pc++] = 1;
+        VM_NEXT();
+
+    VM_CASE(OP_UNDEF_FN)
+        output_printf(out, "Error: undefined function '%s'\n", vp->strings[*pc++]);
+        *sp++ = 0;
+        VM_NEXT();
+
+    VM_CASE(OP_RET) {
+        long val = sp[-1];
+        nframes--;
+        sp = bp;
+        bp = stack + frames[nframes].bp;
+        pc = frames[nframes].ret_pc;
+        *sp++ = val;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_HALT)
+        result = sp[-1];
+        goto done;
+
+    VM_CASE(OP_PRINT_INT)
+        output_line_int(out, *--sp);
+        VM_NEXT();
+
+    VM_CASE(OP_PRINT_STR)
+        output_line_strn(out, vp->strings[*pc], vp->string_lens[*pc]);
+        pc++;
+        VM_NEXT();
+
+    VM_END_DISPATCH()
+
+done:
+    free(stack);
+    free(frames);
+    free(globals);
+    free(gdefined);
+    free(fdefined);
+    return (int)result;
+
+#undef VM_CASE
+#undef VM_NEXT
+#undef VM_DISPATCH
+#undef VM_END_DISPATCH
+}
+
+int vm_eval_program(Program *prog, Output *out, int *used_vm, const char **error) {
+    VMProgram *vp = vm_compile(prog, error);
+    if (!vp) {
+        if (used_vm) *used_vm = 0;
+        return eval_program(prog, out);
+    }
+    int result = vm_run(vp, out);
+    vm_free(vp);
+    if (used_vm) *used_vm = 1;
+    return result;
+}
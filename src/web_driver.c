@@ -13,223 +13,184 @@
 #include <string.h>
 #include "ast.h"
 #include "codegen_x86.h"
-#include "eval.h"
-
-/* 외부 파서 함수 */
-extern int yyparse(void);
-extern void yy_scan_string_custom(const char *str);
-extern void yy_reset_input(void);
+#include "context.h"
+
+/* 드라이버 컨텍스트 (첫 호출 시 생성, 이후 재사용) */
+static MiniJSContext *web_ctx = NULL;
+
+/* 결과 버퍼 (늘어나는 Output, 다음 호출까지 유지) */
+#define AST_BUFSIZE 65536
+static Output result_out;
+static Output asm_out;
+static Output exec_out;
+static char ast_output_buffer[AST_BUFSIZE];
+
+/* 이전 결과를 해제하고 빈 버퍼로 */
+static void reset_output(Output *out) {
+    output_release(out);
+    output_init_grow(out);
+}
 
-/* 전역 프로그램 (parser.y에서 설정) */
-extern Program *g_program;
+/* 버퍼에 문자열 추가 */
+static void append(Output *out, const char *str) {
+    output_write(out, str, (int)strlen(str));
+}
 
-/* 결과 버퍼 */
-#define RESULT_BUFSIZE 65536
-static char result_buffer[RESULT_BUFSIZE];
-static char ast_output_buffer[RESULT_BUFSIZE];
-static char asm_buffer[RESULT_BUFSIZE];
-static char exec_buffer[RESULT_BUFSIZE];
+/* 컨텍스트 준비 후 파싱 (최적화 전 소스 그대로의 AST, 실행할 때 minijs_eval이 최적화)
+ * - 반환: 성공 시 프로그램, 파싱 오류 시 NULL (*parse_error = 1),
+ *         빈 프로그램이면 NULL (*parse_error = 0) */
+static Program *parse_source(const char *js_code, int *parse_error) {
+    *parse_error = 0;
+    if (!web_ctx) {
+        web_ctx = minijs_context_new();
+        if (!web_ctx) {
+            *parse_error = 1;
+            return NULL;
+        }
+    }
+    if (minijs_parse_string(web_ctx, js_code) != 0) {
+        *parse_error = 1;
+        return NULL;
+    }
+    if (web_ctx->program->empty) {
+        minijs_release_program(web_ctx);
+        return NULL;
+    }
+    return web_ctx->program;
+}
 
-/* 버퍼에 문자열 추가 */
-static void append_to_buffer(char *buf, int bufsize, int *pos, const char *str) {
-    int len = strlen(str);
-    int remaining = bufsize - *pos - 1;
-    if (len > remaining) len = remaining;
-    if (len > 0) {
-        memcpy(buf + *pos, str, len);
-        *pos += len;
-        buf[*pos] = '\0';
-    }
+/* 실행 출력을 dst에 추가 (출력 길이 제한 없음) */
+static int eval_to_output(Output *dst) {
+    minijs_set_output_grow(web_ctx);
+    int ret = minijs_eval(web_ctx, MINIJS_ENGINE_TREE, NULL, NULL);
+    output_write(dst, web_ctx->out.buffer, web_ctx->out.pos);
+    minijs_set_output_file(web_ctx, stdout);
+    return ret;
 }
 
 /* JavaScript 코드 컴파일 및 실행 */
 EMSCRIPTEN_KEEPALIVE
 const char *compile_mini_js(const char *js_code) {
-    int result_pos = 0;
-    result_buffer[0] = '\0';
-    asm_buffer[0] = '\0';
-    exec_buffer[0] = '\0';
+    reset_output(&result_out);
 
     if (!js_code || strlen(js_code) == 0) {
-        strcpy(result_buffer, "Error: Empty input\n");
-        return result_buffer;
+        append(&result_out, "Error: Empty input\n");
+        return result_out.buffer;
     }
 
-    /* 이전 프로그램 해제 */
-    if (g_program) {
-        free_program(g_program);
-        g_program = NULL;
+    /* 문자열에서 파싱 (이전 프로그램은 컨텍스트가 해제) */
+    int parse_error;
+    Program *prog = parse_source(js_code, &parse_error);
+    if (parse_error) {
+        append(&result_out, "=== Parse Error ===\nFailed to parse the input code.\n");
+        return result_out.buffer;
     }
-
-    /* 문자열에서 파싱 */
-    g_program = new_program();
-    yy_scan_string_custom(js_code);
-
-    if (yyparse() != 0) {
-        yy_reset_input();
-        free_program(g_program);
-        g_program = NULL;
-        strcpy(result_buffer, "=== Parse Error ===\nFailed to parse the input code.\n");
-        return result_buffer;
-    }
-
-    yy_reset_input();
-
-    if (!g_program || !g_program->items) {
-        strcpy(result_buffer, "=== Error ===\nNo program parsed.\n");
-        if (g_program) free_program(g_program);
-        g_program = NULL;
-        return result_buffer;
+    if (!prog) {
+        append(&result_out, "=== Error ===\nNo program parsed.\n");
+        return result_out.buffer;
     }
 
     /* AST 시각화 */
-    append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos,
-                     "=== AST ===\n");
+    append(&result_out, "=== AST ===\n");
 
     ast_output_buffer[0] = '\0';
-    int ast_len = ast_to_buffer(g_program, ast_output_buffer, RESULT_BUFSIZE);
+    int ast_len = ast_to_buffer(prog, ast_output_buffer, AST_BUFSIZE);
     if (ast_len > 0) {
-        append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos, ast_output_buffer);
+        append(&result_out, ast_output_buffer);
     } else {
-        append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos,
-                         "(No AST generated)\n");
+        append(&result_out, "(No AST generated)\n");
     }
 
     /* 어셈블리 코드 생성 */
-    append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos,
-                     "\n=== x86-64 Assembly ===\n");
+    append(&result_out, "\n=== x86-64 Assembly ===\n");
 
-    int asm_len = gen_x86_to_buffer(g_program, asm_buffer, RESULT_BUFSIZE);
-    if (asm_len > 0) {
-        append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos, asm_buffer);
+    reset_output(&asm_out);
+    if (gen_x86_program(prog, &asm_out, web_ctx->opt_level, NULL) == 0 && asm_out.pos > 0) {
+        output_write(&result_out, asm_out.buffer, asm_out.pos);
     } else {
-        append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos,
-                         "(Assembly generation failed)\n");
+        append(&result_out, "(Assembly generation failed)\n");
     }
 
     /* 인터프리터 실행 */
-    append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos,
-                     "\n=== Execution Result ===\n");
+    append(&result_out, "\n=== Execution Result ===\n");
 
-    eval_set_output_buffer(exec_buffer, RESULT_BUFSIZE);
-    int ret = eval_program(g_program);
-    eval_reset_output_buffer();
-
-    /* 실행 출력 추가 */
-    if (strlen(exec_buffer) > 0) {
-        append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos, exec_buffer);
-    }
+    int ret = eval_to_output(&result_out);
 
     /* 반환값 추가 */
     char ret_str[64];
     snprintf(ret_str, sizeof(ret_str), "\nReturn Value: %d\n", ret);
-    append_to_buffer(result_buffer, RESULT_BUFSIZE, &result_pos, ret_str);
+    append(&result_out, ret_str);
 
     /* 메모리 해제 */
-    free_program(g_program);
-    g_program = NULL;
+    minijs_release_program(web_ctx);
 
-    return result_buffer;
+    return result_out.buffer;
 }
 
 /* 어셈블리만 생성 */
 EMSCRIPTEN_KEEPALIVE
 const char *compile_to_asm(const char *js_code) {
-    asm_buffer[0] = '\0';
+    reset_output(&asm_out);
 
     if (!js_code || strlen(js_code) == 0) {
-        strcpy(asm_buffer, "; Error: Empty input\n");
-        return asm_buffer;
+        append(&asm_out, "; Error: Empty input\n");
+        return asm_out.buffer;
     }
 
-    if (g_program) {
-        free_program(g_program);
-        g_program = NULL;
+    int parse_error;
+    Program *prog = parse_source(js_code, &parse_error);
+    if (parse_error) {
+        append(&asm_out, "; Parse Error\n");
+        return asm_out.buffer;
     }
-
-    g_program = new_program();
-    yy_scan_string_custom(js_code);
-
-    if (yyparse() != 0) {
-        yy_reset_input();
-        free_program(g_program);
-        g_program = NULL;
-        strcpy(asm_buffer, "; Parse Error\n");
-        return asm_buffer;
+    if (!prog) {
+        append(&asm_out, "; No program\n");
+        return asm_out.buffer;
     }
 
-    yy_reset_input();
-
-    if (!g_program || !g_program->items) {
-        strcpy(asm_buffer, "; No program\n");
-        if (g_program) free_program(g_program);
-        g_program = NULL;
-        return asm_buffer;
+    const char *asm_error = NULL;
+    if (gen_x86_program(prog, &asm_out, web_ctx->opt_level, &asm_error) != 0) {
+        reset_output(&asm_out);
+        append(&asm_out, "; Error: ");
+        append(&asm_out, asm_error ? asm_error : "cannot compile");
+        append(&asm_out, "\n");
     }
 
-    gen_x86_to_buffer(g_program, asm_buffer, RESULT_BUFSIZE);
-
-    free_program(g_program);
-    g_program = NULL;
+    minijs_release_program(web_ctx);
 
-    return asm_buffer;
+    return asm_out.buffer;
 }
 
 /* 인터프리터만 실행 */
 EMSCRIPTEN_KEEPALIVE
 const char *execute_mini_js(const char *js_code) {
-    int result_pos = 0;
-    exec_buffer[0] = '\0';
+    reset_output(&exec_out);
 
     if (!js_code || strlen(js_code) == 0) {
-        strcpy(exec_buffer, "Error: Empty input\n");
-        return exec_buffer;
-    }
-
-    if (g_program) {
-        free_program(g_program);
-        g_program = NULL;
+        append(&exec_out, "Error: Empty input\n");
+        return exec_out.buffer;
     }
 
-    g_program = new_program();
-    yy_scan_string_custom(js_code);
-
-    if (yyparse() != 0) {
-        yy_reset_input();
-        free_program(g_program);
-        g_program = NULL;
-        strcpy(exec_buffer, "Parse Error\n");
-        return exec_buffer;
+    int parse_error;
+    Program *prog = parse_source(js_code, &parse_error);
+    if (parse_error) {
+        append(&exec_out, "Parse Error\n");
+        return exec_out.buffer;
     }
-
-    yy_reset_input();
-
-    if (!g_program || !g_program->items) {
-        strcpy(exec_buffer, "No program\n");
-        if (g_program) free_program(g_program);
-        g_program = NULL;
-        return exec_buffer;
+    if (!prog) {
+        append(&exec_out, "No program\n");
+        return exec_out.buffer;
     }
 
-    /* 실행 결과용 임시 버퍼 */
-    char temp_buf[RESULT_BUFSIZE];
-    temp_buf[0] = '\0';
-
-    eval_set_output_buffer(temp_buf, RESULT_BUFSIZE);
-    int ret = eval_program(g_program);
-    eval_reset_output_buffer();
-
-    /* 결과 조합 */
-    append_to_buffer(exec_buffer, RESULT_BUFSIZE, &result_pos, temp_buf);
+    int ret = eval_to_output(&exec_out);
 
     char ret_str[64];
     snprintf(ret_str, sizeof(ret_str), "Return: %d\n", ret);
-    append_to_buffer(exec_buffer, RESULT_BUFSIZE, &result_pos, ret_str);
+    append(&exec_out, ret_str);
 
-    free_program(g_program);
-    g_program = NULL;
+    minijs_release_program(web_ctx);
 
-    return exec_buffer;
+    return exec_out.buffer;
 }
 
 /* 버전 정보 */
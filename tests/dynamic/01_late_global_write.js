@@ -0,0 +1,23 @@
+// Symbol-table fallback 01: a function assigns a global before its declaration
+// Before `let v` runs, `v = ...` creates a local of the current call
+// (not the global), so the top-level read is still undefined
+
+function f() {
+    v = 5;
+    return v;
+}
+
+function r(n) {
+    if (n == 0) {
+        return 0;
+    }
+    v = n * 2;
+    return r(n - 1) + v;
+}
+
+console.log(f());
+console.log(v);
+console.log(r(3));
+let v = 1;
+console.log(f());
+console.log(v);
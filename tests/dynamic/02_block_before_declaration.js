@@ -0,0 +1,14 @@
+// Symbol-table fallback 02: a top-level block assigns a global before its declaration
+// The assignment creates a block local, which a called function sees (dynamic scope)
+
+function peek() {
+    return q;
+}
+
+{
+    q = 5;
+    console.log(peek());
+}
+console.log(peek());
+let q = 1;
+console.log(peek());
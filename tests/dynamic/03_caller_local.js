@@ -0,0 +1,15 @@
+// Symbol-table fallback 03: a function reads and writes its caller's local variable
+
+function show() {
+    console.log(depth);
+    depth = depth + 1;
+    return depth;
+}
+
+function outer() {
+    let depth = 10;
+    show();
+    return depth;
+}
+
+console.log(outer());
@@ -5,6 +5,7 @@ set -eu
 
 QUIET_FLAG="${QUIET_FLAG:--q}"
 DIFF_FLAGS="${DIFF_FLAGS:---strip-trailing-cr}"
+EXTRA_FLAGS="${EXTRA_FLAGS:-}"
 
 SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
 PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
@@ -92,7 +93,7 @@ for JS_FILE in "${EXAMPLES_DIR}"/*.js; do
     TMP_OUT="$(mktemp)"
     TMP_DIFF="$(mktemp)"
 
-    if ! "${BINARY}" "${QUIET_FLAG}" -e "${JS_FILE}" >"${TMP_OUT}" 2>"${TMP_DIFF}"; then
+    if ! "${BINARY}" "${QUIET_FLAG}" -e ${EXTRA_FLAGS} "${JS_FILE}" >"${TMP_OUT}" 2>"${TMP_DIFF}"; then
         echo "[FAIL] ${DISPLAY_NAME}"
         print_reason_block "interpreter exited with non-zero status" "${TMP_DIFF}"
         print_output_block
@@ -0,0 +1,77 @@
+#!/usr/bin/env sh
+# Compile every Mini-JS example to x86-64, link it with the system C compiler,
+# run the binary and compare its output with the recorded expectation.
+# (the exit status of the binary is the program's return value, so it is not checked)
+
+set -eu
+
+OPT="${OPT:--O1}"
+CC="${CC:-cc}"
+DIFF_FLAGS="${DIFF_FLAGS:---strip-trailing-cr}"
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/minijs}"
+EXAMPLES_DIR="${2:-${PROJECT_ROOT}/examples}"
+EXPECTED_DIR="${3:-${EXAMPLES_DIR}/expected}"
+
+if [ ! -x "${BINARY}" ]; then
+    echo "error: binary not found or not executable: ${BINARY}" >&2
+    exit 2
+fi
+
+if ! command -v "${CC}" >/dev/null 2>&1; then
+    echo "skip: no C compiler (${CC}) to link native code"
+    exit 0
+fi
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "${WORK_DIR}"' EXIT
+
+STATUS=0
+
+for JS_FILE in "${EXAMPLES_DIR}"/*.js; do
+    [ -e "${JS_FILE}" ] || {
+        echo "error: no .js files in ${EXAMPLES_DIR}" >&2
+        exit 2
+    }
+
+    BASENAME="$(basename "${JS_FILE}" .js)"
+    DISPLAY_NAME="$(basename "${JS_FILE}")"
+    EXPECTED_FILE="${EXPECTED_DIR}/${BASENAME}.txt"
+    ASM="${WORK_DIR}/${BASENAME}.s"
+    EXE="${WORK_DIR}/${BASENAME}"
+    LOG="${WORK_DIR}/${BASENAME}.log"
+
+    if ! "${BINARY}" -c ${OPT} -o "${ASM}" "${JS_FILE}" >"${LOG}" 2>&1 ||
+       ! "${CC}" -o "${EXE}" "${ASM}" >>"${LOG}" 2>&1; then
+        echo "[FAIL] ${DISPLAY_NAME} (${OPT})"
+        echo "[REASON]"
+        echo "compile/link failed"
+        cat "${LOG}"
+        echo ""
+        STATUS=1
+        continue
+    fi
+
+    "${EXE}" >"${WORK_DIR}/${BASENAME}.out" 2>&1 || true
+
+    if ! diff -u ${DIFF_FLAGS} "${EXPECTED_FILE}" "${WORK_DIR}/${BASENAME}.out" >"${LOG}"; then
+        echo "[FAIL] ${DISPLAY_NAME} (${OPT})"
+        echo "[REASON]"
+        echo "output mismatch"
+        cat "${LOG}"
+        echo ""
+        STATUS=1
+    else
+        echo "[PASS] ${DISPLAY_NAME} (${OPT})"
+    fi
+done
+
+if [ ${STATUS} -eq 0 ]; then
+    printf "\nAll native example tests passed.\n"
+else
+    printf "\nSome native tests failed.\n" >&2
+fi
+
+exit ${STATUS}
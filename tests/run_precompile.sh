@@ -0,0 +1,80 @@
+#!/usr/bin/env sh
+# Precompile every Mini-JS example to .mjsc, run the .mjsc (no parsing) and
+# compare its output with the recorded expectation.
+# (programs that fall back to dynamic scope cannot be precompiled and are skipped)
+
+set -eu
+
+DIFF_FLAGS="${DIFF_FLAGS:---strip-trailing-cr}"
+
+SCRIPT_DIR="$(CDPATH= cd -- "$(dirname "$0")" && pwd)"
+PROJECT_ROOT="$(CDPATH= cd -- "${SCRIPT_DIR}/.." && pwd)"
+BINARY="${1:-${PROJECT_ROOT}/minijs}"
+EXAMPLES_DIR="${2:-${PROJECT_ROOT}/examples}"
+EXPECTED_DIR="${3:-${EXAMPLES_DIR}/expected}"
+
+if [ ! -x "${BINARY}" ]; then
+    echo "error: binary not found or not executable: ${BINARY}" >&2
+    exit 2
+fi
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "${WORK_DIR}"' EXIT
+
+STATUS=0
+
+for JS_FILE in "${EXAMPLES_DIR}"/*.js; do
+    [ -e "${JS_FILE}" ] || {
+        echo "error: no .js files in ${EXAMPLES_DIR}" >&2
+        exit 2
+    }
+
+    BASENAME="$(basename "${JS_FILE}" .js)"
+    DISPLAY_NAME="$(basename "${JS_FILE}")"
+    EXPECTED_FILE="${EXPECTED_DIR}/${BASENAME}.txt"
+    MJSC="${WORK_DIR}/${BASENAME}.mjsc"
+    LOG="${WORK_DIR}/${BASENAME}.log"
+
+    if ! "${BINARY}" --precompile -o "${MJSC}" "${JS_FILE}" >"${LOG}" 2>&1; then
+        if grep -q "dynamic scope" "${LOG}"; then
+            echo "[SKIP] ${DISPLAY_NAME} (dynamic scope)"
+            continue
+        fi
+        echo "[FAIL] ${DISPLAY_NAME} (precompile)"
+        echo "[REASON]"
+        echo "precompile failed"
+        cat "${LOG}"
+        echo ""
+        STATUS=1
+        continue
+    fi
+
+    if ! "${BINARY}" -q -e "${MJSC}" >"${WORK_DIR}/${BASENAME}.out" 2>"${LOG}"; then
+        echo "[FAIL] ${DISPLAY_NAME} (.mjsc)"
+        echo "[REASON]"
+        echo "interpreter exited with non-zero status"
+        cat "${LOG}"
+        echo ""
+        STATUS=1
+        continue
+    fi
+
+    if ! diff -u ${DIFF_FLAGS} "${EXPECTED_FILE}" "${WORK_DIR}/${BASENAME}.out" >"${LOG}"; then
+        echo "[FAIL] ${DISPLAY_NAME} (.mjsc)"
+        echo "[REASON]"
+        echo "output mismatch"
+        cat "${LOG}"
+        echo ""
+        STATUS=1
+    else
+        echo "[PASS] ${DISPLAY_NAME} (.mjsc)"
+    fi
+done
+
+if [ ${STATUS} -eq 0 ]; then
+    printf "\nAll precompiled example tests passed.\n"
+else
+    printf "\nSome precompiled tests failed.\n" >&2
+fi
+
+exit ${STATUS}